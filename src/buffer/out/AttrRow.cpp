@@ -28,6 +28,24 @@ void ATTR_ROW::Reset(const TextAttribute attr)
     _list.push_back(TextAttributeRun(_cchRowWidth, attr));
 }
 
+// Routine Description:
+// - Releases any memory the run list is holding beyond the runs it actually has.
+//   InsertAttrRuns sizes its scratch list for the worst case, and Reset keeps the
+//   old capacity, so a row that once had many runs can hold onto a lot of space.
+// - This is best effort. If it fails, the row stays as it was.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ATTR_ROW::Compact() noexcept
+{
+    try
+    {
+        _list.shrink_to_fit();
+    }
+    CATCH_LOG();
+}
+
 // Routine Description:
 // - Takes an existing row of attributes, and changes the length so that it fills the NewWidth.
 //     If the new size is bigger, then the last attr is extended to fill the NewWidth.
@@ -319,6 +337,21 @@ HRESULT ATTR_ROW::InsertAttrRuns(const std::basic_string_view<TextAttributeRun>
         return S_OK;
     }
 
+    // A single run (like a span of text written in one color) only ever touches the runs it
+    // overlaps and at most one neighbor on each side, so splice it into the list where it is
+    // instead of rebuilding the whole list into a new buffer.
+    if (newAttrs.size() == 1)
+    {
+        FAIL_FAST_IF(!(iStart <= iEnd && iEnd < _cchRowWidth));
+        try
+        {
+            const TextAttributeRun run{ iEnd - iStart + 1, newAttrs.at(0).GetAttributes() };
+            _SpliceRun(run, iStart);
+        }
+        CATCH_RETURN();
+        return S_OK;
+    }
+
     // In the worst case scenario, we will need a new run that is the length of
     // The existing run in memory + The new run in memory + 1.
     // This worst case occurs when we inject a new item in the middle of an existing run like so
@@ -527,6 +560,102 @@ HRESULT ATTR_ROW::InsertAttrRuns(const std::basic_string_view<TextAttributeRun>
     return S_OK;
 }
 
+// Routine Description:
+// - Merges a single run into the list in place. The runs it covers are replaced by at most
+//   three: what's left of the run it starts in, the run itself, and what's left of the run it
+//   ends in. Neighbors with the same attribute are folded into it so the list stays packed.
+// - The list is only shifted once to make or close up room, and keeps its capacity.
+// Arguments:
+// - run - The run to merge in. Its length must fit in the row from iStart.
+// - iStart - The column the run starts at.
+// Return Value:
+// - <none>, throws exceptions on failures.
+void ATTR_ROW::_SpliceRun(const TextAttributeRun& run, const size_t iStart)
+{
+    const size_t iEnd = iStart + run.GetLength(); // exclusive
+    const TextAttribute& attr = run.GetAttributes();
+
+    // Find the first and last existing runs the new run overlaps.
+    size_t first = 0;
+    size_t firstBegin = 0;
+    while (firstBegin + _list.at(first).GetLength() <= iStart)
+    {
+        firstBegin += _list.at(first).GetLength();
+        ++first;
+    }
+
+    size_t last = first;
+    size_t lastEnd = firstBegin + _list.at(first).GetLength();
+    while (lastEnd < iEnd)
+    {
+        ++last;
+        lastEnd += _list.at(last).GetLength();
+    }
+
+    // Work out what will replace [replaceBegin, replaceEnd) in the list.
+    size_t replaceBegin = first;
+    size_t replaceEnd = last + 1;
+    TextAttributeRun pieces[3];
+    size_t cPieces = 0;
+    size_t length = run.GetLength();
+
+    if (iStart > firstBegin)
+    {
+        // The new run starts partway into an existing one. Keep its front, or grow into it if it's the same color.
+        if (_list.at(first).GetAttributes() == attr)
+        {
+            length += iStart - firstBegin;
+        }
+        else
+        {
+            pieces[cPieces++] = TextAttributeRun(iStart - firstBegin, _list.at(first).GetAttributes());
+        }
+    }
+    else if (first > 0 && _list.at(first - 1).GetAttributes() == attr)
+    {
+        // The new run starts right at a boundary and continues the run on the left.
+        --replaceBegin;
+        length += _list.at(replaceBegin).GetLength();
+    }
+
+    TextAttributeRun* const pMiddle = &pieces[cPieces++];
+
+    if (lastEnd > iEnd)
+    {
+        // The new run ends partway into an existing one. Keep its back, or grow into it if it's the same color.
+        if (_list.at(last).GetAttributes() == attr)
+        {
+            length += lastEnd - iEnd;
+        }
+        else
+        {
+            pieces[cPieces++] = TextAttributeRun(lastEnd - iEnd, _list.at(last).GetAttributes());
+        }
+    }
+    else if (replaceEnd < _list.size() && _list.at(replaceEnd).GetAttributes() == attr)
+    {
+        // The new run ends right at a boundary and is continued by the run on the right.
+        length += _list.at(replaceEnd).GetLength();
+        ++replaceEnd;
+    }
+
+    *pMiddle = TextAttributeRun(length, attr);
+
+    // Overwrite what we can in place, then close up or open the gap for the difference.
+    const size_t cReplaced = replaceEnd - replaceBegin;
+    const size_t cShared = std::min(cReplaced, cPieces);
+    std::copy_n(&pieces[0], cShared, _list.begin() + replaceBegin);
+
+    if (cPieces < cReplaced)
+    {
+        _list.erase(_list.cbegin() + replaceBegin + cPieces, _list.cbegin() + replaceEnd);
+    }
+    else if (cPieces > cReplaced)
+    {
+        _list.insert(_list.cbegin() + replaceBegin + cShared, &pieces[cShared], &pieces[cPieces]);
+    }
+}
+
 // Routine Description:
 // - packs a vector of TextAttribute into a vector of TextAttrbuteRun
 // Arguments:
@@ -46,6 +46,7 @@ public:
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith) noexcept;
 
     void Resize(const size_t newWidth);
+    void Compact() noexcept;
 
     [[nodiscard]]
     HRESULT InsertAttrRuns(const std::basic_string_view<TextAttributeRun> newAttrs,
@@ -66,6 +67,8 @@ public:
 
 private:
 
+    void _SpliceRun(const TextAttributeRun& run, const size_t iStart);
+
     std::vector<TextAttributeRun> _list;
     size_t _cchRowWidth;
 
@@ -92,6 +92,20 @@ const TextAttribute& AttrRowIterator::operator*() const
     return _run->GetAttributes();
 }
 
+// Routine Description:
+// - gets how many more columns share the attribute the iterator points to
+//   before the next run in the ATTR_ROW starts
+// Return Value:
+// - the number of columns left in the current run, including this one. 0 at the end.
+size_t AttrRowIterator::GetRunRemaining() const noexcept
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    return _run->GetLength() - _currentAttributeIndex;
+}
+
 // Routine Description:
 // - increments the index the iterator points to
 // Arguments:
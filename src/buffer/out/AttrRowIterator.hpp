@@ -51,6 +51,8 @@ public:
     const TextAttribute* operator->() const;
     const TextAttribute& operator*() const;
 
+    size_t GetRunRemaining() const noexcept;
+
 private:
     std::vector<TextAttributeRun>::const_iterator _run;
     const ATTR_ROW* _pAttrRow;
@@ -18,7 +18,11 @@
 CharRow::CharRow(size_t rowWidth, ROW* const pParent) :
     _wrapForced{ false },
     _doubleBytePadded{ false },
+    _rowWidth{ rowWidth },
     _data(rowWidth, value_type()),
+    _compactText{},
+    _isCompact{ false },
+    _unicodeStorage{},
     _pParent{ FAIL_FAST_IF_NULL(pParent) }
 {
 }
@@ -75,7 +79,7 @@ bool CharRow::WasDoubleBytePadded() const noexcept
 // - the size of the row
 size_t CharRow::size() const noexcept
 {
-    return _data.size();
+    return _rowWidth;
 }
 
 // Routine Description:
@@ -86,11 +90,20 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset()
 {
-    for (auto& cell : _data)
+    if (_isCompact)
     {
-        cell.Reset();
+        // A blank compact row is just an empty string, no need to inflate.
+        _compactText.clear();
+    }
+    else
+    {
+        for (auto& cell : _data)
+        {
+            cell.Reset();
+        }
     }
 
+    _unicodeStorage.Reset();
     _wrapForced = false;
     _doubleBytePadded = false;
 }
@@ -106,31 +119,181 @@ HRESULT CharRow::Resize(const size_t newSize) noexcept
 {
     try
     {
-        const value_type insertVals;
-        _data.resize(newSize, insertVals);
+        if (_isCompact)
+        {
+            // Compact text has no trailing blanks to grow, only text to cut
+            // off. What's left mustn't end in blanks either.
+            if (_compactText.size() > newSize)
+            {
+                _compactText.resize(newSize);
+                _compactText.erase(_compactText.find_last_not_of(' ') + 1);
+            }
+        }
+        else
+        {
+            const value_type insertVals;
+            _data.resize(newSize, insertVals);
+        }
+        _unicodeStorage.EraseFrom(newSize);
+        _rowWidth = newSize;
     }
     CATCH_RETURN();
 
     return S_OK;
 }
 
-typename CharRow::iterator CharRow::begin() noexcept
+// Routine Description:
+// - Switches the row to its compact form, if all of its cells can be
+//   represented there. See the notes on the class. Rows that can't be
+//   compacted, or already are, are left alone.
+// - This is best effort. If it fails, the row stays as it was.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CharRow::Compact() noexcept
+{
+    if (_isCompact)
+    {
+        return;
+    }
+
+    try
+    {
+        const auto lastNonBlank = std::find_if(_data.crbegin(), _data.crend(), [](const value_type& cell) {
+            return !cell.IsSpace() || !cell.DbcsAttr().IsSingle();
+        });
+        const size_t length = _data.crend() - lastNonBlank;
+
+        std::string text;
+        text.reserve(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            const auto& cell = _data[i];
+            if (cell.Char() >= 0x80 || !cell.DbcsAttr().IsSingle() || cell.DbcsAttr().IsGlyphStored())
+            {
+                return;
+            }
+            text.push_back(static_cast<char>(cell.Char()));
+        }
+
+        _compactText.swap(text);
+        _isCompact = true;
+
+        // Actually release the cell storage, clear() alone would keep the capacity.
+        std::vector<value_type>().swap(_data);
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Tells you whether the row is currently held in its compact form.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if the row is compact. False if the full cell storage is present.
+bool CharRow::IsCompact() const noexcept
+{
+    return _isCompact;
+}
+
+// Routine Description:
+// - Retrieves the full-width cell storage, first rebuilding it from the
+//   compact form if the row was compacted. Only for callers that are about
+//   to write to the row.
+// Arguments:
+// - <none>
+// Return Value:
+// - the cell storage for the row
+// Note: will throw exception if unable to allocate the cells
+std::vector<CharRow::value_type>& CharRow::_GetData()
+{
+    if (_isCompact)
+    {
+        _data.assign(_rowWidth, value_type());
+        for (size_t i = 0; i < _compactText.size(); ++i)
+        {
+            _data[i].Char() = static_cast<wchar_t>(_compactText[i]);
+        }
+
+        _isCompact = false;
+        std::string().swap(_compactText);
+    }
+    return _data;
+}
+
+// Routine Description:
+// - Gets a copy of the cell at the column, whichever form the row is in.
+// Arguments:
+// - column - the column of the cell
+// Return Value:
+// - the cell
+// Note: will throw exception if column is out of bounds
+CharRow::value_type CharRow::_GetCell(const size_t column) const
 {
-    return _data.begin();
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
+    if (!_isCompact)
+    {
+        return _data.at(column);
+    }
+
+    value_type cell;
+    if (column < _compactText.size())
+    {
+        cell.Char() = static_cast<wchar_t>(_compactText[column]);
+    }
+    return cell;
 }
 
-typename CharRow::const_iterator CharRow::cbegin() const noexcept
+// Routine Description:
+// - Gets the glyph at the column of a compact row without inflating it.
+// Arguments:
+// - column - the column of the glyph
+// Return Value:
+// - a view of the glyph. It stays valid for the life of the process.
+std::wstring_view CharRow::_GetCompactGlyph(const size_t column) const
 {
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
+
+    // Compact rows only hold ASCII, so every glyph they have is in here.
+    static const std::wstring s_asciiGlyphs = [] {
+        std::wstring glyphs(0x80, UNICODE_NULL);
+        for (size_t i = 0; i < glyphs.size(); ++i)
+        {
+            glyphs[i] = static_cast<wchar_t>(i);
+        }
+        return glyphs;
+    }();
+
+    const char ch = column < _compactText.size() ? _compactText[column] : ' ';
+    return { s_asciiGlyphs.data() + static_cast<unsigned char>(ch), 1 };
+}
+
+typename CharRow::iterator CharRow::begin()
+{
+    return _GetData().begin();
+}
+
+// Routine Description:
+// - Gets a const iterator to the first cell. Compact rows have no cells, so
+//   callers must check IsCompact first and read those through GetText.
+// Return Value:
+// - iterator to the first cell
+// Note: will throw exception if the row is compact
+typename CharRow::const_iterator CharRow::cbegin() const
+{
+    THROW_HR_IF(E_NOT_VALID_STATE, _isCompact);
     return _data.cbegin();
 }
 
-typename CharRow::iterator CharRow::end() noexcept
+typename CharRow::iterator CharRow::end()
 {
-    return _data.end();
+    return _GetData().end();
 }
 
-typename CharRow::const_iterator CharRow::cend() const noexcept
+typename CharRow::const_iterator CharRow::cend() const
 {
+    THROW_HR_IF(E_NOT_VALID_STATE, _isCompact);
     return _data.cend();
 }
 
@@ -142,6 +305,12 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const
 {
+    if (_isCompact)
+    {
+        const auto left = _compactText.find_first_not_of(' ');
+        return left == std::string::npos ? _rowWidth : left;
+    }
+
     std::vector<value_type>::const_iterator it = _data.cbegin();
     while (it != _data.cend() && it->IsSpace())
     {
@@ -158,6 +327,12 @@ size_t CharRow::MeasureLeft() const
 // - The calculated right boundary of the internal string.
 size_t CharRow::MeasureRight() const noexcept
 {
+    if (_isCompact)
+    {
+        // Trailing blanks were trimmed when compacting, so the text ends at the right edge.
+        return _compactText.size();
+    }
+
     std::vector<value_type>::const_reverse_iterator it = _data.crbegin();
     while (it != _data.crend() && it->IsSpace())
     {
@@ -168,7 +343,8 @@ size_t CharRow::MeasureRight() const noexcept
 
 void CharRow::ClearCell(const size_t column)
 {
-    _data.at(column).Reset();
+    _GetData().at(column).Reset();
+    _unicodeStorage.Erase(column);
 }
 
 // Routine Description:
@@ -179,6 +355,11 @@ void CharRow::ClearCell(const size_t column)
 // - True if there is valid text in this row. False otherwise.
 bool CharRow::ContainsText() const noexcept
 {
+    if (_isCompact)
+    {
+        return _compactText.find_first_not_of(' ') != std::string::npos;
+    }
+
     for (const value_type& cell : _data)
     {
         if (!cell.IsSpace())
@@ -198,6 +379,13 @@ bool CharRow::ContainsText() const noexcept
 // Note: will throw exception if column is out of bounds
 const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 {
+    if (_isCompact)
+    {
+        // Every cell of a compact row is a single cell with nothing stored out of line.
+        static const DbcsAttribute s_compactAttr;
+        THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
+        return s_compactAttr;
+    }
     return _data.at(column).DbcsAttr();
 }
 
@@ -210,7 +398,7 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
-    return const_cast<DbcsAttribute&>(static_cast<const CharRow* const>(this)->DbcsAttrAt(column));
+    return _GetData().at(column).DbcsAttr();
 }
 
 // Routine Description:
@@ -222,7 +410,8 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
-    _data.at(column).EraseChars();
+    _GetData().at(column).EraseChars();
+    _unicodeStorage.Erase(column);
 }
 
 // Routine Description:
@@ -234,7 +423,7 @@ void CharRow::ClearGlyph(const size_t column)
 // - Note: will throw exception if column is out of bounds
 const CharRow::reference CharRow::GlyphAt(const size_t column) const
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
     return { const_cast<CharRow&>(*this), column };
 }
 
@@ -247,7 +436,7 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 // - Note: will throw exception if column is out of bounds
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
     return { *this, column };
 }
 
@@ -261,6 +450,11 @@ CharRow::reference CharRow::GlyphAt(const size_t column)
 // - Note: will throw exception if out of memory
 std::wstring CharRow::GetTextRaw() const
 {
+    if (_isCompact)
+    {
+        return _GetCompactText();
+    }
+
     std::wstring wstr;
     wstr.reserve(_data.size());
     for (size_t i = 0;  i < _data.size(); ++i)
@@ -276,6 +470,11 @@ std::wstring CharRow::GetTextRaw() const
 
 std::wstring CharRow::GetText() const
 {
+    if (_isCompact)
+    {
+        return _GetCompactText();
+    }
+
     std::wstring wstr;
     wstr.reserve(_data.size());
 
@@ -293,25 +492,29 @@ std::wstring CharRow::GetText() const
     return wstr;
 }
 
-UnicodeStorage& CharRow::GetUnicodeStorage()
+// Routine Description:
+// - Expands the compact form of the row to a string the width of the row,
+//   without inflating the cells. A compact row has no DBCS or stored glyphs,
+//   so this is both the raw and the displayed text.
+// Arguments:
+// - <none>
+// Return Value:
+// - text stored in the compact row, padded with spaces
+std::wstring CharRow::_GetCompactText() const
 {
-    return _pParent->GetUnicodeStorage();
+    std::wstring wstr(_rowWidth, UNICODE_SPACE);
+    std::copy(_compactText.cbegin(), _compactText.cend(), wstr.begin());
+    return wstr;
 }
 
-const UnicodeStorage& CharRow::GetUnicodeStorage() const
+UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
-// Routine Description:
-// - calculates the key used by the given column of the char row to store glyph data in UnicodeStorage
-// Arguments:
-// - column - the column to generate the key for
-// Return Value:
-// - the COORD key for data access from UnicodeStorage for the column
-COORD CharRow::GetStorageKey(const size_t column) const
+const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
 {
-    return { gsl::narrow<SHORT>(column), _pParent->GetId() };
+    return _unicodeStorage;
 }
 
 // Routine Description:
@@ -37,6 +37,15 @@ class ROW;
 //       ^    ^                  ^                     ^
 //       |    |                  |                     |
 //     Chars Left               Right                end of Chars buffer
+//
+// Rows that have scrolled out of view can be compacted. A compact row holds
+// only its text up to the last non-blank cell, one byte per cell, and drops
+// the full-width cell storage. This only works when every cell is a plain
+// ASCII character with no DBCS attributes. The full storage is only rebuilt
+// when something writes to the row. Reading through the const methods never
+// changes the row, so readers sharing a lock can't race each other. Compact
+// rows have no cells to iterate over, so const iteration needs IsCompact
+// checked first. GetText, GlyphAt and DbcsAttrAt work on either form.
 class CharRow final
 {
 public:
@@ -54,6 +63,8 @@ public:
     bool WasDoubleBytePadded() const noexcept;
     size_t size() const noexcept;
     void Reset();
+    void Compact() noexcept;
+    bool IsCompact() const noexcept;
     [[nodiscard]]
     HRESULT Resize(const size_t newSize) noexcept;
     size_t MeasureLeft() const;
@@ -73,20 +84,19 @@ public:
     reference GlyphAt(const size_t column);
 
     // iterators
-    iterator begin() noexcept;
-    const_iterator cbegin() const noexcept;
+    iterator begin();
+    const_iterator cbegin() const;
 
-    iterator end() noexcept;
-    const_iterator cend() const noexcept;
+    iterator end();
+    const_iterator cend() const;
 
-    UnicodeStorage& GetUnicodeStorage();
-    const UnicodeStorage& GetUnicodeStorage() const;
-    COORD GetStorageKey(const size_t column) const;
+    UnicodeStorage& GetUnicodeStorage() noexcept;
+    const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     void UpdateParent(ROW* const pParent) noexcept;
 
     friend CharRowCellReference;
-    friend constexpr bool operator==(const CharRow& a, const CharRow& b) noexcept;
+    friend bool operator==(const CharRow& a, const CharRow& b);
 
 protected:
     // Occurs when the user runs out of text in a given row and we're forced to wrap the cursor to the next line
@@ -95,18 +105,52 @@ protected:
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
 
-    // storage for glyph data and dbcs attributes
+    // the width of the row, in cells. _data is empty while the row is compact,
+    // so this is kept separately.
+    size_t _rowWidth;
+
+    // storage for glyph data and dbcs attributes. Empty while the row is compact.
     std::vector<value_type> _data;
 
+    // The compact form of the row, valid while _isCompact is set.
+    // Holds the ASCII text of the row with trailing blank cells trimmed.
+    std::string _compactText;
+    bool _isCompact;
+
+    // the text of the glyphs in this row that don't fit in a single cell's wchar_t
+    UnicodeStorage _unicodeStorage;
+
     // ROW that this CharRow belongs to
     ROW* _pParent;
+
+    std::vector<value_type>& _GetData();
+    value_type _GetCell(const size_t column) const;
+    std::wstring_view _GetCompactGlyph(const size_t column) const;
+    std::wstring _GetCompactText() const;
 };
 
-constexpr bool operator==(const CharRow& a, const CharRow& b) noexcept
+inline bool operator==(const CharRow& a, const CharRow& b)
 {
-    return (a._wrapForced == b._wrapForced &&
-            a._doubleBytePadded == b._doubleBytePadded &&
-            a._data == b._data);
+    if (a._wrapForced != b._wrapForced ||
+        a._doubleBytePadded != b._doubleBytePadded ||
+        a._rowWidth != b._rowWidth)
+    {
+        return false;
+    }
+
+    if (!a._isCompact && !b._isCompact)
+    {
+        return a._data == b._data;
+    }
+
+    for (size_t i = 0; i < a._rowWidth; ++i)
+    {
+        if (!(a._GetCell(i) == b._GetCell(i)))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 template<typename InputIt1, typename InputIt2>
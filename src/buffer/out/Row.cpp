@@ -16,7 +16,7 @@
 // - pParent - the text buffer that this row belongs to
 // Return Value:
 // - constructed object
-ROW::ROW(const SHORT rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
+ROW::ROW(const size_t rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
     _id{ rowId },
     _rowWidth{ gsl::narrow<size_t>(rowWidth) },
     _charRow{ gsl::narrow<size_t>(rowWidth), this },
@@ -50,16 +50,30 @@ ATTR_ROW& ROW::GetAttrRow() noexcept
     return const_cast<ATTR_ROW&>(static_cast<const ROW* const>(this)->GetAttrRow());
 }
 
-SHORT ROW::GetId() const noexcept
+size_t ROW::GetId() const noexcept
 {
     return _id;
 }
 
-void ROW::SetId(const SHORT id) noexcept
+void ROW::SetId(const size_t id) noexcept
 {
     _id = id;
 }
 
+// Routine Description:
+// - Shrinks the row's storage down to its compact form, where possible.
+//   Meant for rows that have scrolled out of view and aren't likely to be
+//   touched again soon. They inflate again automatically when they are.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ROW::Compact() noexcept
+{
+    _charRow.Compact();
+    _attrRow.Compact();
+}
+
 // Routine Description:
 // - Sets all properties of the ROW to default values
 // Arguments:
@@ -133,16 +147,6 @@ RowCellIterator ROW::AsCellIter(const size_t startIndex, const size_t count) con
     return RowCellIterator(*this, startIndex, count);
 }
 
-UnicodeStorage& ROW::GetUnicodeStorage()
-{
-    return _pParent->GetUnicodeStorage();
-}
-
-const UnicodeStorage& ROW::GetUnicodeStorage() const
-{
-    return _pParent->GetUnicodeStorage();
-}
-
 // Routine Description:
 // - writes cell data to the row
 // Arguments:
@@ -161,16 +165,41 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
 
+    // Colors are gathered into runs of neighboring cells that share an attribute
+    // and merged into the attribute row once per run instead of once per cell.
+    size_t attrRunStart = currentIndex;
+    size_t attrRunLength = 0;
+    TextAttribute attrRunAttr;
+
+    const auto flushAttrRun = [&]() {
+        if (attrRunLength > 0)
+        {
+            const TextAttributeRun attrRun{ attrRunLength, attrRunAttr };
+            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ &attrRun, 1 },
+                                                  attrRunStart,
+                                                  attrRunStart + attrRunLength - 1,
+                                                  _charRow.size()));
+            attrRunLength = 0;
+        }
+    };
+
     while (it && currentIndex <= finalColumnInRow)
     {
         // Fill the color if the behavior isn't set to keeping the current color.
         if (it->TextAttrBehavior() != TextAttributeBehavior::Current)
         {
-            const TextAttributeRun attrRun{ 1, it->TextAttr() };
-            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ &attrRun, 1 },
-                                                  currentIndex,
-                                                  currentIndex,
-                                                  _charRow.size()));
+            const auto attr = it->TextAttr();
+            if (attrRunLength == 0 || attr != attrRunAttr)
+            {
+                flushAttrRun();
+                attrRunStart = currentIndex;
+                attrRunAttr = attr;
+            }
+            ++attrRunLength;
+        }
+        else
+        {
+            flushAttrRun();
         }
 
         // Fill the text if the behavior isn't set to saying there's only a color stored in this iterator.
@@ -218,5 +247,69 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
         ++currentIndex;
     }
 
+    flushAttrRun();
+
     return it;
 }
+
+// Routine Description:
+// - Writes legacy CHAR_INFO cells into the row, the same as WriteCells does with a
+//   CHAR_INFO iterator, but copies the text straight into the row and merges colors
+//   once per run of identical attributes.
+// - Leading and trailing bytes need WriteCells' padding rules at the edges of the
+//   row, so nothing is written if any of the cells are marked as either.
+// Arguments:
+// - charInfos - The cells to write. Anything past the end of the row is ignored.
+// - index - The column to start writing at
+// - setWrap - Whether to set the wrap flag if we write up to the end of the line
+// Return Value:
+// - true if the cells were written. false if the caller needs to use WriteCells instead.
+bool ROW::WriteCharInfos(const std::basic_string_view<CHAR_INFO> charInfos, const size_t index, const bool setWrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    const auto count = std::min(charInfos.size(), _charRow.size() - index);
+    const auto charInfosEnd = charInfos.cbegin() + count;
+
+    const auto isDbcs = [](const CHAR_INFO& charInfo) noexcept {
+        return WI_IsAnyFlagSet(charInfo.Attributes, COMMON_LVB_LEADING_BYTE | COMMON_LVB_TRAILING_BYTE);
+    };
+    if (std::any_of(charInfos.cbegin(), charInfosEnd, isDbcs))
+    {
+        return false;
+    }
+
+    auto cell = _charRow.begin() + index;
+    size_t runStart = 0;
+    for (size_t i = 0; i < count; ++i, ++cell)
+    {
+        const CHAR_INFO& charInfo = charInfos[i];
+        if (cell->DbcsAttr().IsGlyphStored())
+        {
+            _charRow.GlyphAt(index + i) = std::wstring_view{ &charInfo.Char.UnicodeChar, 1 };
+        }
+        else
+        {
+            cell->Char() = charInfo.Char.UnicodeChar;
+        }
+        cell->DbcsAttr().SetSingle();
+
+        if (i + 1 == count || charInfos[i + 1].Attributes != charInfo.Attributes)
+        {
+            TextAttribute attr;
+            attr.SetFromLegacy(charInfo.Attributes);
+            const TextAttributeRun attrRun{ i + 1 - runStart, attr };
+            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ &attrRun, 1 },
+                                                  index + runStart,
+                                                  index + i,
+                                                  _charRow.size()));
+            runStart = i + 1;
+        }
+    }
+
+    if (setWrap && index + count == _charRow.size())
+    {
+        _charRow.SetWrapForced(true);
+    }
+
+    return true;
+}
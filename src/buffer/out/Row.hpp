@@ -25,14 +25,13 @@ Revision History:
 #include "OutputCellIterator.hpp"
 #include "CharRow.hpp"
 #include "RowCellIterator.hpp"
-#include "UnicodeStorage.hpp"
 
 class TextBuffer;
 
 class ROW final
 {
 public:
-    ROW(const SHORT rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent);
+    ROW(const size_t rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent);
 
     size_t size() const noexcept;
 
@@ -42,10 +41,11 @@ public:
     const ATTR_ROW& GetAttrRow() const noexcept;
     ATTR_ROW& GetAttrRow() noexcept;
 
-    SHORT GetId() const noexcept;
-    void SetId(const SHORT id) noexcept;
+    size_t GetId() const noexcept;
+    void SetId(const size_t id) noexcept;
 
     bool Reset(const TextAttribute Attr);
+    void Compact() noexcept;
     [[nodiscard]]
     HRESULT Resize(const size_t width);
 
@@ -55,10 +55,8 @@ public:
     RowCellIterator AsCellIter(const size_t startIndex) const;
     RowCellIterator AsCellIter(const size_t startIndex, const size_t count) const;
 
-    UnicodeStorage& GetUnicodeStorage();
-    const UnicodeStorage& GetUnicodeStorage() const;
-
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const bool setWrap, std::optional<size_t> limitRight = std::nullopt);
+    bool WriteCharInfos(const std::basic_string_view<CHAR_INFO> charInfos, const size_t index, const bool setWrap);
 
     friend bool operator==(const ROW& a, const ROW& b) noexcept;
 
@@ -69,7 +67,7 @@ public:
 private:
     CharRow _charRow;
     ATTR_ROW _attrRow;
-    SHORT _id;
+    size_t _id;
     size_t _rowWidth;
     TextBuffer* _pParent; // non ownership pointer
 };
@@ -5,94 +5,158 @@
 #include "UnicodeStorage.hpp"
 
 UnicodeStorage::UnicodeStorage() :
-    _map{}
+    _entries{},
+    _text{},
+    _liveText{ 0 }
 {
 }
 
 // Routine Description:
-// - fetches the text associated with key
+// - fetches the text stored for column
 // Arguments:
-// - key - the key into the storage
+// - column - the column of the glyph in its row
 // Return Value:
-// - the glyph data associated with key
-// Note: will throw exception if key is not stored yet
-const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) const
+// - the glyph data stored for column. It's only valid until the next glyph is stored in this row.
+// Note: will throw exception if nothing is stored for column
+UnicodeStorage::mapped_type UnicodeStorage::GetText(const key_type column) const
 {
-    return _map.at(key);
+    const auto it = _Find(column);
+    THROW_HR_IF(E_INVALIDARG, it == _entries.cend() || it->column != column);
+    return { _text.data() + it->offset, it->length };
 }
 
 // Routine Description:
-// - stores glyph data associated with key.
+// - stores glyph data for column, replacing anything already stored there.
 // Arguments:
-// - key - the key into the storage
+// - column - the column of the glyph in its row
 // - glyph - the glyph data to store
-void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
+// Note: will throw exception on failure to allocate
+void UnicodeStorage::StoreGlyph(const key_type column, const mapped_type glyph)
 {
-    _map.insert_or_assign(key, glyph);
+    // The glyph might be text from this same storage (copying one cell of the
+    // row to another). Adding to _text could move it, so take a copy first.
+    if (!_text.empty() && glyph.data() >= _text.data() && glyph.data() < _text.data() + _text.size())
+    {
+        const std::wstring copy{ glyph };
+        StoreGlyph(column, copy);
+        return;
+    }
+
+    auto it = _Find(column);
+    if (it != _entries.end() && it->column == column)
+    {
+        // Reuse the old space when the new glyph fits in it.
+        if (glyph.size() <= it->length)
+        {
+            std::copy(glyph.cbegin(), glyph.cend(), _text.begin() + it->offset);
+            _liveText -= it->length - glyph.size();
+            it->length = glyph.size();
+            return;
+        }
+
+        _liveText -= it->length;
+        it->length = 0;
+    }
+    else
+    {
+        it = _entries.insert(it, { column, 0, 0 });
+    }
+
+    // Don't let text that's no longer referenced pile up as cells get overwritten.
+    if (_text.size() - _liveText > _liveText)
+    {
+        const auto index = it - _entries.begin();
+        _CompactText();
+        it = _entries.begin() + index;
+    }
+
+    const size_t offset = _text.size();
+    _text.insert(_text.end(), glyph.cbegin(), glyph.cend());
+    it->offset = offset;
+    it->length = glyph.size();
+    _liveText += glyph.size();
 }
 
 // Routine Description:
-// - erases key and it's associated data from the storage
+// - erases the glyph data stored for column, if there is any
 // Arguments:
-// - key - the key to remove
-void UnicodeStorage::Erase(const key_type key) noexcept
+// - column - the column to remove
+void UnicodeStorage::Erase(const key_type column) noexcept
 {
-    _map.erase(key);
+    const auto it = _Find(column);
+    if (it != _entries.end() && it->column == column)
+    {
+        _liveText -= it->length;
+        _entries.erase(it);
+    }
 }
 
 // Routine Description:
-// - Remaps all of the stored items to new coordinate positions
-//   based on a bulk rearrangement of row IDs and potential row width resize.
+// - erases the glyph data stored for column and every column after it. Used
+//   when the row gets narrower.
 // Arguments:
-// - rowMap - A map of the old row IDs to the new row IDs.
-// - width - The width of the new row. Remove any items that are beyond the row width.
-//         - Use nullopt if we're not resizing the width of the row, just renumbering the rows.
-void UnicodeStorage::Remap(const std::map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width)
+// - column - the first column to remove
+void UnicodeStorage::EraseFrom(const key_type column) noexcept
 {
-    // Make a temporary map to hold all the new row positioning
-    std::unordered_map<key_type, mapped_type> newMap;
-
-    // Walk through every stored item.
-    for (const auto& pair : _map)
+    const auto it = _Find(column);
+    for (auto erased = it; erased != _entries.end(); ++erased)
     {
-        // Extract the old coordinate position
-        const auto oldCoord = pair.first;
-
-        // Only try to short-circuit based on width if we were told it changed
-        // by being given a new width value.
-        if (width.has_value())
-        {
-            // Get the column ID
-            const auto oldColId = oldCoord.X;
-
-            // If the column index is at/beyond the row width, don't bother copying it to the new map.
-            if (oldColId >= width.value())
-            {
-                continue;
-            }
-        }
-
-        // Get the row ID from the position as that's what we need to remap
-        const auto oldRowId = oldCoord.Y;
+        _liveText -= erased->length;
+    }
+    _entries.erase(it, _entries.end());
+}
 
-        // Use the mapping given to convert the old row ID to the new row ID
-        const auto mapIter = rowMap.find(oldRowId);
+// Routine Description:
+// - erases all stored glyph data. The memory is kept for the next glyphs stored in the row.
+void UnicodeStorage::Reset() noexcept
+{
+    _entries.clear();
+    _text.clear();
+    _liveText = 0;
+}
 
-        // If there's no mapping to a new row, don't bother copying it to the new map. The row is gone.
-        if (mapIter == rowMap.end())
-        {
-            continue;
-        }
+// Routine Description:
+// - gets the number of columns that have glyph data stored
+// Return Value:
+// - the number of stored glyphs
+size_t UnicodeStorage::size() const noexcept
+{
+    return _entries.size();
+}
 
-        const auto newRowId = mapIter->second;
+// Routine Description:
+// - finds the entry for column, or where it would be inserted if there isn't one
+// Arguments:
+// - column - the column to look for
+// Return Value:
+// - the first entry at or after column
+std::vector<UnicodeStorage::Entry>::iterator UnicodeStorage::_Find(const key_type column) noexcept
+{
+    return std::lower_bound(_entries.begin(), _entries.end(), column, [](const Entry& entry, const key_type value) noexcept {
+        return entry.column < value;
+    });
+}
 
-        // Generate a new coordinate with the same X as the old one, but a new Y value.
-        const auto newCoord = COORD{ oldCoord.X, newRowId };
+std::vector<UnicodeStorage::Entry>::const_iterator UnicodeStorage::_Find(const key_type column) const noexcept
+{
+    return std::lower_bound(_entries.cbegin(), _entries.cend(), column, [](const Entry& entry, const key_type value) noexcept {
+        return entry.column < value;
+    });
+}
 
-        // Put the adjusted coordinate into the map with the original value.
-        newMap.emplace(newCoord, pair.second);
+// Routine Description:
+// - moves the text of every entry to the front of _text, dropping text that
+//   isn't referenced anymore
+// Note: will throw exception on failure to allocate
+void UnicodeStorage::_CompactText()
+{
+    std::vector<wchar_t> text;
+    text.reserve(_liveText);
+    for (auto& entry : _entries)
+    {
+        const auto begin = _text.cbegin() + entry.offset;
+        entry.offset = text.size();
+        text.insert(text.end(), begin, begin + entry.length);
     }
-
-    // Swap into the stored map, free the temporary when we exit.
-    _map.swap(newMap);
+    _text.swap(text);
 }
@@ -6,7 +6,10 @@ Module Name:
 - UnicodeStorage.hpp
 
 Abstract:
-- dynamic storage location for glyphs that can't normally fit in the output buffer
+- storage location for the glyphs of a row that can't normally fit in the output buffer
+- Each CharRow owns one, so the glyphs move, resize and get freed along with their row.
+  The text of every glyph lives in one contiguous buffer, and each stored column
+  just records where its text starts and how long it is.
 
 Author(s):
 - Austin Diviness (AustDi) 02-May-2018
@@ -15,51 +18,45 @@ Author(s):
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <climits>
-
-// std::unordered_map needs help to know how to hash a COORD
-namespace std
-{
-    template <>
-    struct hash<COORD>
-    {
-
-        // Routine Description:
-        // - hashes a coord. coord will be hashed by storing the x and y values consecutively in the lower
-        // bits of a size_t.
-        // Arguments:
-        // - coord - the coord to hash
-        // Return Value:
-        // - the hashed coord
-        constexpr size_t operator()(const COORD& coord) const noexcept
-        {
-            size_t retVal = coord.Y;
-            const size_t xCoord = coord.X;
-            retVal |= xCoord << (sizeof(coord.Y) * CHAR_BIT);
-            return retVal;
-        }
-    };
-}
 
 class UnicodeStorage final
 {
 public:
-    using key_type = typename COORD;
-    using mapped_type = typename std::vector<wchar_t>;
+    using key_type = size_t;
+    using mapped_type = std::wstring_view;
 
     UnicodeStorage();
 
-    const mapped_type& GetText(const key_type key) const;
+    mapped_type GetText(const key_type column) const;
+
+    void StoreGlyph(const key_type column, const mapped_type glyph);
 
-    void StoreGlyph(const key_type key, const mapped_type& glyph);
+    void Erase(const key_type column) noexcept;
 
-    void Erase(const key_type key) noexcept;
+    void EraseFrom(const key_type column) noexcept;
 
-    void Remap(const std::map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
+    void Reset() noexcept;
+
+    size_t size() const noexcept;
 
 private:
-    std::unordered_map<key_type, mapped_type> _map;
+    // Where the text of the glyph in one column sits in _text.
+    struct Entry final
+    {
+        key_type column;
+        size_t offset;
+        size_t length;
+    };
+
+    // sorted by column
+    std::vector<Entry> _entries;
+    std::vector<wchar_t> _text;
+    // how much of _text is still referenced by an entry
+    size_t _liveText;
+
+    std::vector<Entry>::iterator _Find(const key_type column) noexcept;
+    std::vector<Entry>::const_iterator _Find(const key_type column) const noexcept;
+    void _CompactText();
 
 #ifdef UNIT_TESTING
     friend class UnicodeStorageTests;
@@ -27,16 +27,18 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
                        const UINT cursorSize,
                        Microsoft::Console::Render::IRenderTarget& renderTarget) :
     _firstRow{ 0 },
+    _archivedRows{ 0 },
+    _archiveLimit{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
     _storage{},
-    _unicodeStorage{},
     _renderTarget{ renderTarget }
 {
     // initialize ROWs
     for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
     {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
+        _storage.emplace_back(i, screenBufferSize.X, _currentAttributes, this);
+        _rowOrder.push_back(i);
     }
 }
 
@@ -57,10 +59,52 @@ void TextBuffer::CopyProperties(const TextBuffer& OtherBuffer)
 // Arguments:
 // - <none>
 // Return Value:
-// - Total number of rows in the buffer
+// - Total number of rows in the buffer, not counting archived rows
 UINT TextBuffer::TotalRowCount() const
 {
-    return static_cast<UINT>(_storage.size());
+    return static_cast<UINT>(_storage.size() - _archivedRows);
+}
+
+// Routine Description:
+// - Gets the number of rows that have cycled off the top of the buffer and been kept.
+// Arguments:
+// - <none>
+// Return Value:
+// - the number of archived rows. Row 0 of the buffer has this retained index.
+size_t TextBuffer::ArchivedRowCount() const noexcept
+{
+    return _archivedRows;
+}
+
+// Routine Description:
+// - Gets the number of rows that can be read by their retained index.
+// Arguments:
+// - <none>
+// Return Value:
+// - the number of archived rows plus the number of rows in the buffer
+size_t TextBuffer::RetainedRowCount() const noexcept
+{
+    return _storage.size();
+}
+
+// Routine Description:
+// - Sets how many rows the buffer keeps as they cycle off its top. If more
+//   than that are already archived, the oldest are dropped.
+// - A limit of 0, the default, reuses the top row every time, like it always has.
+// Arguments:
+// - limit - the most rows to archive
+// Return Value:
+// - <none>
+// Note: will throw exception if rows have to be dropped and the remaining rows can't be moved
+void TextBuffer::SetArchiveLimit(const size_t limit)
+{
+    if (_archivedRows > limit)
+    {
+        _OrderRows(_archivedRows - limit);
+        _archivedRows = limit;
+        _RefreshRowIDs(std::nullopt);
+    }
+    _archiveLimit = limit;
 }
 
 // Routine Description:
@@ -72,11 +116,11 @@ UINT TextBuffer::TotalRowCount() const
 // - const reference to the requested row. Asserts if out of bounds.
 const ROW& TextBuffer::GetRowByOffset(const size_t index) const
 {
-    const size_t totalRows = TotalRowCount();
+    const size_t totalRows = _rowOrder.size();
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage[offsetIndex];
+    return _storage[_rowOrder[offsetIndex]];
 }
 
 // Routine Description:
@@ -91,6 +135,37 @@ ROW& TextBuffer::GetRowByOffset(const size_t index)
     return const_cast<ROW&>(static_cast<const TextBuffer*>(this)->GetRowByOffset(index));
 }
 
+// Routine Description:
+// - Retrieves a row from the buffer by its retained index, counting from the
+//   oldest archived row. Index ArchivedRowCount() is row 0 of the buffer.
+// Arguments:
+// - index - Number of rows down from the oldest archived row.
+// Return Value:
+// - const reference to the requested row.
+// Note: will throw exception if index is past the last row of the buffer
+const ROW& TextBuffer::GetRetainedRow(const size_t index) const
+{
+    THROW_HR_IF(E_INVALIDARG, index >= RetainedRowCount());
+
+    // The archived rows sit just before the first row of the circular buffer.
+    const size_t totalRows = _rowOrder.size();
+    const size_t offsetIndex = (_firstRow + totalRows - _archivedRows + index) % totalRows;
+    return _storage[_rowOrder[offsetIndex]];
+}
+
+// Routine Description:
+// - Retrieves a row from the buffer by its retained index, counting from the
+//   oldest archived row. Index ArchivedRowCount() is row 0 of the buffer.
+// Arguments:
+// - index - Number of rows down from the oldest archived row.
+// Return Value:
+// - reference to the requested row.
+// Note: will throw exception if index is past the last row of the buffer
+ROW& TextBuffer::GetRetainedRow(const size_t index)
+{
+    return const_cast<ROW&>(static_cast<const TextBuffer*>(this)->GetRetainedRow(index));
+}
+
 // Routine Description:
 // - Retrieves read-only text iterator at the given buffer location
 // Arguments:
@@ -169,6 +244,21 @@ TextBufferCellIterator TextBuffer::GetCellDataAt(const COORD at, const Viewport
     return TextBufferCellIterator(*this, at, limit);
 }
 
+// Routine Description:
+// - Retrieves read-only cell iterator at the given location, counting rows
+//   from the given row base instead of from row 0 of the buffer. This can
+//   read archived rows.
+// Arguments:
+// - at - X,Y position for iterator start position, with Y counted from rowBase
+// - limit - boundaries for the iterator to operate within, with rows counted from rowBase
+// - rowBase - the retained index of the row that at and limit call row 0
+// Return Value:
+// - Read-only iterator of cell data.
+TextBufferCellIterator TextBuffer::GetCellDataAt(const COORD at, const Viewport limit, const size_t rowBase) const
+{
+    return TextBufferCellIterator(*this, at, limit, rowBase);
+}
+
 //Routine Description:
 // - Corrects and enforces consistent double byte character state (KAttrs line) within a row of the text buffer.
 // - This will take the given double byte information and check that it will be consistent when inserted into the buffer
@@ -372,6 +462,38 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes one line of legacy cells to the output buffer, without going through
+//   an OutputCellIterator a cell at a time.
+// Arguments:
+// - charInfos - The cells to write. Anything past the end of the line is ignored.
+// - target - Coordinate targeted within output buffer
+// Return Value:
+// - true if the cells were written, the same as WriteLine with setWrap would have.
+// - false if nothing was written because the cells need WriteLine's handling of
+//   leading and trailing bytes.
+bool TextBuffer::WriteCharInfoLine(const std::basic_string_view<CHAR_INFO> charInfos,
+                                   const COORD target)
+{
+    // If we're not in bounds, there's nothing to write.
+    if (!GetSize().IsInBounds(target))
+    {
+        return true;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    if (!row.WriteCharInfos(charInfos, target.X, true))
+    {
+        return false;
+    }
+
+    const auto written = std::min(charInfos.size(), row.size() - target.X);
+    const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(written), 1 });
+    _NotifyPaint(paint);
+
+    return true;
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -539,8 +661,26 @@ bool TextBuffer::IncrementCircularBuffer()
     // to the logical position 0 in the window (cursor coordinates and all other coordinates).
     _renderTarget.TriggerCircling();
 
-    // First, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
-    bool fSuccess = _storage.at(_firstRow).Reset(_currentAttributes);
+    // If there's room in the archive, keep the first row and add a new last row instead.
+    if (_archivedRows < _archiveLimit)
+    {
+        try
+        {
+            _ArchiveFirstRow();
+            return true;
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            return false;
+        }
+    }
+
+    // First, clean out the oldest row as it will become the "last row" of the buffer after the circle is performed.
+    // That's the old "first row", unless there are archived rows above it.
+    const size_t totalRows = _rowOrder.size();
+    const size_t oldestRow = (_firstRow + totalRows - _archivedRows) % totalRows;
+    bool fSuccess = _storage.at(_rowOrder.at(oldestRow)).Reset(_currentAttributes);
     if (fSuccess)
     {
         // Now proceed to increment.
@@ -548,7 +688,7 @@ bool TextBuffer::IncrementCircularBuffer()
         _firstRow++;
 
         // If we pass up the height of the buffer, loop back to 0.
-        if (_firstRow >= GetSize().Height())
+        if (_firstRow >= _storage.size())
         {
             _firstRow = 0;
         }
@@ -556,6 +696,50 @@ bool TextBuffer::IncrementCircularBuffer()
     return fSuccess;
 }
 
+// Routine Description:
+// - Cycles the buffer by one row, archiving its first row. A new blank row
+//   is added to the circular buffer to become the last row.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+// Note: will throw exception if unable to allocate the new row
+void TextBuffer::_ArchiveFirstRow()
+{
+    // The new row goes after the last row of the buffer, which is right before
+    // the oldest archived row, or before the first row if nothing's archived yet.
+    const size_t totalRows = _rowOrder.size();
+    const size_t insertAt = (_firstRow + totalRows - _archivedRows) % totalRows;
+
+    _storage.emplace_back(_storage.size(), GetSize().Width(), _currentAttributes, this);
+    try
+    {
+        if (insertAt == 0)
+        {
+            // The circular buffer wraps at the end of _rowOrder, so the new row
+            // can just be appended. The archive fills like this from the start.
+            _rowOrder.push_back(_storage.size() - 1);
+        }
+        else
+        {
+            _rowOrder.insert(_rowOrder.begin() + insertAt, _storage.size() - 1);
+            if (_firstRow >= insertAt)
+            {
+                _firstRow++;
+            }
+        }
+    }
+    catch (...)
+    {
+        _storage.pop_back();
+        throw;
+    }
+
+    // The old first row is now the newest archived row.
+    _firstRow = (_firstRow + 1) % _rowOrder.size();
+    _archivedRows++;
+}
+
 //Routine Description:
 // - Retrieves the position of the last non-space character on the final line of the text buffer.
 //Arguments:
@@ -623,16 +807,16 @@ COORD TextBuffer::_GetPreviousFromCursor() const
     return coordPosition;
 }
 
-const SHORT TextBuffer::GetFirstRowIndex() const
+size_t TextBuffer::GetFirstRowIndex() const noexcept
 {
     return _firstRow;
 }
 const Viewport TextBuffer::GetSize() const
 {
-    return Viewport::FromDimensions({ 0, 0 }, { gsl::narrow<SHORT>(_storage.at(0).size()), gsl::narrow<SHORT>(_storage.size()) });
+    return Viewport::FromDimensions({ 0, 0 }, { gsl::narrow<SHORT>(_storage.at(0).size()), gsl::narrow<SHORT>(_storage.size() - _archivedRows) });
 }
 
-void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex)
+void TextBuffer::_SetFirstRowIndex(const size_t FirstRowIndex) noexcept
 {
     _firstRow = FirstRowIndex;
 }
@@ -645,17 +829,13 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
-    // OK. We're about to play games by moving rows around within the deque to
-    // scroll a massive region in a faster way than copying things.
-    // To make this easier, first correct the circular buffer to have the first row be 0 again.
-    if (_firstRow != 0)
-    {
-        // Rotate the buffer to put the first row at the front.
-        std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
-
-        // The first row is now at the top.
-        _firstRow = 0;
-    }
+    // OK. We're about to play games by moving rows around to scroll a
+    // massive region in a faster way than copying things.
+    // The ROWs themselves never move. Only their entries in _rowOrder are
+    // rotated, so the rows keep their IDs and everything they own stays put.
+    // The cost is proportional to the size of the region, not the size of the buffer.
+    // The diagrams below are in rows from the top of the buffer (offsets
+    // for GetRowByOffset), which _RotateRows maps onto the circular buffer.
 
     // Rotate just the subsection specified
     if (delta < 0)
@@ -693,7 +873,7 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow + delta, _storage.begin() + firstRow, _storage.begin() + firstRow + size);
+        _RotateRows(firstRow + delta, firstRow, firstRow + size);
     }
     else
     {
@@ -730,12 +910,42 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow, _storage.begin() + firstRow + size, _storage.begin() + firstRow + size + delta);
+        _RotateRows(firstRow, firstRow + size, firstRow + size + delta);
     }
+}
+
+// Routine Description:
+// - Rotates a range of rows like std::rotate, so the row at middle becomes the
+//   row at first. Only the entries in _rowOrder move.
+// Arguments:
+// - first - the offset from the top of the buffer of the first row of the range
+// - middle - the offset of the row that should end up at first
+// - last - the offset one past the last row of the range
+// Return Value:
+// - <none>
+void TextBuffer::_RotateRows(const size_t first, const size_t middle, const size_t last) noexcept
+{
+    _ReverseRows(first, middle);
+    _ReverseRows(middle, last);
+    _ReverseRows(first, last);
+}
 
-    // Renumber the IDs now that we've rearranged where the rows sit within the buffer.
-    // Refreshing should also delegate to the UnicodeStorage to re-key all the stored unicode sequences (where applicable).
-    _RefreshRowIDs(std::nullopt);
+// Routine Description:
+// - Reverses the order of a range of rows by swapping their entries in _rowOrder.
+// Arguments:
+// - first - the offset from the top of the buffer of the first row of the range
+// - last - the offset one past the last row of the range
+// Return Value:
+// - <none>
+void TextBuffer::_ReverseRows(size_t first, size_t last) noexcept
+{
+    const size_t totalRows = _rowOrder.size();
+    while (first + 1 < last)
+    {
+        --last;
+        std::swap(_rowOrder[(_firstRow + first) % totalRows], _rowOrder[(_firstRow + last) % totalRows]);
+        ++first;
+    }
 }
 
 Cursor& TextBuffer::GetCursor()
@@ -784,7 +994,6 @@ NTSTATUS TextBuffer::ResizeTraditional(const COORD newSize) noexcept
 {
     RETURN_HR_IF(E_INVALIDARG, newSize.X < 0 || newSize.Y < 0);
 
-    const auto currentSize = GetSize().Dimensions();
     const auto attributes = GetCurrentAttributes();
 
     SHORT TopRow = 0; // new top row of the screen buffer
@@ -792,35 +1001,34 @@ NTSTATUS TextBuffer::ResizeTraditional(const COORD newSize) noexcept
     {
         TopRow = GetCursor().GetPosition().Y - newSize.Y + 1;
     }
-    const SHORT TopRowIndex = (GetFirstRowIndex() + TopRow) % currentSize.Y;
 
-    // rotate rows until the top row is at index 0
     try
     {
-        const ROW& newTopRow = _storage[TopRowIndex];
-        while (&newTopRow != &_storage.front())
-        {
-            _storage.push_back(std::move(_storage.front()));
-            _storage.pop_front();
-        }
+        // The rows above the new top row are archived if there's room for
+        // them. Whatever doesn't fit is dropped, oldest first.
+        const size_t rowsAbove = _archivedRows + static_cast<size_t>(TopRow);
+        const size_t archivedRows = std::min(rowsAbove, _archiveLimit);
 
-        _SetFirstRowIndex(0);
+        // move the rows into order, starting with the oldest row we keep at index 0
+        _OrderRows(rowsAbove - archivedRows);
+        _archivedRows = archivedRows;
 
         // realloc in the Y direction
+        const size_t newTotalRows = _archivedRows + newSize.Y;
         // remove rows if we're shrinking
-        while (_storage.size() > static_cast<size_t>(newSize.Y))
+        while (_storage.size() > newTotalRows)
         {
             _storage.pop_back();
         }
         // add rows if we're growing
-        while (_storage.size() < static_cast<size_t>(newSize.Y))
+        while (_storage.size() < newTotalRows)
         {
-            _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
+            _storage.emplace_back(_storage.size(), newSize.X, attributes, this);
         }
 
         // Now that we've tampered with the row placement, refresh all the row IDs.
-        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
-        // and cleanup the UnicodeStorage characters that might fall outside the resized buffer.
+        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension.
+        // Each row drops its own stored glyphs that fall outside the new width.
         _RefreshRowIDs(newSize.X);
 
     }
@@ -829,34 +1037,52 @@ NTSTATUS TextBuffer::ResizeTraditional(const COORD newSize) noexcept
     return S_OK;
 }
 
-const UnicodeStorage& TextBuffer::GetUnicodeStorage() const
+// Routine Description:
+// - Moves the rows in _storage into the order they're retained in, oldest
+//   archived row first, and drops the oldest of them. _rowOrder and the row
+//   IDs are left for _RefreshRowIDs to rebuild.
+// Arguments:
+// - dropCount - how many of the oldest rows to drop
+// Return Value:
+// - <none>
+// Note: will throw exception if the rows can't be moved
+void TextBuffer::_OrderRows(const size_t dropCount)
 {
-    return _unicodeStorage;
-}
+    const size_t totalRows = _rowOrder.size();
+    const size_t oldestRow = (_firstRow + totalRows - _archivedRows) % totalRows;
 
-UnicodeStorage& TextBuffer::GetUnicodeStorage()
-{
-    return _unicodeStorage;
+    std::deque<ROW> orderedStorage;
+    for (size_t i = dropCount; i < totalRows; ++i)
+    {
+        orderedStorage.push_back(std::move(_storage[_rowOrder[(oldestRow + i) % totalRows]]));
+    }
+    _storage.swap(orderedStorage);
 }
 
 // Routine Description:
 // - Method to help refresh all the Row IDs after manipulating the row
 //   by shuffling pointers around.
+// - The rows must be in order in _storage, with _archivedRows set. _rowOrder
+//   and the first row index are rebuilt to match.
 // - This will also update parent pointers that are stored in depth within the buffer
 //   (e.g. it will update CharRow parents pointing at Rows that might have been moved around)
-// - Optionally takes a new row width if we're resizing to perform a resize operation and cleanup
-//   any high unicode (UnicodeStorage) runs while we're already looping through the rows.
+// - Optionally takes a new row width if we're resizing to perform a resize operation
+//   while we're already looping through the rows.
 // Arguments:
 // - newRowWidth - Optional new value for the row width.
 void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
 {
-    std::map<SHORT, SHORT> rowMap;
-    SHORT i = 0;
-    for (auto& it : _storage)
+    // The rows are in order now, so each one sits at its own index.
+    _rowOrder.resize(_storage.size());
+    for (size_t i = 0; i < _rowOrder.size(); ++i)
     {
-        // Build a map so we can update Unicode Storage
-        rowMap.emplace(it.GetId(), i);
+        _rowOrder[i] = i;
+    }
+    _SetFirstRowIndex(_archivedRows);
 
+    size_t i = 0;
+    for (auto& it : _storage)
+    {
         // Update the IDs
         it.SetId(i++);
 
@@ -870,9 +1096,6 @@ void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
             THROW_IF_FAILED(it.Resize(newRowWidth.value()));
         }
     }
-
-    // Give the new mapping to Unicode Storage
-    _unicodeStorage.Remap(rowMap, newRowWidth);
 }
 
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
@@ -902,14 +1125,15 @@ ROW& TextBuffer::_GetFirstRow()
 // - will throw exception if called with the first row of the text buffer
 ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
 {
-    int prevRowIndex = Row.GetId() - 1;
-    if (prevRowIndex < 0)
-    {
-        prevRowIndex = TotalRowCount() - 1;
-    }
+    // A row's ID is where it lives in _storage. Find where it is in the circular buffer.
+    const auto position = std::find(_rowOrder.cbegin(), _rowOrder.cend(), Row.GetId());
+    THROW_HR_IF(E_FAIL, position == _rowOrder.cend());
+
+    const size_t rowIndex = position - _rowOrder.cbegin();
+    THROW_HR_IF(E_FAIL, rowIndex == _firstRow);
 
-    THROW_HR_IF(E_FAIL, Row.GetId() == _firstRow);
-    return _storage[prevRowIndex];
+    const size_t prevRowIndex = (rowIndex == 0) ? _rowOrder.size() - 1 : rowIndex - 1;
+    return _storage[_rowOrder[prevRowIndex]];
 }
 
 // Method Description:
@@ -925,6 +1149,8 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget()
 
 // Routine Description:
 // - Retrieves the text data from the selected region and presents it in a clipboard-ready format (given little post-processing).
+// - This gives a color for every character. Callers that can take the text a
+//   run of colors at a time should use WriteSelectionRuns instead.
 // Arguments:
 // - lineSelection - true if entire line is being selected. False otherwise (box selection)
 // - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
@@ -943,91 +1169,188 @@ const TextBuffer::TextAndColor TextBuffer::GetTextForClipboard(const bool lineSe
 
     // preallocate our vectors to reduce reallocs
     size_t const rows = selectionRects.size();
-    data.text.reserve(rows);
-    data.FgAttr.reserve(rows);
-    data.BkAttr.reserve(rows);
+    data.text.resize(rows);
+    data.FgAttr.resize(rows);
+    data.BkAttr.resize(rows);
+
+    WriteSelectionRuns(lineSelection,
+                       trimTrailingWhitespace,
+                       selectionRects,
+                       GetForegroundColor,
+                       GetBackgroundColor,
+                       [&](const size_t rectIndex, const std::wstring_view text, const COLORREF foreground, const COLORREF background) {
+                           data.text.at(rectIndex).append(text);
+                           data.FgAttr.at(rectIndex).insert(data.FgAttr.at(rectIndex).end(), text.size(), foreground);
+                           data.BkAttr.at(rectIndex).insert(data.BkAttr.at(rectIndex).end(), text.size(), background);
+                       });
+
+    return data;
+}
 
-    // for each row in the selection
-    for (UINT i = 0; i < rows; i++)
+// Routine Description:
+// - Walks the text of the selected region and hands it out a run at a time,
+//   where a run is a stretch of text that shares its colors. Each row's
+//   colors are looked up once per attribute run of the row, not per cell.
+// - The runs are only valid during the callback. Consumers like the plain
+//   text and HTML clipboard formats build their output straight from them.
+// - Trailing bytes of double-width characters are skipped. Rows are trimmed
+//   and terminated with CR/LF the same way GetTextForClipboard does it.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// - writeRun - called with each run of text, in order
+void TextBuffer::WriteSelectionRuns(const bool lineSelection,
+                                    const bool trimTrailingWhitespace,
+                                    const std::vector<SMALL_RECT>& selectionRects,
+                                    const std::function<COLORREF(TextAttribute&)>& GetForegroundColor,
+                                    const std::function<COLORREF(TextAttribute&)>& GetBackgroundColor,
+                                    const SelectionRunCallback& writeRun) const
+{
+    WriteSelectionRuns(lineSelection,
+                       trimTrailingWhitespace,
+                       selectionRects,
+                       _archivedRows,
+                       GetForegroundColor,
+                       GetBackgroundColor,
+                       writeRun);
+}
+
+// Routine Description:
+// - Walks the text of the selected region like the version above, but with
+//   the rows of the selection counted from the given row base instead of
+//   from row 0 of the buffer. This can read archived rows.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - rowBase - the retained index of the row that the selection rows count from
+// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// - writeRun - called with each run of text, in order
+void TextBuffer::WriteSelectionRuns(const bool lineSelection,
+                                    const bool trimTrailingWhitespace,
+                                    const std::vector<SMALL_RECT>& selectionRects,
+                                    const size_t rowBase,
+                                    const std::function<COLORREF(TextAttribute&)>& GetForegroundColor,
+                                    const std::function<COLORREF(TextAttribute&)>& GetBackgroundColor,
+                                    const SelectionRunCallback& writeRun) const
+{
+    struct ColorRun
     {
-        const UINT iRow = selectionRects.at(i).Top;
+        size_t length;
+        COLORREF foreground;
+        COLORREF background;
+    };
 
-        const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
+    // These hold one row at a time and are reused for every row.
+    std::wstring rowText;
+    std::vector<ColorRun> colorRuns;
 
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
+    const auto appendRun = [&](const std::wstring_view text, const COLORREF foreground, const COLORREF background) {
+        if (text.empty())
+        {
+            return;
+        }
+        rowText.append(text);
+        if (!colorRuns.empty() &&
+            colorRuns.back().foreground == foreground &&
+            colorRuns.back().background == background)
+        {
+            colorRuns.back().length += text.size();
+        }
+        else
+        {
+            colorRuns.push_back({ text.size(), foreground, background });
+        }
+    };
 
-        // allocate a string buffer
-        std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
+    const SHORT rowWidth = GetSize().Width();
+    for (size_t i = 0; i < selectionRects.size(); ++i)
+    {
+        const SMALL_RECT& rect = selectionRects.at(i);
+        const ROW& row = GetRetainedRow(rowBase + gsl::narrow<size_t>(rect.Top));
+        const CharRow& charRow = row.GetCharRow();
+        const bool wasWrapForced = charRow.WasWrapForced();
 
-        // preallocate to avoid reallocs
-        selectionText.reserve(highlight.Width() + 2); // + 2 for \r\n if we munged it
-        selectionFgAttr.reserve(highlight.Width() + 2);
-        selectionBkAttr.reserve(highlight.Width() + 2);
+        rowText.clear();
+        colorRuns.clear();
 
-        // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+        const SHORT left = std::max<SHORT>(rect.Left, 0);
+        const SHORT right = std::min(rect.Right, gsl::narrow_cast<SHORT>(rowWidth - 1));
+        if (left <= right)
         {
-            const auto& cell = *it;
-            auto cellData = cell.TextAttr();
-            COLORREF const CellFgAttr = GetForegroundColor(cellData);
-            COLORREF const CellBkAttr = GetBackgroundColor(cellData);
+            // A compact row is all single-cell ASCII, so its text can be
+            // sliced directly without inflating the row.
+            const std::wstring compactText = charRow.IsCompact() ? charRow.GetText() : std::wstring{};
+
+            auto attrIt = row.GetAttrRow().cbegin();
+            attrIt += gsl::narrow<ptrdiff_t>(left);
 
-            if (!cell.DbcsAttr().IsTrailing())
+            const size_t lastColumn = right;
+            size_t column = left;
+            while (column <= lastColumn)
             {
-                selectionText.append(cell.Chars());
-                for (const wchar_t wch : cell.Chars())
+                const size_t runColumns = std::min(attrIt.GetRunRemaining(), lastColumn - column + 1);
+
+                TextAttribute attr = *attrIt;
+                const COLORREF foreground = GetForegroundColor(attr);
+                const COLORREF background = GetBackgroundColor(attr);
+
+                if (charRow.IsCompact())
                 {
-                    selectionFgAttr.push_back(CellFgAttr);
-                    selectionBkAttr.push_back(CellBkAttr);
+                    appendRun(std::wstring_view{ compactText }.substr(column, runColumns), foreground, background);
                 }
+                else
+                {
+                    for (size_t runColumn = column; runColumn < column + runColumns; ++runColumn)
+                    {
+                        if (!charRow.DbcsAttrAt(runColumn).IsTrailing())
+                        {
+                            appendRun(charRow.GlyphAt(runColumn), foreground, background);
+                        }
+                    }
+                }
+
+                column += runColumns;
+                attrIt += gsl::narrow<ptrdiff_t>(runColumns);
             }
-            it++;
         }
 
         // trim trailing spaces if SHIFT key not held
         if (trimTrailingWhitespace)
         {
-            const ROW& Row = GetRowByOffset(iRow);
-
             // FOR LINE SELECTION ONLY: if the row was wrapped, don't remove the spaces at the end.
-            if (!lineSelection || !Row.GetCharRow().WasWrapForced())
+            if (!lineSelection || !wasWrapForced)
             {
-                while (!selectionText.empty() && selectionText.back() == UNICODE_SPACE)
+                while (!rowText.empty() && rowText.back() == UNICODE_SPACE)
                 {
-                    selectionText.pop_back();
-                    selectionFgAttr.pop_back();
-                    selectionBkAttr.pop_back();
+                    rowText.pop_back();
+                    if (--colorRuns.back().length == 0)
+                    {
+                        colorRuns.pop_back();
+                    }
                 }
             }
 
             // apply CR/LF to the end of the final string, unless we're the last line.
-            // a.k.a if we're earlier than the bottom, then apply CR/LF.
-            if (i < selectionRects.size() - 1)
+            // FOR LINE SELECTION ONLY: if the row was wrapped, do not apply CR/LF.
+            // always apply \r\n for box selection
+            if (i < selectionRects.size() - 1 && (!lineSelection || !wasWrapForced))
             {
-                // FOR LINE SELECTION ONLY: if the row was wrapped, do not apply CR/LF.
-                // a.k.a. if the row was NOT wrapped, then we can assume a CR/LF is proper
-                // always apply \r\n for box selection
-                if (!lineSelection || !GetRowByOffset(iRow).GetCharRow().WasWrapForced())
-                {
-                    COLORREF const Blackness = RGB(0x00, 0x00, 0x00);      // cant see CR/LF so just use black FG & BK
-
-                    selectionText.push_back(UNICODE_CARRIAGERETURN);
-                    selectionText.push_back(UNICODE_LINEFEED);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                }
+                COLORREF const Blackness = RGB(0x00, 0x00, 0x00);      // cant see CR/LF so just use black FG & BK
+                appendRun(L"\r\n", Blackness, Blackness);
             }
         }
 
-        data.text.emplace_back(selectionText);
-        data.FgAttr.emplace_back(selectionFgAttr);
-        data.BkAttr.emplace_back(selectionBkAttr);
+        const std::wstring_view text{ rowText };
+        size_t offset = 0;
+        for (const auto& colorRun : colorRuns)
+        {
+            writeRun(i, text.substr(offset, colorRun.length), colorRun.foreground, colorRun.background);
+            offset += colorRun.length;
+        }
     }
-
-    return data;
 }
@@ -45,6 +45,15 @@ the top row.  That means scrolling (if scrolling entire screen)
 merely involves changing the FirstRow index,
 filling in the last row, and updating the screen.
 
+A buffer can also archive rows. Rather than reusing the top row when it
+cycles, the buffer keeps it, up to an archive limit, in the same circular
+array just above FirstRow. Archived rows aren't addressable with COORDs;
+everything that is stays within the buffer's own size. They're read by
+their retained index instead, which counts from the oldest archived row,
+so the buffer's row 0 is at retained index ArchivedRowCount(). Anything
+that addresses rows "from a row base" adds the base to its COORD rows to
+get retained indexes.
+
 --*/
 
 #pragma once
@@ -52,7 +61,6 @@ filling in the last row, and updating the screen.
 #include "cursor.h"
 #include "Row.hpp"
 #include "TextAttribute.hpp"
-#include "UnicodeStorage.hpp"
 #include "../types/inc/Viewport.hpp"
 
 #include "../buffer/out/textBufferCellIterator.hpp"
@@ -78,9 +86,13 @@ public:
     const ROW& GetRowByOffset(const size_t index) const;
     ROW& GetRowByOffset(const size_t index);
 
+    const ROW& GetRetainedRow(const size_t index) const;
+    ROW& GetRetainedRow(const size_t index);
+
     TextBufferCellIterator GetCellDataAt(const COORD at) const;
     TextBufferCellIterator GetCellLineDataAt(const COORD at) const;
     TextBufferCellIterator GetCellDataAt(const COORD at, const Microsoft::Console::Types::Viewport limit) const;
+    TextBufferCellIterator GetCellDataAt(const COORD at, const Microsoft::Console::Types::Viewport limit, const size_t rowBase) const;
     TextBufferTextIterator GetTextDataAt(const COORD at) const;
     TextBufferTextIterator GetTextLineDataAt(const COORD at) const;
     TextBufferTextIterator GetTextDataAt(const COORD at, const Microsoft::Console::Types::Viewport limit) const;
@@ -96,6 +108,9 @@ public:
                                  const bool setWrap = false,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    bool WriteCharInfoLine(const std::basic_string_view<CHAR_INFO> charInfos,
+                           const COORD target);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -109,7 +124,7 @@ public:
     Cursor& GetCursor();
     const Cursor& GetCursor() const;
 
-    const SHORT GetFirstRowIndex() const;
+    size_t GetFirstRowIndex() const noexcept;
 
     const Microsoft::Console::Types::Viewport GetSize() const;
 
@@ -117,6 +132,10 @@ public:
 
     UINT TotalRowCount() const;
 
+    size_t ArchivedRowCount() const noexcept;
+    size_t RetainedRowCount() const noexcept;
+    void SetArchiveLimit(const size_t limit);
+
     [[nodiscard]]
     TextAttribute GetCurrentAttributes() const noexcept;
 
@@ -127,9 +146,6 @@ public:
     [[nodiscard]]
     HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
-    const UnicodeStorage& GetUnicodeStorage() const;
-    UnicodeStorage& GetUnicodeStorage();
-
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget();
 
     class TextAndColor
@@ -146,23 +162,56 @@ public:
                                            std::function<COLORREF(TextAttribute&)> GetForegroundColor,
                                            std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const;
 
+    // Receives one run of selected text that shares a foreground and background
+    // color, along with the index of the selection rectangle it came from.
+    using SelectionRunCallback = std::function<void(const size_t rectIndex,
+                                                    const std::wstring_view text,
+                                                    const COLORREF foreground,
+                                                    const COLORREF background)>;
+
+    void WriteSelectionRuns(const bool lineSelection,
+                            const bool trimTrailingWhitespace,
+                            const std::vector<SMALL_RECT>& selectionRects,
+                            const std::function<COLORREF(TextAttribute&)>& GetForegroundColor,
+                            const std::function<COLORREF(TextAttribute&)>& GetBackgroundColor,
+                            const SelectionRunCallback& writeRun) const;
+
+    void WriteSelectionRuns(const bool lineSelection,
+                            const bool trimTrailingWhitespace,
+                            const std::vector<SMALL_RECT>& selectionRects,
+                            const size_t rowBase,
+                            const std::function<COLORREF(TextAttribute&)>& GetForegroundColor,
+                            const std::function<COLORREF(TextAttribute&)>& GetBackgroundColor,
+                            const SelectionRunCallback& writeRun) const;
+
 private:
 
     std::deque<ROW> _storage;
     Cursor _cursor;
 
-    SHORT _firstRow; // indexes top row (not necessarily 0)
+    // The circular buffer of rows, as indexes into _storage. Scrolling a region
+    // reorders these instead of the ROWs, so a ROW's ID is always its index in _storage.
+    std::vector<size_t> _rowOrder;
+    size_t _firstRow; // indexes top row of _rowOrder (not necessarily 0)
 
-    TextAttribute _currentAttributes;
+    // Rows that cycled off the top of the buffer and were kept. They're the
+    // _archivedRows entries of _rowOrder just before _firstRow, oldest first.
+    size_t _archivedRows;
+    size_t _archiveLimit;
 
-    // storage location for glyphs that can't fit into the buffer normally
-    UnicodeStorage _unicodeStorage;
+    TextAttribute _currentAttributes;
 
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
 
+    void _ArchiveFirstRow();
+    void _OrderRows(const size_t dropCount);
+
+    void _RotateRows(const size_t first, const size_t middle, const size_t last) noexcept;
+    void _ReverseRows(size_t first, size_t last) noexcept;
+
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
 
-    void _SetFirstRowIndex(const SHORT FirstRowIndex);
+    void _SetFirstRowIndex(const size_t FirstRowIndex) noexcept;
 
     COORD _GetPreviousFromCursor() const;
 
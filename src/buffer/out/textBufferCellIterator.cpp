@@ -31,16 +31,34 @@ TextBufferCellIterator::TextBufferCellIterator(const TextBuffer& buffer, COORD p
 // - pos - Starting position to retrieve text data from (within screen buffer bounds)
 // - limits - Viewport limits to restrict the iterator within the buffer bounds (smaller than the buffer itself)
 TextBufferCellIterator::TextBufferCellIterator(const TextBuffer& buffer, COORD pos, const Viewport limits) :
+    TextBufferCellIterator(buffer, pos, limits, buffer.ArchivedRowCount())
+{
+}
+
+// Routine Description:
+// - Creates a new read-only iterator to seek through cell data stored within a screen buffer,
+//   with rows counted from the given row base instead of from row 0 of the buffer.
+// Arguments:
+// - buffer - Pointer to screen buffer to seek through
+// - pos - Starting position to retrieve text data from, with Y counted from rowBase
+// - limits - Viewport limits to restrict the iterator within, with rows counted from rowBase
+// - rowBase - The retained index of the row that pos and limits call row 0
+TextBufferCellIterator::TextBufferCellIterator(const TextBuffer& buffer, COORD pos, const Viewport limits, const size_t rowBase) :
     _buffer(buffer),
+    _rowBase(rowBase),
     _pos(pos),
-    _pRow(s_GetRow(buffer, pos)),
+    _pRow(s_GetRow(buffer, rowBase, pos)),
     _bounds(limits),
     _exceeded(false),
     _view({}, {}, {}, TextAttributeBehavior::Stored),
-    _attrIter(s_GetRow(buffer, pos)->GetAttrRow().cbegin())
+    _attrIter(s_GetRow(buffer, rowBase, pos)->GetAttrRow().cbegin())
 {
     // Throw if the bounds rectangle is not limited to the inside of the given buffer.
-    THROW_HR_IF(E_INVALIDARG, !buffer.GetSize().IsInBounds(limits));
+    // Its rows count from rowBase, so it can reach any retained row after that.
+    THROW_HR_IF(E_INVALIDARG, rowBase > buffer.RetainedRowCount());
+    const SHORT reachableRows = gsl::narrow_cast<SHORT>(std::min<size_t>(buffer.RetainedRowCount() - rowBase, SHRT_MAX));
+    const auto reachable = Viewport::FromDimensions({ 0, 0 }, { buffer.GetSize().Width(), reachableRows });
+    THROW_HR_IF(E_INVALIDARG, !reachable.IsInBounds(limits));
 
     // Throw if the coordinate is not limited to the inside of the given buffer.
     THROW_HR_IF(E_INVALIDARG, !limits.IsInBounds(pos));
@@ -197,6 +215,25 @@ ptrdiff_t TextBufferCellIterator::operator-(const TextBufferCellIterator& it)
     return _bounds.CompareInBounds(_pos, it._pos);
 }
 
+// Routine Description:
+// - Gets how many cells, starting with this one, have the same attribute run
+//   in the underlying row. This comes straight from the row's list of runs,
+//   so walkers don't need to compare the attributes of every cell to find
+//   the next boundary.
+// - The run is cut off at the right edge of the iterator's bounds.
+// Return Value:
+// - The number of cells left in the current attribute run. 0 if the iterator is exhausted.
+size_t TextBufferCellIterator::GetAttrRunLength() const noexcept
+{
+    if (!*this)
+    {
+        return 0;
+    }
+
+    const size_t cellsToEdge = static_cast<size_t>(_bounds.RightExclusive() - _pos.X);
+    return std::min(_attrIter.GetRunRemaining(), cellsToEdge);
+}
+
 // Routine Description:
 // - Sets the coordinate position that this iterator will inspect within the text buffer on dereference.
 // Arguments:
@@ -205,7 +242,7 @@ void TextBufferCellIterator::_SetPos(const COORD newPos)
 {
     if (newPos.Y != _pos.Y)
     {
-        _pRow = s_GetRow(_buffer, newPos);
+        _pRow = s_GetRow(_buffer, _rowBase, newPos);
         _attrIter = _pRow->GetAttrRow().cbegin();
         _pos.X = 0;
     }
@@ -226,12 +263,13 @@ void TextBufferCellIterator::_SetPos(const COORD newPos)
 //   We'll hold and cache this to improve performance over looking it up every time.
 // Arguments:
 // - buffer - Screen information pointer to pull text buffer data from
+// - rowBase - The retained index of the row that pos.Y counts from
 // - pos - Position inside screen buffer bounds to retrieve row
 // Return Value:
 // - Pointer to the underlying CharRow structure
-const ROW* TextBufferCellIterator::s_GetRow(const TextBuffer& buffer, const COORD pos)
+const ROW* TextBufferCellIterator::s_GetRow(const TextBuffer& buffer, const size_t rowBase, const COORD pos)
 {
-    return &buffer.GetRowByOffset(pos.Y);
+    return &buffer.GetRetainedRow(rowBase + gsl::narrow<size_t>(pos.Y));
 }
 
 // Routine Description:
@@ -27,6 +27,7 @@ class TextBufferCellIterator
 public:
     TextBufferCellIterator(const TextBuffer& buffer, COORD pos);
     TextBufferCellIterator(const TextBuffer& buffer, COORD pos, const Microsoft::Console::Types::Viewport limits);
+    TextBufferCellIterator(const TextBuffer& buffer, COORD pos, const Microsoft::Console::Types::Viewport limits, const size_t rowBase);
 
     ~TextBufferCellIterator() = default;
 
@@ -49,17 +50,20 @@ public:
     const OutputCellView& operator*() const noexcept;
     const OutputCellView* operator->() const noexcept;
 
+    size_t GetAttrRunLength() const noexcept;
+
 protected:
 
     void _SetPos(const COORD newPos);
     void _GenerateView();
-    static const ROW* s_GetRow(const TextBuffer& buffer, const COORD pos);
+    static const ROW* s_GetRow(const TextBuffer& buffer, const size_t rowBase, const COORD pos);
 
     OutputCellView _view;
 
     const ROW* _pRow;
     AttrRowIterator _attrIter;
     const TextBuffer& _buffer;
+    const size_t _rowBase;
     const Microsoft::Console::Types::Viewport _bounds;
     bool _exceeded;
     COORD _pos;
@@ -19,34 +19,83 @@ class UnicodeStorageTests
     TEST_METHOD(CanOverwriteEmoji)
     {
         UnicodeStorage storage;
-        const COORD coord{ 1, 3 };
-        const std::vector<wchar_t> newMoon{ 0xD83C, 0xDF11 };
-        const std::vector<wchar_t> fullMoon{ 0xD83C, 0xDF15 };
+        const UnicodeStorage::key_type column = 3;
+        const std::wstring newMoon{ 0xD83C, 0xDF11 };
+        const std::wstring fullMoon{ 0xD83C, 0xDF15 };
 
         // store initial glyph
-        storage.StoreGlyph(coord, newMoon);
+        storage.StoreGlyph(column, newMoon);
 
         // verify it was stored
-        auto findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& newMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(newMoonGlyph.size(), newMoon.size());
-        for (size_t i = 0; i < newMoon.size(); ++i)
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), storage.size());
+        VERIFY_ARE_EQUAL(String(newMoon.c_str()), String(std::wstring{ storage.GetText(column) }.c_str()));
+
+        // overwrite it
+        storage.StoreGlyph(column, fullMoon);
+
+        // verify the glyph was overwritten, in the space the old one used
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), storage.size());
+        VERIFY_ARE_EQUAL(String(fullMoon.c_str()), String(std::wstring{ storage.GetText(column) }.c_str()));
+        VERIFY_ARE_EQUAL(newMoon.size(), storage._text.size());
+    }
+
+    TEST_METHOD(ReclaimsSpaceFromReplacedGlyphs)
+    {
+        UnicodeStorage storage;
+        const std::wstring flag{ 0xD83C, 0xDDFA, 0xD83C, 0xDDF8 };
+        const std::wstring family{ 0xD83D, 0xDC68, 0x200D, 0xD83D, 0xDC69, 0x200D, 0xD83D, 0xDC67 };
+
+        // Keep replacing glyphs with longer ones. The text they leave behind
+        // shouldn't make the storage grow without bounds.
+        for (size_t i = 0; i < 100; ++i)
         {
-            VERIFY_ARE_EQUAL(newMoonGlyph.at(i), newMoon.at(i));
+            storage.StoreGlyph(1, flag);
+            storage.StoreGlyph(2, flag);
+            storage.StoreGlyph(1, family);
+            storage.StoreGlyph(2, family);
+            storage.StoreGlyph(1, std::wstring_view{ flag.data(), 2 });
         }
 
-        // overwrite it
-        storage.StoreGlyph(coord, fullMoon);
-
-        // verify the glyph was overwritten
-        findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& fullMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(fullMoonGlyph.size(), fullMoon.size());
-        for (size_t i = 0; i < fullMoon.size(); ++i)
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), storage.size());
+        VERIFY_IS_LESS_THAN_OR_EQUAL(storage._text.size(), 4 * family.size());
+        VERIFY_ARE_EQUAL(String(flag.substr(0, 2).c_str()), String(std::wstring{ storage.GetText(1) }.c_str()));
+        VERIFY_ARE_EQUAL(String(family.c_str()), String(std::wstring{ storage.GetText(2) }.c_str()));
+    }
+
+    TEST_METHOD(CanStoreGlyphFromItself)
+    {
+        UnicodeStorage storage;
+        const std::wstring fire{ 0xD83D, 0xDD25 };
+
+        // Copying a cell to another column of the same row hands the storage its own text.
+        storage.StoreGlyph(0, fire);
+        for (size_t column = 1; column < 50; ++column)
+        {
+            storage.StoreGlyph(column, storage.GetText(column - 1));
+        }
+
+        VERIFY_ARE_EQUAL(static_cast<size_t>(50), storage.size());
+        VERIFY_ARE_EQUAL(String(fire.c_str()), String(std::wstring{ storage.GetText(49) }.c_str()));
+    }
+
+    TEST_METHOD(EraseFromDropsLaterColumns)
+    {
+        UnicodeStorage storage;
+        const std::wstring fire{ 0xD83D, 0xDD25 };
+        for (size_t column = 0; column < 10; column += 2)
         {
-            VERIFY_ARE_EQUAL(fullMoonGlyph.at(i), fullMoon.at(i));
+            storage.StoreGlyph(column, fire);
         }
+
+        storage.Erase(2);
+        VERIFY_ARE_EQUAL(static_cast<size_t>(4), storage.size());
+
+        storage.EraseFrom(5);
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), storage.size());
+        VERIFY_ARE_EQUAL(String(fire.c_str()), String(std::wstring{ storage.GetText(4) }.c_str()));
+        VERIFY_THROWS_SPECIFIC(storage.GetText(6), wil::ResultException, [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+
+        storage.Reset();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), storage.size());
     }
 };
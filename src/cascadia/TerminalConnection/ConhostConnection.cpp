@@ -13,6 +13,8 @@
 
 #include <conpty-universal.h>
 
+#include "../../types/inc/Utf8StreamReader.hpp"
+
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
     ConhostConnection::ConhostConnection(hstring const& commandline,
@@ -139,37 +141,32 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
     DWORD ConhostConnection::_OutputThread()
     {
-        const size_t bufferSize = 4096;
-        BYTE buffer[bufferSize];
-        DWORD dwRead;
-        while (true)
+        // A read from the pipe returns everything that's waiting in it, up to the size
+        // of the buffer, so one large read already gathers up a burst of output.
+        Utf8StreamReader reader{
+            [this](char* const buffer, const size_t size, size_t& read) {
+                DWORD dwRead = 0;
+                const bool fSuccess = !!ReadFile(_outPipe, buffer, static_cast<DWORD>(size), &dwRead, nullptr);
+                read = dwRead;
+                return fSuccess;
+            },
+            nullptr
+        };
+
+        std::wstring_view text;
+        while (reader.Read(text))
         {
-            dwRead = 0;
-            bool fSuccess = false;
-
-            fSuccess = !!ReadFile(_outPipe, buffer, bufferSize, &dwRead, nullptr);
-            if (!fSuccess)
-            {
-                if (_closing)
-                {
-                    // This is okay, break out to kill the thread
-                    return 0;
-                }
-                else
-                {
-                    _disconnectHandlers();
-                    return (DWORD)-1;
-                }
-
-            }
-            if (dwRead == 0) continue;
-            // Convert buffer to hstring
-            char* pchStr = (char*)(buffer);
-            std::string str{pchStr, dwRead};
-            auto hstr = winrt::to_hstring(str);
-
             // Pass the output to our registered event handlers
-            _outputHandlers(hstr);
+            _outputHandlers(hstring{ text });
+        }
+
+        if (_closing)
+        {
+            // This is okay, break out to kill the thread
+            return 0;
         }
+
+        _disconnectHandlers();
+        return (DWORD)-1;
     }
 }
@@ -6,6 +6,8 @@
 
 #include <Windows.h>
 
+#include "../../types/inc/Utf8StreamReader.hpp"
+
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
     ConptyConnection::ConptyConnection(hstring const& commandline,
@@ -230,24 +232,26 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
     DWORD ConptyConnection::_OutputThread()
     {
-        BYTE buffer[256];
-        DWORD dwRead;
+        Utf8StreamReader reader{
+            [this](char* const buffer, const size_t size, size_t& read) {
+                DWORD dwRead = 0;
+                const bool fSuccess = !!ReadFile(_outPipe, buffer, static_cast<DWORD>(size), &dwRead, nullptr);
+                read = dwRead;
+                return fSuccess;
+            },
+            [this]() -> size_t {
+                DWORD dwAvailable = 0;
+                return PeekNamedPipe(_outPipe, nullptr, 0, nullptr, &dwAvailable, nullptr) ? dwAvailable : 0;
+            }
+        };
+
+        std::wstring_view text;
         while (true)
         {
-            dwRead = 0;
-            bool fSuccess = false;
-
-            fSuccess = !!ReadFile(_outPipe, buffer, ARRAYSIZE(buffer), &dwRead, nullptr);
-
-            THROW_LAST_ERROR_IF(!fSuccess);
-
-            // Convert buffer to hstring
-            char* pchStr = (char*)(buffer);
-            std::string str{pchStr, dwRead};
-            auto hstr = winrt::to_hstring(str);
+            THROW_LAST_ERROR_IF(!reader.Read(text));
 
             // Pass the output to our registered event handlers
-            _outputHandlers(hstr);
+            _outputHandlers(hstring{ text });
 
             // if (this->_active)
             // {
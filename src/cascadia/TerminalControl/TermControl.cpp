@@ -820,6 +820,8 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         //      actually fail. We need a way to gracefully fallback.
         _renderer->TriggerFontChange(newDpi, _desiredFont, _actualFont);
 
+        // The width of ambiguous glyphs depends on the font, so forget what we've learned so far.
+        NotifyGlyphWidthFontChanged();
     }
 
     // Method Description:
@@ -41,6 +41,7 @@ Terminal::Terminal() :
     _defaultBg{ ARGB(0, 0, 0, 0) },
     _pfnWriteInput{ nullptr },
     _scrollOffset{ 0 },
+    _scrollNotificationPending{ false },
     _snapOnInput{ true },
     _boxSelection{ false },
     _selectionActive{ false },
@@ -61,14 +62,15 @@ Terminal::Terminal() :
     _InitializeColorTable();
 }
 
-void Terminal::Create(COORD viewportSize, SHORT scrollbackLines, IRenderTarget& renderTarget)
+void Terminal::Create(COORD viewportSize, size_t scrollbackLines, IRenderTarget& renderTarget)
 {
     _mutableViewport = Viewport::FromDimensions({ 0,0 }, viewportSize);
     _scrollbackLines = scrollbackLines;
-    COORD bufferSize { viewportSize.X, viewportSize.Y + scrollbackLines };
+    COORD bufferSize { viewportSize.X, _GetBufferHeight(viewportSize.Y, scrollbackLines) };
     TextAttribute attr{};
     UINT cursorSize = 12;
     _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, renderTarget);
+    _buffer->SetArchiveLimit(_GetArchiveLimit(viewportSize.Y, scrollbackLines));
 }
 
 // Method Description:
@@ -80,8 +82,11 @@ void Terminal::CreateFromSettings(winrt::Microsoft::Terminal::Settings::ICoreSet
             Microsoft::Console::Render::IRenderTarget& renderTarget)
 {
     const COORD viewportSize{ static_cast<short>(settings.InitialCols()), static_cast<short>(settings.InitialRows()) };
-    // TODO:MSFT:20642297 - Support infinite scrollback here, if HistorySize is -1
-    Create(viewportSize, static_cast<short>(settings.HistorySize()), renderTarget);
+    // A negative HistorySize asks for infinite scrollback. That's archived a
+    //      row at a time as it scrolls off, so none of it is allocated up front.
+    const auto historySize = settings.HistorySize();
+    const size_t scrollbackLines = historySize < 0 ? InfiniteScrollback : static_cast<size_t>(historySize);
+    Create(viewportSize, scrollbackLines, renderTarget);
 
     UpdateSettings(settings);
 }
@@ -154,8 +159,15 @@ HRESULT Terminal::UserResize(const COORD viewportSize) noexcept
 
     const auto oldTop = _mutableViewport.Top();
 
-    const short newBufferHeight = viewportSize.Y + _scrollbackLines;
+    const short newBufferHeight = _GetBufferHeight(viewportSize.Y, _scrollbackLines);
     COORD bufferSize{ viewportSize.X, newBufferHeight };
+    // Set the new archive limit first, so rows that no longer fit in the
+    //      buffer can be archived by the resize.
+    try
+    {
+        _buffer->SetArchiveLimit(_GetArchiveLimit(viewportSize.Y, _scrollbackLines));
+    }
+    CATCH_RETURN();
     RETURN_IF_FAILED(_buffer->ResizeTraditional(bufferSize));
 
     auto proposedTop = oldTop;
@@ -180,6 +192,8 @@ void Terminal::Write(std::wstring_view stringView)
     auto lock = LockForWriting();
 
     _stateMachine->ProcessString(stringView.data(), stringView.size());
+
+    _FlushPendingScrollNotification();
 }
 
 // Method Description:
@@ -272,15 +286,63 @@ Viewport Terminal::_GetMutableViewport() const noexcept
     return _mutableViewport;
 }
 
-short Terminal::GetBufferHeight() const noexcept
+// Method Description:
+// - Gets the number of rows of history there are, down to the bottom of the
+//   mutable viewport. That includes the rows the buffer has archived.
+int Terminal::GetBufferHeight() const noexcept
 {
-    return _mutableViewport.BottomExclusive();
+    return gsl::narrow_cast<int>(_buffer->ArchivedRowCount()) + _mutableViewport.BottomExclusive();
+}
+
+// Method Description:
+// - Calculates how tall the buffer should be to hold a viewport of the given
+//   height and the requested amount of scrollback. The result is clamped to
+//   s_maxBufferHeight, so a large scrollback request gets as many rows as the
+//   buffer can address rather than overflowing the SHORT. The rest of it is
+//   archived, see _GetArchiveLimit.
+// - Infinite scrollback is all archived as it arrives, so the buffer only
+//   needs to hold the viewport.
+// Arguments:
+// - viewportHeight: the height of the viewport, in rows
+// - scrollbackLines: the number of rows of history requested above the viewport
+// Return Value:
+// - the height to create the buffer with
+SHORT Terminal::_GetBufferHeight(const SHORT viewportHeight, const size_t scrollbackLines) noexcept
+{
+    const size_t viewportRows = static_cast<size_t>(std::max<SHORT>(viewportHeight, 0));
+    if (scrollbackLines == InfiniteScrollback)
+    {
+        return static_cast<SHORT>(viewportRows);
+    }
+
+    const size_t scrollbackRows = std::min(scrollbackLines, s_maxBufferHeight - std::min(viewportRows, s_maxBufferHeight));
+    return static_cast<SHORT>(viewportRows + scrollbackRows);
+}
+
+// Method Description:
+// - Calculates how many rows of the requested scrollback don't fit in a buffer
+//   of the height _GetBufferHeight gives, and have to be archived instead.
+// Arguments:
+// - viewportHeight: the height of the viewport, in rows
+// - scrollbackLines: the number of rows of history requested above the viewport
+// Return Value:
+// - the archive limit to give the buffer
+size_t Terminal::_GetArchiveLimit(const SHORT viewportHeight, const size_t scrollbackLines) noexcept
+{
+    if (scrollbackLines == InfiniteScrollback)
+    {
+        return InfiniteScrollback;
+    }
+
+    const size_t viewportRows = static_cast<size_t>(std::max<SHORT>(viewportHeight, 0));
+    const size_t bufferScrollbackRows = static_cast<size_t>(_GetBufferHeight(viewportHeight, scrollbackLines)) - viewportRows;
+    return scrollbackLines - bufferScrollbackRows;
 }
 
-// _ViewStartIndex is also the length of the scrollback
+// _ViewStartIndex is also the length of the scrollback, archived rows included
 int Terminal::_ViewStartIndex() const noexcept
 {
-    return _mutableViewport.Top();
+    return gsl::narrow_cast<int>(_buffer->ArchivedRowCount()) + _mutableViewport.Top();
 }
 
 // _VisibleStartIndex is the first visible line of the buffer
@@ -289,9 +351,24 @@ int Terminal::_VisibleStartIndex() const noexcept
     return std::max(0, _ViewStartIndex() - _scrollOffset);
 }
 
+// Method Description:
+// - Picks the row that the visible viewport, cursor and selection are counted
+//   from when they're handed to the renderer. While the visible viewport is
+//   inside the buffer, that's the buffer's own row 0, so they're all in buffer
+//   coordinates. Once it's scrolled up into the archived rows, they're counted
+//   from its top instead, so they still fit in a COORD however far back it is.
+// Return Value:
+// - the retained index of the row to count from
+size_t Terminal::_GetBufferRowBase() const noexcept
+{
+    return std::min(static_cast<size_t>(_VisibleStartIndex()), _buffer->ArchivedRowCount());
+}
+
+// Method Description:
+// - Gets the visible viewport, with its rows counted from _GetBufferRowBase.
 Viewport Terminal::_GetVisibleViewport() const noexcept
 {
-    const COORD origin{ 0, gsl::narrow<short>(_VisibleStartIndex()) };
+    const COORD origin{ 0, gsl::narrow<short>(_VisibleStartIndex() - static_cast<int>(_GetBufferRowBase())) };
     return Viewport::FromDimensions(origin,
                                     _mutableViewport.Dimensions());
 }
@@ -300,33 +377,58 @@ Viewport Terminal::_GetVisibleViewport() const noexcept
 //      in accordance with the written text.
 // This method is our proverbial `WriteCharsLegacy`, and great care should be made to
 //      keep it minimal and orderly, lest it become WriteCharsLegacy2ElectricBoogaloo
+// The string is split into runs at each LF, CR and BS. Each run of other
+//      characters is written with a single WriteLine call, up to the right
+//      margin. Anything that doesn't fit is dropped, as we don't wrap here.
+// The viewport moves along with the cursor, but the redraw and scroll
+//      notification that needs are deferred to the end of Write, so we only
+//      send one of each no matter how many lines we advance.
 // TODO: MSFT 21006766
 //       This needs to become stream logic on the buffer itself sooner rather than later
 //       because it's otherwise impossible to avoid the Electric Boogaloo-ness here.
-//       I had to make a bunch of hacks to get Japanese and emoji to work-ish.
 void Terminal::_WriteBuffer(const std::wstring_view& stringView)
 {
     auto& cursor = _buffer->GetCursor();
     const Viewport bufferSize = _buffer->GetSize();
 
-    for (size_t i = 0; i < stringView.size(); i++)
+    COORD proposedCursorPosition = cursor.GetPosition();
+
+    size_t i = 0;
+    while (i < stringView.size())
     {
-        wchar_t wch = stringView[i];
-        const COORD cursorPosBefore = cursor.GetPosition();
-        COORD proposedCursorPosition = cursorPosBefore;
-        bool notifyScroll = false;
+        const wchar_t wch = stringView[i];
 
         if (wch == UNICODE_LINEFEED)
         {
             proposedCursorPosition.Y++;
+
+            // If we're about to scroll past the bottom of the buffer, instead cycle the buffer.
+            if (proposedCursorPosition.Y >= bufferSize.Height())
+            {
+                _buffer->IncrementCircularBuffer();
+                proposedCursorPosition.Y--;
+                _scrollNotificationPending = true;
+
+                // The row that was at the top of the viewport is now scrollback,
+                //      whether it's still in the buffer or has been archived.
+                const size_t viewStart = static_cast<size_t>(_ViewStartIndex());
+                if (viewStart > 0)
+                {
+                    _CompactScrollbackRows(viewStart - 1, viewStart);
+                }
+            }
+
+            _MoveViewportToCursor(proposedCursorPosition);
+            i++;
         }
         else if (wch == UNICODE_CARRIAGERETURN)
         {
             proposedCursorPosition.X = 0;
+            i++;
         }
         else if (wch == UNICODE_BACKSPACE)
         {
-            if (cursorPosBefore.X == 0)
+            if (proposedCursorPosition.X == 0)
             {
                 proposedCursorPosition.X = bufferSize.Width() - 1;
                 proposedCursorPosition.Y--;
@@ -335,62 +437,82 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
             {
                 proposedCursorPosition.X--;
             }
+            i++;
         }
         else
         {
-            // TODO: MSFT 21006766
-            // This is not great but I need it demoable. Fix by making a buffer stream writer.
-            if (wch >= 0xD800 && wch <= 0xDFFF)
-            {
-                OutputCellIterator it{ stringView.substr(i, 2) , _buffer->GetCurrentAttributes() };
-                const auto end = _buffer->Write(it);
-                const auto cellDistance = end.GetCellDistance(it);
-                i += cellDistance - 1;
-                proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            }
-            else
-            {
-                OutputCellIterator it{ stringView.substr(i, 1) , _buffer->GetCurrentAttributes() };
-                const auto end = _buffer->Write(it);
-                const auto cellDistance = end.GetCellDistance(it);
-                proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            }
-        }
+            // Find the end of this run of characters, and write as much of it
+            //      as will fit on this line in one go.
+            const size_t runEnd = std::min(stringView.find_first_of(s_runBreakChars, i), stringView.size());
 
-        // If we're about to scroll past the bottom of the buffer, instead cycle the buffer.
-        const auto newRows = proposedCursorPosition.Y - bufferSize.Height() + 1;
-        if (newRows > 0)
-        {
-            for(auto dy = 0; dy < newRows; dy++)
-            {
-                _buffer->IncrementCircularBuffer();
-                proposedCursorPosition.Y--;
-            }
-            notifyScroll = true;
-        }
+            OutputCellIterator it{ stringView.substr(i, runEnd - i), _buffer->GetCurrentAttributes() };
+            const auto end = _buffer->WriteLine(it, proposedCursorPosition, false);
+            proposedCursorPosition.X += gsl::narrow<SHORT>(end.GetCellDistance(it));
 
-        // This section is essentially equivalent to `AdjustCursorPosition`
-        // Update Cursor Position
-        cursor.SetPosition(proposedCursorPosition);
+            i = runEnd;
+        }
+    }
 
-        const COORD cursorPosAfter = cursor.GetPosition();
+    // This section is essentially equivalent to `AdjustCursorPosition`
+    // Update Cursor Position
+    cursor.SetPosition(proposedCursorPosition);
+    _MoveViewportToCursor(proposedCursorPosition);
+}
 
-        // Move the viewport down if the cursor moved below the viewport.
-        if (cursorPosAfter.Y > _mutableViewport.BottomInclusive())
+// Method Description:
+// - Moves the viewport down if the cursor moved below the viewport. If it did
+//   move, the redraw and scroll event are left pending for the end of Write.
+// Arguments:
+// - cursorPosition: the new position of the cursor, in buffer coordinates.
+// Return Value:
+// - <none>
+void Terminal::_MoveViewportToCursor(const COORD cursorPosition)
+{
+    if (cursorPosition.Y > _mutableViewport.BottomInclusive())
+    {
+        const auto newViewTop = std::max(0, cursorPosition.Y - (_mutableViewport.Height() - 1));
+        if (newViewTop != _mutableViewport.Top())
         {
-            const auto newViewTop = std::max(0, cursorPosAfter.Y - (_mutableViewport.Height() - 1));
-            if (newViewTop != _mutableViewport.Top())
-            {
-                _mutableViewport = Viewport::FromDimensions({0, gsl::narrow<short>(newViewTop)}, _mutableViewport.Dimensions());
-                notifyScroll = true;
-            }
+            const size_t archivedRows = _buffer->ArchivedRowCount();
+            _CompactScrollbackRows(archivedRows + _mutableViewport.Top(), archivedRows + newViewTop);
+            _mutableViewport = Viewport::FromDimensions({ 0, gsl::narrow<short>(newViewTop) }, _mutableViewport.Dimensions());
+            _scrollNotificationPending = true;
         }
+    }
+}
 
-        if (notifyScroll)
-        {
-            _buffer->GetRenderTarget().TriggerRedrawAll();
-            _NotifyScrollEvent();
-        }
+// Method Description:
+// - Switches rows that have just moved up out of the mutable viewport into
+//   their compact form. Most scrollback is never looked at again, so there's
+//   no need for it to hold full-width cell storage. Rows inflate again only
+//   when written to; readers work from the compact text.
+// Arguments:
+// - firstRow: the retained index of the first row that left the viewport
+// - lastRowExclusive: one past the last row that left the viewport
+// Return Value:
+// - <none>
+void Terminal::_CompactScrollbackRows(const size_t firstRow, const size_t lastRowExclusive)
+{
+    for (size_t row = firstRow; row < lastRowExclusive; row++)
+    {
+        _buffer->GetRetainedRow(row).Compact();
+    }
+}
+
+// Method Description:
+// - Sends the redraw and scroll notification that writing to the buffer may
+//   have deferred. Called once at the end of each Write.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::_FlushPendingScrollNotification()
+{
+    if (_scrollNotificationPending)
+    {
+        _scrollNotificationPending = false;
+        _buffer->GetRenderTarget().TriggerRedrawAll();
+        _NotifyScrollEvent();
     }
 }
 
@@ -414,9 +536,8 @@ void Terminal::_NotifyScrollEvent()
 {
     if (_pfnScrollPositionChanged)
     {
-        const auto visible = _GetVisibleViewport();
-        const auto top = visible.Top();
-        const auto height = visible.Height();
+        const auto top = _VisibleStartIndex();
+        const auto height = _mutableViewport.Height();
         const auto bottom = this->GetBufferHeight();
         _pfnScrollPositionChanged(top, height, bottom);
     }
@@ -454,12 +575,10 @@ void Terminal::SetSelectionAnchor(const COORD position)
 {
     _selectionAnchor = position;
 
-    // include _scrollOffset here to ensure this maps to the right spot of the original viewport
-    THROW_IF_FAILED(ShortSub(_selectionAnchor.Y, gsl::narrow<SHORT>(_scrollOffset), &_selectionAnchor.Y));
-
-    // copy value of ViewStartIndex to support scrolling
+    // copy value of VisibleStartIndex to support scrolling
     // and update on new buffer output (used in _GetSelectionRects())
-    _selectionAnchor_YOffset = gsl::narrow<SHORT>(_ViewStartIndex());
+    // It includes the _scrollOffset, so this maps to the right spot of the original viewport.
+    _selectionAnchor_YOffset = _VisibleStartIndex();
 
     _selectionActive = true;
     SetEndSelectionPosition(position);
@@ -473,12 +592,10 @@ void Terminal::SetEndSelectionPosition(const COORD position)
 {
     _endSelectionPosition = position;
 
-    // include _scrollOffset here to ensure this maps to the right spot of the original viewport
-    THROW_IF_FAILED(ShortSub(_endSelectionPosition.Y, gsl::narrow<SHORT>(_scrollOffset), &_endSelectionPosition.Y));
-
-    // copy value of ViewStartIndex to support scrolling
+    // copy value of VisibleStartIndex to support scrolling
     // and update on new buffer output (used in _GetSelectionRects())
-    _endSelectionPosition_YOffset = gsl::narrow<SHORT>(_ViewStartIndex());
+    // It includes the _scrollOffset, so this maps to the right spot of the original viewport.
+    _endSelectionPosition_YOffset = _VisibleStartIndex();
 }
 
 void Terminal::_InitializeColorTable()
@@ -494,9 +611,13 @@ void Terminal::_InitializeColorTable()
 
 // Method Description:
 // - Helper to determine the selected region of the buffer. Used for rendering.
+// Arguments:
+// - rowBase: the retained index of the row the rectangles are counted from.
+//   Rows of the selection above it, or more than SHORT_MAX rows below it,
+//   aren't included.
 // Return Value:
-// - A vector of rectangles representing the regions to select, line by line. They are absolute coordinates relative to the buffer origin.
-std::vector<SMALL_RECT> Terminal::_GetSelectionRects() const
+// - A vector of rectangles representing the regions to select, line by line. They are relative to rowBase.
+std::vector<SMALL_RECT> Terminal::_GetSelectionRects(const size_t rowBase) const
 {
     std::vector<SMALL_RECT> selectionArea;
 
@@ -506,35 +627,41 @@ std::vector<SMALL_RECT> Terminal::_GetSelectionRects() const
     }
 
     // Add anchor offset here to update properly on new buffer output
-    SHORT temp1, temp2;
-    THROW_IF_FAILED(ShortAdd(_selectionAnchor.Y, _selectionAnchor_YOffset, &temp1));
-    THROW_IF_FAILED(ShortAdd(_endSelectionPosition.Y, _endSelectionPosition_YOffset, &temp2));
-
-    // create these new anchors for comparison and rendering
-    const COORD selectionAnchorWithOffset = { _selectionAnchor.X, temp1 };
-    const COORD endSelectionPositionWithOffset = { _endSelectionPosition.X, temp2 };
+    const int anchorRow = _selectionAnchor.Y + _selectionAnchor_YOffset;
+    const int endRow = _endSelectionPosition.Y + _endSelectionPosition_YOffset;
 
     // NOTE: (0,0) is top-left so vertical comparison is inverted
-    const COORD &higherCoord = (selectionAnchorWithOffset.Y <= endSelectionPositionWithOffset.Y) ? selectionAnchorWithOffset : endSelectionPositionWithOffset;
-    const COORD &lowerCoord = (selectionAnchorWithOffset.Y > endSelectionPositionWithOffset.Y) ? selectionAnchorWithOffset : endSelectionPositionWithOffset;
+    const bool anchorIsHigher = anchorRow <= endRow;
+    const int higherRow = anchorIsHigher ? anchorRow : endRow;
+    const int lowerRow = anchorIsHigher ? endRow : anchorRow;
+    const SHORT higherX = anchorIsHigher ? _selectionAnchor.X : _endSelectionPosition.X;
+    const SHORT lowerX = anchorIsHigher ? _endSelectionPosition.X : _selectionAnchor.X;
+
+    const int base = gsl::narrow<int>(rowBase);
+    const int firstRow = std::max(higherRow, base);
+    const int lastRow = std::min(lowerRow, base + SHRT_MAX);
+    if (firstRow > lastRow)
+    {
+        return selectionArea;
+    }
 
-    selectionArea.reserve(lowerCoord.Y - higherCoord.Y + 1);
-    for (auto row = higherCoord.Y; row <= lowerCoord.Y; row++)
+    selectionArea.reserve(lastRow - firstRow + 1);
+    for (auto row = firstRow; row <= lastRow; row++)
     {
         SMALL_RECT selectionRow;
 
-        selectionRow.Top = row;
-        selectionRow.Bottom = row;
+        selectionRow.Top = gsl::narrow_cast<SHORT>(row - base);
+        selectionRow.Bottom = selectionRow.Top;
 
-        if (_boxSelection || higherCoord.Y == lowerCoord.Y)
+        if (_boxSelection || higherRow == lowerRow)
         {
-            selectionRow.Left = std::min(higherCoord.X, lowerCoord.X);
-            selectionRow.Right = std::max(higherCoord.X, lowerCoord.X);
+            selectionRow.Left = std::min(higherX, lowerX);
+            selectionRow.Right = std::max(higherX, lowerX);
         }
         else
         {
-            selectionRow.Left = (row == higherCoord.Y) ? higherCoord.X : 0;
-            selectionRow.Right = (row == lowerCoord.Y) ? lowerCoord.X : _buffer->GetSize().RightInclusive();
+            selectionRow.Left = (row == higherRow) ? higherX : 0;
+            selectionRow.Right = (row == lowerRow) ? lowerX : _buffer->GetSize().RightInclusive();
         }
 
         selectionArea.emplace_back(selectionRow);
@@ -574,17 +701,22 @@ const std::wstring Terminal::RetrieveSelectedTextFromBuffer(bool trimTrailingWhi
     std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&Terminal::GetForegroundColor, this, std::placeholders::_1);
     std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&Terminal::GetBackgroundColor, this, std::placeholders::_1);
 
-    auto data = _buffer->GetTextForClipboard(!_boxSelection,
-                                             trimTrailingWhitespace,
-                                             _GetSelectionRects(),
-                                             GetForegroundColor,
-                                             GetBackgroundColor);
+    // Count the rectangles from the top of the selection, so they can reach
+    //      archived rows that are above the buffer's own row 0.
+    const int anchorRow = _selectionAnchor.Y + _selectionAnchor_YOffset;
+    const int endRow = _endSelectionPosition.Y + _endSelectionPosition_YOffset;
+    const size_t rowBase = static_cast<size_t>(std::max(0, std::min(anchorRow, endRow)));
 
     std::wstring result;
-    for (const auto& text : data.text)
-    {
-        result += text;
-    }
+    _buffer->WriteSelectionRuns(!_boxSelection,
+                                trimTrailingWhitespace,
+                                _GetSelectionRects(rowBase),
+                                rowBase,
+                                GetForegroundColor,
+                                GetBackgroundColor,
+                                [&](const size_t /*rectIndex*/, const std::wstring_view text, const COLORREF /*foreground*/, const COLORREF /*background*/) {
+                                    result.append(text);
+                                });
 
     return result;
 }
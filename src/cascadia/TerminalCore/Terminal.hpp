@@ -36,8 +36,11 @@ public:
     Terminal();
     virtual ~Terminal() {};
 
+    // Passing this as the scrollback to Create keeps every line of history.
+    static constexpr size_t InfiniteScrollback = SIZE_MAX;
+
     void Create(COORD viewportSize,
-                SHORT scrollbackLines,
+                size_t scrollbackLines,
                 Microsoft::Console::Render::IRenderTarget& renderTarget);
 
     void CreateFromSettings(winrt::Microsoft::Terminal::Settings::ICoreSettings settings,
@@ -53,7 +56,7 @@ public:
     [[nodiscard]]
     std::unique_lock<std::shared_mutex> LockForWriting();
 
-    short GetBufferHeight() const noexcept;
+    int GetBufferHeight() const noexcept;
 
     #pragma region ITerminalApi
     // These methods are defined in TerminalApi.cpp
@@ -89,6 +92,7 @@ public:
     // These methods are defined in TerminalRenderData.cpp
     Microsoft::Console::Types::Viewport GetViewport() noexcept override;
     const TextBuffer& GetTextBuffer() noexcept override;
+    size_t GetBufferRowBase() noexcept override;
     const FontInfo& GetFontInfo() noexcept override;
     const TextAttribute GetDefaultBrushColors() noexcept override;
     const COLORREF GetForegroundColor(const TextAttribute& attr) const noexcept override;
@@ -144,8 +148,8 @@ public:
     COORD _endSelectionPosition;
     bool _boxSelection;
     bool _selectionActive;
-    SHORT _selectionAnchor_YOffset;
-    SHORT _endSelectionPosition_YOffset;
+    int _selectionAnchor_YOffset;
+    int _endSelectionPosition_YOffset;
 
     std::shared_mutex _readWriteLock;
 
@@ -153,7 +157,7 @@ public:
     //      encapsulated, such that a Terminal can have both a main and alt buffer.
     std::unique_ptr<TextBuffer> _buffer;
     Microsoft::Console::Types::Viewport _mutableViewport;
-    SHORT _scrollbackLines;
+    size_t _scrollbackLines;
 
     // _scrollOffset is the number of lines above the viewport that are currently visible
     // If _scrollOffset is 0, then the visible region of the buffer is the viewport.
@@ -171,18 +175,38 @@ public:
     //      underneath them, while others would prefer to anchor it in place.
     //      Either way, we sohould make this behavior controlled by a setting.
 
+    // Set when writing moved the viewport or cycled the buffer, and the
+    //      redraw and scroll event for that haven't been sent yet.
+    bool _scrollNotificationPending;
+
+    // The buffer, viewport and cursor are all addressed with COORDs, so the
+    //      buffer can't be any taller than this. Scrollback that doesn't fit
+    //      is kept in the buffer's archive instead.
+    static constexpr size_t s_maxBufferHeight = SHRT_MAX;
+
+    static SHORT _GetBufferHeight(const SHORT viewportHeight, const size_t scrollbackLines) noexcept;
+    static size_t _GetArchiveLimit(const SHORT viewportHeight, const size_t scrollbackLines) noexcept;
+
+    // These count rows from the oldest archived row, so they can go past SHRT_MAX.
     int _ViewStartIndex() const noexcept;
     int _VisibleStartIndex() const noexcept;
+    size_t _GetBufferRowBase() const noexcept;
 
     Microsoft::Console::Types::Viewport _GetMutableViewport() const noexcept;
     Microsoft::Console::Types::Viewport _GetVisibleViewport() const noexcept;
 
     void _InitializeColorTable();
 
+    // _WriteBuffer splits the text it's given into runs at each of these.
+    static constexpr std::wstring_view s_runBreakChars{ L"\n\r\b", 3 };
+
     void _WriteBuffer(const std::wstring_view& stringView);
+    void _MoveViewportToCursor(const COORD cursorPosition);
+    void _CompactScrollbackRows(const size_t firstRow, const size_t lastRowExclusive);
+    void _FlushPendingScrollNotification();
 
     void _NotifyScrollEvent();
 
-    std::vector<SMALL_RECT> _GetSelectionRects() const;
+    std::vector<SMALL_RECT> _GetSelectionRects(const size_t rowBase) const;
 };
 
@@ -18,6 +18,11 @@ const TextBuffer& Terminal::GetTextBuffer() noexcept
     return *_buffer;
 }
 
+size_t Terminal::GetBufferRowBase() noexcept
+{
+    return _GetBufferRowBase();
+}
+
 const FontInfo& Terminal::GetFontInfo() noexcept
 {
     // TODO: This font value is only used to check if the font is a raster font.
@@ -55,7 +60,12 @@ const COLORREF Terminal::GetBackgroundColor(const TextAttribute& attr) const noe
 COORD Terminal::GetCursorPosition() const noexcept
 {
     const auto& cursor = _buffer->GetCursor();
-    return cursor.GetPosition();
+    auto position = cursor.GetPosition();
+    // The cursor is in buffer coordinates, so move it to be counted from the
+    //      same row as the viewport.
+    const size_t row = _buffer->ArchivedRowCount() + position.Y - _GetBufferRowBase();
+    position.Y = gsl::narrow_cast<SHORT>(std::min<size_t>(row, SHRT_MAX));
+    return position;
 }
 
 bool Terminal::IsCursorVisible() const noexcept
@@ -109,7 +119,7 @@ std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSelectionRects() n
 {
     std::vector<Viewport> result;
 
-    for (const auto& lineRect : _GetSelectionRects())
+    for (const auto& lineRect : _GetSelectionRects(_GetBufferRowBase()))
     {
         result.emplace_back(Viewport::FromInclusive(lineRect));
     }
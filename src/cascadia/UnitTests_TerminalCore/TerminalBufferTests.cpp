@@ -0,0 +1,377 @@
+/*
+* Copyright (c) Microsoft Corporation.
+* Licensed under the MIT license.
+*
+* Class Name: TerminalBufferTests
+*/
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+#include <chrono>
+#include <psapi.h>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+
+namespace TerminalCoreUnitTests
+{
+    // An IRenderTarget that only counts the invalidations it's asked for.
+    class CountingRenderTarget final : public IRenderTarget
+    {
+    public:
+        void TriggerRedraw(const Viewport& /*region*/) override { redrawCount++; }
+        void TriggerRedraw(const COORD* const /*pcoord*/) override { redrawCount++; }
+        void TriggerRedrawCursor(const COORD* const /*pcoord*/) override {}
+        void TriggerRedrawAll() override { redrawAllCount++; }
+        void TriggerTeardown() override {}
+        void TriggerSelection() override {}
+        void TriggerScroll() override {}
+        void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
+        void TriggerCircling() override {}
+        void TriggerTitleChange() override {}
+
+        size_t redrawCount = 0;
+        size_t redrawAllCount = 0;
+    };
+
+    class TerminalBufferTests
+    {
+        TEST_CLASS(TerminalBufferTests);
+
+        // More than the buffer can address, so Create should archive the rest.
+        static constexpr size_t s_maxScrollback = 1000000;
+
+        TEST_METHOD(WriteManyLinesNotifiesOnce)
+        {
+            Terminal term;
+            CountingRenderTarget renderTarget;
+            term.Create({ 80, 30 }, 100, renderTarget);
+
+            size_t scrollEvents = 0;
+            term.SetScrollPositionChangedCallback([&scrollEvents](const int, const int, const int) {
+                scrollEvents++;
+            });
+
+            Log::Comment(L"Write enough lines to fill the scrollback and cycle the buffer.");
+            std::wstring output;
+            for (int i = 0; i < 500; i++)
+            {
+                output += L"line " + std::to_wstring(i) + L"\r\n";
+            }
+            output += L"last";
+            term.Write(output);
+
+            VERIFY_ARE_EQUAL(static_cast<size_t>(1), renderTarget.redrawAllCount);
+            VERIFY_ARE_EQUAL(static_cast<size_t>(1), scrollEvents);
+
+            const auto& buffer = term.GetTextBuffer();
+            const auto cursorPosition = buffer.GetCursor().GetPosition();
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(4), cursorPosition.X);
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(buffer.GetSize().Height() - 1), cursorPosition.Y);
+
+            VERIFY_ARE_EQUAL(String(L"last"), String(buffer.GetRowByOffset(cursorPosition.Y).GetText().substr(0, 4).c_str()));
+            VERIFY_ARE_EQUAL(String(L"line 499"), String(buffer.GetRowByOffset(cursorPosition.Y - 1).GetText().substr(0, 8).c_str()));
+
+            Log::Comment(L"Writing text that doesn't move the viewport shouldn't notify at all.");
+            term.Write(L"\rfirst");
+            VERIFY_ARE_EQUAL(static_cast<size_t>(1), renderTarget.redrawAllCount);
+            VERIFY_ARE_EQUAL(static_cast<size_t>(1), scrollEvents);
+            VERIFY_ARE_EQUAL(String(L"first"), String(buffer.GetRowByOffset(cursorPosition.Y).GetText().substr(0, 5).c_str()));
+        }
+
+        TEST_METHOD(WriteRunStopsAtRightMargin)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 80, 30 }, 0, emptyRT);
+
+            term.Write(std::wstring(100, L'a'));
+
+            const auto& buffer = term.GetTextBuffer();
+            VERIFY_ARE_EQUAL(String(std::wstring(80, L'a').c_str()), String(buffer.GetRowByOffset(0).GetText().c_str()));
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(80), buffer.GetCursor().GetPosition().X);
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(0), buffer.GetCursor().GetPosition().Y);
+
+            Log::Comment(L"Backspace and carriage return split runs, and move the cursor back.");
+            term.Write(L"\b\bXY\rZ");
+            const auto text = buffer.GetRowByOffset(0).GetText();
+            VERIFY_ARE_EQUAL(L'Z', text[0]);
+            VERIFY_ARE_EQUAL(L'X', text[78]);
+            VERIFY_ARE_EQUAL(L'Y', text[79]);
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(1), buffer.GetCursor().GetPosition().X);
+        }
+
+        TEST_METHOD(WriteMillionLinesToLargeScrollback)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+
+            Log::Comment(L"Ask for more scrollback than a SHORT can hold. The buffer should saturate, and archive the rest.");
+            const size_t lines = s_maxScrollback;
+            term.Create({ 80, 30 }, lines, emptyRT);
+
+            const auto& buffer = term.GetTextBuffer();
+            const SHORT bufferHeight = buffer.GetSize().Height();
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(SHRT_MAX), bufferHeight);
+            VERIFY_ARE_EQUAL(static_cast<size_t>(0), buffer.ArchivedRowCount());
+
+            Log::Comment(L"Write a million lines, cycling the buffer many times over.");
+            std::wstring chunk;
+            for (size_t i = 0; i < lines; i++)
+            {
+                chunk += std::to_wstring(i) + L"\r\n";
+                if (chunk.size() >= 4096)
+                {
+                    term.Write(chunk);
+                    chunk.clear();
+                }
+            }
+            term.Write(chunk);
+
+            VERIFY_ARE_EQUAL(bufferHeight, buffer.GetSize().Height());
+
+            const auto cursorPosition = buffer.GetCursor().GetPosition();
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(0), cursorPosition.X);
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(bufferHeight - 1), cursorPosition.Y);
+
+            Log::Comment(L"Nothing should have been dropped: the rows that cycled off the buffer are archived.");
+            VERIFY_ARE_EQUAL(lines + 1, buffer.RetainedRowCount());
+            VERIFY_ARE_EQUAL(lines + 1 - bufferHeight, buffer.ArchivedRowCount());
+            VERIFY_ARE_EQUAL(static_cast<int>(lines + 1), term.GetBufferHeight());
+            VERIFY_ARE_EQUAL(static_cast<int>(lines + 1 - 30), term.GetScrollOffset());
+
+            Log::Comment(L"Every line should still be there, including the ones more than a SHORT's worth of rows back.");
+            for (size_t line = 0; line < lines; line++)
+            {
+                const auto expected = std::to_wstring(line);
+                const auto text = buffer.GetRetainedRow(line).GetText();
+                if (text.compare(0, expected.size(), expected) != 0 || text[expected.size()] != L' ')
+                {
+                    VERIFY_FAIL(String().Format(L"Retained row %zu should start with %s", line, expected.c_str()));
+                }
+            }
+        }
+
+        TEST_METHOD(InfiniteScrollbackArchivesOnDemand)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+
+            Log::Comment(L"Infinite scrollback shouldn't allocate any rows past the viewport up front.");
+            const COORD viewportSize{ 80, 30 };
+            term.Create(viewportSize, Terminal::InfiniteScrollback, emptyRT);
+
+            const auto& buffer = term.GetTextBuffer();
+            VERIFY_ARE_EQUAL(viewportSize.Y, buffer.GetSize().Height());
+            VERIFY_ARE_EQUAL(static_cast<size_t>(viewportSize.Y), buffer.RetainedRowCount());
+
+            const size_t lines = 100;
+            std::wstring output;
+            for (size_t i = 0; i < lines; i++)
+            {
+                output += std::to_wstring(i) + L"\r\n";
+            }
+            term.Write(output);
+
+            Log::Comment(L"The rows that scrolled off should have been archived, not dropped.");
+            VERIFY_ARE_EQUAL(viewportSize.Y, buffer.GetSize().Height());
+            VERIFY_ARE_EQUAL(lines + 1, buffer.RetainedRowCount());
+            VERIFY_ARE_EQUAL(lines + 1 - viewportSize.Y, buffer.ArchivedRowCount());
+            VERIFY_ARE_EQUAL(String(L"0 "), String(buffer.GetRetainedRow(0).GetText().substr(0, 2).c_str()));
+
+            Log::Comment(L"At the bottom, the viewport is the buffer's own rows.");
+            VERIFY_ARE_EQUAL(buffer.ArchivedRowCount(), term.GetBufferRowBase());
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(0), term.GetViewport().Top());
+
+            Log::Comment(L"Scrolled to the top, the viewport is counted from the oldest archived row.");
+            term.UserScrollViewport(0);
+            VERIFY_ARE_EQUAL(0, term.GetScrollOffset());
+            VERIFY_ARE_EQUAL(static_cast<size_t>(0), term.GetBufferRowBase());
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(0), term.GetViewport().Top());
+            const auto viewportText = buffer.GetCellDataAt({ 0, 0 }, term.GetViewport(), term.GetBufferRowBase());
+            VERIFY_ARE_EQUAL(String(L"0"), String(std::wstring{ viewportText->Chars() }.c_str()));
+        }
+
+        TEST_METHOD(RetainedRowMemoryCost)
+        {
+            BEGIN_TEST_METHOD_PROPERTIES()
+                TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+            END_TEST_METHOD_PROPERTIES()
+
+            const auto privateBytes = []() {
+                PROCESS_MEMORY_COUNTERS_EX counters{};
+                counters.cb = sizeof(counters);
+                THROW_IF_WIN32_BOOL_FALSE(GetProcessMemoryInfo(GetCurrentProcess(),
+                                                               reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+                                                               sizeof(counters)));
+                return counters.PrivateUsage;
+            };
+
+            const COORD viewportSize{ 120, 30 };
+            for (const size_t scrollbackLines : { static_cast<size_t>(1000), static_cast<size_t>(9001), s_maxScrollback })
+            {
+                const auto before = privateBytes();
+                {
+                    Terminal term;
+                    DummyRenderTarget emptyRT;
+                    term.Create(viewportSize, scrollbackLines, emptyRT);
+
+                    // Fill every row with text in two colors, so that each row
+                    //      carries the char data and an attribute run split.
+                    std::wstring line(viewportSize.X / 2, L'x');
+                    line = L"\x1b[31m" + line + L"\x1b[m" + line.substr(0, line.size() - 1) + L"\r\n";
+                    std::wstring chunk;
+                    for (size_t i = 0; i < viewportSize.Y + scrollbackLines; i++)
+                    {
+                        chunk += line;
+                        if (chunk.size() >= 65536)
+                        {
+                            term.Write(chunk);
+                            chunk.clear();
+                        }
+                    }
+                    term.Write(chunk);
+
+                    const auto after = privateBytes();
+                    const size_t retainedRows = term.GetTextBuffer().RetainedRowCount();
+                    const double bytesPerRow = static_cast<double>(after - before) / retainedRows;
+                    Log::Comment(String().Format(L"%zu rows of %d columns: %.0f bytes per retained row (%.2f per cell)",
+                                                 retainedRows,
+                                                 viewportSize.X,
+                                                 bytesPerRow,
+                                                 bytesPerRow / viewportSize.X));
+                }
+            }
+        }
+
+        TEST_METHOD(CompactScrollbackMemoryCost)
+        {
+            BEGIN_TEST_METHOD_PROPERTIES()
+                TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+            END_TEST_METHOD_PROPERTIES()
+
+            const auto privateBytes = []() {
+                PROCESS_MEMORY_COUNTERS_EX counters{};
+                counters.cb = sizeof(counters);
+                THROW_IF_WIN32_BOOL_FALSE(GetProcessMemoryInfo(GetCurrentProcess(),
+                                                               reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+                                                               sizeof(counters)));
+                return counters.PrivateUsage;
+            };
+
+            // Something like the output of a build: mostly plain lines of
+            //      varying length, some colored warnings, and the odd blank line.
+            const std::wstring_view samples[] = {
+                L"  Compiling src\\buffer\\out\\textBuffer.cpp",
+                L"  Compiling src\\host\\screenInfo.cpp (12 of 480) ...",
+                L"\x1b[33mwarning C4100: 'unused': unreferenced formal parameter\x1b[m",
+                L"",
+                L"  Linking bufferout.lib",
+                L"Build succeeded. 0 Error(s), 1 Warning(s). Time Elapsed 00:01:23.45",
+            };
+
+            const COORD viewportSize{ 120, 30 };
+            const size_t scrollbackLines = 9001;
+
+            const auto before = privateBytes();
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create(viewportSize, scrollbackLines, emptyRT);
+
+            const auto& buffer = term.GetTextBuffer();
+            const SHORT bufferHeight = buffer.GetSize().Height();
+            std::wstring output;
+            for (SHORT i = 0; i < bufferHeight * 2; i++)
+            {
+                output += samples[i % ARRAYSIZE(samples)];
+                output += L"\r\n";
+            }
+            term.Write(output);
+            const auto compacted = privateBytes();
+
+            size_t compactRows = 0;
+            for (SHORT i = 0; i < bufferHeight; i++)
+            {
+                compactRows += buffer.GetRowByOffset(i).GetCharRow().IsCompact() ? 1 : 0;
+            }
+
+            Log::Comment(L"Reading the rows back doesn't inflate them.");
+            for (SHORT i = 0; i < bufferHeight; i++)
+            {
+                const auto& charRow = buffer.GetRowByOffset(i).GetCharRow();
+                const auto wasCompact = charRow.IsCompact();
+                VERIFY_ARE_EQUAL(static_cast<size_t>(viewportSize.X), charRow.GetText().size());
+                VERIFY_ARE_EQUAL(wasCompact, charRow.IsCompact());
+            }
+
+            Log::Comment(L"Hold a buffer of the same size with no compact rows, for comparison.");
+            const TextBuffer inflatedBuffer{ buffer.GetSize().Dimensions(), TextAttribute{}, 0, emptyRT };
+            const auto inflated = privateBytes();
+
+            Log::Comment(String().Format(L"%d rows of %d columns, %zu of them compact",
+                                         bufferHeight,
+                                         viewportSize.X,
+                                         compactRows));
+            Log::Comment(String().Format(L"Compact scrollback: %.0f bytes per row",
+                                         static_cast<double>(compacted - before) / bufferHeight));
+            Log::Comment(String().Format(L"Fully inflated: %.0f bytes per row",
+                                         static_cast<double>(inflated - compacted) / bufferHeight));
+
+            VERIFY_IS_GREATER_THAN(compactRows, static_cast<size_t>(bufferHeight - viewportSize.Y - 1));
+        }
+
+        TEST_METHOD(WriteThroughput)
+        {
+            BEGIN_TEST_METHOD_PROPERTIES()
+                TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+            END_TEST_METHOD_PROPERTIES()
+
+            Terminal term;
+            CountingRenderTarget renderTarget;
+            term.Create({ 120, 30 }, 9001, renderTarget);
+
+            // Roughly what `cat` of a 100k line build log looks like, handed
+            //      over in the chunk sizes we get from the connection.
+            const size_t lines = 100000;
+            const size_t cchChunk = 4096;
+
+            std::wstring output;
+            for (size_t i = 0; i < lines; i++)
+            {
+                output += L"[" + std::to_wstring(i) + L"] Compiling src\\cascadia\\TerminalCore\\Terminal.cpp ...\r\n";
+            }
+
+            size_t writes = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < output.size(); i += cchChunk)
+            {
+                term.Write(std::wstring_view(output).substr(i, cchChunk));
+                writes++;
+            }
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const double megabytes = static_cast<double>(output.size() * sizeof(wchar_t)) / (1024.0 * 1024.0);
+            Log::Comment(String().Format(L"%zu lines (%.2f MB) in %.3f s: %.0f lines/s, %.2f MB/s",
+                                         lines,
+                                         megabytes,
+                                         elapsed,
+                                         elapsed > 0 ? lines / elapsed : 0.0,
+                                         elapsed > 0 ? megabytes / elapsed : 0.0));
+            Log::Comment(String().Format(L"%zu writes caused %zu redraw-alls and %zu region redraws",
+                                         writes,
+                                         renderTarget.redrawAllCount,
+                                         renderTarget.redrawCount));
+
+            VERIFY_IS_LESS_THAN_OR_EQUAL(renderTarget.redrawAllCount, writes);
+        }
+    };
+}
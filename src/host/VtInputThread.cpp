@@ -68,16 +68,21 @@ HRESULT VtInputThread::_HandleRunInput(_In_reads_(cch) const byte* const charBuf
 
     try
     {
-        std::unique_ptr<wchar_t[]> pwsSequence;
-        unsigned int cchConsumed;
-        unsigned int cchSequence;
-        auto hr = _utf8Parser.Parse(charBuffer, cch, cchConsumed, pwsSequence, cchSequence);
+        const size_t cb = gsl::narrow<size_t>(cch);
+        const size_t cchMax = Utf8ToWideCharParser::GetMaxConvertedSize(cb);
+        if (_wideBuffer.size() < cchMax)
+        {
+            _wideBuffer.resize(cchMax);
+        }
+
+        size_t cchSequence;
+        auto hr = _utf8Parser.Parse(gsl::make_span(charBuffer, cb), gsl::make_span(_wideBuffer), cchSequence);
         // If we hit a parsing error, eat it. It's bad utf-8, we can't do anything with it.
         if (FAILED(hr))
         {
             return S_FALSE;
         }
-        _pInputStateMachine->ProcessString(pwsSequence.get(), cchSequence);
+        _pInputStateMachine->ProcessString(_wideBuffer.data(), cchSequence);
     }
     CATCH_RETURN();
 
@@ -43,5 +43,9 @@ namespace Microsoft::Console
 
         std::unique_ptr<StateMachine> _pInputStateMachine;
         Utf8ToWideCharParser _utf8Parser;
+
+        // Where input is decoded to before it goes to the state machine. It's kept
+        // between reads so decoding doesn't have to allocate.
+        std::vector<wchar_t> _wideBuffer;
     };
 }
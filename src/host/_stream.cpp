@@ -22,12 +22,62 @@
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 
+#include <intrin.h>
+
 #pragma hdrstop
 using namespace Microsoft::Console::Types;
 
 // Used by WriteCharsLegacy.
 #define IS_GLYPH_CHAR(wch)   (((wch) < L' ') || ((wch) == 0x007F))
 
+// Routine Description:
+// - Measures the run of printable ASCII characters (space through tilde) at the
+//   start of a string. These are always one cell wide and never need any of the
+//   special handling in WriteCharsLegacy, so they can be written as they are.
+//   On x86/x64 this checks 8 characters at a time with SSE2, and then falls back
+//   to checking the remaining tail one character at a time.
+// Arguments:
+// - pwch - The string to check.
+// - cch - The number of characters in the string.
+// Return Value:
+// - The number of printable ASCII characters before the first one that isn't.
+static size_t _FindPrintableAsciiSpan(_In_reads_(cch) const wchar_t* const pwch, const size_t cch) noexcept
+{
+    size_t i = 0;
+
+#if defined(_M_IX86) || defined(_M_X64)
+    static_assert(sizeof(wchar_t) == sizeof(uint16_t), "The SSE2 scan assumes UTF-16 code units.");
+
+    const __m128i first = _mm_set1_epi16(L' ');
+    const __m128i last = _mm_set1_epi16(L'~');
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; cch - i >= 8; i += 8)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pwch + i));
+
+        // An unsigned saturating subtract leaves zero behind wherever the left side is the smaller one.
+        const __m128i notBelow = _mm_cmpeq_epi16(_mm_subs_epu16(first, chars), zero);
+        const __m128i notAbove = _mm_cmpeq_epi16(_mm_subs_epu16(chars, last), zero);
+
+        const int mask = _mm_movemask_epi8(_mm_and_si128(notBelow, notAbove));
+        if (mask != 0xffff)
+        {
+            unsigned long index;
+            _BitScanForward(&index, static_cast<unsigned long>(~mask & 0xffff));
+            // Each wchar_t contributes two bits to the byte mask.
+            return i + (index / 2);
+        }
+    }
+#endif
+
+    while (i < cch && pwch[i] >= L' ' && pwch[i] <= L'~')
+    {
+        i++;
+    }
+    return i;
+}
+
 // Routine Description:
 // - This routine updates the cursor position.  Its input is the non-special
 //   cased new location of the cursor.  For example, if the cursor were being
@@ -317,6 +367,7 @@ NTSTATUS WriteCharsLegacy(SCREEN_INFORMATION& screenInfo,
     NTSTATUS Status = STATUS_SUCCESS;
     SHORT XPosition;
     WCHAR LocalBuffer[LOCAL_BUFFER_SIZE];
+    const wchar_t* pwchWrite;
     size_t TempNumSpaces = 0;
     const bool fUnprocessed = WI_IsFlagClear(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT);
 
@@ -401,6 +452,28 @@ NTSTATUS WriteCharsLegacy(SCREEN_INFORMATION& screenInfo,
         XPosition = cursor.GetPosition().X;
         size_t i = 0;
         wchar_t* LocalBufPtr = LocalBuffer;
+        pwchWrite = LocalBuffer;
+
+        // Most output is runs of plain ASCII. If one starts here, write as much of it as fits
+        // on this row straight from the caller's string instead of copying it into LocalBuffer.
+        if (XPosition < coordScreenBufferSize.X)
+        {
+            const size_t cchRemaining = (BufferSize - *pcb) / sizeof(wchar_t);
+            const size_t cchFits = static_cast<size_t>(coordScreenBufferSize.X - XPosition);
+            const size_t cchSpan = _FindPrintableAsciiSpan(lpString, std::min(cchRemaining, cchFits));
+            if (cchSpan != 0)
+            {
+                pwchWrite = lpString;
+                i = cchSpan;
+                XPosition += gsl::narrow_cast<SHORT>(cchSpan);
+                lpString += cchSpan;
+                pwchRealUnicode += cchSpan;
+                pwchBuffer += cchSpan;
+                *pcb += cchSpan * sizeof(wchar_t);
+                goto EndWhile;
+            }
+        }
+
         while (*pcb < BufferSize && i < LOCAL_BUFFER_SIZE && XPosition < coordScreenBufferSize.X)
         {
 #pragma prefast(suppress:26019, "Buffer is taken in multiples of 2. Validation is ok.")
@@ -558,7 +631,7 @@ NTSTATUS WriteCharsLegacy(SCREEN_INFORMATION& screenInfo,
             }
 
             // line was wrapped if we're writing up to the end of the current row
-            OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
+            OutputCellIterator it(std::wstring_view(pwchWrite, i), Attributes);
             const auto itEnd = screenInfo.Write(it);
 
             // Notify accessibility
@@ -623,50 +696,28 @@ NTSTATUS WriteCharsLegacy(SCREEN_INFORMATION& screenInfo,
             }
             else
             {
-                const wchar_t* Tmp;
-                wchar_t* Tmp2 = nullptr;
-                WCHAR LastChar;
-
-                const size_t bufferSize = pwchBuffer - pwchBufferBackupLimit;
-                std::unique_ptr<wchar_t[]> buffer;
-                try
+                // Find the last character that hasn't been erased by a backspace. Walking backwards,
+                // every backspace erases the nearest character before it that isn't already erased.
+                // Backspaces with nothing left to erase before them do nothing (see 18120085).
+                WCHAR LastChar = UNICODE_SPACE;
+                size_t cErasing = 0;
+                for (const wchar_t* Tmp = pwchBuffer; Tmp > pwchBufferBackupLimit;)
                 {
-                    buffer = std::make_unique<wchar_t[]>(bufferSize);
-                    std::fill_n(buffer.get(), bufferSize, UNICODE_NULL);
-                }
-                catch (...)
-                {
-                    return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
-                }
-
-                for (i = 0, Tmp2 = buffer.get(), Tmp = pwchBufferBackupLimit;
-                     i < bufferSize; i++, Tmp++)
-                {
-                    // see 18120085, these two need to be seperate if statements
+                    --Tmp;
                     if (*Tmp == UNICODE_BACKSPACE)
                     {
-                        //it is important we do nothing in the else case for
-                        //      this one instead of falling through to the below else.
-                        if(Tmp2 > buffer.get())
-                        {
-                            Tmp2--;
-                        }
+                        cErasing++;
+                    }
+                    else if (cErasing > 0)
+                    {
+                        cErasing--;
                     }
                     else
                     {
-                        FAIL_FAST_IF(!(Tmp2 >= buffer.get()));
-                        *Tmp2++ = *Tmp;
+                        LastChar = *Tmp;
+                        break;
                     }
                 }
-                if (Tmp2 == buffer.get())
-                {
-                    LastChar = UNICODE_SPACE;
-                }
-                else
-                {
-#pragma prefast(suppress:26001, "This is fine. Tmp2 has to have advanced or it would equal pBuffer.")
-                    LastChar = *(Tmp2 - 1);
-                }
 
 
                 if (LastChar == UNICODE_TAB)
@@ -1134,6 +1185,7 @@ HRESULT ApiRoutines::WriteConsoleAImpl(IConsoleOutputObject& context,
 
         // Convert our input parameters to Unicode
         std::unique_ptr<wchar_t[]> wideCharBuffer{ nullptr };
+        std::vector<wchar_t>* pTranslationBuffer = nullptr;
         static Utf8ToWideCharParser parser{ gci.OutputCP };
 
         // update current codepage in case it was changed from last time
@@ -1173,9 +1225,11 @@ HRESULT ApiRoutines::WriteConsoleAImpl(IConsoleOutputObject& context,
 
             // (cchTextBufferLength + 2) I think because we might be shoving another unicode char
             // from ScreenInfo->WriteConsoleDbcsLeadByte in front
-            TransBuffer = new WCHAR[buffer.size() + 2];
-            RETURN_IF_NULL_ALLOC(TransBuffer);
-            ZeroMemory(TransBuffer, sizeof(WCHAR) * (buffer.size() + 2));
+            // The storage is kept on the main buffer between calls. Writing can switch away from
+            // and free an alternate buffer, but never the main one.
+            pTranslationBuffer = &ScreenInfo.GetMainBuffer().WriteConsoleTranslationBuffer;
+            pTranslationBuffer->assign(buffer.size() + 2, UNICODE_NULL);
+            TransBuffer = pTranslationBuffer->data();
 
             TransBufferOriginalLocation = TransBuffer;
 
@@ -1326,10 +1380,11 @@ HRESULT ApiRoutines::WriteConsoleAImpl(IConsoleOutputObject& context,
             }
         }
 
-        // Free remaining data
-        if (codepage != CP_UTF8)
+        // Don't hold on to the storage from an unusually large write.
+        constexpr size_t cchTranslationBufferKept = 64 * 1024;
+        if (nullptr != pTranslationBuffer && pTranslationBuffer->capacity() > cchTranslationBufferKept)
         {
-            delete[] pwchBuffer;
+            std::vector<wchar_t>().swap(*pTranslationBuffer);
         }
 
         // Give back the waiter now that we're done with tinkering with it.
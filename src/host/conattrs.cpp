@@ -76,6 +76,25 @@ static double _FindDifference(const _HSL* const phslColorA, const COLORREF rgbCo
                  pow((hslColorB.l - phslColorA->l), 2) );
 }
 
+//Routine Description:
+// Finds the "distance" between two colors using a weighted RGB distance that
+//   leans on red and blue depending on how red the colors are ("redmean").
+//   It tracks perceived differences better than a plain RGB distance and is
+//   much cheaper than going through HSL.
+//Arguments:
+// - rgbColorA - The first color.
+// - rgbColorB - The second color.
+// Return value:
+// The "distance" between the two, squared and scaled by 256.
+static unsigned int _FindPerceptualDifference(const COLORREF rgbColorA, const COLORREF rgbColorB) noexcept
+{
+    const int redMean = (GetRValue(rgbColorA) + GetRValue(rgbColorB)) / 2;
+    const int r = GetRValue(rgbColorA) - GetRValue(rgbColorB);
+    const int g = GetGValue(rgbColorA) - GetGValue(rgbColorB);
+    const int b = GetBValue(rgbColorA) - GetBValue(rgbColorB);
+    return static_cast<unsigned int>(((512 + redMean) * r * r) + (1024 * g * g) + ((767 - redMean) * b * b));
+}
+
 //Routine Description:
 // For a given RGB color Color, finds the nearest color from the array ColorTable, and returns the index of that match.
 //Arguments:
@@ -112,6 +131,214 @@ WORD FindNearestTableIndex(const COLORREF Color, _In_reads_(cColorTable) const C
     return closest;
 }
 
+ColorQuantizer::ColorQuantizer(const Metric metric) noexcept :
+    _metric(metric),
+    _cTable(0),
+    _table{},
+    _tableHsl{},
+    _cache{},
+    _lut{}
+{
+    _ClearCache();
+}
+
+// Only the choice of metric is copied. The copy works out everything else again on its own.
+ColorQuantizer::ColorQuantizer(const ColorQuantizer& other) noexcept :
+    ColorQuantizer(other._metric)
+{
+}
+
+ColorQuantizer& ColorQuantizer::operator=(const ColorQuantizer& other) noexcept
+{
+    if (this != &other)
+    {
+        _cTable = 0;
+        _lut.reset();
+        SetMetric(other._metric);
+    }
+    return *this;
+}
+
+ColorQuantizer::Metric ColorQuantizer::GetMetric() const noexcept
+{
+    return _metric;
+}
+
+void ColorQuantizer::SetMetric(const Metric metric) noexcept
+{
+    _metric = metric;
+    _ClearCache();
+}
+
+//Routine Description:
+// For a given RGB color Color, finds the nearest color from the array ColorTable, and returns the index of that match.
+// Answers are remembered until the contents of ColorTable change.
+//Arguments:
+// - Color - The RGB color to fine the nearest color to.
+// - ColorTable - The array of colors to find a nearest color from.
+// - cColorTable - The number of elements in ColorTable
+// Return value:
+// The index in ColorTable of the nearest match to Color.
+WORD ColorQuantizer::FindNearestTableIndex(const COLORREF Color,
+                                           _In_reads_(cColorTable) const COLORREF* const ColorTable,
+                                           const WORD cColorTable) noexcept
+{
+    if (cColorTable == 0 || cColorTable > _table.size() || Color == INVALID_COLOR)
+    {
+        return ::FindNearestTableIndex(Color, ColorTable, cColorTable);
+    }
+
+    if (!_IsTableCurrent(ColorTable, cColorTable))
+    {
+        _SetTable(ColorTable, cColorTable);
+    }
+
+    CacheEntry& entry = _cache[s_CacheSlot(Color)];
+    if (entry.color == Color)
+    {
+        return entry.index;
+    }
+
+    WORD index;
+    if (!FindTableIndex(Color, _table.data(), _cTable, &index))
+    {
+        index = _metric == Metric::Hsl ? _FindNearestHsl(Color) : _LookupPerceptual(Color);
+    }
+
+    entry.color = Color;
+    entry.index = index;
+    return index;
+}
+
+bool ColorQuantizer::_IsTableCurrent(_In_reads_(cColorTable) const COLORREF* const ColorTable,
+                                     const WORD cColorTable) const noexcept
+{
+    return _cTable == cColorTable && std::equal(ColorTable, ColorTable + cColorTable, _table.cbegin());
+}
+
+// Routine Description:
+// - Remembers a new color table, and forgets everything worked out for the old one.
+// Arguments:
+// - ColorTable - The array of colors to find nearest colors from.
+// - cColorTable - The number of elements in ColorTable. No more than COLOR_TABLE_SIZE.
+// Return Value:
+// - <none>
+void ColorQuantizer::_SetTable(_In_reads_(cColorTable) const COLORREF* const ColorTable,
+                               const WORD cColorTable) noexcept
+{
+    _cTable = cColorTable;
+    for (WORD i = 0; i < cColorTable; i++)
+    {
+        _table[i] = ColorTable[i];
+
+        const _HSL hsl(ColorTable[i]);
+        _tableHsl[i] = { hsl.h, hsl.s, hsl.l };
+    }
+    _ClearCache();
+}
+
+void ColorQuantizer::_ClearCache() noexcept
+{
+    _cache.fill({ INVALID_COLOR, 0 });
+    if (_lut)
+    {
+        memset(_lut.get(), s_lutEmpty, size_t{ 1 } << (3 * s_lutBits));
+    }
+}
+
+// Routine Description:
+// - The same search as ::FindNearestTableIndex, using the HSL values worked out
+//      for the table when it was set instead of converting every entry again.
+// Arguments:
+// - Color - The RGB color to find the nearest color to.
+// Return Value:
+// - The index in the table of the nearest match to Color.
+WORD ColorQuantizer::_FindNearestHsl(const COLORREF Color) const noexcept
+{
+    const _HSL hslColor(Color);
+    const auto difference = [&](const Hsl& hslEntry) {
+        return sqrt(pow((hslEntry.h - hslColor.h), 2) +
+                    pow((hslEntry.s - hslColor.s), 2) +
+                    pow((hslEntry.l - hslColor.l), 2));
+    };
+
+    WORD closest = 0;
+    double minDiff = difference(_tableHsl[0]);
+    for (WORD i = 1; i < _cTable; i++)
+    {
+        const double diff = difference(_tableHsl[i]);
+        if (diff < minDiff)
+        {
+            minDiff = diff;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+WORD ColorQuantizer::_FindNearestPerceptual(const COLORREF Color) const noexcept
+{
+    WORD closest = 0;
+    unsigned int minDiff = _FindPerceptualDifference(Color, _table[0]);
+    for (WORD i = 1; i < _cTable; i++)
+    {
+        const unsigned int diff = _FindPerceptualDifference(Color, _table[i]);
+        if (diff < minDiff)
+        {
+            minDiff = diff;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+// Routine Description:
+// - Finds the nearest color with the perceptual metric through the lookup
+//      table. A cell is worked out the first time a color lands in it, for the
+//      color at the middle of the cell.
+// Arguments:
+// - Color - The RGB color to find the nearest color to.
+// Return Value:
+// - The index in the table of the nearest match to Color.
+WORD ColorQuantizer::_LookupPerceptual(const COLORREF Color) noexcept
+{
+    if (!_lut)
+    {
+        const size_t cCells = size_t{ 1 } << (3 * s_lutBits);
+        _lut.reset(new(std::nothrow) BYTE[cCells]);
+        if (!_lut)
+        {
+            return _FindNearestPerceptual(Color);
+        }
+        memset(_lut.get(), s_lutEmpty, cCells);
+    }
+
+    constexpr unsigned int shift = 8 - s_lutBits;
+    const unsigned int r = GetRValue(Color) >> shift;
+    const unsigned int g = GetGValue(Color) >> shift;
+    const unsigned int b = GetBValue(Color) >> shift;
+    BYTE& cell = _lut[(r << (2 * s_lutBits)) | (g << s_lutBits) | b];
+    if (cell == s_lutEmpty)
+    {
+        constexpr unsigned int middle = 1u << (shift - 1);
+        const COLORREF center = RGB((r << shift) | middle, (g << shift) | middle, (b << shift) | middle);
+        cell = static_cast<BYTE>(_FindNearestPerceptual(center));
+    }
+    return cell;
+}
+
+// Routine Description:
+// - Picks the slot of the recently seen colors cache for a color. Multiplying
+//      by a large odd constant mixes all three channels into the top byte.
+// Arguments:
+// - Color - The RGB color.
+// Return Value:
+// - The slot in the cache.
+size_t ColorQuantizer::s_CacheSlot(const COLORREF Color) noexcept
+{
+    return static_cast<size_t>((Color * 0x9E3779B1u) >> 24);
+}
+
 // Function Description:
 // - Converts the value of a xterm color table index to the windows color table equivalent.
 // Arguments:
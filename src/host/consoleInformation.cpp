@@ -94,6 +94,11 @@ NTSTATUS CONSOLE_INFORMATION::AllocateConsole(const std::wstring_view title)
     WI_SetFlagIf(gci.Flags, CONSOLE_QUICK_EDIT_MODE, !!gci.GetQuickEdit());
     WI_SetFlagIf(gci.Flags, CONSOLE_HISTORY_NODUP, !!gci.GetHistoryNoDup());
 
+    if (gci.GetHistoryPersist())
+    {
+        LOG_IF_FAILED(CommandHistory::s_EnablePersistence());
+    }
+
     Selection* const pSelection = &Selection::Instance();
     pSelection->SetLineSelection(!!gci.GetLineSelection());
 
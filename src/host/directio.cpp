@@ -806,6 +806,62 @@ static std::vector<CHAR_INFO> _ConvertCellsToMungedW(gsl::span<CHAR_INFO> buffer
     return result;
 }
 
+// Routine Description:
+// - Converts a span of one row of the text buffer into legacy CHAR_INFOs. The legacy
+//   attributes are worked out once per run of the row's attributes instead of per cell.
+// Arguments:
+// - row - The row to read from
+// - left - The column of the row to start reading at
+// - target - Where to put the cells. One cell is read for every CHAR_INFO.
+// Return Value:
+// - <none>
+static void _ReadRowAsCharInfos(const ROW& row,
+                                const size_t left,
+                                gsl::span<CHAR_INFO> target)
+{
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto& charRow = row.GetCharRow();
+
+    // Compact rows have no cells to walk, but everything in them is a single
+    // ASCII character, so they're read a glyph at a time instead.
+    const bool compact = charRow.IsCompact();
+    CharRow::const_iterator cell;
+    if (!compact)
+    {
+        cell = charRow.cbegin() + left;
+    }
+
+    auto attrIter = row.GetAttrRow().cbegin();
+    attrIter += left;
+
+    size_t column = left;
+    auto targetIter = target.begin();
+    while (targetIter < target.end())
+    {
+        const WORD legacyAttributes = gci.GenerateLegacyAttributes(*attrIter);
+        const auto runLength = std::min(attrIter.GetRunRemaining(), static_cast<size_t>(target.end() - targetIter));
+        attrIter += runLength;
+
+        for (size_t i = 0; i < runLength; ++i, ++column, ++targetIter)
+        {
+            if (compact)
+            {
+                targetIter->Char.UnicodeChar = *charRow.GlyphAt(column).begin();
+                targetIter->Attributes = legacyAttributes;
+                continue;
+            }
+
+            // Glyphs that don't fit in one wchar_t are kept out of line. They can't be
+            // represented in a CHAR_INFO anyway and come back as the replacement character.
+            targetIter->Char.UnicodeChar = cell->DbcsAttr().IsGlyphStored() ?
+                Utf16ToUcs2(charRow.GlyphAt(column)) :
+                cell->Char();
+            targetIter->Attributes = legacyAttributes | cell->DbcsAttr().GeneratePublicApiAttributeFormat();
+            ++cell;
+        }
+    }
+}
+
 [[nodiscard]]
 static HRESULT _ReadConsoleOutputWImplHelper(const SCREEN_INFORMATION& context,
                                              gsl::span<CHAR_INFO> targetBuffer,
@@ -814,7 +870,6 @@ static HRESULT _ReadConsoleOutputWImplHelper(const SCREEN_INFORMATION& context,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -848,47 +903,30 @@ static HRESULT _ReadConsoleOutputWImplHelper(const SCREEN_INFORMATION& context,
         clip.Left = std::max(clip.Left, 0i16);
         clip.Top = std::max(clip.Top, 0i16);
 
+        // A request that starts off the right or bottom of the buffer has nothing inside it to read.
+        RETURN_HR_IF(E_INVALIDARG, clip.Left >= clip.Right || clip.Top >= clip.Bottom);
+
         // The final "request rectangle" or the area inside the buffer we want to read, is the clipped dimensions.
         const auto clippedRequestRectangle = Viewport::FromExclusive(clip);
 
-        // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
-        const auto sourcePoint = clippedRequestRectangle.Origin();
-
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backgin store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Copy the clipped request a row at a time into the matching span of the user's buffer.
+        // The cells of the user's buffer that fall outside the clipped request are left alone.
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
+        const ptrdiff_t width = clippedRequestRectangle.Width();
+        for (SHORT row = 0; row < clippedRequestRectangle.Height(); ++row)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
-            {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
-
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
+            const ptrdiff_t targetOffset = (targetPoint.Y + row) * static_cast<ptrdiff_t>(targetSize.X) + targetPoint.X;
 
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
+            // The user's buffer may end partway through the request. Stop where it does.
+            if (targetOffset >= targetBuffer.size())
             {
-                targetPos.X = 0;
-                targetPos.Y++;
+                break;
             }
+            const auto targetRow = targetBuffer.subspan(targetOffset, std::min(width, targetBuffer.size() - targetOffset));
+
+            _ReadRowAsCharInfos(textBuffer.GetRowByOffset(clippedRequestRectangle.Top() + row),
+                                clippedRequestRectangle.Left(),
+                                targetRow);
         }
 
         // Reply with the region we read out of the backing buffer (potentially clipped)
@@ -1041,9 +1079,13 @@ static HRESULT _WriteConsoleOutputWImplHelper(SCREEN_INFORMATION& context,
             // Convert to a CHAR_INFO view to fit into the iterator
             const auto charInfos = std::basic_string_view<CHAR_INFO>(subspan.data(), subspan.size());
 
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            // Copy the row straight into the buffer if we can. Otherwise, make the iterator
+            // and write to the target position a cell at a time.
+            if (!storageBuffer.GetTextBuffer().WriteCharInfoLine(charInfos, target))
+            {
+                OutputCellIterator it(charInfos);
+                storageBuffer.Write(it, target);
+            }
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
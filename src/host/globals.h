@@ -47,7 +47,7 @@ public:
 
     CONSOLE_INFORMATION& getConsoleInformation();
 
-    DeviceComm* pDeviceComm;
+    IDeviceComm* pDeviceComm;
 
     wil::unique_event_nothrow hInputEvent;
 
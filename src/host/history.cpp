@@ -29,19 +29,34 @@
 // If CommandHistory::s_Allocate and friends stop shuffling elements
 // for maintaining LRU, then this datatype can be changed.
 std::list<CommandHistory> CommandHistory::s_historyLists;
+std::unordered_map<HANDLE, CommandHistory*> CommandHistory::s_historiesByProcess;
+std::wstring CommandHistory::s_persistDirectory;
+
+// Saved histories are this header followed by each command, oldest first,
+// as its length in characters and then its text.
+struct HistoryFileHeader
+{
+    DWORD magic;
+    DWORD version;
+    DWORD count;
+};
+
+static constexpr DWORD s_historyFileMagic = 0x54534948; // "HIST"
+static constexpr DWORD s_historyFileVersion = 1;
+
+// Anything bigger than this isn't a history we wrote.
+static constexpr LONGLONG s_cbHistoryFileMax = 64 * 1024 * 1024;
 
 CommandHistory* CommandHistory::s_Find(const HANDLE processHandle)
 {
-    for (auto& historyList : s_historyLists)
+    const auto found = s_historiesByProcess.find(processHandle);
+    if (found == s_historiesByProcess.end())
     {
-        if (historyList._processHandle == processHandle)
-        {
-            FAIL_FAST_IF(WI_IsFlagClear(historyList.Flags, CLE_ALLOCATED));
-            return &historyList;
-        }
+        return nullptr;
     }
 
-    return nullptr;
+    FAIL_FAST_IF(WI_IsFlagClear(found->second->Flags, CLE_ALLOCATED));
+    return found->second;
 }
 
 // Routine Description:
@@ -53,11 +68,54 @@ void CommandHistory::s_Free(const HANDLE processHandle)
     CommandHistory* const History = CommandHistory::s_Find(processHandle);
     if (History)
     {
+        s_historiesByProcess.erase(processHandle);
+        LOG_IF_FAILED(History->_Save());
+
         WI_ClearFlag(History->Flags, CLE_ALLOCATED);
         History->_processHandle = nullptr;
     }
 }
 
+// Routine Description:
+// - Sets where command histories are saved when the process using them goes
+//   away, so they can be loaded again the next time the same app starts.
+// Arguments:
+// - directory - The directory to keep histories in. Empty turns saving off.
+void CommandHistory::s_SetPersistDirectory(const std::wstring_view directory)
+{
+    s_persistDirectory = directory;
+}
+
+// Routine Description:
+// - Turns on saving command histories to the current user's local app data.
+// Return Value:
+// - S_OK, or a relevant error if the directory couldn't be found or made.
+[[nodiscard]]
+HRESULT CommandHistory::s_EnablePersistence()
+{
+    try
+    {
+        std::wstring directory(MAX_PATH, UNICODE_NULL);
+        const DWORD cch = GetEnvironmentVariableW(L"LOCALAPPDATA", directory.data(), gsl::narrow<DWORD>(directory.size()));
+        RETURN_LAST_ERROR_IF(cch == 0);
+        RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_BUFFER_OVERFLOW), cch >= directory.size());
+        directory.resize(cch);
+
+        for (const auto subdirectory : { L"\\Microsoft", L"\\Console", L"\\History" })
+        {
+            directory += subdirectory;
+            if (!CreateDirectoryW(directory.c_str(), nullptr))
+            {
+                RETURN_LAST_ERROR_IF(GetLastError() != ERROR_ALREADY_EXISTS);
+            }
+        }
+
+        s_SetPersistDirectory(directory);
+        return S_OK;
+    }
+    CATCH_RETURN();
+}
+
 void CommandHistory::s_ResizeAll(const size_t commands)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -103,9 +161,7 @@ HRESULT CommandHistory::Add(const std::wstring_view newCommand,
     try
     {
         if (_commands.size() == 0 ||
-            _commands.back().size() != newCommand.size() ||
-            !std::equal(_commands.back().cbegin(), _commands.back().cbegin() + newCommand.size(),
-                        newCommand.cbegin(), newCommand.cend()))
+            _At(gsl::narrow<SHORT>(_commands.size() - 1)).text != newCommand)
         {
             std::wstring reuse{};
 
@@ -118,29 +174,26 @@ HRESULT CommandHistory::Add(const std::wstring_view newCommand,
                 }
             }
 
-            // find free record.  if all records are used, free the lru one.
+            // find free record.  if all records are used, the lru one is replaced.
             if ((SHORT)_commands.size() == _maxCommands)
             {
-                _commands.erase(_commands.cbegin());
                 // move LastDisplayed back one in order to stay synced with the
-                // command it referred to before erasing the lru one
+                // command it referred to before replacing the lru one
                 --LastDisplayed;
             }
 
             // add newCommand to array
             if (!reuse.empty())
             {
-                _commands.emplace_back(reuse);
+                _Push(reuse);
             }
             else
             {
-                _commands.emplace_back(newCommand);
+                _Push(newCommand);
             }
 
             if (LastDisplayed == -1 ||
-                _commands.at(LastDisplayed).size() != newCommand.size() ||
-                !std::equal(_commands.at(LastDisplayed).cbegin(), _commands.at(LastDisplayed).cbegin() + newCommand.size(),
-                            newCommand.cbegin(), newCommand.cend()))
+                _At(LastDisplayed).text != newCommand)
             {
                 _Reset();
             }
@@ -156,7 +209,7 @@ std::wstring_view CommandHistory::GetNth(const SHORT index) const
 {
     try
     {
-        return _commands.at(index);
+        return _At(index).text;
     }
     CATCH_LOG();
 
@@ -172,7 +225,7 @@ HRESULT CommandHistory::RetrieveNth(const SHORT index,
 
     try
     {
-        const auto& cmd = _commands.at(index);
+        const auto& cmd = _At(index).text;
         if (cmd.size() > (size_t)buffer.size())
         {
             commandSize = buffer.size(); // room for CRLF?
@@ -235,7 +288,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
     {
         try
         {
-            return _commands.at(LastDisplayed);
+            return _At(LastDisplayed).text;
         }
         CATCH_LOG();
     }
@@ -245,7 +298,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
 
 void CommandHistory::Empty()
 {
-    _commands.clear();
+    _ClearCommands();
     LastDisplayed = -1;
     Flags = CLE_RESET;
 }
@@ -279,13 +332,12 @@ void CommandHistory::Realloc(const size_t commands)
         return;
     }
 
-    const auto oldCommands = _commands;
-    const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
-
-    _commands.clear();
-    for (SHORT i = 0; i < newNumberOfCommands; i++)
+    // Keep the oldest commands that still fit.
+    _Unwrap();
+    while (_commands.size() > commands)
     {
-        _commands.emplace_back(oldCommands[i]);
+        _index.erase(_FindIndexEntry(_commands.back()));
+        _commands.pop_back();
     }
 
     WI_SetFlag(Flags, CLE_RESET);
@@ -299,11 +351,10 @@ void CommandHistory::s_ReallocExeToFront(const std::wstring_view appName, const
     {
         if (WI_IsFlagSet(it->Flags, CLE_ALLOCATED) && it->IsAppNameMatch(appName))
         {
-            CommandHistory backup = *it;
-            backup.Realloc(commands);
+            it->Realloc(commands);
 
-            s_historyLists.erase(it);
-            s_historyLists.push_front(backup);
+            // Splicing moves the history without copying it, so s_historiesByProcess stays valid.
+            s_historyLists.splice(s_historyLists.begin(), s_historyLists, it);
 
             return;
         }
@@ -338,19 +389,21 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     // Reuse a history buffer.  The buffer must be !CLE_ALLOCATED.
     // If possible, the buffer should have the same app name.
-    std::optional<CommandHistory> BestCandidate;
+    // Buffers are spliced to the front rather than copied there, so pointers
+    // to them (like the ones in s_historiesByProcess) stay valid.
+    CommandHistory* BestCandidate = nullptr;
     bool SameApp = false;
 
-    for (auto it = s_historyLists.cbegin(); it != s_historyLists.cend(); it++)
+    for (auto it = s_historyLists.begin(); it != s_historyLists.end(); it++)
     {
         if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
         {
             // use LRU history buffer with same app name
             if (it->IsAppNameMatch(appName))
             {
-                BestCandidate = *it;
+                s_historyLists.splice(s_historyLists.begin(), s_historyLists, it);
+                BestCandidate = &s_historyLists.front();
                 SameApp = true;
-                s_historyLists.erase(it);
                 break;
             }
         }
@@ -367,17 +420,21 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         History.LastDisplayed = -1;
         History._maxCommands = gsl::narrow<SHORT>(gci.GetHistoryBufferSize());
         History._processHandle = processHandle;
-        return &s_historyLists.emplace_front(History);
+        LOG_IF_FAILED(History._Load());
+
+        CommandHistory* const NewHistory = &s_historyLists.emplace_front(History);
+        s_historiesByProcess[processHandle] = NewHistory;
+        return NewHistory;
     }
-    else if (!BestCandidate.has_value() && s_historyLists.size() > 0)
+    else if (BestCandidate == nullptr && s_historyLists.size() > 0)
     {
         // If we have no candidate already and we need one, take the LRU (which is the back/last one) which isn't allocated.
-        for (auto it = s_historyLists.crbegin(); it != s_historyLists.crend(); it++)
+        for (auto it = s_historyLists.rbegin(); it != s_historyLists.rend(); it++)
         {
             if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
             {
-                BestCandidate = *it;
-                s_historyLists.erase(std::next(it).base()); // trickery to turn reverse iterator into forward iterator for erase.
+                s_historyLists.splice(s_historyLists.begin(), s_historyLists, std::next(it).base()); // trickery to turn reverse iterator into forward iterator for splice.
+                BestCandidate = &s_historyLists.front();
                 break;
             }
         }
@@ -385,19 +442,21 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     }
 
     // If the app name doesn't match, copy in the new app name and free the old commands.
-    if (BestCandidate.has_value())
+    if (BestCandidate != nullptr)
     {
         if (!SameApp)
         {
-            BestCandidate->_commands.clear();
+            BestCandidate->_ClearCommands();
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
+            LOG_IF_FAILED(BestCandidate->_Load());
         }
 
         BestCandidate->_processHandle = processHandle;
         WI_SetFlag(BestCandidate->Flags, CLE_ALLOCATED);
 
-        return &s_historyLists.emplace_front(BestCandidate.value());
+        s_historiesByProcess[processHandle] = BestCandidate;
+        return BestCandidate;
     }
 
     return nullptr;
@@ -468,11 +527,11 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
     try
     {
-        const auto str = _commands.at(iDel);
+        const auto str = _At(iDel).text;
 
         if (iDel < iLast)
         {
-            _commands.erase(_commands.cbegin() + iDel);
+            _Erase(iDel);
             if ((iDisp > iDel) && (iDisp <= iLast))
             {
                 _Dec(iDisp);
@@ -481,7 +540,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
         }
         else if (iFirst <= iDel)
         {
-            _commands.erase(_commands.cbegin() + iDel);
+            _Erase(iDel);
             if ((iDisp >= iFirst) && (iDisp < iDel))
             {
                 _Inc(iDisp);
@@ -529,20 +588,42 @@ bool CommandHistory::FindMatchingCommand(const std::wstring_view givenCommand,
 
     try
     {
-        for (size_t i = 0; i < _commands.size(); i++)
+        // Walking backwards from indexFound and wrapping around, the first
+        // match is the newest one that's no newer than indexFound, or failing
+        // that the newest one of all. Everything that starts with the given
+        // command sits together in the index, so only those are looked at.
+        const size_t startingId = _At(indexFound).id;
+
+        std::wstring foldedCommand;
+        s_Fold(givenCommand, foldedCommand);
+
+        std::optional<size_t> newestAtOrBefore;
+        std::optional<size_t> newest;
+        for (auto it = _index.lower_bound(foldedCommand);
+             it != _index.end() && it->first.compare(0, foldedCommand.size(), foldedCommand) == 0;
+             ++it)
         {
-            const auto& storedCommand = _commands.at(indexFound);
-            if ((WI_IsFlagClear(options, MatchOptions::ExactMatch) && (givenCommand.size() <= storedCommand.size())) || (givenCommand.size() == storedCommand.size()))
+            // Exact matches sort ahead of everything they're a prefix of.
+            if (WI_IsFlagSet(options, MatchOptions::ExactMatch) && it->first.size() != foldedCommand.size())
             {
-                if (std::equal(storedCommand.begin(), storedCommand.begin() + givenCommand.size(),
-                               givenCommand.begin(), givenCommand.end(),
-                               CaseInsensitiveEquality))
-                {
-                    return true;
-                }
+                break;
+            }
+
+            const size_t id = it->second;
+            if (id <= startingId && id >= newestAtOrBefore.value_or(0))
+            {
+                newestAtOrBefore = id;
+            }
+            if (id >= newest.value_or(0))
+            {
+                newest = id;
             }
+        }
 
-            _Prev(indexFound);
+        if (newest.has_value())
+        {
+            indexFound = _IndexOfId(newestAtOrBefore.value_or(newest.value()));
+            return true;
         }
     }
     CATCH_LOG();
@@ -553,6 +634,7 @@ bool CommandHistory::FindMatchingCommand(const std::wstring_view givenCommand,
 #ifdef UNIT_TESTING
 void CommandHistory::s_ClearHistoryListStorage()
 {
+    s_historiesByProcess.clear();
     s_historyLists.clear();
 }
 #endif
@@ -564,7 +646,321 @@ void CommandHistory::s_ClearHistoryListStorage()
 // - indexB - index of one history item to swap
 void CommandHistory::Swap(const short indexA, const short indexB)
 {
-    std::swap(_commands.at(indexA), _commands.at(indexB));
+    Command& commandA = _At(indexA);
+    Command& commandB = _At(indexB);
+    if (&commandA == &commandB)
+    {
+        return;
+    }
+
+    // The ids stay in their slots so that they keep growing from the oldest
+    // command to the newest. Only the text moves, and the index follows it.
+    const auto indexedA = _FindIndexEntry(commandA);
+    const auto indexedB = _FindIndexEntry(commandB);
+    std::swap(indexedA->second, indexedB->second);
+    std::swap(commandA.text, commandB.text);
+}
+
+// Routine Description:
+// - Gets a command by its index, oldest first, from the ring it's stored in.
+// Arguments:
+// - index - The index of the command
+// Return Value:
+// - The command. Throws if the index is out of range.
+const CommandHistory::Command& CommandHistory::_At(const SHORT index) const
+{
+    THROW_HR_IF(E_INVALIDARG, index < 0 || gsl::narrow_cast<size_t>(index) >= _commands.size());
+    return _commands[(_first + index) % _commands.size()];
+}
+
+CommandHistory::Command& CommandHistory::_At(const SHORT index)
+{
+    return const_cast<Command&>(static_cast<const CommandHistory* const>(this)->_At(index));
+}
+
+// Routine Description:
+// - Finds the index of the command that was given the id.
+// Arguments:
+// - id - The id of a command in the history
+// Return Value:
+// - The index of the command
+SHORT CommandHistory::_IndexOfId(const size_t id) const
+{
+    SHORT low = 0;
+    SHORT high = gsl::narrow<SHORT>(_commands.size());
+    while (low < high)
+    {
+        const SHORT middle = gsl::narrow_cast<SHORT>(low + (high - low) / 2);
+        if (_At(middle).id < id)
+        {
+            low = gsl::narrow_cast<SHORT>(middle + 1);
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    FAIL_FAST_IF(_At(low).id != id);
+    return low;
+}
+
+// Routine Description:
+// - Finds the entry in the index for a command in the history.
+// Arguments:
+// - command - A command in the history
+// Return Value:
+// - The command's entry in _index
+std::multimap<std::wstring, size_t>::iterator CommandHistory::_FindIndexEntry(const Command& command)
+{
+    std::wstring foldedCommand;
+    s_Fold(command.text, foldedCommand);
+
+    const auto range = _index.equal_range(foldedCommand);
+    const auto found = std::find_if(range.first, range.second, [&](const auto& entry) { return entry.second == command.id; });
+    FAIL_FAST_IF(found == range.second);
+    return found;
+}
+
+// Routine Description:
+// - Adds a command as the newest in the history. If the history is full, the
+//   oldest command's slot and index entry are reused for it.
+// Arguments:
+// - command - The command to add
+void CommandHistory::_Push(const std::wstring_view command)
+{
+    std::wstring foldedCommand;
+    s_Fold(command, foldedCommand);
+
+    const size_t id = _nextId;
+    if (_commands.size() < gsl::narrow_cast<size_t>(_maxCommands))
+    {
+        const auto indexed = _index.emplace(std::move(foldedCommand), id);
+        try
+        {
+            _commands.push_back({ std::wstring{ command }, id });
+        }
+        catch (...)
+        {
+            _index.erase(indexed);
+            throw;
+        }
+    }
+    else
+    {
+        Command& oldest = _commands.at(_first);
+        const auto indexed = _FindIndexEntry(oldest);
+        oldest.text.assign(command);
+
+        auto node = _index.extract(indexed);
+        node.key().swap(foldedCommand);
+        node.mapped() = id;
+        _index.insert(std::move(node));
+
+        oldest.id = id;
+        _first = (_first + 1) % _commands.size();
+    }
+
+    ++_nextId;
+}
+
+// Routine Description:
+// - Removes a command from the history.
+// Arguments:
+// - index - The index of the command to remove
+void CommandHistory::_Erase(const SHORT index)
+{
+    const auto indexed = _FindIndexEntry(_At(index));
+
+    _Unwrap();
+    _commands.erase(_commands.cbegin() + index);
+    _index.erase(indexed);
+}
+
+void CommandHistory::_ClearCommands() noexcept
+{
+    _commands.clear();
+    _index.clear();
+    _first = 0;
+}
+
+// Routine Description:
+// - Rotates the ring so the oldest command is in the first slot, for the
+//   operations that would rather deal with a plain array.
+void CommandHistory::_Unwrap()
+{
+    std::rotate(_commands.begin(), _commands.begin() + _first, _commands.end());
+    _first = 0;
+}
+
+// Routine Description:
+// - Lowercases a command the way commands are compared in the history.
+// Arguments:
+// - command - The command to lowercase
+// - folded - Receives the lowercased command
+void CommandHistory::s_Fold(const std::wstring_view command, std::wstring& folded)
+{
+    folded.resize(command.size());
+    std::transform(command.cbegin(), command.cend(), folded.begin(), [](const wchar_t wch) {
+        return static_cast<wchar_t>(::towlower(wch));
+    });
+}
+
+// Routine Description:
+// - Gets the file this history is saved to, if saving is turned on.
+// Arguments:
+// - path - Receives the path, or is left empty if the history isn't saved.
+// Return Value:
+// - S_OK, or E_INVALIDARG if the app name can't be used as a file name.
+[[nodiscard]]
+HRESULT CommandHistory::_GetPersistPath(std::wstring& path) const
+{
+    path.clear();
+    if (s_persistDirectory.empty() || _appName.empty())
+    {
+        return S_OK;
+    }
+
+    // The app name comes from the client, so only plain file names are used.
+    RETURN_HR_IF(E_INVALIDARG, _appName.find_first_of(L"\\/:*?\"<>|") != std::wstring::npos);
+    RETURN_HR_IF(E_INVALIDARG, _appName.find_first_not_of(L'.') == std::wstring::npos);
+
+    try
+    {
+        // App names match without regard to case, so their files do too.
+        std::wstring fileName;
+        s_Fold(_appName, fileName);
+
+        path = s_persistDirectory;
+        path += L'\\';
+        path += fileName;
+        path += L".history";
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Replaces the commands with the ones saved for this app, if there are any.
+// Return Value:
+// - S_OK if the history was loaded or there wasn't one, otherwise a relevant error.
+[[nodiscard]]
+HRESULT CommandHistory::_Load()
+{
+    std::wstring path;
+    RETURN_IF_FAILED(_GetPersistPath(path));
+    RETURN_HR_IF(S_OK, path.empty());
+
+    wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (!file)
+    {
+        const DWORD error = GetLastError();
+        RETURN_HR_IF(S_OK, error == ERROR_FILE_NOT_FOUND);
+        RETURN_WIN32(error);
+    }
+
+    LARGE_INTEGER cbFile;
+    RETURN_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &cbFile));
+    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA),
+                 cbFile.QuadPart < static_cast<LONGLONG>(sizeof(HistoryFileHeader)) || cbFile.QuadPart > s_cbHistoryFileMax);
+
+    wil::unique_handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    RETURN_LAST_ERROR_IF_NULL(mapping.get());
+
+    const BYTE* const pView = static_cast<const BYTE*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0));
+    RETURN_LAST_ERROR_IF_NULL(pView);
+    auto unmap = wil::scope_exit([&] { UnmapViewOfFile(pView); });
+
+    try
+    {
+        const size_t cbView = gsl::narrow<size_t>(cbFile.QuadPart);
+
+        HistoryFileHeader header;
+        memcpy(&header, pView, sizeof(header));
+        RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), header.magic != s_historyFileMagic || header.version != s_historyFileVersion);
+
+        // Check the whole file before anything is changed.
+        std::vector<std::wstring_view> commands;
+        size_t offset = sizeof(header);
+        for (DWORD i = 0; i < header.count; i++)
+        {
+            DWORD cch;
+            RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), cbView - offset < sizeof(cch));
+            memcpy(&cch, pView + offset, sizeof(cch));
+            offset += sizeof(cch);
+
+            RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), (cbView - offset) / sizeof(wchar_t) < cch);
+            if (cch > 0)
+            {
+                commands.emplace_back(reinterpret_cast<const wchar_t*>(pView + offset), cch);
+            }
+            offset += cch * sizeof(wchar_t);
+        }
+
+        _ClearCommands();
+        if (_maxCommands > 0)
+        {
+            for (const auto command : commands)
+            {
+                _Push(command);
+            }
+        }
+        _Reset();
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Saves the commands for the next time this app starts, if saving is turned on.
+// - The file is sized up front and written through a view of it.
+// Return Value:
+// - S_OK, or a relevant error if the file couldn't be written.
+[[nodiscard]]
+HRESULT CommandHistory::_Save() const
+{
+    std::wstring path;
+    RETURN_IF_FAILED(_GetPersistPath(path));
+    RETURN_HR_IF(S_OK, path.empty());
+
+    try
+    {
+        size_t cbFile = sizeof(HistoryFileHeader);
+        for (const auto& command : _commands)
+        {
+            RETURN_IF_FAILED(SizeTAdd(cbFile, sizeof(DWORD) + command.text.size() * sizeof(wchar_t), &cbFile));
+        }
+        RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE), cbFile > gsl::narrow<size_t>(s_cbHistoryFileMax));
+
+        wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        RETURN_LAST_ERROR_IF(!file);
+
+        wil::unique_handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READWRITE, 0, gsl::narrow<DWORD>(cbFile), nullptr) };
+        RETURN_LAST_ERROR_IF_NULL(mapping.get());
+
+        BYTE* const pView = static_cast<BYTE*>(MapViewOfFile(mapping.get(), FILE_MAP_WRITE, 0, 0, cbFile));
+        RETURN_LAST_ERROR_IF_NULL(pView);
+        auto unmap = wil::scope_exit([&] { UnmapViewOfFile(pView); });
+
+        const HistoryFileHeader header{ s_historyFileMagic, s_historyFileVersion, gsl::narrow<DWORD>(_commands.size()) };
+        memcpy(pView, &header, sizeof(header));
+
+        BYTE* pb = pView + sizeof(header);
+        for (SHORT i = 0; i < gsl::narrow<SHORT>(_commands.size()); i++)
+        {
+            const auto& text = _At(i).text;
+            const DWORD cch = gsl::narrow<DWORD>(text.size());
+            memcpy(pb, &cch, sizeof(cch));
+            pb += sizeof(cch);
+            memcpy(pb, text.data(), text.size() * sizeof(wchar_t));
+            pb += text.size() * sizeof(wchar_t);
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
 }
 
 // Routine Description:
@@ -26,6 +26,9 @@ public:
     static void s_Free(const HANDLE processHandle);
     static void s_ResizeAll(const size_t commands);
     static size_t s_CountOfHistories();
+    static void s_SetPersistDirectory(const std::wstring_view directory);
+    [[nodiscard]]
+    static HRESULT s_EnablePersistence();
 
     enum class MatchOptions
     {
@@ -86,15 +89,60 @@ private:
     void _Dec(SHORT& ind) const;
     void _Inc(SHORT& ind) const;
 
+    struct Command
+    {
+        std::wstring text;
+        size_t id;
+    };
+
+    Command& _At(const SHORT index);
+    const Command& _At(const SHORT index) const;
+    SHORT _IndexOfId(const size_t id) const;
+    std::multimap<std::wstring, size_t>::iterator _FindIndexEntry(const Command& command);
+    void _Push(const std::wstring_view command);
+    void _Erase(const SHORT index);
+    void _ClearCommands() noexcept;
+    void _Unwrap();
+
+    static void s_Fold(const std::wstring_view command, std::wstring& folded);
 
-    std::vector<std::wstring> _commands;
+    [[nodiscard]]
+    HRESULT _GetPersistPath(std::wstring& path) const;
+    [[nodiscard]]
+    HRESULT _Load();
+    [[nodiscard]]
+    HRESULT _Save() const;
+
+    // The commands are kept in a ring of up to _maxCommands slots, oldest
+    // first starting at _first. Once the ring is full, adding a command
+    // replaces the oldest one in place instead of shifting the rest down.
+    // _first is only ever nonzero while the ring is full.
+    std::vector<Command> _commands;
+    size_t _first = 0;
     SHORT _maxCommands;
 
+    // Every command is given an id when it's added. Ids only ever grow from
+    // the oldest command to the newest, so they can be turned back into an
+    // index by a binary search over the ring.
+    size_t _nextId = 0;
+
+    // The lowercased text of every command mapped to its id, so that
+    // FindMatchingCommand only has to look at the commands that match.
+    std::multimap<std::wstring, size_t> _index;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
     static std::list<CommandHistory> s_historyLists;
 
+    // The histories in use, by the process that they belong to. The histories
+    // themselves live in s_historyLists, which never moves its elements.
+    static std::unordered_map<HANDLE, CommandHistory*> s_historiesByProcess;
+
+    // Where histories are saved to when their process goes away and loaded
+    // from when the app starts again. Empty unless persistence is turned on.
+    static std::wstring s_persistDirectory;
+
 public:
     DWORD Flags;
     SHORT LastDisplayed;
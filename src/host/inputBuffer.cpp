@@ -13,6 +13,45 @@
 
 #define INPUT_BUFFER_DEFAULT_INPUT_MODE (ENABLE_LINE_INPUT | ENABLE_PROCESSED_INPUT | ENABLE_ECHO_INPUT | ENABLE_MOUSE_INPUT)
 
+// The most records a scratch vector keeps between calls. One that grew past
+// this for a big paste is released rather than held until the console exits.
+static constexpr size_t s_scratchRecordsKept = 64 * 1024;
+
+// Routine Description:
+// - Releases the memory of a scratch vector that grew past s_scratchRecordsKept.
+// Arguments:
+// - scratch - the scratch vector to trim
+// Return Value:
+// - <none>
+static void s_TrimScratch(std::vector<INPUT_RECORD>& scratch) noexcept
+{
+    if (scratch.capacity() > s_scratchRecordsKept)
+    {
+        std::vector<INPUT_RECORD>().swap(scratch);
+    }
+}
+
+// Routine Description:
+// - Checks that a record holds one of the event types the input buffer knows how to store.
+// Arguments:
+// - record - the record to check
+// Return Value:
+// - true if the record can be stored, false otherwise
+static bool s_IsKnownEventType(const INPUT_RECORD& record) noexcept
+{
+    switch (record.EventType)
+    {
+    case KEY_EVENT:
+    case MOUSE_EVENT:
+    case WINDOW_BUFFER_SIZE_EVENT:
+    case MENU_EVENT:
+    case FOCUS_EVENT:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // Routine Description:
 // - This method creates an input buffer.
 // Arguments:
@@ -209,17 +248,17 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event)
+    _storage.remove_if([](const INPUT_RECORD& record) noexcept
     {
-        return event->EventType() != InputEventType::KeyEvent;
+        return record.EventType != KEY_EVENT;
     });
-    _storage.erase(newEnd, _storage.end());
 }
 
 // Routine Description:
 // - This routine reads from the input buffer.
 // - It can convert returned data to through the currently set Input CP, it can optionally return a wait condition
 //   if there isn't enough data in the buffer, and it can be set to not remove records as it reads them out.
+// - This is a wrapper around the record based Read below for callers that work with IInputEvents.
 // Note:
 // - The console lock must be held when calling this routine.
 // Arguments:
@@ -252,11 +291,12 @@ NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEv
             return CONSOLE_STATUS_WAIT;
         }
 
-        // read from buffer
-        std::deque<std::unique_ptr<IInputEvent>> events;
+        // we can't read more events than are stored, even when AmountToRead asks for more.
+        _readScratch.resize(std::min(AmountToRead, _storage.size()));
+
         size_t eventsRead;
         bool resetWaitEvent;
-        _ReadBuffer(events,
+        _ReadBuffer(_readScratch,
                     AmountToRead,
                     eventsRead,
                     Peek,
@@ -264,12 +304,68 @@ NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEv
                     Unicode,
                     Stream);
 
-        // copy events to outEvents
-        while (!events.empty())
+        for (size_t i = 0; i < eventsRead; ++i)
         {
-            OutEvents.push_back(std::move(events.front()));
-            events.pop_front();
+            OutEvents.push_back(IInputEvent::Create(_readScratch[i]));
         }
+        s_TrimScratch(_readScratch);
+
+        if (resetWaitEvent)
+        {
+            ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
+        }
+        return STATUS_SUCCESS;
+    }
+    catch (...)
+    {
+        return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+    }
+}
+
+// Routine Description:
+// - This routine reads from the input buffer straight into a caller's array of records.
+// - It behaves like the IInputEvent version of Read, but doesn't allocate anything per event.
+// Note:
+// - The console lock must be held when calling this routine.
+// Arguments:
+// - records - where to store the read events. Its size is the amount of events to try to read.
+// - eventsRead - on exit, the number of records that were filled in
+// - Peek - If true, copy events to records but don't remove them from the input buffer.
+// - WaitForData - if true, wait until an event is input (if there aren't enough to fill client buffer). if false, return immediately
+// - Unicode - true if the data in key events should be treated as unicode. false if they should be converted by the current input CP.
+// - Stream - true if read should unpack KeyEvents that have a >1 repeat count. records must hold 1 record if Stream is true.
+// Return Value:
+// - STATUS_SUCCESS if records were read into the client buffer and everything is OK.
+// - CONSOLE_STATUS_WAIT if there weren't enough records to satisfy the request (and waits are allowed)
+// - otherwise a suitable memory/math/string error in NTSTATUS form.
+[[nodiscard]]
+NTSTATUS InputBuffer::Read(gsl::span<INPUT_RECORD> records,
+                           _Out_ size_t& eventsRead,
+                           const bool Peek,
+                           const bool WaitForData,
+                           const bool Unicode,
+                           const bool Stream)
+{
+    eventsRead = 0;
+    try
+    {
+        if (_storage.empty())
+        {
+            if (!WaitForData)
+            {
+                return STATUS_SUCCESS;
+            }
+            return CONSOLE_STATUS_WAIT;
+        }
+
+        bool resetWaitEvent;
+        _ReadBuffer(records,
+                    static_cast<size_t>(records.size()),
+                    eventsRead,
+                    Peek,
+                    resetWaitEvent,
+                    Unicode,
+                    Stream);
 
         if (resetWaitEvent)
         {
@@ -309,16 +405,17 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
     NTSTATUS Status;
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
-        Status = Read(outEvents,
-                      1,
+        INPUT_RECORD record;
+        size_t eventsRead;
+        Status = Read(gsl::span<INPUT_RECORD>{ &record, 1 },
+                      eventsRead,
                       Peek,
                       WaitForData,
                       Unicode,
                       Stream);
-        if (!outEvents.empty())
+        if (eventsRead > 0)
         {
-            outEvent.swap(outEvents.front());
+            outEvent = IInputEvent::Create(record);
         }
     }
     catch (...)
@@ -332,7 +429,8 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
 // Routine Description:
 // - This routine reads from a buffer. It does the buffer manipulation.
 // Arguments:
-// - outEvents - where read events are placed
+// - outRecords - where read events are placed. It must be able to hold at
+// least min(readCount, GetNumberOfReadyEvents()) records.
 // - readCount - amount of events to read
 // - eventsRead - where to store number of events read
 // - peek - if true , don't remove data from buffer, just copy it.
@@ -343,7 +441,7 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
 // - <none>
 // Note:
 // - The console lock must be held when calling this routine.
-void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+void InputBuffer::_ReadBuffer(gsl::span<INPUT_RECORD> outRecords,
                               const size_t readCount,
                               _Out_ size_t& eventsRead,
                               const bool peek,
@@ -356,118 +454,107 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
     FAIL_FAST_IF(streamRead && readCount != 1);
 
     resetWaitEvent = false;
+    eventsRead = 0;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
+    const size_t outSize = static_cast<size_t>(outRecords.size());
     // we need another var to keep track of how many we've read
     // because dbcs records count for two when we aren't doing a
     // unicode read but the eventsRead count should return the number
     // of events actually put into outRecords.
     size_t virtualReadCount = 0;
+    // when peeking we walk the stored events instead of removing them,
+    // so the storage is left exactly as it was.
+    size_t storageIndex = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    while (storageIndex < _storage.size() && virtualReadCount < readCount && eventsRead < outSize)
     {
-        bool performNormalRead = true;
+        INPUT_RECORD& stored = _storage[storageIndex];
+        INPUT_RECORD& record = outRecords[eventsRead];
+        record = stored;
+
         // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
+        if (streamRead &&
+            stored.EventType == KEY_EVENT &&
+            stored.Event.KeyEvent.wRepeatCount > 1)
         {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
+            record.Event.KeyEvent.wRepeatCount = 1;
+            if (!peek)
             {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
-                {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
-                }
+                --stored.Event.KeyEvent.wRepeatCount;
+            }
+            else
+            {
+                ++storageIndex;
             }
         }
-
-        if (performNormalRead)
+        else if (peek)
+        {
+            ++storageIndex;
+        }
+        else
         {
-            readEvents.push_back(std::move(_storage.front()));
             _storage.pop_front();
         }
 
+        ++eventsRead;
         ++virtualReadCount;
         if (!unicode)
         {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            if (record.EventType == KEY_EVENT &&
+                IsGlyphFullWidth(record.Event.KeyEvent.uChar.UnicodeChar))
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
-                {
-                    ++virtualReadCount;
-                }
+                ++virtualReadCount;
             }
         }
     }
 
-    // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
+    // signal if we emptied the buffer
+    if (_storage.empty())
     {
-        if (streamRead)
-        {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                                static_cast<const KeyEvent&>(*_storage.front())))
-            {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
-            else
-            {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
-            }
-        }
-        else
-        {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
-            {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
-            }
-        }
+        resetWaitEvent = true;
     }
+}
 
-    // move events read to proper deque
-    while (!readEvents.empty())
+// Routine Description:
+// -  Writes events to the beginning of the input buffer.
+// - This is a wrapper around the record based Prepend below for callers that work with IInputEvents.
+// Arguments:
+// - inEvents - events to write to buffer. It is emptied by this call.
+// Return Value:
+// - The number of events that were written to the input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
     {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        const std::vector<INPUT_RECORD> records = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Prepend(records);
     }
-
-    // signal if we emptied the buffer
-    if (_storage.empty())
+    catch (...)
     {
-        resetWaitEvent = true;
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
     }
 }
 
 // Routine Description:
 // -  Writes events to the beginning of the input buffer.
 // Arguments:
-// - inEvents - events to write to buffer.
-// - eventsWritten - The number of events written to the buffer on exit.
+// - records - events to write to buffer.
 // Return Value:
-// S_OK if successful.
+// - The number of events that were written to the input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
-size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+size_t InputBuffer::Prepend(const gsl::span<const INPUT_RECORD> records)
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        THROW_HR_IF(E_INVALIDARG, !std::all_of(records.begin(), records.end(), s_IsKnownEventType));
+
+        _HandleConsoleSuspensionEvents(records, _writeScratch);
+        if (_writeScratch.empty())
         {
             return STATUS_SUCCESS;
         }
@@ -476,23 +563,27 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // this way to handle any coalescing that might occur.
 
         // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        _prependScratch.resize(_storage.size());
+        for (size_t i = 0; i < _storage.size(); ++i)
+        {
+            _prependScratch[i] = _storage[i];
+        }
+        _storage.clear();
 
         // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
-        // However, because we swapped the storage out from under it with an empty deque, it will always
-        // return true after the first one (as it is filling the newly emptied backing deque.)
+        // However, because we emptied the storage out from under it, it will always
+        // return true after the first one (as it is filling the newly emptied storage.)
         // Then after the second one, because we've inserted some input, it will always say false.
         bool unusedWaitStatus = false;
 
         // write the prepend records
         size_t prependEventsWritten;
-        _WriteBuffer(inEvents, prependEventsWritten, unusedWaitStatus);
+        _WriteBuffer(_writeScratch, prependEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(unusedWaitStatus));
 
         // write all previously existing records
         size_t existingEventsWritten;
-        _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
+        _WriteBuffer(_prependScratch, existingEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(!unusedWaitStatus));
 
         // We need to set the wait event if there were 0 events in the
@@ -500,12 +591,14 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // Because we did interesting manipulation of the wait queue
         // in order to prepend, we can't trust what _WriteBuffer said
         // and instead need to set the event if the original backing
-        // buffer (the one we swapped out at the top) was empty
+        // buffer (the one we emptied at the top) was empty
         // when this whole thing started.
-        if (existingStorage.empty())
+        if (_prependScratch.empty())
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
+        s_TrimScratch(_writeScratch);
+        s_TrimScratch(_prependScratch);
         WakeUpReadersWaitingForData();
 
         return prependEventsWritten;
@@ -532,9 +625,9 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents;
-        inEvents.push_back(std::move(inEvent));
-        return Write(inEvents);
+        const INPUT_RECORD record = inEvent->ToInputRecord();
+        inEvent.reset();
+        return Write(gsl::span<const INPUT_RECORD>{ &record, 1 });
     }
     catch (...)
     {
@@ -546,8 +639,9 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 // Routine Description:
 // - Writes events to the input buffer. Wakes up any readers that are
 // waiting for additional input events.
+// - This is a wrapper around the record based Write below for callers that work with IInputEvents.
 // Arguments:
-// - inEvents - input events to store in the buffer.
+// - inEvents - input events to store in the buffer. It is emptied by this call.
 // Return Value:
 // - The number of events that were written to input buffer.
 // Note:
@@ -556,8 +650,34 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const std::vector<INPUT_RECORD> records = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Write(records);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes events to the input buffer. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - records - input events to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Write(const gsl::span<const INPUT_RECORD> records)
+{
+    try
+    {
+        THROW_HR_IF(E_INVALIDARG, !std::all_of(records.begin(), records.end(), s_IsKnownEventType));
+
+        _HandleConsoleSuspensionEvents(records, _writeScratch);
+        if (_writeScratch.empty())
         {
             return 0;
         }
@@ -565,7 +685,8 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
         // Write to buffer.
         size_t EventsWritten;
         bool SetWaitEvent;
-        _WriteBuffer(inEvents, EventsWritten, SetWaitEvent);
+        _WriteBuffer(_writeScratch, EventsWritten, SetWaitEvent);
+        s_TrimScratch(_writeScratch);
 
         if (SetWaitEvent)
         {
@@ -586,7 +707,7 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 // Routine Description:
 // - Coalesces input events and transfers them to storage queue.
 // Arguments:
-// - inRecords - The events to store.
+// - records - The events to store.
 // - eventsWritten - The number of events written since this function
 // was called.
 // - setWaitEvent - on exit, true if buffer became non-empty.
@@ -595,28 +716,29 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw on failure
-void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
+void InputBuffer::_WriteBuffer(const gsl::span<const INPUT_RECORD> records,
                                _Out_ size_t& eventsWritten,
                                _Out_ bool& setWaitEvent)
 {
     eventsWritten = 0;
     setWaitEvent = false;
     const bool initiallyEmptyQueue = _storage.empty();
-    const size_t initialInEventsSize = inEvents.size();
+    const size_t recordCount = static_cast<size_t>(records.size());
     const bool vtInputMode = IsInVirtualTerminalInputMode();
 
-    while(!inEvents.empty())
+    // grow the storage once up front instead of while appending.
+    _storage.reserve(_storage.size() + recordCount);
+
+    for (const INPUT_RECORD& record : records)
     {
-        // Pop the next event.
         // If we're in vt mode, try and handle it with the vt input module.
         // If it was handled, do nothing else for it.
         // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
         // If it's not coalesced, append it to the buffer.
-        std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (vtInputMode)
+        if (vtInputMode && record.EventType == KEY_EVENT)
         {
-            const bool handled = _termInput.HandleKey(inEvent.get());
+            const KeyEvent keyEvent{ record.Event.KeyEvent };
+            const bool handled = _termInput.HandleKey(&keyEvent);
             if (handled)
             {
                 eventsWritten++;
@@ -628,42 +750,19 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
         // record at a time because this is the original behavior of
         // the input buffer. Changing this behavior may break stuff
         // that was depending on it.
-        if (initialInEventsSize == 1 && !_storage.empty())
+        if (recordCount == 1 && !_storage.empty())
         {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
-
-            bool coalesced = false;
             // this looks kinda weird but we don't want to coalesce a
             // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
+            if (_CoalesceMouseMovedEvents(record) ||
+                _CoalesceRepeatedKeyPressEvents(record))
             {
                 eventsWritten = 1;
                 return;
             }
-            else
-            {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
-            }
         }
         // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
+        _storage.push_back(record);
         ++eventsWritten;
     }
     if (initiallyEmptyQueue && !_storage.empty())
@@ -673,42 +772,34 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
+// - Checks if the last saved event and the incoming record are
 // both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
-// dropped.
+// updated with the new mouse position and the incoming record
+// doesn't need to be stored.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - record - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceMouseMovedEvents(const INPUT_RECORD& record)
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
+    INPUT_RECORD& lastStored = _storage.back();
+    if (record.EventType == MOUSE_EVENT &&
+        lastStored.EventType == MOUSE_EVENT)
     {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
+        const MouseEvent inMouseEvent{ record.Event.MouseEvent };
+        const MouseEvent lastMouseEvent{ lastStored.Event.MouseEvent };
 
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
+        if (inMouseEvent.IsMouseMoveEvent() &&
+            lastMouseEvent.IsMouseMoveEvent())
         {
             // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastStored.Event.MouseEvent.dwMousePosition = record.Event.MouseEvent.dwMousePosition;
             return true;
         }
     }
@@ -741,44 +832,35 @@ bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexc
 }
 
 // Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// - If the last input event saved and the incoming record are
+// both a keypress down event for the same key, update the repeat
+// count of the saved event so the incoming record doesn't need to be stored.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - record - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& record)
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
-    {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
-
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+    INPUT_RECORD& lastStored = _storage.back();
+    if (record.EventType == KEY_EVENT &&
+        lastStored.EventType == KEY_EVENT)
+    {
+        const KeyEvent inKeyEvent{ record.Event.KeyEvent };
+        const KeyEvent lastKeyEvent{ lastStored.Event.KeyEvent };
+
+        if (inKeyEvent.IsKeyDown() &&
+            lastKeyEvent.IsKeyDown() &&
+            !IsGlyphFullWidth(inKeyEvent.GetCharData()) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastStored.Event.KeyEvent.wRepeatCount = lastKeyEvent.GetRepeatCount() + inKeyEvent.GetRepeatCount();
             return true;
         }
     }
@@ -789,41 +871,41 @@ bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique
 // - Handles records that suspend/resume the console.
 // Arguments:
 // - records - records to check for pause/unpause events
+// - outRecords - on exit, the records that should still be written to the buffer
 // Return Value:
 // - None
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw exception on error
-void InputBuffer::_HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+void InputBuffer::_HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> records,
+                                                 _Out_ std::vector<INPUT_RECORD>& outRecords)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    std::deque<std::unique_ptr<IInputEvent>> outEvents;
-    while (!inEvents.empty())
+    outRecords.clear();
+    outRecords.reserve(static_cast<size_t>(records.size()));
+    for (const INPUT_RECORD& record : records)
     {
-        std::unique_ptr<IInputEvent> currEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (currEvent->EventType() == InputEventType::KeyEvent)
+        if (record.EventType == KEY_EVENT)
         {
-            const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(currEvent.get());
-            if (pKeyEvent->IsKeyDown())
+            const KeyEvent keyEvent{ record.Event.KeyEvent };
+            if (keyEvent.IsKeyDown())
             {
                 if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
-                    !IsSystemKey(pKeyEvent->GetVirtualKeyCode()))
+                    !IsSystemKey(keyEvent.GetVirtualKeyCode()))
                 {
                     UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
                     continue;
                 }
-                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && pKeyEvent->IsPauseKey())
+                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && keyEvent.IsPauseKey())
                 {
                     WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
                     continue;
                 }
             }
         }
-        outEvents.push_back(std::move(currEvent));
+        outRecords.push_back(record);
     }
-    inEvents.swap(outEvents);
 }
 
 // Routine Description:
@@ -841,8 +923,7 @@ bool InputBuffer::IsInVirtualTerminalInputMode() const
 // - Handler for inserting key sequences into the buffer when the terminal emulation layer
 //   has determined a key can be converted appropriately into a sequence of inputs
 // Arguments:
-// - rgInput - Series of input records to insert into the buffer
-// - cInput - Length of input records array
+// - inEvents - Series of input events to insert into the buffer
 // Return Value:
 // - <none>
 void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInputEvent>>& inEvents)
@@ -850,12 +931,11 @@ void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInput
     try
     {
         // add all input events to the storage queue
-        while (!inEvents.empty())
+        for (const auto& inEvent : inEvents)
         {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-            inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
+            _storage.push_back(inEvent->ToInputRecord());
         }
+        inEvents.clear();
     }
     catch (...)
     {
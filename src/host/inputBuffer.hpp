@@ -20,6 +20,7 @@ Revision History:
 
 #include "inputReadHandleData.h"
 #include "readData.hpp"
+#include "inputEventQueue.hpp"
 #include "../types/inc/IInputEvent.hpp"
 
 #include "../server/ObjectHandle.h"
@@ -70,22 +71,38 @@ public:
                   const bool Unicode,
                   const bool Stream);
 
+    [[nodiscard]]
+    NTSTATUS Read(gsl::span<INPUT_RECORD> records,
+                  _Out_ size_t& eventsRead,
+                  const bool Peek,
+                  const bool WaitForData,
+                  const bool Unicode,
+                  const bool Stream);
 
     size_t Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t Prepend(const gsl::span<const INPUT_RECORD> records);
 
     size_t Write(_Inout_ std::unique_ptr<IInputEvent> inEvent);
     size_t Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t Write(const gsl::span<const INPUT_RECORD> records);
 
     bool IsInVirtualTerminalInputMode() const;
     Microsoft::Console::VirtualTerminal::TerminalInput& GetTerminalInput();
 
 private:
-    std::deque<std::unique_ptr<IInputEvent>> _storage;
+    InputEventQueue _storage;
     std::unique_ptr<IInputEvent> _readPartialByteSequence;
     std::unique_ptr<IInputEvent> _writePartialByteSequence;
     Microsoft::Console::VirtualTerminal::TerminalInput _termInput;
 
-    void _ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+    // Scratch space reused between calls so that reading and writing
+    // events doesn't have to allocate once the buffers are big enough.
+    // Any that grew unusually large is released after the call, see s_TrimScratch.
+    std::vector<INPUT_RECORD> _readScratch;
+    std::vector<INPUT_RECORD> _writeScratch;
+    std::vector<INPUT_RECORD> _prependScratch;
+
+    void _ReadBuffer(gsl::span<INPUT_RECORD> outRecords,
                      const size_t readCount,
                      _Out_ size_t& eventsRead,
                      const bool peek,
@@ -93,14 +110,15 @@ private:
                      const bool unicode,
                      const bool streamRead);
 
-    void _WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inRecords,
+    void _WriteBuffer(const gsl::span<const INPUT_RECORD> records,
                       _Out_ size_t& eventsWritten,
                       _Out_ bool& setWaitEvent);
 
     bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
-    bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    bool _CoalesceMouseMovedEvents(const INPUT_RECORD& record);
+    bool _CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& record);
+    void _HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> records,
+                                        _Out_ std::vector<INPUT_RECORD>& outRecords);
 
     void _HandleTerminalInputCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
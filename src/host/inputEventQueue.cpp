@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inputEventQueue.hpp"
+
+// The smallest ring we'll allocate. It's enough for a burst of typing without
+// growing again.
+static constexpr size_t s_minimumCapacity = 64;
+
+bool InputEventQueue::empty() const noexcept
+{
+    return _size == 0;
+}
+
+size_t InputEventQueue::size() const noexcept
+{
+    return _size;
+}
+
+size_t InputEventQueue::capacity() const noexcept
+{
+    return _ring.size();
+}
+
+INPUT_RECORD& InputEventQueue::front() noexcept
+{
+    return _ring[_head];
+}
+
+const INPUT_RECORD& InputEventQueue::front() const noexcept
+{
+    return _ring[_head];
+}
+
+INPUT_RECORD& InputEventQueue::back() noexcept
+{
+    return (*this)[_size - 1];
+}
+
+const INPUT_RECORD& InputEventQueue::back() const noexcept
+{
+    return (*this)[_size - 1];
+}
+
+INPUT_RECORD& InputEventQueue::operator[](const size_t index) noexcept
+{
+    return _ring[_Wrap(_head + index)];
+}
+
+const INPUT_RECORD& InputEventQueue::operator[](const size_t index) const noexcept
+{
+    return _ring[_Wrap(_head + index)];
+}
+
+// Routine Description:
+// - Makes sure the ring can hold the given number of events without growing.
+// Arguments:
+// - count - the number of events to make room for
+// Return Value:
+// - <none>
+// Note:
+// - will throw on failure to allocate
+void InputEventQueue::reserve(const size_t count)
+{
+    if (count > _ring.size())
+    {
+        _Grow(count);
+    }
+}
+
+// Routine Description:
+// - Adds an event to the back of the queue.
+// Arguments:
+// - record - the event to add
+// Return Value:
+// - <none>
+// Note:
+// - will throw on failure to allocate
+void InputEventQueue::push_back(const INPUT_RECORD& record)
+{
+    reserve(_size + 1);
+    _ring[_Wrap(_head + _size)] = record;
+    ++_size;
+}
+
+// Routine Description:
+// - Adds an event to the front of the queue.
+// Arguments:
+// - record - the event to add
+// Return Value:
+// - <none>
+// Note:
+// - will throw on failure to allocate
+void InputEventQueue::push_front(const INPUT_RECORD& record)
+{
+    reserve(_size + 1);
+    _head = _Wrap(_head + _ring.size() - 1);
+    _ring[_head] = record;
+    ++_size;
+}
+
+// Routine Description:
+// - Removes the event at the front of the queue. The queue must not be empty.
+// - If that empties the queue, the ring is shrunk back to its smallest size.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputEventQueue::pop_front() noexcept
+{
+    _head = _Wrap(_head + 1);
+    --_size;
+    if (_size == 0)
+    {
+        _Shrink();
+    }
+}
+
+// Routine Description:
+// - Removes all the events, and shrinks the ring back to its smallest size.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputEventQueue::clear() noexcept
+{
+    _size = 0;
+    _Shrink();
+}
+
+size_t InputEventQueue::_Wrap(const size_t index) const noexcept
+{
+    return index & (_ring.size() - 1);
+}
+
+// Routine Description:
+// - Moves the events into a bigger ring, that holds at least the given number
+//   of events. The events start at the beginning of the new ring.
+// Arguments:
+// - count - the number of events the new ring must be able to hold
+// Return Value:
+// - <none>
+// Note:
+// - will throw on failure to allocate
+void InputEventQueue::_Grow(const size_t count)
+{
+    size_t newCapacity = std::max(s_minimumCapacity, _ring.size() * 2);
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+
+    std::vector<INPUT_RECORD> newRing(newCapacity);
+    for (size_t i = 0; i < _size; ++i)
+    {
+        newRing[i] = (*this)[i];
+    }
+
+    _ring.swap(newRing);
+    _head = 0;
+}
+
+// Routine Description:
+// - Gives back the memory of a ring that grew past the smallest size, now that
+//   the queue is empty. The queue must be empty.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputEventQueue::_Shrink() noexcept
+{
+    _head = 0;
+    if (_ring.size() > s_minimumCapacity)
+    {
+        try
+        {
+            std::vector<INPUT_RECORD> newRing(s_minimumCapacity);
+            _ring.swap(newRing);
+        }
+        catch (...)
+        {
+            // If even the small ring can't be allocated, drop the ring
+            // entirely. The next event to be added will allocate one.
+            std::vector<INPUT_RECORD>().swap(_ring);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- inputEventQueue.hpp
+
+Abstract:
+- Storage for the input events waiting in the input buffer.
+- Events are kept by value, as INPUT_RECORDs, in one contiguous ring. The ring
+  grows as needed, so once it's big enough for the usual amount of input, adding
+  and removing events doesn't allocate anything. When the queue drains, a ring
+  that grew for a burst of input (like a big paste) shrinks back to its
+  smallest size, so that memory isn't held until the console exits.
+--*/
+
+#pragma once
+
+#include <vector>
+
+class InputEventQueue final
+{
+public:
+    InputEventQueue() = default;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    size_t capacity() const noexcept;
+
+    INPUT_RECORD& front() noexcept;
+    const INPUT_RECORD& front() const noexcept;
+    INPUT_RECORD& back() noexcept;
+    const INPUT_RECORD& back() const noexcept;
+    INPUT_RECORD& operator[](const size_t index) noexcept;
+    const INPUT_RECORD& operator[](const size_t index) const noexcept;
+
+    void reserve(const size_t count);
+    void push_back(const INPUT_RECORD& record);
+    void push_front(const INPUT_RECORD& record);
+    void pop_front() noexcept;
+    void clear() noexcept;
+
+    // Routine Description:
+    // - Removes every event the predicate returns true for, keeping the
+    //   order of the rest.
+    // Arguments:
+    // - pred - called with each event, returns true if it should be removed
+    // Return Value:
+    // - <none>
+    template<typename Predicate>
+    void remove_if(Predicate pred)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < _size; ++i)
+        {
+            const INPUT_RECORD& record = (*this)[i];
+            if (!pred(record))
+            {
+                (*this)[kept] = record;
+                ++kept;
+            }
+        }
+        _size = kept;
+        if (_size == 0)
+        {
+            _Shrink();
+        }
+    }
+
+private:
+    // The capacity of the ring is always zero or a power of two, so that
+    // an index can be wrapped around with a mask.
+    std::vector<INPUT_RECORD> _ring;
+    size_t _head = 0;
+    size_t _size = 0;
+
+    size_t _Wrap(const size_t index) const noexcept;
+    void _Grow(const size_t count);
+    void _Shrink() noexcept;
+};
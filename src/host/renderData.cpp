@@ -35,6 +35,16 @@ const TextBuffer& RenderData::GetTextBuffer() noexcept
     return gci.GetActiveOutputBuffer().GetTextBuffer();
 }
 
+// Routine Description:
+// - Tells which row of the text buffer the viewport's rows count from. Screen
+//   buffers don't archive rows, so this is always their own row 0.
+// Return Value:
+// - The retained index of the text buffer row that the viewport calls row 0
+size_t RenderData::GetBufferRowBase() noexcept
+{
+    return GetTextBuffer().ArchivedRowCount();
+}
+
 // Routine Description:
 // - Describes which font should be used for presenting text
 // Return Value:
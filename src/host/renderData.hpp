@@ -23,6 +23,7 @@ class RenderData final : public IRenderData
 public:
     Microsoft::Console::Types::Viewport GetViewport() noexcept override;
     const TextBuffer& GetTextBuffer() noexcept override;
+    size_t GetBufferRowBase() noexcept override;
     const FontInfo& GetFontInfo() noexcept override;
     const TextAttribute GetDefaultBrushColors() noexcept override;
 
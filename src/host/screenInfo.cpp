@@ -38,6 +38,7 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _textBuffer{ nullptr },
     Next{ nullptr },
     WriteConsoleDbcsLeadByte{ 0, 0 },
+    WriteConsoleTranslationBuffer{},
     FillOutDbcsLeadChar{ 0 },
     // LineChar initialized below.
     ConvScreenInfo{ nullptr },
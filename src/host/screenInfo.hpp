@@ -172,6 +172,8 @@ private:
 public:
     SCREEN_INFORMATION *Next;
     BYTE WriteConsoleDbcsLeadByte[2];
+    // Holds the text of WriteConsoleA calls converted to Unicode. Kept so every call doesn't allocate.
+    std::vector<wchar_t> WriteConsoleTranslationBuffer;
     BYTE FillOutDbcsLeadChar;
     WCHAR LineChar[6];
 #define UPPER_LEFT_CORNER   0
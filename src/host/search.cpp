@@ -10,6 +10,8 @@
 #include "../types/inc/Utf16Parser.hpp"
 #include "../types/inc/GlyphWidth.hpp"
 
+#include <future>
+
 // Routine Description:
 // - Constructs a Search object.
 // - Make a Search object then call .FindNext() to locate items.
@@ -30,6 +32,7 @@ Search::Search(const SCREEN_INFORMATION& screenInfo,
     _coordAnchor(s_GetInitialAnchor(screenInfo, direction))
 {
     _coordNext = _coordAnchor;
+    _PrepareNeedle();
 }
 
 // Routine Description:
@@ -54,10 +57,13 @@ Search::Search(const SCREEN_INFORMATION& screenInfo,
     _coordAnchor(anchor)
 {
     _coordNext = _coordAnchor;
+    _PrepareNeedle();
 }
 
 // Routine Description
 // - Locates the next instance of the search term within the screen buffer.
+// - Rows are searched a block at a time in the direction of the search, so a
+//   nearby match only costs the rows around it.
 // Arguments:
 // - <none> - Uses internal state from constructor
 // Return Value:
@@ -71,21 +77,83 @@ bool Search::FindNext()
         return false;
     }
 
-    do
+    const auto bufferSize = _screenInfo.GetBufferSize();
+    const size_t width = bufferSize.Width();
+    const size_t height = bufferSize.Height();
+    const size_t totalCells = width * height;
+    const bool forward = _direction == Direction::Forward;
+
+    // Every cell is measured by how many steps the search takes to get to it
+    // from _coordNext. The search stops short of the anchor, unless it started
+    // there, in which case it goes all the way around the buffer.
+    const auto cellIndex = [width](const COORD coord) {
+        return static_cast<size_t>(coord.Y) * width + static_cast<size_t>(coord.X);
+    };
+    const size_t nextIndex = cellIndex(_coordNext);
+    const auto stepsTo = [=](const size_t index) {
+        return forward ? (index + totalCells - nextIndex) % totalCells : (nextIndex + totalCells - index) % totalCells;
+    };
+    size_t limit = stepsTo(cellIndex(_coordAnchor));
+    if (limit == 0)
     {
-        if (_FindNeedleInHaystackAt(_coordNext, _coordSelStart, _coordSelEnd))
+        limit = totalCells;
+    }
+
+    // how far into its row _coordNext is, going in the direction of the search
+    const size_t stepsIntoRow = forward ? _coordNext.X : width - 1 - _coordNext.X;
+
+    Haystack haystack;
+    std::vector<std::pair<COORD, COORD>> matches;
+    std::optional<std::pair<COORD, COORD>> found;
+    size_t foundSteps = 0;
+    size_t rowsSearched = 0;
+    while (rowsSearched < height)
+    {
+        // Take the next block of rows in the direction of the search, stopping
+        // at the edge of the buffer so the block is contiguous.
+        const size_t row = forward ?
+            (_coordNext.Y + rowsSearched) % height :
+            (_coordNext.Y + height - rowsSearched) % height;
+        const size_t rowsLeft = std::min(s_FindNextRowsPerBlock, height - rowsSearched);
+        const size_t rowCount = std::min(rowsLeft, forward ? height - row : row + 1);
+        const size_t firstRow = forward ? row : row + 1 - rowCount;
+
+        matches.clear();
+        _FindInRows(gsl::narrow<SHORT>(firstRow),
+                    gsl::narrow<SHORT>(firstRow + rowCount - 1),
+                    haystack,
+                    matches);
+        for (const auto& match : matches)
         {
-            _UpdateNextPosition();
-            _reachedEnd = _coordNext == _coordAnchor;
-            return true;
+            const size_t steps = stepsTo(cellIndex(match.first));
+            if (steps < limit && (!found || steps < foundSteps))
+            {
+                found = match;
+                foundSteps = steps;
+            }
         }
-        else
+        rowsSearched += rowCount;
+
+        // Nothing in the rows still to come is closer than this.
+        if (found && foundSteps < rowsSearched * width - stepsIntoRow)
         {
-            _UpdateNextPosition();
+            break;
         }
+    }
 
-    } while (_coordNext != _coordAnchor);
+    if (found)
+    {
+        _coordSelStart = found->first;
+        _coordSelEnd = found->second;
+        _coordNext = _coordSelStart;
+        _UpdateNextPosition();
+        _reachedEnd = _coordNext == _coordAnchor;
+        return true;
+    }
 
+    _coordSelStart = { 0 };
+    _coordSelEnd = { 0 };
+    _coordNext = _coordAnchor;
     return false;
 }
 
@@ -123,6 +191,61 @@ std::pair<COORD, COORD> Search::GetFoundLocation() const noexcept
     return { _coordSelStart, _coordSelEnd };
 }
 
+// Routine Description:
+// - Finds every instance of the search term that starts within the given rows,
+//   for highlighting them all or counting them.
+// - A match may run on past lastRow, wrapping around the bottom of the buffer
+//   the same way FindNext does.
+// - Rows are only read, never inflated, so blocks of them can be searched on
+//   separate threads at once. The caller must hold the console lock throughout.
+// Arguments:
+// - firstRow - The first row to search
+// - lastRow - The last row to search, inclusive
+// - parallel - Whether to split large ranges across threads
+// Return Value:
+// - The [start, end] coord positions of each match, in buffer order
+std::vector<std::pair<COORD, COORD>> Search::FindAll(const SHORT firstRow,
+                                                     const SHORT lastRow,
+                                                     const bool parallel) const
+{
+    const auto bufferSize = _screenInfo.GetBufferSize();
+    THROW_HR_IF(E_INVALIDARG, firstRow < 0 || firstRow > lastRow || lastRow >= bufferSize.Height());
+
+    std::vector<std::pair<COORD, COORD>> matches;
+    const size_t rowCount = static_cast<size_t>(lastRow) - firstRow + 1;
+    const size_t blockCount = parallel ?
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), rowCount / s_MinRowsPerParallelBlock) :
+        1;
+
+    if (blockCount <= 1)
+    {
+        Haystack haystack;
+        _FindInRows(firstRow, lastRow, haystack, matches);
+        return matches;
+    }
+
+    std::vector<std::future<std::vector<std::pair<COORD, COORD>>>> blocks;
+    blocks.reserve(blockCount);
+    for (size_t block = 0; block < blockCount; ++block)
+    {
+        const auto blockFirst = gsl::narrow<SHORT>(firstRow + rowCount * block / blockCount);
+        const auto blockLast = gsl::narrow<SHORT>(firstRow + rowCount * (block + 1) / blockCount - 1);
+        blocks.emplace_back(std::async(std::launch::async, [this, blockFirst, blockLast]() {
+            Haystack haystack;
+            std::vector<std::pair<COORD, COORD>> blockMatches;
+            _FindInRows(blockFirst, blockLast, haystack, blockMatches);
+            return blockMatches;
+        }));
+    }
+
+    for (auto& block : blocks)
+    {
+        const auto blockMatches = block.get();
+        matches.insert(matches.end(), blockMatches.cbegin(), blockMatches.cend());
+    }
+    return matches;
+}
+
 // Routine Description:
 // - Finds the anchor position where we will start searches from.
 // - This position will represent the "wrap around" point in the buffer or where
@@ -164,72 +287,161 @@ COORD Search::s_GetInitialAnchor(const SCREEN_INFORMATION& screenInfo, const Dir
 }
 
 // Routine Description:
-// - Attempts to compare the search term (the needle) to the screen buffer (the haystack)
-//   at the given coordinate position of the screen buffer.
-// - Performs one comparison. Call again with new positions to check other spots.
-// Arguments:
-// - pos - The position in the haystack (screen buffer) to compare
-// - start - If we found it, this is filled with the coordinate of the first character of the needle.
-// - end - If we found it, this is filled with the coordinate of the last character of the needle.
-// Return Value:
-// - True if we found it. False if not.
-bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end) const
+// - Folds the search term (the needle) for our sensitivity and builds the
+//   Boyer-Moore-Horspool skip table for it. Done once, when the search is made.
+void Search::_PrepareNeedle()
 {
-    start = { 0 };
-    end = { 0 };
-
-    COORD bufferPos = pos;
-
-    for (const auto& needleCell : _needle)
+    for (const auto& cell : _needle)
     {
-        // Haystack is the buffer. Needle is the string we were given.
-        const auto hayIter = _screenInfo.GetTextDataAt(bufferPos);
-        const auto hayChars = *hayIter;
-        const auto needleChars = std::wstring_view(needleCell.data(), needleCell.size());
-
-        // If we didn't match at any point of the needle, return false.
-        if (!_CompareChars(hayChars, needleChars))
+        for (const auto wch : cell)
         {
-            return false;
+            _needleText.push_back(_ApplySensitivity(wch));
         }
-
-        _IncrementCoord(bufferPos);
     }
 
-    _DecrementCoord(bufferPos);
+    // The skip table says how far the needle can slide along when the haystack
+    // character under its last character is a given one. Characters share a
+    // slot by their low byte, so each slot keeps the shortest slide of any of
+    // them, which is always safe.
+    _skip.assign(256, _needleText.size());
+    for (size_t i = 0; i + 1 < _needleText.size(); ++i)
+    {
+        _skip[_needleText[i] & 0xFF] = _needleText.size() - 1 - i;
+    }
+}
 
-    // If we made it the whole way through the needle, then it was in the haystack.
-    // Fill out the span that we found the result at and return true.
-    start = pos;
-    end = bufferPos;
+// Routine Description:
+// - Appends the text of the cells of one row to the haystack, folded for our
+//   sensitivity. Each cell's text is exactly what GetTextDataAt gives for it,
+//   so both halves of a full-width glyph carry the glyph.
+// - Compact rows are read through their text, which doesn't inflate them.
+// Arguments:
+// - row - The row to read
+// - maxCells - How many cells of the row, from the left, to append
+// - haystack - The haystack to append to
+void Search::_AppendRowText(const ROW& row, const size_t maxCells, Haystack& haystack) const
+{
+    const CharRow& charRow = row.GetCharRow();
+    if (charRow.IsCompact())
+    {
+        const auto text = charRow.GetText();
+        const size_t cells = std::min(maxCells, text.size());
+        for (size_t column = 0; column < cells; ++column)
+        {
+            haystack.cellOffsets.push_back(haystack.text.size());
+            haystack.text.push_back(_ApplySensitivity(text[column]));
+        }
+        return;
+    }
 
-    return true;
+    const auto& unicodeStorage = charRow.GetUnicodeStorage();
+    size_t column = 0;
+    for (auto it = charRow.cbegin(); it != charRow.cend() && column < maxCells; ++it, ++column)
+    {
+        haystack.cellOffsets.push_back(haystack.text.size());
+        if (it->DbcsAttr().IsGlyphStored())
+        {
+            for (const auto wch : unicodeStorage.GetText(column))
+            {
+                haystack.text.push_back(_ApplySensitivity(wch));
+            }
+        }
+        else
+        {
+            haystack.text.push_back(_ApplySensitivity(it->Char()));
+        }
+    }
 }
 
 // Routine Description:
-// - Provides an abstraction for comparing two spans of text.
-// - Internally handles case sensitivity based on object construction.
+// - Finds every instance of the search term (the needle) that starts within
+//   the given rows of the screen buffer (the haystack).
+// - The rows are read into one span of text and searched with
+//   Boyer-Moore-Horspool. A match only counts if it starts and ends on cell
+//   boundaries and covers as many cells as the needle has, which is the same
+//   as comparing the needle to the buffer one cell at a time.
 // Arguments:
-// - one - String view representing the first string of text
-// - two - String view representing the second string of text
-// Return Value:
-// - True if they are the same. False otherwise.
-bool Search::_CompareChars(const std::wstring_view one, const std::wstring_view two) const
+// - firstRow - The first row to search
+// - lastRow - The last row to search, inclusive
+// - haystack - Scratch space for the text of the rows
+// - matches - Receives the [start, end] coord positions of each match, in buffer order
+void Search::_FindInRows(const SHORT firstRow,
+                         const SHORT lastRow,
+                         Haystack& haystack,
+                         std::vector<std::pair<COORD, COORD>>& matches) const
 {
-    if (one.size() != two.size())
+    const auto& textBuffer = _screenInfo.GetTextBuffer();
+    const auto bufferSize = _screenInfo.GetBufferSize();
+    const size_t width = bufferSize.Width();
+    const size_t height = bufferSize.Height();
+
+    haystack.text.clear();
+    haystack.cellOffsets.clear();
+    for (SHORT row = firstRow; row <= lastRow; ++row)
     {
-        return false;
+        _AppendRowText(textBuffer.GetRowByOffset(row), width, haystack);
+    }
+    const size_t rowCells = haystack.cellOffsets.size();
+
+    // A match that starts near the end of the last row runs on into the rows
+    // after it, wrapping around to the top of the buffer.
+    size_t spillCells = _needle.empty() ? 0 : _needle.size() - 1;
+    for (size_t row = static_cast<size_t>(lastRow) + 1; spillCells > 0; ++row)
+    {
+        const size_t cells = std::min(spillCells, width);
+        _AppendRowText(textBuffer.GetRowByOffset(row % height), cells, haystack);
+        spillCells -= cells;
+    }
+    haystack.cellOffsets.push_back(haystack.text.size());
+
+    const size_t needleLength = _needleText.size();
+    if (needleLength == 0 || needleLength > haystack.text.size())
+    {
+        return;
     }
 
-    for (size_t i = 0; i < one.size(); i++)
+    const auto offsetsBegin = haystack.cellOffsets.cbegin();
+    const wchar_t* const text = haystack.text.data();
+    const size_t lastStart = std::min(haystack.text.size() - needleLength, haystack.cellOffsets.at(rowCells));
+    const wchar_t needleLast = _needleText.back();
+    size_t offset = 0;
+    while (offset <= lastStart)
     {
-        if (_ApplySensitivity(one[i]) != _ApplySensitivity(two[i]))
+        const wchar_t hayLast = text[offset + needleLength - 1];
+        if (hayLast == needleLast &&
+            std::equal(_needleText.cbegin(), _needleText.cend() - 1, text + offset))
         {
-            return false;
+            const size_t cell = std::upper_bound(offsetsBegin, haystack.cellOffsets.cend(), offset) - offsetsBegin - 1;
+            const size_t endCell = cell + _needle.size();
+            if (cell < rowCells &&
+                haystack.cellOffsets.at(cell) == offset &&
+                endCell < haystack.cellOffsets.size() &&
+                haystack.cellOffsets.at(endCell) == offset + needleLength)
+            {
+                matches.push_back(_MakeMatch(static_cast<size_t>(firstRow) * width + cell));
+            }
         }
+        offset += _skip[hayLast & 0xFF];
     }
+}
+
+// Routine Description:
+// - Works out the span of the buffer covered by a match of the search term.
+// Arguments:
+// - cellIndex - The cell the match starts on, counting cells across each row
+//   from the top of the buffer
+// Return Value:
+// - pair containing [start, end] coord positions of the match
+std::pair<COORD, COORD> Search::_MakeMatch(const size_t cellIndex) const
+{
+    const auto bufferSize = _screenInfo.GetBufferSize();
+    const size_t width = bufferSize.Width();
+    const size_t totalCells = width * bufferSize.Height();
+    const size_t endIndex = (cellIndex + _needle.size() - 1) % totalCells;
 
-    return true;
+    const COORD start{ gsl::narrow<SHORT>(cellIndex % width), gsl::narrow<SHORT>(cellIndex / width) };
+    const COORD end{ gsl::narrow<SHORT>(endIndex % width), gsl::narrow<SHORT>(endIndex / width) };
+    return { start, end };
 }
 
 // Routine Description:
@@ -243,6 +455,11 @@ wchar_t Search::_ApplySensitivity(const wchar_t wch) const
 {
     if (_sensitivity == Sensitivity::CaseInsensitive)
     {
+        // Most of the buffer is ASCII, which doesn't need the CRT.
+        if (wch < 0x80)
+        {
+            return (wch >= L'A' && wch <= L'Z') ? static_cast<wchar_t>(wch + (L'a' - L'A')) : wch;
+        }
         return ::towlower(wch);
     }
     else
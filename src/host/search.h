@@ -52,11 +52,34 @@ public:
 
     std::pair<COORD, COORD> GetFoundLocation() const noexcept;
 
+    std::vector<std::pair<COORD, COORD>> FindAll(const SHORT firstRow,
+                                                 const SHORT lastRow,
+                                                 const bool parallel) const;
+
 private:
 
+    // The text of a block of buffer rows, laid out one cell after another
+    // and folded for the search's sensitivity.
+    struct Haystack
+    {
+        std::wstring text;
+        // where each cell's text starts in text, followed by text.size()
+        std::vector<size_t> cellOffsets;
+    };
+
+    // How many rows FindNext looks through at a time.
+    static constexpr size_t s_FindNextRowsPerBlock = 64;
+    // The fewest rows worth handing to a thread of their own in FindAll.
+    static constexpr size_t s_MinRowsPerParallelBlock = 1024;
+
     wchar_t _ApplySensitivity(const wchar_t wch) const;
-    bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end) const;
-    bool _CompareChars(const std::wstring_view one, const std::wstring_view two) const;
+    void _PrepareNeedle();
+    void _AppendRowText(const ROW& row, const size_t maxCells, Haystack& haystack) const;
+    void _FindInRows(const SHORT firstRow,
+                     const SHORT lastRow,
+                     Haystack& haystack,
+                     std::vector<std::pair<COORD, COORD>>& matches) const;
+    std::pair<COORD, COORD> _MakeMatch(const size_t cellIndex) const;
     void _UpdateNextPosition();
 
     void _IncrementCoord(COORD& coord) const;
@@ -72,6 +95,10 @@ private:
 
     const COORD _coordAnchor;
     const std::vector<std::vector<wchar_t>> _needle;
+    // the text of _needle's cells, folded for the search's sensitivity
+    std::wstring _needleText;
+    // Boyer-Moore-Horspool skip distances, indexed by the low byte of a character
+    std::vector<size_t> _skip;
     const Direction _direction;
     const Sensitivity _sensitivity;
     const SCREEN_INFORMATION& _screenInfo;
@@ -55,7 +55,8 @@ Settings::Settings() :
     _DefaultForeground(INVALID_COLOR),
     _DefaultBackground(INVALID_COLOR),
     _fUseDx(false),
-    _fCopyColor(false)
+    _fCopyColor(false),
+    _fHistoryPersist(false)
 {
     _dwScreenBufferSize.X = 80;
     _dwScreenBufferSize.Y = 25;
@@ -799,7 +800,7 @@ WORD Settings::GenerateLegacyAttributes(const TextAttribute attributes) const
 // The index in ColorTable of the nearest match to Color.
 WORD Settings::FindNearestTableIndex(const COLORREF Color) const
 {
-    return ::FindNearestTableIndex(Color, _ColorTable, ARRAYSIZE(_ColorTable));
+    return _colorQuantizer.FindNearestTableIndex(Color, _ColorTable, ARRAYSIZE(_ColorTable));
 }
 
 COLORREF Settings::GetCursorColor() const noexcept
@@ -946,3 +947,8 @@ bool Settings::GetCopyColor() const noexcept
 {
     return _fCopyColor;
 }
+
+bool Settings::GetHistoryPersist() const noexcept
+{
+    return _fHistoryPersist;
+}
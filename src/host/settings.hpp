@@ -184,6 +184,7 @@ public:
 
     bool GetUseDx() const noexcept;
     bool GetCopyColor() const noexcept;
+    bool GetHistoryPersist() const noexcept;
 
     COLORREF CalculateDefaultForeground() const noexcept;
     COLORREF CalculateDefaultBackground() const noexcept;
@@ -233,6 +234,7 @@ private:
     bool _fRenderGridWorldwide;
     bool _fUseDx;
     bool _fCopyColor;
+    bool _fHistoryPersist;
 
     COLORREF _XtermColorTable[XTERM_COLOR_TABLE_SIZE];
 
@@ -249,6 +251,10 @@ private:
     COLORREF _DefaultForeground;
     COLORREF _DefaultBackground;
     bool _TerminalScrolling;
+
+    // GenerateLegacyAttributes runs for every RGB attribute written through the
+    //      legacy APIs, so the nearest color lookups against _ColorTable are cached.
+    mutable ColorQuantizer _colorQuantizer;
     friend class RegistrySerialization;
 
 public:
@@ -514,7 +514,10 @@ NTSTATUS ConsoleAllocateConsole(PCONSOLE_API_CONNECTINFO p)
     {
         g.pRender = nullptr;
 
-        auto renderThread = std::make_unique<RenderThread>();
+        // Without a window, every frame goes out over the VT pipe, so pace
+        //      frames by how fast the other end reads them.
+        const FramePacing pacing = g.IsHeadless() ? FramePacing::Headless : FramePacing::Latency;
+        auto renderThread = std::make_unique<RenderThread>(pacing);
         // stash a local pointer to the thread here -
         // We're going to give ownership of the thread to the Renderer,
         //      but the thread also need to be told who it's renderer is,
@@ -8,16 +8,100 @@
 #include "CommonState.hpp"
 
 #include "ApiRoutines.h"
+#include "directio.h"
 #include "getset.h"
 #include "dbcs.h"
 #include "misc.h"
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 
+#include "..\..\server\ApiMessageBufferPool.h"
+#include "..\..\server\ApiSorter.h"
+#include "..\..\server\IDeviceComm.h"
+
+#include <chrono>
+
 using namespace Microsoft::Console::Types;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
 
+// Stands in for the console driver so API messages can be dispatched in-process.
+// Message payloads are read from a packet laid out like the one a client sends:
+// the message header, then the API descriptor, then the payload.
+class MemoryDeviceComm final : public IDeviceComm
+{
+public:
+    [[nodiscard]]
+    HRESULT SetServerInformation(_In_ CD_IO_SERVER_INFORMATION* const /*pServerInfo*/) const override
+    {
+        return S_OK;
+    }
+
+    [[nodiscard]]
+    HRESULT ReadIo(_In_opt_ CD_IO_COMPLETE* const /*pCompletion*/,
+                   _Out_ CONSOLE_API_MSG* const /*pMessage*/) const override
+    {
+        return E_NOTIMPL;
+    }
+
+    [[nodiscard]]
+    HRESULT CompleteIo(_In_ CD_IO_COMPLETE* const /*pCompletion*/) const override
+    {
+        return S_OK;
+    }
+
+    [[nodiscard]]
+    HRESULT ReadInput(_In_ CD_IO_OPERATION* const pIoOperation) const override
+    {
+        const size_t offset = pIoOperation->Buffer.Offset;
+        const size_t size = pIoOperation->Buffer.Size;
+        RETURN_HR_IF(E_INVALIDARG, offset > _packet.size() || size > _packet.size() - offset);
+
+        memcpy(pIoOperation->Buffer.Data, _packet.data() + offset, size);
+        return S_OK;
+    }
+
+    [[nodiscard]]
+    HRESULT WriteOutput(_In_ CD_IO_OPERATION* const pIoOperation) const override
+    {
+        _cbWritten += pIoOperation->Buffer.Size;
+        return S_OK;
+    }
+
+    [[nodiscard]]
+    HRESULT AllowUIAccess() const override
+    {
+        return S_OK;
+    }
+
+    // Routine Description:
+    // - Sets up the packet for a message and fills in its sizes.
+    // Arguments:
+    // - message - The message to prepare. Its header must already say which API it is.
+    // - payload - The bytes to send after the API descriptor.
+    // - cbOutput - The number of bytes the client can receive after the API descriptor.
+    void PrepareMessage(CONSOLE_API_MSG& message, const gsl::span<const BYTE> payload, const ULONG cbOutput)
+    {
+        const size_t cbHeader = sizeof(CONSOLE_MSG_HEADER) + message.msgHeader.ApiDescriptorSize;
+        _packet.assign(cbHeader, 0);
+        _packet.insert(_packet.end(), payload.begin(), payload.end());
+
+        message.Descriptor.Function = CONSOLE_IO_USER_DEFINED;
+        message.Descriptor.InputSize = gsl::narrow<ULONG>(_packet.size());
+        message.Descriptor.OutputSize = message.msgHeader.ApiDescriptorSize + cbOutput;
+        message._pDeviceComm = this;
+    }
+
+    size_t GetBytesWritten() const
+    {
+        return _cbWritten;
+    }
+
+private:
+    std::vector<BYTE> _packet;
+    mutable size_t _cbWritten = 0;
+};
+
 class ApiRoutinesTests
 {
     TEST_CLASS(ApiRoutinesTests);
@@ -471,6 +555,89 @@ class ApiRoutinesTests
         }
     }
 
+    TEST_METHOD(ApiWriteConsoleWMixedText)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        si.GetTextBuffer().GetCursor().SetPosition({ 0, 0 });
+
+        Log::Comment(L"Runs of ASCII broken up by a tab, a backspace, a newline and a non-ASCII character.");
+        const std::wstring testText(L"abc\tdef\bg\r\nh\x00e9ij");
+
+        size_t cchRead = 0;
+        std::unique_ptr<IWaitRoutine> waiter;
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleWImpl(si, testText, cchRead, waiter));
+        VERIFY_IS_NULL(waiter.get());
+        VERIFY_ARE_EQUAL(testText.size(), cchRead);
+
+        const std::wstring firstRow(L"abc     deg");
+        const std::wstring secondRow(L"h\x00e9ij");
+        VERIFY_ARE_EQUAL(firstRow, si.GetTextBuffer().GetRowByOffset(0).GetText().substr(0, firstRow.size()));
+        VERIFY_ARE_EQUAL(secondRow, si.GetTextBuffer().GetRowByOffset(1).GetText().substr(0, secondRow.size()));
+        VERIFY_ARE_EQUAL(COORD({ 4, 1 }), si.GetTextBuffer().GetCursor().GetPosition());
+    }
+
+    TEST_METHOD(ApiWriteConsolePerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        gci.OutputCP = CP_USA;
+        SetConsoleCPInfo(TRUE);
+
+        // A build log: mostly ASCII lines with the odd tab.
+        std::string text;
+        for (size_t line = 0; line < 2000; ++line)
+        {
+            text += "[12:34:56.789] ";
+            text += line % 10 == 0 ? "warning:\t" : "info:\t";
+            text += "compiled src/module" + std::to_string(line) + ".cpp in 42 ms\r\n";
+        }
+        const std::wstring wideText(text.cbegin(), text.cend());
+
+        const size_t iterations = 20;
+
+        const auto measure = [&](const wchar_t* const name, const size_t cb, auto&& write) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                write();
+            }
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Log::Comment(WEX::Common::String().Format(L"%s: %zu calls of %zu bytes, %.1f MB/s",
+                                                      name,
+                                                      iterations,
+                                                      cb,
+                                                      (iterations * cb) / elapsed / (1024 * 1024)));
+        };
+
+        measure(L"WriteConsoleW", wideText.size() * sizeof(wchar_t), [&]() {
+            size_t cchRead = 0;
+            std::unique_ptr<IWaitRoutine> waiter;
+            VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleWImpl(si, wideText, cchRead, waiter));
+            VERIFY_ARE_EQUAL(wideText.size(), cchRead);
+        });
+
+        measure(L"WriteConsoleA", text.size(), [&]() {
+            size_t cchRead = 0;
+            std::unique_ptr<IWaitRoutine> waiter;
+            VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleAImpl(si, text, cchRead, waiter));
+            VERIFY_ARE_EQUAL(text.size(), cchRead);
+        });
+    }
+
     void ValidateScreen(SCREEN_INFORMATION& si,
                         const CHAR_INFO background,
                         const CHAR_INFO fill,
@@ -854,4 +1021,292 @@ class ApiRoutinesTests
 
         ValidateComplexScreen(si, background, fill, scrollRect, Viewport::FromInclusive(scroll), destination, clipViewport);
     }
+
+    TEST_METHOD(ApiWriteReadConsoleOutputW)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        VERIFY_SUCCEEDED(si.GetTextBuffer().ResizeTraditional({ 10, 5 }), L"Make the buffer small so every cell can be checked.");
+        const auto bufferSize = si.GetBufferSize();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        CHAR_INFO background;
+        background.Char.UnicodeChar = L'Z';
+        background.Attributes = FOREGROUND_GREEN;
+        si.GetActiveBuffer().Write(OutputCellIterator(background), { 0, 0 });
+
+        Log::Comment(L"Write a 4x3 block that changes color every other column and hangs off the right of the buffer.");
+        const COORD blockSize{ 4, 3 };
+        std::vector<CHAR_INFO> block;
+        for (SHORT y = 0; y < blockSize.Y; ++y)
+        {
+            for (SHORT x = 0; x < blockSize.X; ++x)
+            {
+                CHAR_INFO cell;
+                cell.Char.UnicodeChar = static_cast<wchar_t>(L'a' + y * blockSize.X + x);
+                cell.Attributes = (x / 2) % 2 ? FOREGROUND_BLUE | BACKGROUND_RED : FOREGROUND_RED | FOREGROUND_INTENSITY;
+                block.push_back(cell);
+            }
+        }
+
+        const auto blockRectangle = Viewport::FromDimensions({ 8, 1 }, blockSize);
+        Viewport writtenRectangle;
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, block, blockRectangle, writtenRectangle));
+        VERIFY_ARE_EQUAL(Viewport::FromDimensions({ 8, 1 }, { 2, 3 }).ToInclusive(), writtenRectangle.ToInclusive());
+
+        Log::Comment(L"Read the whole buffer back. It should match the block where it was written, and what each cell holds.");
+        std::vector<CHAR_INFO> screen(bufferSize.Width() * bufferSize.Height());
+        Viewport readRectangle;
+        VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, screen, bufferSize, readRectangle));
+        VERIFY_ARE_EQUAL(bufferSize.ToInclusive(), readRectangle.ToInclusive());
+
+        for (SHORT y = 0; y < bufferSize.Height(); ++y)
+        {
+            for (SHORT x = 0; x < bufferSize.Width(); ++x)
+            {
+                const auto& actual = screen.at(y * bufferSize.Width() + x);
+                const CHAR_INFO expected = writtenRectangle.IsInBounds({ x, y }) ?
+                    block.at((y - blockRectangle.Top()) * blockSize.X + (x - blockRectangle.Left())) :
+                    background;
+                VERIFY_ARE_EQUAL(expected, actual);
+                VERIFY_ARE_EQUAL(gci.AsCharInfo(*si.GetTextBuffer().GetCellDataAt({ x, y })), actual);
+            }
+        }
+
+        Log::Comment(L"Read a rectangle hanging off the top left. Only the part inside the buffer should be filled in.");
+        CHAR_INFO untouched;
+        untouched.Char.UnicodeChar = L'?';
+        untouched.Attributes = BACKGROUND_BLUE;
+        std::vector<CHAR_INFO> corner(4 * 3, untouched);
+        VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, corner, Viewport::FromInclusive({ -1, -1, 2, 1 }), readRectangle));
+        VERIFY_ARE_EQUAL(Viewport::FromInclusive({ 0, 0, 2, 1 }).ToInclusive(), readRectangle.ToInclusive());
+        for (size_t i = 0; i < corner.size(); ++i)
+        {
+            const bool inside = i >= 4 && i % 4 != 0;
+            VERIFY_ARE_EQUAL(inside ? background : untouched, corner.at(i));
+        }
+
+        Log::Comment(L"Rectangles that start off the right or the bottom of the buffer can't be read, and the buffer given is left alone.");
+        const SMALL_RECT outside[] = {
+            { 10, 0, 12, 1 },
+            { 11, 0, 13, 1 },
+            { 0, 5, 2, 6 },
+            { 0, 6, 2, 7 },
+        };
+        for (const auto& rect : outside)
+        {
+            std::vector<CHAR_INFO> offEdge(3 * 2, untouched);
+            VERIFY_FAILED(_pApiRoutines->ReadConsoleOutputWImpl(si, offEdge, Viewport::FromInclusive(rect), readRectangle));
+            for (const auto& cell : offEdge)
+            {
+                VERIFY_ARE_EQUAL(untouched, cell);
+            }
+        }
+
+        Log::Comment(L"Rows with leading and trailing bytes are left for the cell at a time path.");
+        CHAR_INFO leading;
+        leading.Char.UnicodeChar = L'\x3042';
+        leading.Attributes = FOREGROUND_RED | COMMON_LVB_LEADING_BYTE;
+        CHAR_INFO trailing = leading;
+        trailing.Attributes = FOREGROUND_RED | COMMON_LVB_TRAILING_BYTE;
+        const CHAR_INFO dbcs[] = { leading, trailing };
+        VERIFY_IS_FALSE(si.GetTextBuffer().WriteCharInfoLine({ dbcs, ARRAYSIZE(dbcs) }, { 0, 4 }));
+        VERIFY_ARE_EQUAL(background, gci.AsCharInfo(*si.GetTextBuffer().GetCellDataAt({ 0, 4 })));
+    }
+
+    TEST_METHOD(ApiConsoleOutputRectPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        // A full screen program blitting and polling a whole 200x60 screen.
+        const COORD size{ 200, 60 };
+        VERIFY_SUCCEEDED(si.GetTextBuffer().ResizeTraditional(size));
+        const auto rectangle = Viewport::FromDimensions({ 0, 0 }, size);
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        // Panels and menus: the color changes every 8 columns.
+        std::vector<CHAR_INFO> frame;
+        frame.reserve(size.X * size.Y);
+        for (SHORT y = 0; y < size.Y; ++y)
+        {
+            for (SHORT x = 0; x < size.X; ++x)
+            {
+                CHAR_INFO cell;
+                cell.Char.UnicodeChar = static_cast<wchar_t>(L'!' + (x + y) % 94);
+                cell.Attributes = static_cast<WORD>(((x / 8) + y) % 0x100);
+                frame.push_back(cell);
+            }
+        }
+        std::vector<CHAR_INFO> readBack(frame.size());
+
+        const size_t iterations = 1000;
+        Viewport resultRectangle;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, frame, rectangle, resultRectangle));
+        }
+        const auto writeElapsed = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, readBack, rectangle, resultRectangle));
+        }
+        const auto readElapsed = std::chrono::steady_clock::now() - start;
+
+        const auto sameCell = [](const CHAR_INFO& a, const CHAR_INFO& b) {
+            return a.Char.UnicodeChar == b.Char.UnicodeChar && a.Attributes == b.Attributes;
+        };
+        VERIFY_IS_TRUE(std::equal(frame.cbegin(), frame.cend(), readBack.cbegin(), sameCell), L"The frame should read back the same as it was written.");
+
+        const auto nsPerCall = [&](const std::chrono::steady_clock::duration elapsed) {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        };
+        Log::Comment(WEX::Common::String().Format(L"WriteConsoleOutputW %dx%d: %.0f ns per call, %.2f ns per cell",
+                                                  size.X,
+                                                  size.Y,
+                                                  nsPerCall(writeElapsed),
+                                                  nsPerCall(writeElapsed) / frame.size()));
+        Log::Comment(WEX::Common::String().Format(L"ReadConsoleOutputW %dx%d: %.0f ns per call, %.2f ns per cell",
+                                                  size.X,
+                                                  size.Y,
+                                                  nsPerCall(readElapsed),
+                                                  nsPerCall(readElapsed) / frame.size()));
+    }
+
+    TEST_METHOD(ApiMessageBufferPoolReusesBuffers)
+    {
+        auto& pool = ApiMessageBufferPool::Instance();
+
+        Log::Comment(L"A buffer given back should be handed out again for any size in its class.");
+        BYTE* const pSmall = pool.Acquire(100);
+        VERIFY_IS_NOT_NULL(pSmall);
+        pool.Release(pSmall, 100);
+        BYTE* const pSameClass = pool.Acquire(ApiMessageBufferPool::s_cbSmallestClass);
+        VERIFY_ARE_EQUAL(pSmall, pSameClass);
+        pool.Release(pSameClass, ApiMessageBufferPool::s_cbSmallestClass);
+
+        Log::Comment(L"Buffers too large for every class still work, they just aren't kept.");
+        const ULONG cbHuge = ApiMessageBufferPool::s_cbSmallestClass << ApiMessageBufferPool::s_cClasses;
+        BYTE* const pHuge = pool.Acquire(cbHuge);
+        VERIFY_IS_NOT_NULL(pHuge);
+        pHuge[cbHuge - 1] = 0;
+        pool.Release(pHuge, cbHuge);
+
+        Log::Comment(L"Releasing nothing is fine.");
+        pool.Release(nullptr, 0);
+    }
+
+    TEST_METHOD(ApiDispatchPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        Log::Comment(L"Attaching this process as the client.");
+        ConsoleProcessHandle* pProcessData = nullptr;
+        VERIFY_SUCCEEDED(gci.ProcessHandleList.AllocProcessData(GetCurrentProcessId(), GetCurrentThreadId(), 0, nullptr, &pProcessData));
+        auto FreeProcess = wil::scope_exit([&] { gci.ProcessHandleList.FreeProcessData(pProcessData); });
+
+        Log::Comment(L"Opening a handle to a new screen buffer for the client to use.");
+        CONSOLE_API_MSG createMessage;
+        CD_CREATE_OBJECT_INFORMATION createInformation{};
+        createInformation.DesiredAccess = GENERIC_READ | GENERIC_WRITE;
+        createInformation.ShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE;
+        CONSOLE_CREATESCREENBUFFER_MSG createBuffer{};
+        createBuffer.Flags = CONSOLE_TEXTMODE_BUFFER;
+        std::unique_ptr<ConsoleHandleData> screenBufferHandle;
+        VERIFY_ARE_EQUAL(STATUS_SUCCESS, ConsoleCreateScreenBuffer(screenBufferHandle, &createMessage, &createInformation, &createBuffer));
+
+        SCREEN_INFORMATION* pScreenInfo = nullptr;
+        VERIFY_SUCCEEDED(screenBufferHandle->GetScreenBuffer(GENERIC_READ, &pScreenInfo));
+        const Viewport viewport = pScreenInfo->GetViewport();
+        const SMALL_RECT region = viewport.ToInclusive();
+        const ULONG cbRegion = gsl::narrow<ULONG>(viewport.Width() * viewport.Height() * sizeof(CHAR_INFO));
+
+        MemoryDeviceComm deviceComm;
+
+        CONSOLE_API_MSG templateMessage;
+        templateMessage._pApiRoutines = _pApiRoutines;
+        templateMessage.Descriptor.Process = reinterpret_cast<ULONG_PTR>(pProcessData);
+        templateMessage.Descriptor.Object = reinterpret_cast<ULONG_PTR>(screenBufferHandle.get());
+
+        // A line at a time, like a chatty program logging to the console.
+        const std::wstring line(L"The quick brown fox jumps over the lazy dog, then does it all again.\r\n");
+        const auto lineBytes = gsl::make_span(reinterpret_cast<const BYTE*>(line.data()), line.size() * sizeof(wchar_t));
+
+        CONSOLE_API_MSG writeMessage = templateMessage;
+        writeMessage.msgHeader.ApiNumber = ConsolepWriteConsole;
+        writeMessage.msgHeader.ApiDescriptorSize = sizeof(CONSOLE_WRITECONSOLE_MSG);
+        writeMessage.u.consoleMsgL1.WriteConsole.Unicode = TRUE;
+
+        // The whole viewport, like a full screen program polling what's displayed.
+        CONSOLE_API_MSG readMessage = templateMessage;
+        readMessage.msgHeader.ApiNumber = ConsolepReadConsoleOutput;
+        readMessage.msgHeader.ApiDescriptorSize = sizeof(CONSOLE_READCONSOLEOUTPUT_MSG);
+        readMessage.u.consoleMsgL2.ReadConsoleOutput.CharRegion = region;
+        readMessage.u.consoleMsgL2.ReadConsoleOutput.Unicode = TRUE;
+
+        const size_t iterations = 10000;
+
+        const auto dispatch = [](CONSOLE_API_MSG& message) {
+            PCONSOLE_API_MSG const pReply = ApiSorter::ConsoleDispatchRequest(&message);
+            VERIFY_ARE_EQUAL(&message, pReply, L"Message should complete without waiting.");
+            VERIFY_ARE_EQUAL(STATUS_SUCCESS, message.Complete.IoStatus.Status);
+            VERIFY_SUCCEEDED(message.ReleaseMessageBuffers());
+        };
+
+        Log::Comment(L"Dispatching WriteConsoleW.");
+        deviceComm.PrepareMessage(writeMessage, lineBytes, 0);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            CONSOLE_API_MSG message = writeMessage;
+            dispatch(message);
+            VERIFY_ARE_EQUAL(lineBytes.size(), static_cast<ptrdiff_t>(message.u.consoleMsgL1.WriteConsole.NumBytes));
+        }
+        const auto writeElapsed = std::chrono::steady_clock::now() - start;
+
+        Log::Comment(L"Dispatching ReadConsoleOutputW.");
+        deviceComm.PrepareMessage(readMessage, {}, cbRegion);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            CONSOLE_API_MSG message = readMessage;
+            dispatch(message);
+            VERIFY_ARE_EQUAL(region, message.u.consoleMsgL2.ReadConsoleOutput.CharRegion);
+        }
+        const auto readElapsed = std::chrono::steady_clock::now() - start;
+
+        VERIFY_ARE_EQUAL(iterations * cbRegion, deviceComm.GetBytesWritten(), L"Every read should have been written back to the client.");
+
+        const auto nsPerCall = [&](const std::chrono::steady_clock::duration elapsed) {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        };
+        Log::Comment(WEX::Common::String().Format(L"WriteConsoleW: %zu calls of %zu bytes, %.0f ns per call",
+                                                  iterations,
+                                                  static_cast<size_t>(lineBytes.size()),
+                                                  nsPerCall(writeElapsed)));
+        Log::Comment(WEX::Common::String().Format(L"ReadConsoleOutputW: %zu calls of %u bytes, %.0f ns per call",
+                                                  iterations,
+                                                  cbRegion,
+                                                  nsPerCall(readElapsed)));
+    }
 };
@@ -158,6 +158,30 @@ class ClipboardTests
         VERIFY_IS_NOT_NULL(ptr);
     }
 
+    TEST_METHOD(HtmlSpansFollowColorRuns)
+    {
+        const COLORREF red = RGB(0xff, 0x00, 0x00);
+        const COLORREF blue = RGB(0x00, 0x00, 0xff);
+        const COLORREF black = RGB(0x00, 0x00, 0x00);
+
+        Clipboard::HtmlBuilder builder;
+        VERIFY_IS_TRUE(builder.Finish().empty());
+
+        builder.AppendRun(L"ab", red, black);
+        builder.AppendRun(L"cd", red, black);
+        builder.AppendRun(L"", blue, black);
+        builder.AppendRun(L"ef", blue, black);
+        const std::string html = builder.Finish();
+
+        // one span for each change of color, closed before the next one opens
+        const std::string redSpan = R"X(<SPAN STYLE="color:#ff0000;background-color:#000000">abcd</SPAN>)X";
+        const std::string blueSpan = R"X(<SPAN STYLE="color:#0000ff;background-color:#000000">ef</SPAN>)X";
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find(redSpan + blueSpan));
+
+        VERIFY_ARE_EQUAL(0u, html.find("Version:0.9\r\n"));
+        VERIFY_ARE_EQUAL('\0', html.back());
+    }
+
     TEST_METHOD(CanConvertTextToInputEvents)
     {
         std::wstring wstr = L"hello world";
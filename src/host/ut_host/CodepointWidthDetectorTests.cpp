@@ -8,6 +8,8 @@
 
 #include "../types/inc/CodepointWidthDetector.hpp"
 
+#include <chrono>
+
 using namespace WEX::Logging;
 
 static const std::wstring emoji = L"\xD83E\xDD22"; // U+1F922 nauseated face
@@ -26,7 +28,11 @@ static const std::vector<std::tuple<unsigned int, std::wstring, CodepointWidth>>
     { 0x30CA, L"\x30CA", CodepointWidth::Wide }, // U+30CA katakana na
     { 0x72D7, L"\x72D7", CodepointWidth::Wide }, // U+72D7
     { 0x1F47E, L"\xD83D\xDC7E", CodepointWidth::Wide }, // U+1F47E alien monster
-    { 0x1F51C, L"\xD83D\xDD1C", CodepointWidth::Wide } // U+1F51C SOON
+    { 0x1F51C, L"\xD83D\xDD1C", CodepointWidth::Wide }, // U+1F51C SOON
+    { 0x20000, L"\xD840\xDC00", CodepointWidth::Wide }, // U+20000 first CJK extension B ideograph
+    { 0x2FFFD, L"\xD87F\xDFFD", CodepointWidth::Wide }, // U+2FFFD end of plane 2
+    { 0xF0000, L"\xDB80\xDC00", CodepointWidth::Ambiguous }, // U+F0000 first supplementary private use area-a codepoint
+    { 0xE0080, L"\xDB40\xDC80", CodepointWidth::Invalid } // U+E0080 unassigned
 };
 
 class CodepointWidthDetectorTests
@@ -34,32 +40,12 @@ class CodepointWidthDetectorTests
     TEST_CLASS(CodepointWidthDetectorTests);
 
 
-    TEST_METHOD(CodepointWidthDetectDefersMapPopulation)
-    {
-        CodepointWidthDetector widthDetector;
-        VERIFY_IS_TRUE(widthDetector._map.empty());
-        widthDetector.IsWide(UNICODE_SPACE);
-        VERIFY_IS_TRUE(widthDetector._map.empty());
-        // now force checking
-        widthDetector.GetWidth(emoji);
-        VERIFY_IS_FALSE(widthDetector._map.empty());
-    }
-
     TEST_METHOD(CanLookUpEmoji)
     {
         CodepointWidthDetector widthDetector;
         VERIFY_IS_TRUE(widthDetector.IsWide(emoji));
     }
 
-    TEST_METHOD(TestUnicodeRangeCompare)
-    {
-        CodepointWidthDetector::UnicodeRangeCompare compare;
-        // test comparing 2 search terms
-        CodepointWidthDetector::UnicodeRange a{ 0x10 };
-        CodepointWidthDetector::UnicodeRange b{ 0x15 };
-        VERIFY_IS_TRUE(static_cast<bool>(compare(a, b)));
-    }
-
     TEST_METHOD(CanExtractCodepoint)
     {
         CodepointWidthDetector widthDetector;
@@ -84,6 +70,13 @@ class CodepointWidthDetectorTests
         }
     }
 
+    TEST_METHOD(CodepointsOutsideUnicodeAreInvalid)
+    {
+        VERIFY_ARE_EQUAL(CodepointWidth::Narrow, CodepointWidthDetector::_lookupWidth(0x10FFFD)); // supplementary private use area-b
+        VERIFY_ARE_EQUAL(CodepointWidth::Invalid, CodepointWidthDetector::_lookupWidth(0x110000));
+        VERIFY_ARE_EQUAL(CodepointWidth::Invalid, CodepointWidthDetector::_lookupWidth(UINT_MAX));
+    }
+
     static bool FallbackMethod(const std::wstring_view glyph)
     {
         if (glyph.size() < 1)
@@ -103,22 +96,109 @@ class CodepointWidthDetectorTests
         widthDetector.SetFallbackMethod(std::bind(&FallbackMethod, std::placeholders::_1));
 
         // Ensure fallback cache is empty.
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.Size());
 
         // Lookup ambiguous width character.
         widthDetector.IsWide(ambiguous);
 
         // Cache should hold it.
-        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackCache.size());
+        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackCache.Size());
 
         // Cached item should match what we expect
-        const auto it = widthDetector._fallbackCache.begin();
-        VERIFY_ARE_EQUAL(ambiguous, it->first);
-        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), it->second);
+        bool isWide = false;
+        VERIFY_IS_TRUE(widthDetector._fallbackCache.TryGet(widthDetector._extractCodepoint(ambiguous), isWide));
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), isWide);
 
         // Cache should empty when font changes.
         widthDetector.NotifyFontChanged();
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.Size());
+    }
+
+    TEST_METHOD(AmbiguousCacheStaysBounded)
+    {
+        CodepointWidthDetector widthDetector;
+        size_t cFallbackCalls = 0;
+        widthDetector.SetFallbackMethod([&](const std::wstring_view glyph) {
+            ++cFallbackCalls;
+            return FallbackMethod(glyph);
+        });
+
+        // The supplementary private use area is ambiguous. Ask about far
+        //      more of it than the cache can hold.
+        for (unsigned int cp = 0xF0000; cp < 0xF0800; ++cp)
+        {
+            const wchar_t pair[] = { static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10)),
+                                     static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF)) };
+            const std::wstring_view glyph{ pair, ARRAYSIZE(pair) };
+            VERIFY_ARE_EQUAL(FallbackMethod(glyph), widthDetector.IsWide(glyph));
+            VERIFY_IS_LESS_THAN(widthDetector._fallbackCache.Size(), static_cast<size_t>(1024));
+        }
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0x800), cFallbackCalls);
+
+        // Once the cache has room again, answers are reused without asking twice.
+        for (wchar_t wch = 0x401; wch <= 0x451; ++wch)
+        {
+            VERIFY_ARE_EQUAL(FallbackMethod({ &wch, 1 }), widthDetector.IsWide(wch));
+        }
+        const auto cCallsBefore = cFallbackCalls;
+        for (wchar_t wch = 0x401; wch <= 0x451; ++wch)
+        {
+            widthDetector.IsWide(wch);
+        }
+        VERIFY_ARE_EQUAL(cCallsBefore, cFallbackCalls);
+    }
+
+    TEST_METHOD(LookupThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        std::wstring ascii;
+        for (wchar_t wch = 0x20; wch < 0x7F; ++wch)
+        {
+            ascii.push_back(wch);
+        }
+
+        std::wstring cjk;
+        for (wchar_t wch = 0x4E00; wch < 0x4E00 + 0x100; ++wch)
+        {
+            cjk.push_back(wch);
+        }
+
+        std::wstring emojis;
+        for (unsigned int cp = 0x1F300; cp < 0x1F400; ++cp)
+        {
+            emojis.push_back(static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10)));
+            emojis.push_back(static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+        }
+
+        const auto measure = [](_In_ PCWSTR const pwszName, const std::wstring& text, const size_t cchGlyph) {
+            CodepointWidthDetector widthDetector;
+            const size_t cIterations = 10000;
+            size_t cWide = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < cIterations; ++i)
+            {
+                for (size_t j = 0; j < text.size(); j += cchGlyph)
+                {
+                    cWide += widthDetector.IsWide({ text.data() + j, cchGlyph }) ? 1 : 0;
+                }
+            }
+            const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+            const size_t cLookups = cIterations * (text.size() / cchGlyph);
+            Log::Comment(String().Format(L"%s: %zu lookups (%zu wide), %.2f ns per lookup",
+                                         pwszName,
+                                         cLookups,
+                                         cWide,
+                                         elapsed / cLookups));
+        };
+
+        measure(L"ASCII", ascii, 1);
+        measure(L"CJK", cjk, 1);
+        measure(L"Emoji", emojis, 2);
     }
 
 };
@@ -9,6 +9,8 @@
 
 #include "search.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -241,6 +243,173 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(FindByProcessHandle)
+    {
+        const auto first = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        const auto second = CommandHistory::s_Allocate(_manyApps[1], _MakeHandle(1));
+        VERIFY_IS_NOT_NULL(first);
+        VERIFY_IS_NOT_NULL(second);
+
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(0)));
+        VERIFY_ARE_EQUAL(second, CommandHistory::s_Find(_MakeHandle(1)));
+        VERIFY_IS_NULL(CommandHistory::s_Find(_MakeHandle(2)));
+
+        Log::Comment(L"Moving a history to the front of the list shouldn't lose track of it.");
+        CommandHistory::s_ReallocExeToFront(_manyApps[0], 20);
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(0)));
+
+        CommandHistory::s_Free(_MakeHandle(0));
+        VERIFY_IS_NULL(CommandHistory::s_Find(_MakeHandle(0)));
+
+        Log::Comment(L"Coming back under another handle should find the same history under that handle.");
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(3)));
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(3)));
+    }
+
+    TEST_METHOD(FindMatchingCommandPrefix)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        Log::Comment(L"Overfill the history so the oldest commands have been replaced.");
+        for (const auto& item : _manyHistoryItems)
+        {
+            VERIFY_SUCCEEDED(history->Add(item, false));
+        }
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(L"dir /p /w"), String(history->GetNth(0).data()));
+
+        const auto options = CommandHistory::MatchOptions::JustLooking;
+        SHORT index;
+
+        Log::Comment(L"The newest match at or before the starting index is found, without regard to case.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"IPCONFIG", 9, index, options));
+        VERIFY_ARE_EQUAL(String(L"ipconfig /all"), String(history->GetNth(index).data()));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"ipconfig", 3, index, options));
+        VERIFY_ARE_EQUAL(String(L"ipconfig"), String(history->GetNth(index).data()));
+
+        Log::Comment(L"Failing that, it wraps around to the newest match.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"net", 1, index, options));
+        VERIFY_ARE_EQUAL(String(L"net"), String(history->GetNth(index).data()));
+
+        Log::Comment(L"An exact match has to be the whole command.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"Ipconfig", 9, index, options | CommandHistory::MatchOptions::ExactMatch));
+        VERIFY_ARE_EQUAL(String(L"ipconfig"), String(history->GetNth(index).data()));
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"ipconfig /a", 9, index, options | CommandHistory::MatchOptions::ExactMatch));
+
+        Log::Comment(L"Replaced commands are gone from the index.");
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"dir /w", 9, index, options));
+
+        Log::Comment(L"Swapped and removed commands are found where they are now.");
+        history->Swap(0, 9);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 9, index, options));
+        VERIFY_ARE_EQUAL(9, index);
+        VERIFY_ARE_EQUAL(String(L"git push"), String(history->Remove(0).c_str()));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 8, index, options));
+        VERIFY_ARE_EQUAL(8, index);
+    }
+
+    TEST_METHOD(PersistAcrossSessions)
+    {
+        wchar_t tempPath[MAX_PATH];
+        VERIFY_ARE_NOT_EQUAL(0ul, GetTempPathW(ARRAYSIZE(tempPath), tempPath));
+        std::wstring directory{ tempPath };
+        directory += L"HistoryTests";
+        VERIFY_IS_TRUE(CreateDirectoryW(directory.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS);
+
+        const std::wstring file{ directory + L"\\foo.exe.history" };
+        DeleteFileW(file.c_str());
+
+        CommandHistory::s_SetPersistDirectory(directory);
+        auto cleanup = wil::scope_exit([&] {
+            CommandHistory::s_SetPersistDirectory({});
+            DeleteFileW(file.c_str());
+            RemoveDirectoryW(directory.c_str());
+        });
+
+        Log::Comment(L"Fill a history and let its process go away.");
+        auto history = CommandHistory::s_Allocate(L"Foo.exe", _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        for (const auto& item : _manyHistoryItems)
+        {
+            VERIFY_SUCCEEDED(history->Add(item, false));
+        }
+        CommandHistory::s_Free(_MakeHandle(0));
+
+        std::vector<std::wstring> commandsStored;
+        for (SHORT i = 0; i < (SHORT)history->GetNumberOfCommands(); i++)
+        {
+            commandsStored.emplace_back(history->GetNth(i));
+        }
+
+        Log::Comment(L"Start over as if the console restarted, and the app's history should come back.");
+        CommandHistory::s_ClearHistoryListStorage();
+        history = CommandHistory::s_Allocate(L"FOO.EXE", _MakeHandle(1));
+        VERIFY_IS_NOT_NULL(history);
+        VERIFY_ARE_EQUAL(commandsStored.size(), history->GetNumberOfCommands());
+        for (SHORT i = 0; i < (SHORT)commandsStored.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(String(commandsStored[i].data()), String(history->GetNth(i).data()));
+        }
+        VERIFY_ARE_EQUAL(String(commandsStored.back().data()), String(history->GetLastCommand().data()));
+
+        Log::Comment(L"Other apps start out empty.");
+        history = CommandHistory::s_Allocate(_manyApps[1], _MakeHandle(2));
+        VERIFY_IS_NOT_NULL(history);
+        VERIFY_ARE_EQUAL(0ul, history->GetNumberOfCommands());
+    }
+
+    TEST_METHOD(AddAndFindPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        history->Realloc(SHORT_MAX);
+
+        const size_t commandCount = 100000;
+        std::vector<std::wstring> commands;
+        commands.reserve(commandCount);
+        for (size_t i = 0; i < commandCount; ++i)
+        {
+            commands.emplace_back(L"git checkout topic/" + std::to_wstring(i * 7919 % 100003));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& command : commands)
+        {
+            VERIFY_SUCCEEDED(history->Add(command, false));
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        VERIFY_ARE_EQUAL(static_cast<size_t>(SHORT_MAX), history->GetNumberOfCommands());
+        Log::Comment(WEX::Common::String().Format(L"Add: %zu commands into a history of %d, %.0f ns per command",
+                                                  commandCount,
+                                                  SHORT_MAX,
+                                                  elapsed * 1e9 / commandCount));
+
+        const size_t searchCount = 10000;
+        size_t found = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < searchCount; ++i)
+        {
+            const auto prefix = L"GIT CHECKOUT TOPIC/" + std::to_wstring(i * 13);
+            SHORT index;
+            if (history->FindMatchingCommand(prefix, history->LastDisplayed, index, CommandHistory::MatchOptions::JustLooking))
+            {
+                ++found;
+            }
+        }
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(WEX::Common::String().Format(L"FindMatchingCommand: %zu prefixes, %zu found, %.0f ns per search",
+                                                  searchCount,
+                                                  found,
+                                                  elapsed * 1e9 / searchCount));
+    }
+
 private:
 
     const std::array<std::wstring, 5> _manyApps =
@@ -9,6 +9,8 @@
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\types\inc\IInputEvent.hpp"
 
+#include <chrono>
+
 using namespace WEX::Logging;
 
 class InputBufferTests
@@ -77,7 +79,7 @@ class InputBufferTests
             INPUT_RECORD record;
             record.EventType = MENU_EVENT;
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back()->ToInputRecord());
+            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back());
         }
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
     }
@@ -97,7 +99,7 @@ class InputBufferTests
         // verify that the events are the same in storage
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i]->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i], record);
         }
     }
 
@@ -120,10 +122,9 @@ class InputBufferTests
         // check that they coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 1u);
         // check that the mouse position is being updated correctly
-        const IInputEvent* const pOutEvent = inputBuffer._storage.front().get();
-        const MouseEvent* const pMouseEvent = static_cast<const MouseEvent* const>(pOutEvent);
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
+        const MouseEvent mouseEvent{ inputBuffer._storage.front().Event.MouseEvent };
+        VERIFY_ARE_EQUAL(mouseEvent.GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
+        VERIFY_ARE_EQUAL(mouseEvent.GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
 
         // add a key event and another mouse event to make sure that
         // an event between two mouse events stopped the coalescing.
@@ -161,10 +162,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), mouseRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), mouseRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), mouseRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], mouseRecords[i]);
         }
     }
 
@@ -220,10 +221,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), keyRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), keyRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), keyRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], keyRecords[i]);
         }
     }
 
@@ -238,7 +239,7 @@ class InputBufferTests
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(inputBuffer._storage.back()->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage.back(), record);
         }
 
         // The events shouldn't be coalesced
@@ -381,10 +382,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read one record, make sure ResetWaitEvent isn't set
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords(RECORD_INSERT_COUNT);
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 1,
                                 eventsRead,
                                 false,
@@ -395,8 +396,7 @@ class InputBufferTests
         VERIFY_IS_FALSE(!!resetWaitEvent);
 
         // read the rest, resetWaitEvent should be set to true
-        outEvents.clear();
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 RECORD_INSERT_COUNT - 1,
                                 eventsRead,
                                 false,
@@ -430,10 +430,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read them out non-unicode style and compare
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords(recordInsertCount);
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 recordInsertCount,
                                 eventsRead,
                                 false,
@@ -443,10 +443,9 @@ class InputBufferTests
         // the dbcs record should have counted for two elements in
         // the array, making it so that we get less events read
         VERIFY_ARE_EQUAL(eventsRead, recordInsertCount - 1);
-        VERIFY_ARE_EQUAL(eventsRead, outEvents.size());
         for (size_t i = 0; i < eventsRead; ++i)
         {
-            VERIFY_ARE_EQUAL(outEvents[i]->ToInputRecord(), inRecords[i]);
+            VERIFY_ARE_EQUAL(outRecords[i], inRecords[i]);
         }
     }
 
@@ -588,22 +587,17 @@ class InputBufferTests
     {
         InputBuffer inputBuffer;
         INPUT_RECORD record = MakeKeyEvent(true, 1, L'a', 0, L'a', 0);
-        std::unique_ptr<IInputEvent> inputEvent = IInputEvent::Create(record);
         size_t eventsWritten;
         bool waitEvent = false;
         inputBuffer.Flush();
         // write one event to an empty buffer
-        std::deque<std::unique_ptr<IInputEvent>> storage;
-        storage.push_back(std::move(inputEvent));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer({ &record, 1 }, eventsWritten, waitEvent);
         VERIFY_IS_TRUE(waitEvent);
         // write another, it shouldn't signal this time
         INPUT_RECORD record2 = MakeKeyEvent(true, 1, L'b', 0, L'b', 0);
-        std::unique_ptr<IInputEvent> inputEvent2 = IInputEvent::Create(record2);
         // write another event to a non-empty buffer
         waitEvent = false;
-        storage.push_back(std::move(inputEvent2));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer({ &record2, 1 }, eventsWritten, waitEvent);
 
         VERIFY_IS_FALSE(waitEvent);
     }
@@ -624,7 +618,7 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount - 1);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount - 1);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
@@ -644,8 +638,128 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
+    TEST_METHOD(RecordsStayInOrderWhenStorageWrapsAndGrows)
+    {
+        Log::Comment(L"Events must come back out in the order they went in, even after the storage wraps around and grows");
+
+        InputBuffer inputBuffer;
+        WCHAR nextIn = 0x100;
+        WCHAR nextOut = 0x100;
+
+        const auto write = [&](const size_t count) {
+            std::vector<INPUT_RECORD> records;
+            for (size_t i = 0; i < count; ++i)
+            {
+                records.push_back(MakeKeyEvent(TRUE, 1, L'A', 0, nextIn++, 0));
+            }
+            VERIFY_ARE_EQUAL(inputBuffer.Write(records), count);
+        };
+
+        const auto read = [&](const size_t count) {
+            std::vector<INPUT_RECORD> records(count);
+            size_t eventsRead = 0;
+            VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(records, eventsRead, false, false, true, false));
+            VERIFY_ARE_EQUAL(eventsRead, count);
+            for (const auto& record : records)
+            {
+                VERIFY_ARE_EQUAL(record.Event.KeyEvent.uChar.UnicodeChar, nextOut++);
+            }
+        };
+
+        write(48);
+        read(40);
+        // the storage now starts part of the way into its memory, so these wrap around the end of it.
+        write(48);
+        read(8);
+        // and these don't fit anymore, so the storage has to grow while it's wrapped.
+        write(100);
+        read(148);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+
+        Log::Comment(L"Once a large write has been read back out, the memory it needed is given back");
+        write(100000);
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(inputBuffer._storage.capacity(), 100000u);
+        read(100000);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(inputBuffer._storage.capacity(), 64u);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(inputBuffer._writeScratch.capacity(), 64u * 1024u);
+
+        Log::Comment(L"and the storage still works after it shrinks");
+        write(10);
+        read(10);
+    }
+
+    TEST_METHOD(PasteThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // 1MB of UTF-16 text, pasted as a key down and key up for each character.
+        const size_t cchPaste = 1024 * 1024 / sizeof(wchar_t);
+        std::vector<INPUT_RECORD> pasteRecords;
+        pasteRecords.reserve(cchPaste * 2);
+        for (size_t i = 0; i < cchPaste; ++i)
+        {
+            const WCHAR wch = static_cast<WCHAR>(L' ' + (i % 95));
+            pasteRecords.push_back(MakeKeyEvent(TRUE, 1, 0, 0, wch, 0));
+            pasteRecords.push_back(MakeKeyEvent(FALSE, 1, 0, 0, wch, 0));
+        }
+
+        const size_t cReadChunk = 4096;
+
+        const auto report = [&](_In_ PCWSTR const pwszName, const double elapsed) {
+            Log::Comment(String().Format(L"%s: %zu events in %.2f ms, %.2f MB/s",
+                                         pwszName,
+                                         pasteRecords.size(),
+                                         elapsed,
+                                         (cchPaste * sizeof(wchar_t)) / (1024.0 * 1024.0) / (elapsed / 1000.0)));
+        };
+
+        {
+            InputBuffer inputBuffer;
+            const auto start = std::chrono::steady_clock::now();
+
+            std::deque<std::unique_ptr<IInputEvent>> inEvents = IInputEvent::Create(gsl::span<const INPUT_RECORD>(pasteRecords));
+            VERIFY_ARE_EQUAL(inputBuffer.Write(inEvents), pasteRecords.size());
+
+            size_t cRead = 0;
+            std::deque<std::unique_ptr<IInputEvent>> outEvents;
+            while (inputBuffer.GetNumberOfReadyEvents() > 0)
+            {
+                outEvents.clear();
+                VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outEvents, cReadChunk, false, false, true, false));
+                cRead += outEvents.size();
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            VERIFY_ARE_EQUAL(cRead, pasteRecords.size());
+            report(L"IInputEvent", elapsed);
+        }
+
+        {
+            InputBuffer inputBuffer;
+            const auto start = std::chrono::steady_clock::now();
+
+            VERIFY_ARE_EQUAL(inputBuffer.Write(pasteRecords), pasteRecords.size());
+
+            size_t cRead = 0;
+            std::vector<INPUT_RECORD> outRecords(cReadChunk);
+            while (inputBuffer.GetNumberOfReadyEvents() > 0)
+            {
+                size_t eventsRead = 0;
+                VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords, eventsRead, false, false, true, false));
+                cRead += eventsRead;
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            VERIFY_ARE_EQUAL(cRead, pasteRecords.size());
+            report(L"INPUT_RECORD", elapsed);
+        }
+    }
+
 };
@@ -8,9 +8,340 @@
 
 #include "..\..\host\renderData.hpp"
 #include "..\..\renderer\base\renderer.hpp"
+#include "..\..\renderer\vt\Xterm256Engine.hpp"
+#include "..\..\renderer\vt\XtermEngine.hpp"
+#include "..\..\renderer\inc\DummyRenderTarget.hpp"
+#include "..\..\renderer\inc\RenderEngineBase.hpp"
+
+#include <chrono>
 
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
+using namespace Microsoft::Console::Types;
+
+// A stand-in for the console's render data that presents a private text buffer
+// of any size, so frames can be painted without resizing the global screen buffer.
+class BufferOnlyRenderData final : public IRenderData
+{
+public:
+    BufferOnlyRenderData(const COORD size) :
+        _font(L"Consolas", 0, 0, { 8, 12 }, 0),
+        _buffer(size, TextAttribute{}, 12, _renderTarget)
+    {
+    }
+
+    TextBuffer& Buffer() noexcept
+    {
+        return _buffer;
+    }
+
+    Viewport GetViewport() noexcept override
+    {
+        return _buffer.GetSize();
+    }
+
+    const TextBuffer& GetTextBuffer() noexcept override
+    {
+        return _buffer;
+    }
+
+    size_t GetBufferRowBase() noexcept override
+    {
+        return _buffer.ArchivedRowCount();
+    }
+
+    const FontInfo& GetFontInfo() noexcept override
+    {
+        return _font;
+    }
+
+    const TextAttribute GetDefaultBrushColors() noexcept override
+    {
+        return {};
+    }
+
+    const COLORREF GetForegroundColor(const TextAttribute& attr) const noexcept override
+    {
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        return gci.LookupForegroundColor(attr);
+    }
+
+    const COLORREF GetBackgroundColor(const TextAttribute& attr) const noexcept override
+    {
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        return gci.LookupBackgroundColor(attr);
+    }
+
+    COORD GetCursorPosition() const noexcept override
+    {
+        return { 0, 0 };
+    }
+
+    bool IsCursorVisible() const noexcept override
+    {
+        return false;
+    }
+
+    bool IsCursorOn() const noexcept override
+    {
+        return false;
+    }
+
+    ULONG GetCursorHeight() const noexcept override
+    {
+        return 25;
+    }
+
+    CursorType GetCursorStyle() const noexcept override
+    {
+        return CursorType::Legacy;
+    }
+
+    ULONG GetCursorPixelWidth() const noexcept override
+    {
+        return 1;
+    }
+
+    COLORREF GetCursorColor() const noexcept override
+    {
+        return INVALID_COLOR;
+    }
+
+    bool IsCursorDoubleWidth() const noexcept override
+    {
+        return false;
+    }
+
+    const std::vector<RenderOverlay> GetOverlays() const noexcept override
+    {
+        return {};
+    }
+
+    const bool IsGridLineDrawingAllowed() noexcept override
+    {
+        return true;
+    }
+
+    std::vector<Viewport> GetSelectionRects() noexcept override
+    {
+        return {};
+    }
+
+    const std::wstring GetConsoleTitle() const noexcept override
+    {
+        return L"";
+    }
+
+    void LockConsole() noexcept override
+    {
+    }
+
+    void UnlockConsole() noexcept override
+    {
+    }
+
+private:
+    DummyRenderTarget _renderTarget;
+    FontInfo _font;
+    TextBuffer _buffer;
+};
+
+// A render engine that only keeps track of what was invalidated, and takes
+// time to "paint" a frame in proportion to the cells that were invalidated.
+// Invalidating and painting happen on different threads here, so unlike a real
+// engine, it locks around its dirty region itself.
+class TimedRenderEngine final : public RenderEngineBase
+{
+public:
+    TimedRenderEngine(const COORD size, const std::chrono::nanoseconds costPerCell) :
+        _size{ size },
+        _costPerCell{ costPerCell },
+        _invalid{ Viewport::Empty() },
+        _painting{ Viewport::Empty() }
+    {
+    }
+
+    HRESULT StartPaint() noexcept override
+    {
+        std::lock_guard<std::mutex> lock{ _lock };
+        if (!_invalid.IsValid())
+        {
+            return S_FALSE;
+        }
+        _painting = _invalid;
+        _invalid = Viewport::Empty();
+        return S_OK;
+    }
+
+    HRESULT EndPaint() noexcept override
+    {
+        const auto cost = _costPerCell * (_painting.Width() * _painting.Height());
+        const auto end = std::chrono::steady_clock::now() + cost;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            // Busy, like an engine that's really drawing.
+        }
+        _painting = Viewport::Empty();
+        return S_OK;
+    }
+
+    HRESULT Present() noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override
+    {
+        *pForcePaint = false;
+        return S_OK;
+    }
+
+    HRESULT ScrollFrame() noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override
+    {
+        _Invalidate(Viewport::FromExclusive(*psrRegion));
+        return S_OK;
+    }
+
+    HRESULT InvalidateCursor(const COORD* const pcoordCursor) noexcept override
+    {
+        _Invalidate(Viewport::FromCoord(*pcoordCursor));
+        return S_OK;
+    }
+
+    HRESULT InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept override
+    {
+        return InvalidateAll();
+    }
+
+    HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override
+    {
+        for (const auto& rect : rectangles)
+        {
+            _Invalidate(Viewport::FromInclusive(rect));
+        }
+        return S_OK;
+    }
+
+    HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override
+    {
+        return (pcoordDelta->X != 0 || pcoordDelta->Y != 0) ? InvalidateAll() : S_OK;
+    }
+
+    HRESULT InvalidateAll() noexcept override
+    {
+        _Invalidate(Viewport::FromDimensions({ 0, 0 }, _size));
+        return S_OK;
+    }
+
+    HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override
+    {
+        *pForcePaint = false;
+        return S_OK;
+    }
+
+    HRESULT PaintBackground() noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT PaintBufferLine(std::basic_string_view<Cluster> const /*clusters*/,
+                            const COORD /*coord*/,
+                            const bool /*fTrimLeft*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT PaintBufferGridLines(const GridLines /*lines*/,
+                                 const COLORREF /*color*/,
+                                 const size_t /*cchLine*/,
+                                 const COORD /*coordTarget*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT PaintSelection(const SMALL_RECT /*rect*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT PaintCursor(const CursorOptions& /*options*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT UpdateDrawingBrushes(const COLORREF /*colorForeground*/,
+                                 const COLORREF /*colorBackground*/,
+                                 const WORD /*legacyColorAttribute*/,
+                                 const bool /*isBold*/,
+                                 const bool /*isSettingDefaultBrushes*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT UpdateFont(const FontInfoDesired& /*FontInfoDesired*/,
+                       _Out_ FontInfo& /*FontInfo*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT UpdateDpi(const int /*iDpi*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT UpdateViewport(const SMALL_RECT /*srNewViewport*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    HRESULT GetProposedFont(const FontInfoDesired& /*FontInfoDesired*/,
+                            _Out_ FontInfo& /*FontInfo*/,
+                            const int /*iDpi*/) noexcept override
+    {
+        return S_OK;
+    }
+
+    SMALL_RECT GetDirtyRectInChars() override
+    {
+        return _painting.ToInclusive();
+    }
+
+    HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override
+    {
+        *pFontSize = { 1, 1 };
+        return S_OK;
+    }
+
+    HRESULT IsGlyphWideByFont(const std::wstring_view /*glyph*/, _Out_ bool* const pResult) noexcept override
+    {
+        *pResult = false;
+        return S_OK;
+    }
+
+protected:
+    HRESULT _DoUpdateTitle(const std::wstring& /*newTitle*/) noexcept override
+    {
+        return S_OK;
+    }
+
+private:
+    void _Invalidate(const Viewport& region) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ _lock };
+        _invalid = Viewport::Union(_invalid, region);
+    }
+
+    const COORD _size;
+    const std::chrono::nanoseconds _costPerCell;
+    std::mutex _lock;
+    Viewport _invalid;
+    Viewport _painting;
+};
 
 class RendererTests
 {
@@ -68,4 +399,450 @@ class RendererTests
     {
         m_renderer->TriggerTitleChange();
     }
+
+    TEST_METHOD(FramePacingDelays)
+    {
+        const size_t large = FrameScheduler::s_SmallInvalidationCells + 1;
+
+        Log::Comment(L"Latency pacing paints an isolated small change right away.");
+        FrameScheduler latency{ FramePacing::Latency, FrameScheduler::s_DefaultBudgetMilliseconds };
+        latency.NotifyInvalidated(1);
+        VERIFY_ARE_EQUAL(0ul, latency.GetPaintDelay());
+
+        Log::Comment(L"Right after a frame, small and large changes both wait at most a frame interval.");
+        latency.BeginFrame();
+        latency.EndFrame();
+        latency.NotifyInvalidated(1);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(latency.GetPaintDelay(), FrameScheduler::s_FrameIntervalMilliseconds);
+        latency.NotifyInvalidated(large);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(latency.GetPaintDelay(), FrameScheduler::s_FrameIntervalMilliseconds);
+
+        Log::Comment(L"Once the last frame is a frame interval old, a small change is painted right away again.");
+        latency.BeginFrame();
+        latency.EndFrame();
+        latency.NotifyInvalidated(1);
+        Sleep(FrameScheduler::s_FrameIntervalMilliseconds + 1);
+        VERIFY_ARE_EQUAL(0ul, latency.GetPaintDelay());
+
+        Log::Comment(L"Throughput pacing holds large changes back for at most the budget.");
+        FrameScheduler throughput{ FramePacing::Throughput, 20 };
+        throughput.BeginFrame();
+        throughput.EndFrame();
+        throughput.NotifyInvalidated(large);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(throughput.GetPaintDelay(), 20ul);
+
+        Log::Comment(L"Painting takes everything invalidated so far, and counts the frame.");
+        throughput.BeginFrame();
+        throughput.EndFrame();
+        throughput.NotifyInvalidated(1);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(throughput.GetPaintDelay(), FrameScheduler::s_FrameIntervalMilliseconds);
+        VERIFY_ARE_EQUAL(2u, throughput.GetStatistics().frames);
+
+        throughput.ResetStatistics();
+        VERIFY_ARE_EQUAL(0u, throughput.GetStatistics().frames);
+    }
+
+    TEST_METHOD(FramePacingLatencyAndThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const COORD size{ 120, 30 };
+        BufferOnlyRenderData data{ size };
+
+        const std::pair<const wchar_t*, FramePacing> pacings[] = {
+            { L"Latency", FramePacing::Latency },
+            { L"Throughput", FramePacing::Throughput },
+            { L"Headless", FramePacing::Headless },
+        };
+        for (const auto& pacing : pacings)
+        {
+            // Painting the whole screen costs about 3.6ms.
+            TimedRenderEngine engine{ size, std::chrono::microseconds(1) };
+            IRenderEngine* pEngine = &engine;
+
+            auto thread = std::make_unique<RenderThread>(pacing.second);
+            auto* const pThread = thread.get();
+            Renderer renderer(&data, &pEngine, 1, std::move(thread));
+            VERIFY_SUCCEEDED(pThread->Initialize(&renderer));
+            renderer.EnablePainting();
+
+            // Someone typing quickly: one cell changes every few milliseconds,
+            //      faster than the frame interval.
+            pThread->ResetFrameStatistics();
+            for (SHORT i = 0; i < 100; ++i)
+            {
+                renderer.TriggerRedraw(Viewport::FromCoord({ static_cast<SHORT>(i % size.X), 0 }));
+                Sleep(3);
+            }
+            Sleep(50);
+            const auto typing = pThread->GetFrameStatistics();
+
+            // A flood of output: the whole screen changes over and over.
+            pThread->ResetFrameStatistics();
+            const auto floodEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+            while (std::chrono::steady_clock::now() < floodEnd)
+            {
+                renderer.TriggerRedrawAll();
+                Sleep(0);
+            }
+            Sleep(50);
+            const auto flood = pThread->GetFrameStatistics();
+
+            // A spinner: a few cells rewritten in a tight loop. Every change
+            //      is small, but they mustn't be painted back to back.
+            pThread->ResetFrameStatistics();
+            const auto spinEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+            while (std::chrono::steady_clock::now() < spinEnd)
+            {
+                renderer.TriggerRedraw(Viewport::FromDimensions({ 0, 0 }, { 4, 1 }));
+                Sleep(0);
+            }
+            Sleep(50);
+            const auto spinner = pThread->GetFrameStatistics();
+
+            Log::Comment(String().Format(L"%s typing: %zu frames, latency %.2f ms average, %.2f ms max",
+                                         pacing.first,
+                                         typing.frames,
+                                         typing.averageLatencyMilliseconds,
+                                         typing.maxLatencyMilliseconds));
+            Log::Comment(String().Format(L"%s flood: %zu frames, %.1f paints per second, %.2f ms per frame, latency %.2f ms average, %.2f ms max",
+                                         pacing.first,
+                                         flood.frames,
+                                         flood.paintsPerSecond,
+                                         flood.averageFrameMilliseconds,
+                                         flood.averageLatencyMilliseconds,
+                                         flood.maxLatencyMilliseconds));
+            Log::Comment(String().Format(L"%s spinner: %zu frames, %.1f paints per second, latency %.2f ms average, %.2f ms max",
+                                         pacing.first,
+                                         spinner.frames,
+                                         spinner.paintsPerSecond,
+                                         spinner.averageLatencyMilliseconds,
+                                         spinner.maxLatencyMilliseconds));
+
+            // Frames start at least a frame interval after the last one ended.
+            //      Leave a little room for the first and last frame.
+            VERIFY_IS_LESS_THAN_OR_EQUAL(spinner.paintsPerSecond, 1.1 * 1000.0 / FrameScheduler::s_FrameIntervalMilliseconds);
+        }
+    }
+
+    TEST_METHOD(FullFrameRepaintThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        const COORD size{ 240, 80 };
+        BufferOnlyRenderData data{ size };
+
+        // Something like a colorized directory listing: every row has a handful
+        //      of attribute runs of varying lengths.
+        const TextAttribute plain{};
+        const TextAttribute blue{ FOREGROUND_BLUE | FOREGROUND_INTENSITY };
+        const TextAttribute green{ FOREGROUND_GREEN | BACKGROUND_BLUE };
+        for (SHORT row = 0; row < size.Y; ++row)
+        {
+            SHORT col = 0;
+            for (int run = 0; col < size.X; ++run)
+            {
+                const SHORT length = std::min(static_cast<SHORT>(6 + (row + run * 7) % 23), static_cast<SHORT>(size.X - col));
+                const std::wstring text(length, static_cast<wchar_t>(L'a' + (row + run) % 26));
+                const auto& attr = run % 3 == 0 ? plain : (run % 3 == 1 ? blue : green);
+                data.Buffer().WriteLine(OutputCellIterator(text, attr), { col, row });
+                col += length;
+            }
+        }
+
+        // The VT engine writes every frame to the null device, so all we're
+        //      timing is the renderer and the engine's formatting.
+        wil::unique_hfile hNull{ CreateFileW(L"NUL", GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        VERIFY_IS_TRUE(hNull.is_valid());
+
+        Xterm256Engine engine(std::move(hNull),
+                              gci,
+                              Viewport::FromDimensions({ 0, 0 }, size),
+                              gci.GetColorTable(),
+                              static_cast<WORD>(gci.GetColorTableSize()));
+        IRenderEngine* pEngine = &engine;
+        Renderer renderer(&data, &pEngine, 1, std::make_unique<RenderThread>());
+
+        // Paint one frame up front, so the first frame's setup isn't counted.
+        VERIFY_SUCCEEDED(engine.InvalidateAll());
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+
+        const size_t cFrames = 500;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < cFrames; ++i)
+        {
+            VERIFY_SUCCEEDED(engine.InvalidateAll());
+            VERIFY_SUCCEEDED(renderer.PaintFrame());
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(String().Format(L"%zu full repaints of %dx%d: %.3f ms per frame",
+                                     cFrames,
+                                     size.X,
+                                     size.Y,
+                                     elapsed / cFrames));
+    }
+
+    // Routine Description:
+    // - Runs a clock in a status bar at the top right of the screen while
+    //      someone types at the bottom, and counts the bytes the engine emits.
+    // Arguments:
+    // - engine - The VT engine to paint with. Its output is counted, not written.
+    // - data - The render data the engine paints from.
+    // - useBoundingBox - If true, invalidate one rectangle around both changes
+    //      each frame instead of the two changes themselves.
+    // Return Value:
+    // - The number of bytes the engine wrote for all the frames.
+    size_t _CountStatusBarAndTypingBytes(VtEngine& engine, BufferOnlyRenderData& data, const bool useBoundingBox)
+    {
+        size_t cbWritten = 0;
+        engine.SetTestCallback([&](const char* const /*pch*/, size_t const cch) {
+            cbWritten += cch;
+            return true;
+        });
+
+        IRenderEngine* pEngine = &engine;
+        Renderer renderer(&data, &pEngine, 1, std::make_unique<RenderThread>());
+
+        const COORD size = data.Buffer().GetSize().Dimensions();
+
+        // Get the first frame, which paints everything, out of the way.
+        VERIFY_SUCCEEDED(engine.InvalidateAll());
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+        cbWritten = 0;
+
+        const SHORT cchClock = 8;
+        const SHORT clockLeft = static_cast<SHORT>(size.X - cchClock);
+        const SHORT promptRow = static_cast<SHORT>(size.Y - 1);
+        const SHORT promptLeft = 2;
+        for (SHORT i = 0; i < size.X - promptLeft; ++i)
+        {
+            // Tick the clock...
+            wchar_t clock[cchClock + 1];
+            swprintf_s(clock, L"12:%02d:%02d", (i / 60) % 60, i % 60);
+            data.Buffer().WriteLine(OutputCellIterator(std::wstring_view{ clock, cchClock }), { clockLeft, 0 });
+            SMALL_RECT clockRegion{ clockLeft, 0, size.X, 1 };
+
+            // ... and type one more character at the prompt.
+            const SHORT typedColumn = static_cast<SHORT>(promptLeft + i);
+            data.Buffer().WriteLine(OutputCellIterator(std::wstring_view{ L"x", 1 }), { typedColumn, promptRow });
+            SMALL_RECT typedRegion{ typedColumn, promptRow, static_cast<SHORT>(typedColumn + 1), size.Y };
+
+            if (useBoundingBox)
+            {
+                SMALL_RECT bounding{ typedColumn, 0, size.X, size.Y };
+                VERIFY_SUCCEEDED(engine.Invalidate(&bounding));
+            }
+            else
+            {
+                VERIFY_SUCCEEDED(engine.Invalidate(&clockRegion));
+                VERIFY_SUCCEEDED(engine.Invalidate(&typedRegion));
+            }
+
+            VERIFY_SUCCEEDED(renderer.PaintFrame());
+        }
+
+        return cbWritten;
+    }
+
+    TEST_METHOD(StatusBarAndTypingByteCount)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const COORD size{ 120, 30 };
+        const size_t cFrames = size.X - 2;
+
+        // Put some text on every row, so repainting a row costs something.
+        BufferOnlyRenderData data{ size };
+        for (SHORT row = 0; row < size.Y; ++row)
+        {
+            const std::wstring text(size.X, static_cast<wchar_t>(L'a' + row % 26));
+            data.Buffer().WriteLine(OutputCellIterator(text), { 0, row });
+        }
+
+        for (const bool useBoundingBox : { false, true })
+        {
+            Xterm256Engine xterm256(wil::unique_hfile(INVALID_HANDLE_VALUE),
+                                    gci,
+                                    Viewport::FromDimensions({ 0, 0 }, size),
+                                    gci.GetColorTable(),
+                                    static_cast<WORD>(gci.GetColorTableSize()));
+            const auto cb256 = _CountStatusBarAndTypingBytes(xterm256, data, useBoundingBox);
+
+            XtermEngine xterm(wil::unique_hfile(INVALID_HANDLE_VALUE),
+                              gci,
+                              Viewport::FromDimensions({ 0, 0 }, size),
+                              gci.GetColorTable(),
+                              static_cast<WORD>(gci.GetColorTableSize()),
+                              false);
+            const auto cbXterm = _CountStatusBarAndTypingBytes(xterm, data, useBoundingBox);
+
+            Log::Comment(String().Format(L"%s: Xterm256Engine %zu bytes (%.1f per frame), XtermEngine %zu bytes (%.1f per frame)",
+                                         useBoundingBox ? L"One bounding rectangle" : L"Separate regions",
+                                         cb256,
+                                         static_cast<double>(cb256) / cFrames,
+                                         cbXterm,
+                                         static_cast<double>(cbXterm) / cFrames));
+        }
+    }
+
+    // Routine Description:
+    // - Replays a full screen TUI session, where the application redraws the
+    //      whole screen every frame but only a few cells actually change, and
+    //      counts the bytes the engine emits.
+    // Arguments:
+    // - data - The render data the engine paints from.
+    // - cFrames - The number of frames in the session.
+    // - drawFrame - Writes one frame of the session into the buffer.
+    // - forgetLastFrame - If true, invalidate everything with InvalidateAll,
+    //      which makes the engine forget what it last sent and send every cell.
+    // Return Value:
+    // - The number of bytes the engine wrote for all the frames.
+    size_t _CountTuiSessionBytes(BufferOnlyRenderData& data,
+                                 const size_t cFrames,
+                                 const std::function<void(TextBuffer&, size_t)>& drawFrame,
+                                 const bool forgetLastFrame)
+    {
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const Viewport view = data.Buffer().GetSize();
+
+        Xterm256Engine engine(wil::unique_hfile(INVALID_HANDLE_VALUE),
+                              gci,
+                              view,
+                              gci.GetColorTable(),
+                              static_cast<WORD>(gci.GetColorTableSize()));
+        size_t cbWritten = 0;
+        engine.SetTestCallback([&](const char* const /*pch*/, size_t const cch) {
+            cbWritten += cch;
+            return true;
+        });
+
+        IRenderEngine* pEngine = &engine;
+        Renderer renderer(&data, &pEngine, 1, std::make_unique<RenderThread>());
+
+        drawFrame(data.Buffer(), 0);
+        VERIFY_SUCCEEDED(engine.InvalidateAll());
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+        cbWritten = 0;
+
+        SMALL_RECT everything = view.ToExclusive();
+        for (size_t frame = 1; frame <= cFrames; ++frame)
+        {
+            drawFrame(data.Buffer(), frame);
+            if (forgetLastFrame)
+            {
+                VERIFY_SUCCEEDED(engine.InvalidateAll());
+            }
+            else
+            {
+                VERIFY_SUCCEEDED(engine.Invalidate(&everything));
+            }
+            VERIFY_SUCCEEDED(renderer.PaintFrame());
+        }
+
+        return cbWritten;
+    }
+
+    TEST_METHOD(TuiRedrawByteCount)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        const COORD size{ 120, 40 };
+        const size_t cFrames = 200;
+        BufferOnlyRenderData data{ size };
+
+        const TextAttribute plain{};
+        const TextAttribute header{ BACKGROUND_GREEN };
+        const TextAttribute meter{ FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+        const TextAttribute status{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED | BACKGROUND_BLUE };
+
+        // Cheap, repeatable noise, so every run replays the same session.
+        const auto noise = [](const size_t frame, const size_t row) {
+            return static_cast<unsigned int>((frame * 2654435761u) ^ (row * 40503u)) % 1000;
+        };
+        const auto writeRow = [&](TextBuffer& buffer, const SHORT row, std::wstring text, const TextAttribute& attr) {
+            text.resize(size.X, L' ');
+            buffer.WriteLine(OutputCellIterator(text, attr), { 0, row });
+        };
+
+        // Something like htop: CPU meters, a header, a process list where a
+        //      few numbers change every frame, and a function key bar.
+        const auto drawTop = [&](TextBuffer& buffer, const size_t frame) {
+            wchar_t line[128];
+            for (SHORT cpu = 0; cpu < 4; ++cpu)
+            {
+                const auto load = noise(frame / 4, cpu) % 100;
+                const std::wstring bar(load * 40 / 100, L'|');
+                swprintf_s(line, L"  %d  [%-40s%5.1f%%]", cpu, bar.c_str(), load + 0.1 * (noise(frame, cpu) % 10));
+                writeRow(buffer, cpu, line, meter);
+            }
+            swprintf_s(line, L"  Tasks: %u, 1 running   Load average: 0.%02u", 120 + noise(frame / 20, 99) % 4, noise(frame / 10, 98) % 100);
+            writeRow(buffer, 5, line, plain);
+            writeRow(buffer, 7, L"    PID USER      PRI  NI  VIRT   RES   SHR S CPU% MEM%   TIME+  Command", header);
+            for (SHORT row = 8; row < size.Y - 1; ++row)
+            {
+                const auto busy = noise(frame / 8, row) % 10 == 0;
+                swprintf_s(line,
+                           L"  %5d user       20   0  %3uM  %3uM  %3uM %c %4.1f  0.%u  0:%02zu.%02zu %s",
+                           1000 + row * 17,
+                           100 + row,
+                           40 + row,
+                           10 + row,
+                           busy ? L'R' : L'S',
+                           busy ? 0.1 * (noise(frame, row) % 500) : 0.0,
+                           row % 10,
+                           (frame / 30) % 60,
+                           busy ? frame % 100 : 0,
+                           row % 3 == 0 ? L"/usr/bin/python3 worker.py" : L"/usr/sbin/sshd -D");
+                writeRow(buffer, row, line, plain);
+            }
+            writeRow(buffer, size.Y - 1, L"F1Help  F2Setup F3SearchF4FilterF5Tree  F6SortByF7Nice -F8Nice +F9Kill  F10Quit", status);
+        };
+
+        // Something like vim: a screen of text, one line being typed into, and
+        //      a status line with the cursor position.
+        const auto drawEditor = [&](TextBuffer& buffer, const size_t frame) {
+            const std::wstring typed = std::wstring(frame % 80, L'x');
+            for (SHORT row = 0; row < size.Y - 1; ++row)
+            {
+                if (row == 20)
+                {
+                    writeRow(buffer, row, L"    " + typed + L"return result;", plain);
+                }
+                else
+                {
+                    writeRow(buffer, row, std::wstring(4 + row % 8, L' ') + L"auto value = compute(input, options);", plain);
+                }
+            }
+            wchar_t line[128];
+            swprintf_s(line, L"-- INSERT --%90s21,%zu  Top", L"", 5 + frame % 80);
+            writeRow(buffer, size.Y - 1, line, status);
+        };
+
+        const std::pair<const wchar_t*, std::function<void(TextBuffer&, size_t)>> sessions[] = {
+            { L"top", drawTop },
+            { L"editor", drawEditor },
+        };
+        for (const auto& session : sessions)
+        {
+            const auto cbChanged = _CountTuiSessionBytes(data, cFrames, session.second, false);
+            const auto cbEverything = _CountTuiSessionBytes(data, cFrames, session.second, true);
+
+            Log::Comment(String().Format(L"%s: %.1f bytes per frame sending changed cells, %.1f bytes per frame sending every cell",
+                                         session.first,
+                                         static_cast<double>(cbChanged) / cFrames,
+                                         static_cast<double>(cbEverything) / cFrames));
+        }
+    }
 };
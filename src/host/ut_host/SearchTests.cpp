@@ -9,6 +9,8 @@
 
 #include "search.h"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -163,4 +165,106 @@ class SearchTests
         Search s(outputBuffer, L"\x304b", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
         DoFoundChecks(s, coordStartExpected, -1);
     }
+
+    TEST_METHOD(ForwardAcrossRowEnd)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+
+        const SHORT lastColumn = textBuffer.GetSize().RightInclusive();
+        textBuffer.WriteLine(OutputCellIterator(std::wstring_view{ L"x", 1 }), { lastColumn, 5 });
+        textBuffer.WriteLine(OutputCellIterator(std::wstring_view{ L"y", 1 }), { 0, 6 });
+
+        Search s(outputBuffer, L"XY", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        VERIFY_IS_TRUE(s.FindNext());
+        VERIFY_ARE_EQUAL(COORD({ lastColumn, 5 }), s._coordSelStart);
+        VERIFY_ARE_EQUAL(COORD({ 0, 6 }), s._coordSelEnd);
+        VERIFY_IS_FALSE(s.FindNext());
+    }
+
+    TEST_METHOD(FindAllInRange)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+        const SHORT lastRow = outputBuffer.GetBufferSize().BottomInclusive();
+
+        Search s(outputBuffer, L"ab", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        const auto matches = s.FindAll(0, lastRow, false);
+        VERIFY_ARE_EQUAL(4u, matches.size());
+        for (SHORT row = 0; row < 4; ++row)
+        {
+            VERIFY_ARE_EQUAL(COORD({ 0, row }), matches.at(row).first);
+            VERIFY_ARE_EQUAL(COORD({ 1, row }), matches.at(row).second);
+        }
+
+        const auto parallelMatches = s.FindAll(0, lastRow, true);
+        VERIFY_ARE_EQUAL(matches.size(), parallelMatches.size());
+        VERIFY_IS_TRUE(std::equal(matches.cbegin(), matches.cend(), parallelMatches.cbegin()));
+
+        const auto someMatches = s.FindAll(1, 2, false);
+        VERIFY_ARE_EQUAL(2u, someMatches.size());
+        VERIFY_ARE_EQUAL(COORD({ 0, 1 }), someMatches.at(0).first);
+        VERIFY_ARE_EQUAL(COORD({ 0, 2 }), someMatches.at(1).first);
+
+        Search japanese(outputBuffer, L"\x304b", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        const auto japaneseMatches = japanese.FindAll(0, lastRow, false);
+        VERIFY_ARE_EQUAL(4u, japaneseMatches.size());
+        VERIFY_ARE_EQUAL(COORD({ 2, 3 }), japaneseMatches.at(3).first);
+        VERIFY_ARE_EQUAL(COORD({ 3, 3 }), japaneseMatches.at(3).second);
+    }
+
+    TEST_METHOD(SearchScrollbackPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+        VERIFY_SUCCEEDED(textBuffer.ResizeTraditional({ 120, 9999 }));
+
+        // Fill the scrollback with build output, with an error every so often.
+        size_t expected = 0;
+        for (SHORT row = 0; row < 9999; ++row)
+        {
+            std::wstring line = L"[" + std::to_wstring(row) + L"] Compiling src\\host\\module" + std::to_wstring(row % 50) + L".cpp";
+            if (row % 97 == 0)
+            {
+                line += L" : error C2065: 'Widget': undeclared identifier";
+                ++expected;
+            }
+            textBuffer.WriteLine(OutputCellIterator(line), { 0, row });
+        }
+
+        const std::wstring needle{ L"UNDECLARED IDENTIFIER" };
+
+        size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            Search s(outputBuffer, needle, Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, { 0, 0 });
+            while (s.FindNext())
+            {
+                ++found;
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Log::Comment(String().Format(L"FindNext through 9999 rows: %zu matches in %.2f ms", found, elapsed));
+        VERIFY_ARE_EQUAL(expected, found);
+
+        Search s(outputBuffer, needle, Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, { 0, 0 });
+
+        start = std::chrono::steady_clock::now();
+        const auto matches = s.FindAll(0, 9998, false);
+        elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Log::Comment(String().Format(L"FindAll through 9999 rows: %zu matches in %.2f ms", matches.size(), elapsed));
+        VERIFY_ARE_EQUAL(expected, matches.size());
+
+        start = std::chrono::steady_clock::now();
+        const auto parallelMatches = s.FindAll(0, 9998, true);
+        elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Log::Comment(String().Format(L"FindAll in parallel through 9999 rows: %zu matches in %.2f ms", parallelMatches.size(), elapsed));
+        VERIFY_ARE_EQUAL(expected, parallelMatches.size());
+    }
 };
@@ -17,6 +17,8 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../renderer/inc/DummyRenderTarget.hpp"
 
+#include <chrono>
+
 using namespace Microsoft::Console::Types;
 using namespace WEX::Common;
 using namespace WEX::Logging;
@@ -102,6 +104,7 @@ class TextBufferTests
     TEST_METHOD(TestSetWrapOnCurrentRow);
 
     TEST_METHOD(TestIncrementCircularBuffer);
+    TEST_METHOD(TestArchivedRows);
 
     TEST_METHOD(TestMixedRgbAndLegacyForeground);
     TEST_METHOD(TestMixedRgbAndLegacyBackground);
@@ -136,12 +139,23 @@ class TextBufferTests
 
     TEST_METHOD(ResizeTraditionalRotationPreservesHighUnicode);
     TEST_METHOD(ScrollBufferRotationPreservesHighUnicode);
+    TEST_METHOD(ScrollRowsAcrossCircularBufferEnd);
+    TEST_METHOD(ScrollRowsInMarginsPerf);
 
     TEST_METHOD(ResizeTraditionalHighUnicodeRowRemoval);
     TEST_METHOD(ResizeTraditionalHighUnicodeColumnRemoval);
+    TEST_METHOD(EmojiScrollbackChurnPerf);
 
     TEST_METHOD(TestBurrito);
 
+    TEST_METHOD(TestCompactRow);
+
+    TEST_METHOD(WriteColoredCellsKeepsRunsPacked);
+    TEST_METHOD(WriteSgrRichOutputPerf);
+
+    TEST_METHOD(SelectionRunsFollowAttributes);
+    TEST_METHOD(CopyFullBufferPerf);
+
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -175,7 +189,7 @@ void TextBufferTests::TestBufferRowByOffset()
     short sId = csBufferHeight / 2 - 5;
 
     const ROW& row = textBuffer.GetRowByOffset(sId);
-    VERIFY_ARE_EQUAL(row.GetId(), sId);
+    VERIFY_ARE_EQUAL(row.GetId(), gsl::narrow<size_t>(sId));
 }
 
 void TextBufferTests::TestWrapFlag()
@@ -542,7 +556,7 @@ void TextBufferTests::TestIncrementCircularBuffer()
         textBuffer.IncrementCircularBuffer();
 
         // validate that first row has moved
-        VERIFY_ARE_EQUAL(textBuffer._firstRow, iNextRowIndex); // first row has incremented
+        VERIFY_ARE_EQUAL(textBuffer._firstRow, gsl::narrow<size_t>(iNextRowIndex)); // first row has incremented
         VERIFY_ARE_NOT_EQUAL(textBuffer._GetFirstRow(), FirstRow); // the old first row is no longer the first
 
         // ensure old first row has been emptied
@@ -550,6 +564,55 @@ void TextBufferTests::TestIncrementCircularBuffer()
     }
 }
 
+void TextBufferTests::TestArchivedRows()
+{
+    const COORD bufferSize{ 10, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+    _buffer->SetArchiveLimit(3);
+
+    const auto verifyRetainedRows = [&](const size_t firstLine, const size_t archivedRows) {
+        VERIFY_ARE_EQUAL(archivedRows, _buffer->ArchivedRowCount());
+        VERIFY_ARE_EQUAL(archivedRows + _buffer->GetSize().Height(), _buffer->RetainedRowCount());
+        for (size_t i = 0; i < _buffer->RetainedRowCount(); i++)
+        {
+            const auto text = _buffer->GetRetainedRow(i).GetText();
+            VERIFY_ARE_EQUAL(String(std::to_wstring(firstLine + i).c_str()), String(text.substr(0, 1).c_str()));
+        }
+    };
+
+    Log::Comment(L"Fill the buffer, then keep writing on the bottom row as it circles.");
+    for (short i = 0; i < bufferSize.Y; i++)
+    {
+        _buffer->Write(OutputCellIterator{ std::to_wstring(i) }, { 0, i });
+    }
+    for (short i = bufferSize.Y; i < 8; i++)
+    {
+        VERIFY_IS_TRUE(_buffer->IncrementCircularBuffer());
+        _buffer->Write(OutputCellIterator{ std::to_wstring(i) }, { 0, bufferSize.Y - 1 });
+    }
+
+    Log::Comment(L"The rows that circled off are archived, up to the limit. Only the oldest is dropped.");
+    VERIFY_ARE_EQUAL(bufferSize.Y, _buffer->GetSize().Height());
+    VERIFY_ARE_EQUAL(String(L"4"), String(_buffer->GetRowByOffset(0).GetText().substr(0, 1).c_str()));
+    verifyRetainedRows(1, 3);
+
+    Log::Comment(L"Cells can be read from archived rows by counting from an earlier row.");
+    const auto archivedCell = _buffer->GetCellDataAt({ 0, 0 }, Viewport::FromDimensions({ 0, 0 }, bufferSize), 0);
+    VERIFY_ARE_EQUAL(String(L"1"), String(std::wstring{ archivedCell->Chars() }.c_str()));
+
+    Log::Comment(L"Shrinking the buffer archives the rows above the cursor, dropping the oldest that don't fit.");
+    _buffer->GetCursor().SetPosition({ 0, bufferSize.Y - 1 });
+    VERIFY_SUCCEEDED(_buffer->ResizeTraditional({ bufferSize.X, 2 }));
+    VERIFY_ARE_EQUAL(String(L"6"), String(_buffer->GetRowByOffset(0).GetText().substr(0, 1).c_str()));
+    verifyRetainedRows(3, 3);
+
+    Log::Comment(L"Lowering the archive limit drops the oldest archived rows.");
+    _buffer->SetArchiveLimit(1);
+    verifyRetainedRows(5, 1);
+}
+
 void TextBufferTests::TestMixedRgbAndLegacyForeground()
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -1818,7 +1881,7 @@ void TextBufferTests::ResizeTraditionalRotationPreservesHighUnicode()
     VERIFY_ARE_EQUAL(String(bbutton), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
     // Make it the first row in the buffer so it will rotate around when we resize and cause renumbering
-    const SHORT delta = _buffer->GetFirstRowIndex() - pos.Y;
+    const SHORT delta = gsl::narrow<SHORT>(_buffer->GetFirstRowIndex()) - pos.Y;
     const COORD newPos{ pos.X, pos.Y + delta };
 
     _buffer->_SetFirstRowIndex(pos.Y);
@@ -1874,6 +1937,88 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
     VERIFY_ARE_EQUAL(String(fire), String(shouldBeFireText.data(), gsl::narrow<int>(shouldBeFireText.size())));
 }
 
+// This tests that scrolling a region that straddles the end of the circular buffer
+// moves the right rows, leaves the first row index alone, and keeps high unicode with its row.
+void TextBufferTests::ScrollRowsAcrossCircularBufferEnd()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Circle the buffer so the top row sits near the end of the storage.
+    for (size_t i = 0; i < 7; ++i)
+    {
+        VERIFY_IS_TRUE(_buffer->IncrementCircularBuffer());
+    }
+    VERIFY_ARE_EQUAL(7u, _buffer->GetFirstRowIndex());
+
+    // Label each row with a letter, and put an emoji in row 4.
+    for (SHORT i = 0; i < bufferSize.Y; ++i)
+    {
+        const wchar_t label = static_cast<wchar_t>(L'A' + i);
+        _buffer->GetRowByOffset(i).GetCharRow().GlyphAt(0) = { &label, 1 };
+    }
+    const auto fire = L"\xD83D\xDD25";
+    _buffer->GetRowByOffset(4).GetCharRow().GlyphAt(2) = fire;
+
+    // Move rows 2 through 6 up by one. Rows 1 through 6 wrap around the end of the storage.
+    _buffer->ScrollRows(2, 5, -1);
+
+    VERIFY_ARE_EQUAL(7u, _buffer->GetFirstRowIndex());
+    const std::wstring expected = L"ACDEFGBHIJ";
+    for (SHORT i = 0; i < bufferSize.Y; ++i)
+    {
+        const auto text = *_buffer->GetTextDataAt({ 0, i });
+        VERIFY_ARE_EQUAL(String(expected.substr(i, 1).c_str()), String(text.data(), gsl::narrow<int>(text.size())));
+    }
+
+    const auto fireText = *_buffer->GetTextDataAt({ 2, 3 });
+    VERIFY_ARE_EQUAL(String(fire), String(fireText.data(), gsl::narrow<int>(fireText.size())));
+    const auto emptyText = *_buffer->GetTextDataAt({ 2, 4 });
+    VERIFY_ARE_EQUAL(String(L" "), String(emptyText.data(), gsl::narrow<int>(emptyText.size())));
+}
+
+// Measures scrolling inside margins at the bottom of a full scrollback, like a
+// pager or editor with a status line does for every line it scrolls.
+void TextBufferTests::ScrollRowsInMarginsPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    const COORD bufferSize{ 120, 9001 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Put the top of the buffer somewhere in the middle of the storage, as it
+    // would be after the scrollback has filled up and circled.
+    for (size_t i = 0; i < 4500; ++i)
+    {
+        VERIFY_IS_TRUE(_buffer->IncrementCircularBuffer());
+    }
+
+    // A 30 row viewport at the bottom of the buffer with a one line status bar.
+    const SHORT viewportTop = bufferSize.Y - 30;
+    const SHORT regionSize = 28;
+    const size_t cScrolls = 10000;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cScrolls; ++i)
+    {
+        _buffer->ScrollRows(viewportTop + 1, regionSize, -1);
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Log::Comment(String().Format(L"%zu scrolls of %d rows in a %d row buffer: %.2f ms, %.2f us per scroll",
+                                 cScrolls,
+                                 regionSize,
+                                 bufferSize.Y,
+                                 elapsed,
+                                 elapsed * 1000.0 / cScrolls));
+}
+
 // This tests that rows removed from the buffer while resizing traditionally will also drop the high unicode
 // characters from the Unicode Storage buffer
 void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
@@ -1899,14 +2044,17 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->GetRowByOffset(pos.Y).GetCharRow().GetUnicodeStorage().size(), L"There should be one glyph stored in the row.");
 
     // Perform resize to trim off the row of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X, bufferSize.Y - 1 };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (SHORT i = 0; i < trimmedBufferSize.Y; ++i)
+    {
+        VERIFY_ARE_EQUAL(0u, _buffer->GetRowByOffset(i).GetCharRow().GetUnicodeStorage().size(), L"No row should have a glyph stored now.");
+    }
 }
 
 // This tests that columns removed from the buffer while resizing traditionally will also drop the high unicode
@@ -1934,14 +2082,59 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->GetRowByOffset(pos.Y).GetCharRow().GetUnicodeStorage().size(), L"There should be one glyph stored in the row.");
 
     // Perform resize to trim off the column of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X - 1, bufferSize.Y};
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    VERIFY_ARE_EQUAL(0u, _buffer->GetRowByOffset(pos.Y).GetCharRow().GetUnicodeStorage().size(), L"The row should no longer have a glyph stored.");
+}
+
+// Measures writing lines full of emoji at the bottom of a buffer that keeps
+// circling, so every new line also recycles a row full of stored glyphs.
+void TextBufferTests::EmojiScrollbackChurnPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    const COORD bufferSize{ 120, 1000 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Each emoji is two cells wide, so this fills a row.
+    std::wstring line;
+    for (SHORT i = 0; i < bufferSize.X / 2; ++i)
+    {
+        // Cycle through the status-like emoji at U+1F534 and up.
+        const wchar_t emoji[] = { 0xD83D, static_cast<wchar_t>(0xDD34 + (i % 8)) };
+        line.append(emoji, ARRAYSIZE(emoji));
+    }
+
+    const size_t cCells = 1000000;
+    const size_t cLines = (cCells + bufferSize.X - 1) / bufferSize.X;
+    const COORD bottom{ 0, bufferSize.Y - 1 };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cLines; ++i)
+    {
+        VERIFY_IS_TRUE(_buffer->IncrementCircularBuffer());
+        _buffer->WriteLine(OutputCellIterator{ line }, bottom);
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const auto lastText = *_buffer->GetTextDataAt(bottom);
+    VERIFY_ARE_EQUAL(String(line.substr(0, 2).c_str()), String(lastText.data(), gsl::narrow<int>(lastText.size())));
+
+    Log::Comment(String().Format(L"%zu emoji cells on %zu lines through a %d row buffer: %.2f ms, %.2f ns per cell",
+                                 cLines * bufferSize.X,
+                                 cLines,
+                                 bufferSize.Y,
+                                 elapsed,
+                                 elapsed * 1000000.0 / (cLines * bufferSize.X)));
 }
 
 void TextBufferTests::TestBurrito()
@@ -1964,3 +2157,348 @@ void TextBufferTests::TestBurrito()
     _buffer->IncrementCursor();
     VERIFY_IS_FALSE(afterBurritoIter);
 }
+
+void TextBufferTests::TestCompactRow()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const std::wstring text{ L"Hello, world" };
+    std::wstring expected{ text };
+    expected.resize(bufferSize.X, UNICODE_SPACE);
+
+    Log::Comment(L"An ASCII row compacts, and still answers questions about its text without inflating.");
+    _buffer->Write(OutputCellIterator{ text }, { 0, 0 });
+    ROW& row = _buffer->GetRowByOffset(0);
+    CharRow& charRow = row.GetCharRow();
+    row.Compact();
+    VERIFY_IS_TRUE(charRow.IsCompact());
+    VERIFY_ARE_EQUAL(String(expected.c_str()), String(charRow.GetText().c_str()));
+    VERIFY_ARE_EQUAL(text.size(), charRow.MeasureRight());
+    VERIFY_ARE_EQUAL(static_cast<size_t>(0), charRow.MeasureLeft());
+    VERIFY_IS_TRUE(charRow.ContainsText());
+    VERIFY_ARE_EQUAL(static_cast<size_t>(bufferSize.X), charRow.size());
+    VERIFY_IS_TRUE(charRow.IsCompact());
+
+    Log::Comment(L"Reading individual cells through a const buffer leaves it compact.");
+    const auto readBack = *_buffer->GetTextDataAt({ 7, 0 });
+    VERIFY_ARE_EQUAL(String(L"w"), String(readBack.data(), gsl::narrow<int>(readBack.size())));
+    const auto trailing = *_buffer->GetTextDataAt({ 70, 0 });
+    VERIFY_ARE_EQUAL(String(L" "), String(trailing.data(), gsl::narrow<int>(trailing.size())));
+    const CharRow& constCharRow = charRow;
+    VERIFY_IS_TRUE(constCharRow.DbcsAttrAt(7).IsSingle());
+    VERIFY_IS_TRUE(charRow.IsCompact());
+    VERIFY_ARE_EQUAL(String(expected.c_str()), String(charRow.GetText().c_str()));
+
+    Log::Comment(L"Writing to it inflates it again.");
+    _buffer->Write(OutputCellIterator{ L"J" }, { 0, 0 });
+    VERIFY_IS_FALSE(charRow.IsCompact());
+    expected[0] = L'J';
+    VERIFY_ARE_EQUAL(String(expected.c_str()), String(charRow.GetText().c_str()));
+
+    Log::Comment(L"A blank row stays compact through a reset.");
+    ROW& blankRow = _buffer->GetRowByOffset(1);
+    blankRow.Compact();
+    VERIFY_IS_TRUE(blankRow.GetCharRow().IsCompact());
+    VERIFY_IS_FALSE(blankRow.GetCharRow().ContainsText());
+    VERIFY_ARE_EQUAL(static_cast<size_t>(bufferSize.X), blankRow.GetCharRow().MeasureLeft());
+    VERIFY_ARE_EQUAL(static_cast<size_t>(0), blankRow.GetCharRow().MeasureRight());
+    VERIFY_IS_TRUE(blankRow.Reset(attr));
+    VERIFY_IS_TRUE(blankRow.GetCharRow().IsCompact());
+    VERIFY_ARE_EQUAL(String(std::wstring(bufferSize.X, UNICODE_SPACE).c_str()), String(blankRow.GetCharRow().GetText().c_str()));
+
+    Log::Comment(L"Rows with glyphs that need more than a byte are left alone.");
+    ROW& emojiRow = _buffer->GetRowByOffset(2);
+    const auto fire = L"\xD83D\xDD25";
+    emojiRow.GetCharRow().GlyphAt(2) = fire;
+    emojiRow.Compact();
+    VERIFY_IS_FALSE(emojiRow.GetCharRow().IsCompact());
+    const auto fireText = *_buffer->GetTextDataAt({ 2, 2 });
+    VERIFY_ARE_EQUAL(String(fire), String(fireText.data(), gsl::narrow<int>(fireText.size())));
+}
+
+void TextBufferTests::WriteColoredCellsKeepsRunsPacked()
+{
+    const COORD bufferSize{ 40, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute plain{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, plain, cursorSize, _renderTarget);
+
+    TextAttribute executable{ FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    executable.Embolden();
+    TextAttribute truecolor{ plain };
+    truecolor.SetForeground(RGB(0x5f, 0xd7, 0x00));
+
+    std::vector<OutputCell> cells;
+    const auto append = [&](const std::wstring_view text, const TextAttribute& textAttr) {
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            cells.emplace_back(text.substr(i, 1), DbcsAttribute{}, textAttr);
+        }
+    };
+
+    Log::Comment(L"A line in three colors ends up as three runs, however many cells each covers.");
+    append(L"-rwxr-xr-x 1 ", plain);
+    append(L"build.sh", executable);
+    append(L" ok", truecolor);
+    _buffer->WriteLine(OutputCellIterator{ std::basic_string_view<OutputCell>{ cells.data(), cells.size() } }, { 0, 0 });
+
+    const ATTR_ROW& attrRow = _buffer->GetRowByOffset(0).GetAttrRow();
+    VERIFY_ARE_EQUAL(static_cast<size_t>(4), attrRow.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(12));
+    VERIFY_ARE_EQUAL(executable, attrRow.GetAttrByColumn(13));
+    VERIFY_ARE_EQUAL(executable, attrRow.GetAttrByColumn(20));
+    VERIFY_ARE_EQUAL(truecolor, attrRow.GetAttrByColumn(21));
+    VERIFY_ARE_EQUAL(truecolor, attrRow.GetAttrByColumn(23));
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(24));
+
+    Log::Comment(L"Writing over the middle run in the color of its neighbors folds all three back together.");
+    cells.clear();
+    append(L"build.sh", plain);
+    _buffer->WriteLine(OutputCellIterator{ std::basic_string_view<OutputCell>{ cells.data(), cells.size() } }, { 13, 0 });
+    VERIFY_ARE_EQUAL(static_cast<size_t>(3), attrRow.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(20));
+    VERIFY_ARE_EQUAL(truecolor, attrRow.GetAttrByColumn(21));
+
+    Log::Comment(L"Text written without colors leaves the colors under it alone.");
+    _buffer->WriteLine(OutputCellIterator{ std::wstring_view{ L"okay" } }, { 20, 0 });
+    VERIFY_ARE_EQUAL(static_cast<size_t>(3), attrRow.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(20));
+    VERIFY_ARE_EQUAL(truecolor, attrRow.GetAttrByColumn(21));
+    VERIFY_ARE_EQUAL(plain, attrRow.GetAttrByColumn(24));
+}
+
+void TextBufferTests::WriteSgrRichOutputPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    const COORD bufferSize{ 120, 9001 };
+    const UINT cursorSize = 12;
+    const TextAttribute plain{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, plain, cursorSize, _renderTarget);
+
+    TextAttribute directory{ FOREGROUND_BLUE | FOREGROUND_INTENSITY };
+    directory.Embolden();
+    TextAttribute executable{ FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    executable.Embolden();
+    TextAttribute symlink{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    TextAttribute location{ plain };
+    location.Embolden();
+    TextAttribute error{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    error.Embolden();
+    TextAttribute note{ plain };
+    note.SetForeground(RGB(0x00, 0xaf, 0xd7));
+    TextAttribute caret{ plain };
+    caret.SetForeground(RGB(0x5f, 0xd7, 0x00));
+
+    // Build one block of colored output the way `ls --color -l` and a compiler's
+    // diagnostics paint it: short runs of color between plain text, each line
+    // padded out to the edge of the buffer.
+    std::vector<OutputCell> cells;
+    size_t lineStart = 0;
+    const auto append = [&](const std::wstring_view text, const TextAttribute& textAttr) {
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            cells.emplace_back(text.substr(i, 1), DbcsAttribute{}, textAttr);
+        }
+    };
+    const auto endLine = [&]() {
+        while (cells.size() - lineStart < static_cast<size_t>(bufferSize.X))
+        {
+            cells.emplace_back(std::wstring_view{ L" " }, DbcsAttribute{}, plain);
+        }
+        lineStart = cells.size();
+    };
+
+    append(L"drwxr-xr-x 1 user user     0 Oct 17 09:14 ", plain);
+    append(L"buffer", directory);
+    endLine();
+    append(L"-rwxr-xr-x 1 user user 18432 Oct 17 09:14 ", plain);
+    append(L"build.sh", executable);
+    endLine();
+    append(L"lrwxrwxrwx 1 user user    14 Oct 17 09:14 ", plain);
+    append(L"current", symlink);
+    append(L" -> ", plain);
+    append(L"buffer", directory);
+    endLine();
+    append(L"src/host/_stream.cpp:412:17: ", location);
+    append(L"error: ", error);
+    append(L"no matching function for call to '", plain);
+    append(L"WriteCharsLegacy", location);
+    append(L"'", plain);
+    endLine();
+    append(L"    WriteCharsLegacy(screenInfo, pwchBuffer, pwchBuffer, pwchRealUnicode, &cb, nullptr);", plain);
+    endLine();
+    append(L"    ", plain);
+    append(L"^~~~~~~~~~~~~~~~", caret);
+    endLine();
+    append(L"src/host/_stream.h:88:10: ", location);
+    append(L"note: ", note);
+    append(L"candidate function not viable: requires 9 arguments, but 6 were provided", plain);
+    endLine();
+
+    const SHORT blockRows = gsl::narrow<SHORT>(cells.size() / bufferSize.X);
+    const std::basic_string_view<OutputCell> block{ cells.data(), cells.size() };
+
+    const size_t cPasses = 4;
+    size_t cCells = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < cPasses; ++pass)
+    {
+        for (SHORT row = 0; row + blockRows <= bufferSize.Y; row += blockRows)
+        {
+            _buffer->Write(OutputCellIterator{ block }, { 0, row });
+            cCells += block.size();
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const ATTR_ROW& attrRow = _buffer->GetRowByOffset(2).GetAttrRow();
+    VERIFY_ARE_EQUAL(symlink, attrRow.GetAttrByColumn(42));
+    VERIFY_ARE_EQUAL(directory, attrRow.GetAttrByColumn(53));
+    VERIFY_ARE_EQUAL(static_cast<size_t>(5), attrRow.GetNumberOfRuns());
+
+    Log::Comment(String().Format(L"%zu colored cells in %zu passes over a %dx%d buffer: %.2f ms, %.2f ns per cell",
+                                 cCells,
+                                 cPasses,
+                                 bufferSize.X,
+                                 bufferSize.Y,
+                                 elapsed,
+                                 elapsed * 1000000.0 / cCells));
+}
+
+void TextBufferTests::SelectionRunsFollowAttributes()
+{
+    const COORD bufferSize{ 20, 3 };
+    const TextAttribute plain{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED };
+    const TextAttribute red{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    const TextAttribute blue{ FOREGROUND_BLUE | BACKGROUND_GREEN };
+    TextBuffer buffer(bufferSize, plain, 12, _renderTarget);
+
+    buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"ab" }, red }, { 0, 0 });
+    buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"cd" }, blue }, { 2, 0 });
+    buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"ef" }, plain }, { 4, 0 });
+    buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"gh" }, red }, { 0, 1 });
+
+    size_t colorLookups = 0;
+    std::function<COLORREF(TextAttribute&)> GetForegroundColor = [&](TextAttribute& attr) {
+        ++colorLookups;
+        return static_cast<COLORREF>(attr.GetLegacyAttributes() & FG_ATTRS);
+    };
+    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = [](TextAttribute& attr) {
+        return static_cast<COLORREF>((attr.GetLegacyAttributes() & BG_ATTRS) >> 4);
+    };
+
+    struct Run
+    {
+        size_t rectIndex;
+        std::wstring text;
+        COLORREF foreground;
+    };
+    std::vector<Run> runs;
+    const std::vector<SMALL_RECT> selection{ { 0, 0, 19, 0 }, { 0, 1, 19, 1 } };
+    buffer.WriteSelectionRuns(false,
+                              true,
+                              selection,
+                              GetForegroundColor,
+                              GetBackgroundColor,
+                              [&](const size_t rectIndex, const std::wstring_view text, const COLORREF foreground, const COLORREF /*background*/) {
+                                  runs.push_back({ rectIndex, std::wstring{ text }, foreground });
+                              });
+
+    // The colors are looked up once per attribute run, not once per cell.
+    VERIFY_ARE_EQUAL(static_cast<size_t>(5), colorLookups);
+
+    // The trailing spaces are trimmed off the plain run and the first row ends in a black CR/LF.
+    VERIFY_ARE_EQUAL(static_cast<size_t>(5), runs.size());
+    VERIFY_ARE_EQUAL(L"ab", std::wstring_view{ runs.at(0).text });
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(red.GetLegacyAttributes() & FG_ATTRS), runs.at(0).foreground);
+    VERIFY_ARE_EQUAL(L"cd", std::wstring_view{ runs.at(1).text });
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(blue.GetLegacyAttributes() & FG_ATTRS), runs.at(1).foreground);
+    VERIFY_ARE_EQUAL(L"ef", std::wstring_view{ runs.at(2).text });
+    VERIFY_ARE_EQUAL(L"\r\n", std::wstring_view{ runs.at(3).text });
+    VERIFY_ARE_EQUAL(static_cast<size_t>(0), runs.at(3).rectIndex);
+    VERIFY_ARE_EQUAL(L"gh", std::wstring_view{ runs.at(4).text });
+    VERIFY_ARE_EQUAL(static_cast<size_t>(1), runs.at(4).rectIndex);
+
+    // The per-character form is built from the same runs.
+    const auto data = buffer.GetTextForClipboard(false, true, selection, GetForegroundColor, GetBackgroundColor);
+    VERIFY_ARE_EQUAL(L"abcdef\r\n", std::wstring_view{ data.text.at(0) });
+    VERIFY_ARE_EQUAL(L"gh", std::wstring_view{ data.text.at(1) });
+    VERIFY_ARE_EQUAL(data.text.at(0).size(), data.FgAttr.at(0).size());
+    VERIFY_ARE_EQUAL(runs.at(1).foreground, data.FgAttr.at(0).at(3));
+}
+
+void TextBufferTests::CopyFullBufferPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    const COORD bufferSize{ 120, 9999 };
+    const TextAttribute plain{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED };
+    TextBuffer buffer(bufferSize, plain, 12, _renderTarget);
+
+    // Color the scrollback the way a build log looks: a few colored words per line.
+    const TextAttribute location{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY };
+    const TextAttribute error{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    const TextAttribute note{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    for (SHORT row = 0; row < bufferSize.Y; ++row)
+    {
+        buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"src/host/_stream.cpp:412:17: " }, location }, { 0, row });
+        buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"error: " }, row % 3 ? error : note }, { 29, row });
+        buffer.WriteLine(OutputCellIterator{ std::wstring_view{ L"no matching function for call to 'WriteCharsLegacy'" }, plain }, { 36, row });
+    }
+
+    std::vector<SMALL_RECT> selection;
+    for (SHORT row = 0; row < bufferSize.Y; ++row)
+    {
+        selection.push_back({ 0, row, gsl::narrow<SHORT>(bufferSize.X - 1), row });
+    }
+
+    const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
+    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
+
+    size_t cchRuns = 0;
+    size_t cRuns = 0;
+    auto start = std::chrono::steady_clock::now();
+    buffer.WriteSelectionRuns(false,
+                              true,
+                              selection,
+                              GetForegroundColor,
+                              GetBackgroundColor,
+                              [&](const size_t /*rectIndex*/, const std::wstring_view text, const COLORREF /*foreground*/, const COLORREF /*background*/) {
+                                  cchRuns += text.size();
+                                  ++cRuns;
+                              });
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Log::Comment(String().Format(L"Selection runs for a %dx%d buffer: %zu characters in %zu runs, %.2f ms",
+                                 bufferSize.X,
+                                 bufferSize.Y,
+                                 cchRuns,
+                                 cRuns,
+                                 elapsed));
+
+    start = std::chrono::steady_clock::now();
+    const auto data = buffer.GetTextForClipboard(false,
+                                                 true,
+                                                 selection,
+                                                 GetForegroundColor,
+                                                 GetBackgroundColor);
+    elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t cchData = 0;
+    for (const auto& text : data.text)
+    {
+        cchData += text.size();
+    }
+    VERIFY_ARE_EQUAL(cchRuns, cchData);
+    Log::Comment(String().Format(L"Per-character text and colors for the same selection: %.2f ms", elapsed));
+}
@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../types/inc/Utf8StreamReader.hpp"
+
+#include <chrono>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+// "a", e acute, euro sign, smiling face with sunglasses, " z"
+static const std::string MixedUtf8{ "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x8E z" };
+static const std::wstring MixedUtf16{ L"a\x00E9\x20AC\xD83D\xDE0E z" };
+
+// Stands in for a pipe: hands out the bytes it was given a chunk at a time,
+// and can say how many are left as if they were all waiting in the pipe.
+class MemoryStream
+{
+public:
+    MemoryStream(const std::string_view data, const size_t chunkSize, const bool reportAvailable) :
+        _data{ data },
+        _chunkSize{ chunkSize },
+        _reportAvailable{ reportAvailable },
+        _pos{ 0 },
+        _reads{ 0 }
+    {
+    }
+
+    Utf8StreamReader MakeReader(const size_t bufferSize = Utf8StreamReader::DefaultBufferSize)
+    {
+        return Utf8StreamReader{
+            [this](char* const buffer, const size_t size, size_t& read) {
+                if (_pos == _data.size())
+                {
+                    return false;
+                }
+                read = std::min({ size, _chunkSize, _data.size() - _pos });
+                std::copy_n(_data.data() + _pos, read, buffer);
+                _pos += read;
+                ++_reads;
+                return true;
+            },
+            _reportAvailable ? Utf8StreamReader::AvailableCallback{ [this]() { return _data.size() - _pos; } } : nullptr,
+            bufferSize
+        };
+    }
+
+    size_t Reads() const noexcept
+    {
+        return _reads;
+    }
+
+private:
+    std::string_view _data;
+    size_t _chunkSize;
+    bool _reportAvailable;
+    size_t _pos;
+    size_t _reads;
+};
+
+class Utf8StreamReaderTests
+{
+    TEST_CLASS(Utf8StreamReaderTests);
+
+    TEST_METHOD(DecodesSequencesSplitAtAnyPoint)
+    {
+        for (size_t split = 0; split <= MixedUtf8.size(); ++split)
+        {
+            Utf8StreamDecoder decoder;
+            std::wstring text;
+            decoder.Decode(std::string_view{ MixedUtf8 }.substr(0, split), text);
+            decoder.Decode(std::string_view{ MixedUtf8 }.substr(split), text);
+            VERIFY_IS_FALSE(decoder.HasPartialSequence());
+            VERIFY_ARE_EQUAL(String(MixedUtf16.c_str()), String(text.c_str()), NoThrowString().Format(L"split at %zu", split));
+        }
+
+        Log::Comment(L"One byte at a time.");
+        Utf8StreamDecoder decoder;
+        std::wstring text;
+        for (const auto ch : MixedUtf8)
+        {
+            decoder.Decode({ &ch, 1 }, text);
+        }
+        VERIFY_ARE_EQUAL(String(MixedUtf16.c_str()), String(text.c_str()));
+    }
+
+    TEST_METHOD(ReplacesIllFormedSequences)
+    {
+        const std::pair<std::string, std::wstring> cases[] = {
+            { "\x80", L"\xFFFD" }, // stray continuation byte
+            { "\xC3(", L"\xFFFD(" }, // lead byte without its continuation
+            { "\xC0\xAF", L"\xFFFD\xFFFD" }, // overlong two-byte form of '/'
+            { "\xE0\x80\xAF", L"\xFFFD\xFFFD\xFFFD" }, // overlong three-byte form of '/'
+            { "\xED\xA0\x80", L"\xFFFD\xFFFD\xFFFD" }, // encoded surrogate
+            { "\xF4\x90\x80\x80", L"\xFFFD\xFFFD\xFFFD\xFFFD" }, // past U+10FFFF
+            { "\xE2\x82z", L"\xFFFDz" }, // truncated euro sign
+            { "\xFF" "a", L"\xFFFD" L"a" }, // never valid
+        };
+
+        for (const auto& [input, expected] : cases)
+        {
+            Utf8StreamDecoder decoder;
+            std::wstring text;
+            decoder.Decode(input, text);
+            decoder.Flush(text);
+            VERIFY_ARE_EQUAL(String(expected.c_str()), String(text.c_str()));
+        }
+
+        Log::Comment(L"A sequence still open when the stream ends is replaced when it's flushed.");
+        Utf8StreamDecoder decoder;
+        std::wstring text;
+        decoder.Decode("ok\xF0\x9F", text);
+        VERIFY_IS_TRUE(decoder.HasPartialSequence());
+        VERIFY_ARE_EQUAL(String(L"ok"), String(text.c_str()));
+        decoder.Flush(text);
+        VERIFY_IS_FALSE(decoder.HasPartialSequence());
+        VERIFY_ARE_EQUAL(String(L"ok\xFFFD"), String(text.c_str()));
+    }
+
+    TEST_METHOD(CoalescesReadsThatAreReady)
+    {
+        std::string data;
+        for (int i = 0; i < 40; ++i)
+        {
+            data += MixedUtf8;
+        }
+
+        std::wstring expected;
+        for (int i = 0; i < 40; ++i)
+        {
+            expected += MixedUtf16;
+        }
+
+        Log::Comment(L"Everything waiting in the stream comes back as one piece of text.");
+        {
+            MemoryStream stream{ data, 7, true };
+            auto reader = stream.MakeReader();
+            std::wstring_view text;
+            VERIFY_IS_TRUE(reader.Read(text));
+            VERIFY_ARE_EQUAL(String(expected.c_str()), String(text.data(), gsl::narrow<int>(text.size())));
+            VERIFY_IS_TRUE(stream.Reads() > 1);
+            VERIFY_IS_FALSE(reader.Read(text));
+            VERIFY_IS_FALSE(reader.IsOpen());
+        }
+
+        Log::Comment(L"Without knowing what's ready, each read is delivered on its own, still split safely.");
+        {
+            MemoryStream stream{ data, 7, false };
+            auto reader = stream.MakeReader();
+            std::wstring_view text;
+            std::wstring all;
+            size_t deliveries = 0;
+            while (reader.Read(text))
+            {
+                all.append(text);
+                ++deliveries;
+            }
+            VERIFY_ARE_EQUAL(String(expected.c_str()), String(all.c_str()));
+            VERIFY_IS_TRUE(deliveries > 1);
+        }
+
+        Log::Comment(L"A small buffer limits how much is gathered into one piece.");
+        {
+            MemoryStream stream{ data, 7, true };
+            auto reader = stream.MakeReader(16);
+            std::wstring_view text;
+            std::wstring all;
+            while (reader.Read(text))
+            {
+                VERIFY_IS_TRUE(text.size() <= 16u);
+                all.append(text);
+            }
+            VERIFY_ARE_EQUAL(String(expected.c_str()), String(all.c_str()));
+        }
+    }
+
+    TEST_METHOD(DeliversTextReadBeforeStreamEnds)
+    {
+        const std::string data{ "done\xE2\x82" };
+        MemoryStream stream{ data, 3, false };
+        auto reader = stream.MakeReader();
+
+        std::wstring_view text;
+        VERIFY_IS_TRUE(reader.Read(text));
+        VERIFY_ARE_EQUAL(String(L"don"), String(text.data(), gsl::narrow<int>(text.size())));
+
+        // The second read ends in the middle of the euro sign, so only the "e" is ready.
+        VERIFY_IS_TRUE(reader.Read(text));
+        VERIFY_ARE_EQUAL(String(L"e"), String(text.data(), gsl::narrow<int>(text.size())));
+
+        // Then the stream ends with the sequence unfinished.
+        VERIFY_IS_TRUE(reader.Read(text));
+        VERIFY_ARE_EQUAL(String(L"\xFFFD"), String(text.data(), gsl::narrow<int>(text.size())));
+
+        VERIFY_IS_FALSE(reader.Read(text));
+        VERIFY_IS_TRUE(text.empty());
+    }
+
+    TEST_METHOD(ReadThroughputPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Mostly ASCII with colors, the way a build or a directory listing looks,
+        // with some text in other scripts mixed in.
+        const std::string line{ "\x1b[32mcompiling\x1b[0m src/host/_stream.cpp "
+                                "\xE6\x96\x87\xE5\xAD\x97 \xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 "
+                                "\xF0\x9F\x98\x8E done\r\n" };
+        std::string data;
+        const size_t targetSize = 32 * 1024 * 1024;
+        data.reserve(targetSize + line.size());
+        while (data.size() < targetSize)
+        {
+            data += line;
+        }
+        const double megabytes = data.size() / (1024.0 * 1024.0);
+
+        Log::Comment(L"256 bytes at a time, a new converted string per read.");
+        size_t baselineUnits = 0;
+        const auto baselineStart = std::chrono::steady_clock::now();
+        for (size_t pos = 0; pos < data.size(); pos += 256)
+        {
+            const int cb = gsl::narrow<int>(std::min<size_t>(256, data.size() - pos));
+            const std::string chunk{ data.data() + pos, static_cast<size_t>(cb) };
+            const int cch = MultiByteToWideChar(CP_UTF8, 0, chunk.data(), cb, nullptr, 0);
+            std::wstring converted(cch, L'\0');
+            MultiByteToWideChar(CP_UTF8, 0, chunk.data(), cb, converted.data(), cch);
+            baselineUnits += converted.size();
+        }
+        const auto baselineElapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - baselineStart).count();
+
+        Log::Comment(L"The streaming reader, with the stream handing out 4K reads that are all ready.");
+        MemoryStream stream{ data, 4096, true };
+        auto reader = stream.MakeReader();
+        std::wstring_view text;
+        size_t units = 0;
+        size_t deliveries = 0;
+        const auto start = std::chrono::steady_clock::now();
+        while (reader.Read(text))
+        {
+            units += text.size();
+            ++deliveries;
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(String().Format(L"%.1f MB: per-chunk conversion %.2f ms (%.1f MB/s, %zu units), streaming reader %.2f ms (%.1f MB/s, %zu units in %zu deliveries)",
+                                     megabytes,
+                                     baselineElapsed,
+                                     megabytes * 1000.0 / baselineElapsed,
+                                     baselineUnits,
+                                     elapsed,
+                                     megabytes * 1000.0 / elapsed,
+                                     units,
+                                     deliveries));
+    }
+};
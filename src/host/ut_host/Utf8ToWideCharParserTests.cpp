@@ -7,6 +7,8 @@
 
 #include "utf8ToWideCharParser.hpp"
 
+#include <chrono>
+
 #define IsBitSet WI_IsFlagSet
 
 using namespace WEX::Common;
@@ -14,6 +16,16 @@ using namespace WEX::Logging;
 using namespace WEX::TestExecution;
 using namespace std;
 
+// The inputs used by the tests below, gathered up so both versions of Parse
+// can be checked against each other and timed on the same text.
+static const std::vector<std::vector<unsigned char>> ParserCorpus = {
+    { 0x48, 0x65, 0x6c, 0x6c, 0x6f }, // ascii "hello"
+    { 0xe3, 0x81, 0x99, 0xe3, 0x81, 0x97 }, // hiragana sushi
+    { 0xe3, 0x81, 0xa9, 0xe3, 0x81, 0x86, 0xe3, 0x82, 0x82, 0xe3, 0x81, 0x82,
+      0xe3, 0x82, 0x8a, 0xe3, 0x81, 0x8c, 0xe3, 0x81, 0xa8, 0xe3, 0x81, 0x86 }, // hiragana doomo arigatoo
+    { 0xe3, 0x81, 0x99, 0x80, 0x81, 0x82, 0xe3, 0x81, 0x97 }, // hiragana sushi with junk between
+};
+
 class Utf8ToWideCharParserTests
 {
     static const unsigned int utf8CodePage = 65001;
@@ -350,4 +362,176 @@ class Utf8ToWideCharParserTests
         VERIFY_ARE_EQUAL(parser._Utf8SequenceSize(0xFF), (unsigned int)8);
     }
 
+    // Routine Description:
+    // - Runs bytes through the version of Parse that allocates, cchChunk at a time.
+    std::wstring ParseToArrays(const std::vector<unsigned char>& bytes, const size_t cchChunk)
+    {
+        auto parser = Utf8ToWideCharParser { utf8CodePage };
+        std::wstring result;
+        for (size_t pos = 0; pos < bytes.size(); pos += cchChunk)
+        {
+            const unsigned int count = gsl::narrow<unsigned int>(std::min(cchChunk, bytes.size() - pos));
+            unsigned int consumed = 0;
+            unsigned int generated = 0;
+            unique_ptr<wchar_t[]> output { nullptr };
+            // A chunk of nothing but invalid bytes fails. It's dropped, just like VtInputThread does.
+            if (SUCCEEDED(parser.Parse(bytes.data() + pos, count, consumed, output, generated)) && generated > 0)
+            {
+                VERIFY_ARE_EQUAL(count, consumed);
+                result.append(output.get(), generated);
+            }
+        }
+        return result;
+    }
+
+    // Routine Description:
+    // - Runs bytes through the version of Parse that writes to a span, cchChunk at a time,
+    //   reusing the same buffer for every chunk.
+    std::wstring ParseToSpan(const std::vector<unsigned char>& bytes, const size_t cchChunk)
+    {
+        auto parser = Utf8ToWideCharParser { utf8CodePage };
+        std::vector<wchar_t> buffer(Utf8ToWideCharParser::GetMaxConvertedSize(cchChunk));
+        std::wstring result;
+        for (size_t pos = 0; pos < bytes.size(); pos += cchChunk)
+        {
+            const size_t count = std::min(cchChunk, bytes.size() - pos);
+            size_t generated = 0;
+            VERIFY_SUCCEEDED(parser.Parse(gsl::make_span(bytes.data() + pos, count), gsl::make_span(buffer), generated));
+            result.append(buffer.data(), generated);
+        }
+        return result;
+    }
+
+    TEST_METHOD(SpanParseMatchesArrayParseTest)
+    {
+        Log::Comment(L"Testing that parsing into a span gives the same text as parsing into new arrays, however the input is split up");
+        for (const auto& bytes : ParserCorpus)
+        {
+            for (size_t cchChunk = 1; cchChunk <= bytes.size(); ++cchChunk)
+            {
+                const auto expected = ParseToArrays(bytes, cchChunk);
+                const auto actual = ParseToSpan(bytes, cchChunk);
+                VERIFY_ARE_EQUAL(String(expected.c_str()), String(actual.c_str()), NoThrowString().Format(L"%zu byte chunks", cchChunk));
+            }
+        }
+
+        Log::Comment(L"A run of ASCII long enough to be widened in blocks, with a sequence in the middle of a block");
+        std::vector<unsigned char> longRun(70, 'x');
+        longRun[37] = 0xe3;
+        longRun[38] = 0x81;
+        longRun[39] = 0x99;
+        const auto expected = ParseToArrays(longRun, longRun.size());
+        VERIFY_ARE_EQUAL(static_cast<size_t>(68), expected.size());
+        VERIFY_ARE_EQUAL(String(expected.c_str()), String(ParseToSpan(longRun, longRun.size()).c_str()));
+        VERIFY_ARE_EQUAL(String(expected.c_str()), String(ParseToSpan(longRun, 38).c_str()));
+    }
+
+    TEST_METHOD(SpanParseDropsInvalidCodePointsTest)
+    {
+        Log::Comment(L"Testing that overlong, surrogate, and out of range sequences are dropped without losing the text around them");
+        const std::vector<unsigned char> bytes = {
+            'A',
+            0xc0, 0xaf, // overlong '/'
+            'B',
+            0xed, 0xa0, 0x80, // surrogate U+D800
+            'C',
+            0xf4, 0x90, 0x80, 0x80, // past U+10FFFF
+            0xf0, 0x9f, 0x98, 0x8e // U+1F60E smiling face with sunglasses
+        };
+        VERIFY_ARE_EQUAL(String(L"ABCØ3DÞ0E"), String(ParseToSpan(bytes, bytes.size()).c_str()));
+        VERIFY_ARE_EQUAL(String(L"ABCØ3DÞ0E"), String(ParseToSpan(bytes, 1).c_str()));
+    }
+
+    TEST_METHOD(SpanParseChecksArgumentsTest)
+    {
+        Log::Comment(L"Testing that the span must have room for the worst case, and that other code pages fail");
+        const std::vector<unsigned char>& hello = ParserCorpus.at(0);
+        std::vector<wchar_t> buffer(hello.size());
+        size_t generated = 1;
+
+        auto parser = Utf8ToWideCharParser { utf8CodePage };
+        VERIFY_ARE_EQUAL(E_NOT_SUFFICIENT_BUFFER, parser.Parse(gsl::make_span(hello), gsl::make_span(buffer), generated));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), generated);
+
+        buffer.resize(Utf8ToWideCharParser::GetMaxConvertedSize(hello.size()));
+        VERIFY_SUCCEEDED(parser.Parse(gsl::make_span(hello), gsl::make_span(buffer), generated));
+        VERIFY_ARE_EQUAL(hello.size(), generated);
+
+        Log::Comment(L"A partial sequence is kept in the same place as the other Parse keeps it");
+        const unsigned char partialSequence[] = { 0xe3, 0x81 };
+        VERIFY_SUCCEEDED(parser.Parse(gsl::make_span(partialSequence), gsl::make_span(buffer), generated));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), generated);
+        VERIFY_ARE_EQUAL(parser._currentState, Utf8ToWideCharParser::_State::BeginPartialParse);
+        VERIFY_ARE_EQUAL(parser._bytesStored, (unsigned int)2);
+
+        parser.SetCodePage(USACodePage);
+        VERIFY_ARE_EQUAL(E_FAIL, parser.Parse(gsl::make_span(hello), gsl::make_span(buffer), generated));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), generated);
+    }
+
+    TEST_METHOD(ParseThroughputPerf)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Repeat the corpus, padded out with the kind of ASCII and VT sequences
+        // that make up most of what comes through the input pipe.
+        const std::string ascii{ "\x1b[A\x1b[1;5Cls -la --color=auto\r" };
+        std::vector<unsigned char> bytes;
+        const size_t targetSize = 16 * 1024 * 1024;
+        bytes.reserve(targetSize + 256);
+        while (bytes.size() < targetSize)
+        {
+            for (const auto& text : ParserCorpus)
+            {
+                bytes.insert(bytes.end(), text.begin(), text.end());
+                bytes.insert(bytes.end(), ascii.begin(), ascii.end());
+            }
+        }
+        const double megabytes = bytes.size() / (1024.0 * 1024.0);
+
+        // VtInputThread reads 256 bytes at a time.
+        const size_t cchChunk = 256;
+
+        size_t cchArrays = 0;
+        {
+            auto parser = Utf8ToWideCharParser { utf8CodePage };
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t pos = 0; pos < bytes.size(); pos += cchChunk)
+            {
+                const unsigned int count = gsl::narrow<unsigned int>(std::min(cchChunk, bytes.size() - pos));
+                unsigned int consumed = 0;
+                unsigned int generated = 0;
+                unique_ptr<wchar_t[]> output { nullptr };
+                if (SUCCEEDED(parser.Parse(bytes.data() + pos, count, consumed, output, generated)))
+                {
+                    cchArrays += generated;
+                }
+            }
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            Log::Comment(String().Format(L"Parse into new arrays: %.1f MB in %.2f ms, %.1f MB/s", megabytes, elapsed, megabytes * 1000.0 / elapsed));
+        }
+
+        size_t cchSpan = 0;
+        {
+            auto parser = Utf8ToWideCharParser { utf8CodePage };
+            std::vector<wchar_t> buffer(Utf8ToWideCharParser::GetMaxConvertedSize(cchChunk));
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t pos = 0; pos < bytes.size(); pos += cchChunk)
+            {
+                const size_t count = std::min(cchChunk, bytes.size() - pos);
+                size_t generated = 0;
+                if (SUCCEEDED(parser.Parse(gsl::make_span(bytes.data() + pos, count), gsl::make_span(buffer), generated)))
+                {
+                    cchSpan += generated;
+                }
+            }
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            Log::Comment(String().Format(L"Parse into a reused span: %.1f MB in %.2f ms, %.1f MB/s", megabytes, elapsed, megabytes * 1000.0 / elapsed));
+        }
+
+        VERIFY_ARE_EQUAL(cchArrays, cchSpan);
+    }
+
 };
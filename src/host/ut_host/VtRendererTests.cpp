@@ -11,6 +11,8 @@
 #include "../../renderer/vt/WinTelnetEngine.hpp"
 #include "../Settings.hpp"
 
+#include <chrono>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -109,6 +111,16 @@ class Microsoft::Console::Render::VtRendererTest
 
     TEST_METHOD(TestResize);
 
+    TEST_METHOD(TestDisjointInvalidRegions);
+
+    TEST_METHOD(TestOnlyChangedCellsArePainted);
+
+    TEST_METHOD(SequenceEmitterPerf);
+
+    TEST_METHOD(TestColorQuantizer);
+
+    TEST_METHOD(ColorQuantizationPerf);
+
     void Test16Colors(VtEngine* engine);
 
     std::deque<std::string> qExpectedInput;
@@ -247,6 +259,33 @@ void VtRendererTest::VtSequenceHelperTests()
 
     qExpectedInput.push_back("\x1b[10C");
     VERIFY_SUCCEEDED(engine->_CursorForward(10));
+
+    qExpectedInput.push_back("\x1b[10000;32767H");
+    VERIFY_SUCCEEDED(engine->_CursorPosition({32766, 9999}));
+
+    qExpectedInput.push_back("\x1b[91m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRendition16Color(FOREGROUND_RED | FOREGROUND_INTENSITY, true));
+
+    qExpectedInput.push_back("\x1b[44m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRendition16Color(FOREGROUND_BLUE, false));
+
+    qExpectedInput.push_back("\x1b[38;2;1;20;255m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(1, 20, 255), true));
+
+    qExpectedInput.push_back("\x1b[48;2;0;0;0m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(0, 0, 0), false));
+
+    qExpectedInput.push_back("\x1b[39m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionDefaultColor(true));
+
+    qExpectedInput.push_back("\x1b[22m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsBoldness(false));
+
+    qExpectedInput.push_back("\x1b]0;hello world\x7");
+    VERIFY_SUCCEEDED(engine->_ChangeTitle("hello world"));
+
+    qExpectedInput.push_back("\x1b]0;hi\x7");
+    VERIFY_SUCCEEDED(engine->_ChangeTitle("hi"));
 }
 
 void VtRendererTest::Xterm256TestInvalidate()
@@ -390,16 +429,22 @@ void VtRendererTest::Xterm256TestInvalidate()
         VerifyOutputTraits<SMALL_RECT>::ToString(engine->_invalidRect.ToExclusive())
     ));
 
-    qExpectedInput.push_back("\x1b[2J");
     TestPaint(*engine, [&]()
     {
         Log::Comment(NoThrowString().Format(
             L"---- Scrolled one down and one up, nothing should change ----"
-            L" But it still does for now MSFT:14169294"
+            L" But the top and bottom lines are still repainted for now MSFT:14169294"
         ));
         invalid = view.ToExclusive();
         VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
 
+        // The bounding box is the whole viewport, but only the two rows that
+        //      scrolled in are dirty, so the screen isn't cleared.
+        const auto& dirtyArea = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirtyArea.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 0, 79, 0 }), dirtyArea.at(0));
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 31, 79, 31 }), dirtyArea.at(1));
+
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
 }
@@ -785,16 +830,22 @@ void VtRendererTest::XtermTestInvalidate()
         VerifyOutputTraits<SMALL_RECT>::ToString(engine->_invalidRect.ToExclusive())
     ));
 
-    qExpectedInput.push_back("\x1b[2J");
     TestPaint(*engine, [&]()
     {
         Log::Comment(NoThrowString().Format(
             L"---- Scrolled one down and one up, nothing should change ----"
-            L" But it still does for now MSFT:14169294"
+            L" But the top and bottom lines are still repainted for now MSFT:14169294"
         ));
         invalid = view.ToExclusive();
         VERIFY_ARE_EQUAL(view, engine->_invalidRect);
 
+        // The bounding box is the whole viewport, but only the two rows that
+        //      scrolled in are dirty, so the screen isn't cleared.
+        const auto& dirtyArea = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirtyArea.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 0, 79, 0 }), dirtyArea.at(0));
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 31, 79, 31 }), dirtyArea.at(1));
+
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
 }
@@ -1338,3 +1389,296 @@ void VtRendererTest::TestResize()
 
 
 }
+
+void VtRendererTest::TestDisjointInvalidRegions()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Invalidate a status bar at the top and one cell at the bottom. "
+        L"Only those should be dirty, not everything in between."
+    ));
+    SMALL_RECT statusBar = { 60, 0, 80, 1 };
+    SMALL_RECT typed = { 5, 31, 6, 32 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&statusBar));
+    VERIFY_SUCCEEDED(engine->Invalidate(&typed));
+    TestPaint(*engine, [&]()
+    {
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 5, 0, 80, 32 }), engine->_invalidRect.ToExclusive());
+
+        const auto& dirtyArea = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirtyArea.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 60, 0, 79, 0 }), dirtyArea.at(0));
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 5, 31, 5, 31 }), dirtyArea.at(1));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Rows with the same dirty columns are reported as one rectangle."
+    ));
+    SMALL_RECT block = { 2, 3, 10, 7 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&block));
+    TestPaint(*engine, [&]()
+    {
+        const auto& dirtyArea = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), dirtyArea.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 2, 3, 9, 6 }), dirtyArea.at(0));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"After painting, nothing is dirty."
+    ));
+    VERIFY_IS_TRUE(engine->GetDirtyArea().empty());
+}
+
+void VtRendererTest::TestOnlyChangedCellsArePainted()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    std::vector<Cluster> clusters;
+    const auto paintLine = [&](const wchar_t* const line) {
+        clusters.clear();
+        for (size_t i = 0; i < wcslen(line); i++)
+        {
+            clusters.emplace_back(std::wstring_view{ &line[i], 1 }, static_cast<size_t>(1));
+        }
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 0, 1 }, false));
+    };
+
+    // The line is invalidated before every frame, like the renderer would.
+    SMALL_RECT invalid = { 0, 1, 80, 2 };
+
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Nothing was painted yet, so the whole line is sent."
+        ));
+        qExpectedInput.push_back("\x1b[2;1H");
+        qExpectedInput.push_back("hello world");
+        paintLine(L"hello world");
+    });
+
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Only the one character that changed is sent."
+        ));
+        qExpectedInput.push_back("\x1b[2;8H");
+        qExpectedInput.push_back("i");
+        paintLine(L"hello wirld");
+    });
+
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Painting the same line again sends nothing."
+        ));
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        paintLine(L"hello wirld");
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+    });
+
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"The cursor is moved forward over the unchanged cells."
+        ));
+        qExpectedInput.push_back("\x1b[3C");
+        qExpectedInput.push_back("!!");
+        paintLine(L"hello wirld!!");
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Text written straight to the terminal could have changed any cell, "
+        L"so the next paint sends the whole line again."
+    ));
+    qExpectedInput.push_back("x");
+    VERIFY_SUCCEEDED(engine->WriteTerminalUtf8("x"));
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    TestPaintXterm(*engine, [&]()
+    {
+        qExpectedInput.push_back("\r");
+        qExpectedInput.push_back("hello wirld!!");
+        paintLine(L"hello wirld!!");
+    });
+}
+
+void VtRendererTest::SequenceEmitterPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+    size_t cSequences = 0;
+    size_t cbSequences = 0;
+    engine->SetTestCallback([&](const char* const /*pch*/, size_t const cch) {
+        ++cSequences;
+        cbSequences += cch;
+        return true;
+    });
+
+    // A colorful 240x80 frame: every row starts with a cursor move, then
+    // changes colors every 8 columns, mixing table and RGB colors, erasing and
+    // skipping a few cells along the way.
+    const SHORT width = 240;
+    const SHORT height = 80;
+    const SHORT runLength = 8;
+    const size_t frames = 100;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        for (SHORT row = 0; row < height; ++row)
+        {
+            VERIFY_SUCCEEDED(engine->_CursorPosition({ 0, row }));
+            for (SHORT col = 0; col < width; col += runLength)
+            {
+                const COLORREF foreground = RGB(row * 3, col, (frame + col) & 0xff);
+                const COLORREF background = g_ColorTable[(col / runLength) % 16];
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(foreground, background, 0, (col / runLength) % 3 == 0, false));
+                VERIFY_SUCCEEDED(engine->_EraseCharacter(runLength / 2));
+                VERIFY_SUCCEEDED(engine->_CursorForward(runLength / 2));
+            }
+            VERIFY_SUCCEEDED(engine->_EraseLine());
+        }
+        VERIFY_SUCCEEDED(engine->_InsertLine(2));
+        VERIFY_SUCCEEDED(engine->_DeleteLine(2));
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    Log::Comment(String().Format(L"%zu frames of %dx%d: %zu sequences, %zu bytes, %.1f ns per sequence",
+                                 frames,
+                                 width,
+                                 height,
+                                 cSequences,
+                                 cbSequences,
+                                 elapsed / cSequences));
+}
+
+void VtRendererTest::TestColorQuantizer()
+{
+    COLORREF colorTable[COLOR_TABLE_SIZE];
+    std::copy(std::begin(g_ColorTable), std::end(g_ColorTable), colorTable);
+
+    ColorQuantizer quantizer;
+    VERIFY_ARE_EQUAL(ColorQuantizer::Metric::Hsl, quantizer.GetMetric());
+
+    Log::Comment(L"The HSL metric should agree with FindNearestTableIndex, whether or not the answer was cached.");
+    const auto verifyGrid = [&]() {
+        for (int r = 0; r < 256; r += 15)
+        {
+            for (int g = 0; g < 256; g += 17)
+            {
+                for (int b = 0; b < 256; b += 13)
+                {
+                    const COLORREF color = RGB(r, g, b);
+                    const WORD expected = ::FindNearestTableIndex(color, colorTable, COLOR_TABLE_SIZE);
+                    VERIFY_ARE_EQUAL(expected, quantizer.FindNearestTableIndex(color, colorTable, COLOR_TABLE_SIZE));
+                    VERIFY_ARE_EQUAL(expected, quantizer.FindNearestTableIndex(color, colorTable, COLOR_TABLE_SIZE));
+                }
+            }
+        }
+    };
+    verifyGrid();
+
+    Log::Comment(L"Changing an entry of the table should throw away the cached answers.");
+    const COLORREF color = RGB(250, 0, 250);
+    VERIFY_ARE_NOT_EQUAL(static_cast<WORD>(3), quantizer.FindNearestTableIndex(color, colorTable, COLOR_TABLE_SIZE));
+    colorTable[3] = color;
+    VERIFY_ARE_EQUAL(static_cast<WORD>(3), quantizer.FindNearestTableIndex(color, colorTable, COLOR_TABLE_SIZE));
+    verifyGrid();
+
+    Log::Comment(L"The perceptual metric should still find every color of the table exactly.");
+    quantizer.SetMetric(ColorQuantizer::Metric::Perceptual);
+    for (WORD i = 0; i < COLOR_TABLE_SIZE; i++)
+    {
+        VERIFY_ARE_EQUAL(i, quantizer.FindNearestTableIndex(colorTable[i], colorTable, COLOR_TABLE_SIZE));
+    }
+    VERIFY_ARE_EQUAL(static_cast<WORD>(0), quantizer.FindNearestTableIndex(RGB(1, 1, 1), g_ColorTable, COLOR_TABLE_SIZE));
+    VERIFY_ARE_EQUAL(static_cast<WORD>(15), quantizer.FindNearestTableIndex(RGB(254, 254, 254), g_ColorTable, COLOR_TABLE_SIZE));
+
+    Log::Comment(L"A copy should keep the metric.");
+    const ColorQuantizer copy = quantizer;
+    VERIFY_ARE_EQUAL(ColorQuantizer::Metric::Perceptual, copy.GetMetric());
+}
+
+void VtRendererTest::ColorQuantizationPerf()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    // A truecolor gradient, like a full screen of `lolcat` output drawn
+    // through a 16 color terminal: neighbouring cells have nearby colors,
+    // and every frame draws the same colors again.
+    const size_t width = 240;
+    const size_t height = 80;
+    const size_t frames = 20;
+    std::vector<COLORREF> gradient;
+    gradient.reserve(width * height);
+    for (size_t row = 0; row < height; ++row)
+    {
+        for (size_t col = 0; col < width; ++col)
+        {
+            gradient.push_back(RGB(col * 255 / width, row * 255 / height, (col + row) & 0xff));
+        }
+    }
+
+    const auto measure = [&](const wchar_t* const name, auto&& find) {
+        size_t sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (const COLORREF color : gradient)
+            {
+                sum += find(color);
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        Log::Comment(String().Format(L"%s: %.1f ns per lookup (checksum %zu)",
+                                     name,
+                                     elapsed / (frames * gradient.size()),
+                                     sum));
+    };
+
+    measure(L"FindNearestTableIndex", [&](const COLORREF color) {
+        return ::FindNearestTableIndex(color, g_ColorTable, COLOR_TABLE_SIZE);
+    });
+
+    ColorQuantizer hsl(ColorQuantizer::Metric::Hsl);
+    measure(L"ColorQuantizer (HSL)", [&](const COLORREF color) {
+        return hsl.FindNearestTableIndex(color, g_ColorTable, COLOR_TABLE_SIZE);
+    });
+
+    ColorQuantizer perceptual(ColorQuantizer::Metric::Perceptual);
+    measure(L"ColorQuantizer (perceptual)", [&](const COLORREF color) {
+        return perceptual.FindNearestTableIndex(color, g_ColorTable, COLOR_TABLE_SIZE);
+    });
+}
@@ -6,6 +6,10 @@
 #include "utf8ToWideCharParser.hpp"
 #include <unicode.hpp>
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#endif
+
 #ifndef WIL_ENABLE_EXCEPTIONS
 #error WIL exception helpers must be enabled
 #endif
@@ -133,6 +137,213 @@ HRESULT Utf8ToWideCharParser::Parse(_In_reads_(cchBuffer) const byte* const pByt
     return hr;
 }
 
+// Routine Description:
+// - Parses the input multi-byte sequence into a buffer owned by the caller.
+// - Unlike the other Parse, this one doesn't allocate and doesn't go through
+//   MultiByteToWideChar. Runs of ASCII are widened in blocks, and everything
+//   else goes through a decoder that checks each sequence as it goes, so
+//   overlong forms, surrogates, and values past U+10FFFF are dropped along with
+//   the other invalid sequences instead of failing the whole call.
+// - A sequence cut off at the end of the input is saved and finished by the
+//   next call, the same way as with the other Parse. All input is consumed.
+// Arguments:
+// - bytes - The byte sequence to parse.
+// - converted - Where to put the wide chars. Must hold at least
+//   GetMaxConvertedSize(bytes.size()) of them.
+// - cchConverted - Receives how many wide chars were written to converted.
+// Return Value:
+// - S_OK on success, E_NOT_SUFFICIENT_BUFFER if converted is too small,
+//   E_FAIL if the code page isn't UTF-8.
+[[nodiscard]]
+HRESULT Utf8ToWideCharParser::Parse(const gsl::span<const byte> bytes,
+                                    const gsl::span<wchar_t> converted,
+                                    _Out_ size_t& cchConverted) noexcept
+{
+    cchConverted = 0;
+
+    // we can't parse anything if we weren't given any data to parse
+    if (bytes.empty())
+    {
+        return S_OK;
+    }
+    // we shouldn't be parsing if the current codepage isn't UTF8
+    if (_currentCodePage != CP_UTF8)
+    {
+        _Reset();
+        return E_FAIL;
+    }
+    RETURN_HR_IF(E_NOT_SUFFICIENT_BUFFER, static_cast<size_t>(converted.size()) < GetMaxConvertedSize(bytes.size()));
+
+    wchar_t* pwchOut = converted.data();
+
+    // The sequence being decoded: its bytes so far, how many it should have,
+    // the code point built up from them, and the range the next byte has to be
+    // in so the sequence isn't overlong, a surrogate, or past U+10FFFF.
+    byte sequence[_UTF8_BYTE_SEQUENCE_MAX];
+    unsigned int sequenceLength = 0;
+    unsigned int sequenceSize = 0;
+    unsigned int codePoint = 0;
+    byte lowerBoundary = 0x80;
+    byte upperBoundary = 0xBF;
+
+    // Feeds one byte to the decoder. Returns false if the byte broke the sequence
+    // in progress, in which case that sequence is dropped and the byte needs to be
+    // looked at again on its own.
+    const auto decode = [&](const byte ch) noexcept {
+        if (sequenceSize == 0)
+        {
+            if (ch < 0x80)
+            {
+                *pwchOut++ = ch;
+                return true;
+            }
+            else if (ch >= 0xC2 && ch <= 0xDF)
+            {
+                sequenceSize = 2;
+                codePoint = ch & 0x1F;
+            }
+            else if (ch >= 0xE0 && ch <= 0xEF)
+            {
+                lowerBoundary = ch == 0xE0 ? 0xA0 : 0x80;
+                upperBoundary = ch == 0xED ? 0x9F : 0xBF;
+                sequenceSize = 3;
+                codePoint = ch & 0x0F;
+            }
+            else if (ch >= 0xF0 && ch <= 0xF4)
+            {
+                lowerBoundary = ch == 0xF0 ? 0x90 : 0x80;
+                upperBoundary = ch == 0xF4 ? 0x8F : 0xBF;
+                sequenceSize = 4;
+                codePoint = ch & 0x07;
+            }
+            else
+            {
+                // invalid byte, skip it.
+                return true;
+            }
+            sequence[0] = ch;
+            sequenceLength = 1;
+            return true;
+        }
+
+        if (ch < lowerBoundary || ch > upperBoundary)
+        {
+            sequenceSize = 0;
+            sequenceLength = 0;
+            lowerBoundary = 0x80;
+            upperBoundary = 0xBF;
+            return false;
+        }
+
+        lowerBoundary = 0x80;
+        upperBoundary = 0xBF;
+        codePoint = (codePoint << 6) | (ch & 0x3F);
+        sequence[sequenceLength++] = ch;
+
+        if (sequenceLength == sequenceSize)
+        {
+            if (codePoint < 0x10000)
+            {
+                *pwchOut++ = static_cast<wchar_t>(codePoint);
+            }
+            else
+            {
+                const unsigned int supplementary = codePoint - 0x10000;
+                *pwchOut++ = static_cast<wchar_t>(0xD800 + (supplementary >> 10));
+                *pwchOut++ = static_cast<wchar_t>(0xDC00 + (supplementary & 0x3FF));
+            }
+            sequenceSize = 0;
+            sequenceLength = 0;
+        }
+        return true;
+    };
+
+    // Finish off whatever was left over from last time first.
+    for (unsigned int i = 0; i < _bytesStored; ++i)
+    {
+        if (!decode(_utf8CodePointPieces[i]))
+        {
+            decode(_utf8CodePointPieces[i]);
+        }
+    }
+    _bytesStored = 0;
+
+    const byte* pb = bytes.data();
+    const byte* const pbEnd = pb + bytes.size();
+    while (pb < pbEnd)
+    {
+        if (sequenceSize == 0 && *pb < 0x80)
+        {
+            const size_t cchAscii = s_WidenAscii(pb, static_cast<size_t>(pbEnd - pb), pwchOut);
+            pb += cchAscii;
+            pwchOut += cchAscii;
+        }
+        else if (decode(*pb))
+        {
+            ++pb;
+        }
+    }
+
+    if (sequenceSize != 0)
+    {
+        _StorePartialSequence(sequence, sequenceLength);
+        _currentState = _State::BeginPartialParse;
+    }
+    else
+    {
+        _currentState = _State::Ready;
+    }
+
+    cchConverted = static_cast<size_t>(pwchOut - converted.data());
+    return S_OK;
+}
+
+// Routine Description:
+// - Widens the run of ASCII bytes at the start of pBytes into wide chars.
+//   On x86/x64 this converts 16 bytes at a time with SSE2, and then falls
+//   back to one byte at a time for the tail and for the block where the
+//   run ends.
+// Arguments:
+// - pBytes - The bytes to widen.
+// - cb - The amount of bytes in pBytes.
+// - pwch - Receives the wide chars. Must have room for cb of them.
+// Return Value:
+// - The length of the ASCII run, which is how many wide chars were written.
+size_t Utf8ToWideCharParser::s_WidenAscii(_In_reads_(cb) const byte* const pBytes,
+                                          const size_t cb,
+                                          _Out_writes_to_(cb, return) wchar_t* const pwch) noexcept
+{
+    size_t i = 0;
+
+#if defined(_M_IX86) || defined(_M_X64)
+    static_assert(sizeof(wchar_t) == sizeof(uint16_t), "The SSE2 widening assumes UTF-16 code units.");
+
+    const __m128i zero = _mm_setzero_si128();
+    while (cb - i >= 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + i));
+
+        // Any byte with its high bit set ends the run somewhere in this block.
+        if (_mm_movemask_epi8(chunk) != 0)
+        {
+            break;
+        }
+
+        // Interleaving with zeroes turns each byte into a little-endian wchar_t.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pwch + i), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pwch + i + 8), _mm_unpackhi_epi8(chunk, zero));
+        i += 16;
+    }
+#endif
+
+    while (i < cb && pBytes[i] < NonAsciiBytePrefix)
+    {
+        pwch[i] = pBytes[i];
+        ++i;
+    }
+    return i;
+}
+
 // Routine Description:
 // - Determines if ch is a UTF8 lead byte. See _Utf8SequenceSize() for a
 // description of how a lead byte is specified.
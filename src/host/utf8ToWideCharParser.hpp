@@ -9,6 +9,8 @@ Abstract:
 - This transforms a multi-byte character sequence into wide chars
 - It will attempt to work around invalid byte sequences
 - Partial byte sequences are supported
+- Input can either be converted into a new array for each call, or decoded
+  into a buffer the caller owns and reuses, which doesn't allocate
 
 Author(s):
 - Austin Diviness (AustDi) 16-August-2016
@@ -28,6 +30,20 @@ public:
                   _Inout_ std::unique_ptr<wchar_t[]>& converted,
                   _Out_ unsigned int& cchConverted);
 
+    [[nodiscard]]
+    HRESULT Parse(const gsl::span<const byte> bytes,
+                  const gsl::span<wchar_t> converted,
+                  _Out_ size_t& cchConverted) noexcept;
+
+    // Routine Description:
+    // - Gets how much room the span version of Parse needs for the given number of bytes.
+    //   No sequence decodes to more wide chars than it has bytes, and at most a partial
+    //   sequence's worth of bytes can be left over from the previous call.
+    static constexpr size_t GetMaxConvertedSize(const size_t cb) noexcept
+    {
+        return cb + _UTF8_BYTE_SEQUENCE_MAX;
+    }
+
 private:
     enum class _State
     {
@@ -51,6 +67,10 @@ private:
     void _StorePartialSequence(_In_reads_(cb) const byte* const pLeadByte, const unsigned int cb);
     void _Reset();
 
+    static size_t s_WidenAscii(_In_reads_(cb) const byte* const pBytes,
+                               const size_t cb,
+                               _Out_writes_to_(cb, return) wchar_t* const pwch) noexcept;
+
     static const unsigned int _UTF8_BYTE_SEQUENCE_MAX = 4;
 
     byte _utf8CodePointPieces[_UTF8_BYTE_SEQUENCE_MAX];
@@ -4,6 +4,9 @@ Licensed under the MIT license.
 --*/
 #pragma once
 
+#include <array>
+#include <memory>
+
 #define FG_ATTRS (FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY)
 #define BG_ATTRS (BACKGROUND_BLUE | BACKGROUND_GREEN | BACKGROUND_RED | BACKGROUND_INTENSITY)
 #define META_ATTRS (COMMON_LVB_LEADING_BYTE | COMMON_LVB_TRAILING_BYTE | COMMON_LVB_GRID_HORIZONTAL | COMMON_LVB_GRID_LVERTICAL | COMMON_LVB_GRID_RVERTICAL | COMMON_LVB_REVERSE_VIDEO | COMMON_LVB_UNDERSCORE )
@@ -54,3 +57,75 @@ constexpr COLORREF INVALID_COLOR = 0xffffffff;
 
 constexpr WORD COLOR_TABLE_SIZE = 16;
 constexpr WORD XTERM_COLOR_TABLE_SIZE = 256;
+
+// Finds the nearest color table entry for RGB colors like FindNearestTableIndex
+//      does, but remembers what it worked out about the table and recent
+//      colors, so that a stream of colors against the same table (like a
+//      truecolor gradient drawn through a 16 color renderer) is cheap.
+// - The table is copied and compared on every call, and everything is thrown
+//      away when it changes. Tables larger than COLOR_TABLE_SIZE aren't cached.
+// - Metric::Hsl gives exactly the same answers as FindNearestTableIndex.
+// - Metric::Perceptual compares colors with a weighted RGB distance instead,
+//      and answers from a lookup table at 5 bits per channel, built up as
+//      colors are seen. It's faster, but colors that share a cell of the
+//      lookup table share an answer.
+class ColorQuantizer final
+{
+public:
+    enum class Metric
+    {
+        Hsl,
+        Perceptual
+    };
+
+    ColorQuantizer(const Metric metric = Metric::Hsl) noexcept;
+    ColorQuantizer(const ColorQuantizer& other) noexcept;
+    ColorQuantizer& operator=(const ColorQuantizer& other) noexcept;
+    ~ColorQuantizer() = default;
+
+    WORD FindNearestTableIndex(const COLORREF Color,
+                               _In_reads_(cColorTable) const COLORREF* const ColorTable,
+                               const WORD cColorTable) noexcept;
+
+    Metric GetMetric() const noexcept;
+    void SetMetric(const Metric metric) noexcept;
+
+    static constexpr size_t s_cCacheEntries = 256;
+    static constexpr unsigned int s_lutBits = 5;
+
+private:
+    struct CacheEntry
+    {
+        COLORREF color;
+        WORD index;
+    };
+
+    struct Hsl
+    {
+        double h;
+        double s;
+        double l;
+    };
+
+    bool _IsTableCurrent(_In_reads_(cColorTable) const COLORREF* const ColorTable, const WORD cColorTable) const noexcept;
+    void _SetTable(_In_reads_(cColorTable) const COLORREF* const ColorTable, const WORD cColorTable) noexcept;
+    void _ClearCache() noexcept;
+
+    WORD _FindNearestHsl(const COLORREF Color) const noexcept;
+    WORD _FindNearestPerceptual(const COLORREF Color) const noexcept;
+    WORD _LookupPerceptual(const COLORREF Color) noexcept;
+
+    static size_t s_CacheSlot(const COLORREF Color) noexcept;
+
+    Metric _metric;
+
+    WORD _cTable;
+    std::array<COLORREF, COLOR_TABLE_SIZE> _table;
+    std::array<Hsl, COLOR_TABLE_SIZE> _tableHsl;
+
+    std::array<CacheEntry, s_cCacheEntries> _cache;
+
+    // One table index per cell, or s_lutEmpty if the cell hasn't been worked out yet.
+    std::unique_ptr<BYTE[]> _lut;
+    static constexpr BYTE s_lutEmpty = 0xff;
+};
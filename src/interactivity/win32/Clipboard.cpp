@@ -208,11 +208,46 @@ void Clipboard::StoreSelectionToClipboard(bool const fAlsoCopyHtml)
     const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     const auto& screenInfo = gci.GetActiveOutputBuffer();
 
-    const auto text = RetrieveTextFromBuffer(screenInfo,
-                                             lineSelection,
-                                             selectionRects);
+    // Build the plain text and the HTML in the same pass over the selection,
+    // straight from its runs of color.
+    std::wstring text;
+    std::optional<HtmlBuilder> html;
+    if (fAlsoCopyHtml)
+    {
+        html.emplace();
+    }
+
+    RetrieveRunsFromBuffer(screenInfo,
+                           lineSelection,
+                           selectionRects,
+                           [&](const size_t /*rectIndex*/, const std::wstring_view runText, const COLORREF foreground, const COLORREF background) {
+                               text.append(runText);
+                               if (html)
+                               {
+                                   try
+                                   {
+                                       html->AppendRun(runText, foreground, background);
+                                   }
+                                   catch (...)
+                                   {
+                                       // dont return a partial html fragment...
+                                       LOG_HR(wil::ResultFromCaughtException());
+                                       html.reset();
+                                   }
+                               }
+                           });
+
+    std::string htmlText;
+    if (html)
+    {
+        try
+        {
+            htmlText = html->Finish();
+        }
+        CATCH_LOG();
+    }
 
-    CopyTextToSystemClipboard(text, fAlsoCopyHtml);
+    CopyTextToSystemClipboard(text, htmlText);
 }
 
 // Routine Description:
@@ -240,265 +275,245 @@ TextBuffer::TextAndColor Clipboard::RetrieveTextFromBuffer(const SCREEN_INFORMAT
 }
 
 // Routine Description:
-// - Generates a CF_HTML compliant structure based on the passed in text and color data
+// - Retrieves the text data from the selected region of the text buffer a run
+//   of colors at a time, without gathering it up first.
 // Arguments:
-// - rows - the text and color data we will format & encapsulate
-// Return Value:
-// - string containing the generated HTML
-std::string Clipboard::GenHTML(const TextBuffer::TextAndColor& rows)
+// - screenInfo - what is rendered on the screen
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - writeRun - called with each run of text and its colors, in order
+void Clipboard::RetrieveRunsFromBuffer(const SCREEN_INFORMATION& screenInfo,
+                                       const bool lineSelection,
+                                       const std::vector<SMALL_RECT>& selectionRects,
+                                       const TextBuffer::SelectionRunCallback& writeRun)
 {
-    std::string szClipboard;            // we will build the data going back in this string buffer
+    const auto &buffer = screenInfo.GetTextBuffer();
+    const bool trimTrailingWhitespace = !WI_IsFlagSet(GetKeyState(VK_SHIFT), KEY_PRESSED);
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    try
-    {
-        std::string const szHtmlClipFormat =
-            "Version:0.9\r\n"
-            "StartHTML:%010d\r\n"
-            "EndHTML:%010d\r\n"
-            "StartFragment:%010d\r\n"
-            "EndFragment:%010d\r\n"
-            "StartSelection:%010d\r\n"
-            "EndSelection:%010d\r\n";
+    std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
+    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
 
-        // measure clip header
-        size_t const cbHeader = 157;        // when formats are expanded, there will be 157 bytes in the header.
+    buffer.WriteSelectionRuns(lineSelection,
+                              trimTrailingWhitespace,
+                              selectionRects,
+                              GetForegroundColor,
+                              GetBackgroundColor,
+                              writeRun);
+}
 
-        std::string const szHtmlHeader =
-            "<!DOCTYPE><HTML><HEAD><TITLE>Windows Console Host</TITLE></HEAD><BODY>";
-        size_t const cbHtmlHeader = szHtmlHeader.size();
+// The parts of the CF_HTML document that go around the selected text.
+static constexpr std::string_view s_htmlHeader{ "<!DOCTYPE><HTML><HEAD><TITLE>Windows Console Host</TITLE></HEAD><BODY>" };
+static constexpr std::string_view s_htmlFragStart{ "<!--StartFragment -->" };
+static constexpr std::string_view s_htmlFragEnd{ "<!--EndFragment -->" };
+static constexpr std::string_view s_htmlFooter{ "</BODY></HTML>" };
+static constexpr std::string_view s_htmlSpanEnd{ "</SPAN>" };
+static constexpr std::string_view s_htmlDivEnd{ "</DIV>" };
 
-        std::string const szHtmlFragStart = "<!--StartFragment -->";
-        std::string const szHtmlFragEnd = "<!--EndFragment -->";
-        std::string const szHtmlFooter = "</BODY></HTML>";
-        size_t const cbHtmlFooter = szHtmlFooter.size();
+// when the clip header's formats are expanded, there will be 157 bytes in it.
+static constexpr size_t s_cbHtmlClipHeader = 157;
 
-        std::string const szDivOuterBackgroundPattern = R"X(<DIV STYLE="background-color:#%02x%02x%02x;white-space:pre;">)X";
+// Routine Description:
+// - Adds one run of selected text to the CF_HTML document, in a span of its
+//   colors. The document is started by the first run that has any text.
+// Arguments:
+// - text - the text of the run
+// - foreground - the color of the text
+// - background - the color behind the text
+void Clipboard::HtmlBuilder::AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background)
+{
+    if (text.empty())
+    {
+        return;
+    }
 
-        size_t const cbDivOuter = 55;
-        std::string szDivOuter;
-        szDivOuter.reserve(cbDivOuter);
+    if (!_started)
+    {
+        _Start(background);
+    }
 
-        std::string const szSpanFontSizePattern = R"X(<SPAN STYLE="font-size: %dpt">)X";
+    if (!_spanOpen || foreground != _foreground || background != _background)
+    {
+        if (_spanOpen)
+        {
+            // close previous span
+            _html.append(s_htmlSpanEnd);
+        }
 
-        const auto& fontData = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetCurrentFont();
-        int const iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
-        size_t const cbSpanFontSize = 28 + (iFontHeightPoints / 10) + 1;
+        // start new span
+        std::string const szSpanStartPattern = R"X(<SPAN STYLE="color:#%02x%02x%02x;background-color:#%02x%02x%02x">)X";
+        size_t const cbSpanStart = 53;          // when format is expanded, there will be 53 bytes per color pattern.
 
-        std::string szSpanFontSize;
-        szSpanFontSize.resize(cbSpanFontSize + 1);    // reserve space for null after string for sprintf
-        sprintf_s(szSpanFontSize.data(), cbSpanFontSize + 1, szSpanFontSizePattern.data(), iFontHeightPoints);
-        szSpanFontSize.resize(cbSpanFontSize);      //chop off null at end
+        const size_t offset = _html.size();
+        _html.resize(offset + cbSpanStart + 1);    // +1 for null terminator
+        sprintf_s(_html.data() + offset, cbSpanStart + 1, szSpanStartPattern.data(),
+            GetRValue(foreground), GetGValue(foreground), GetBValue(foreground),
+            GetRValue(background), GetGValue(background), GetBValue(background));
+        _html.resize(offset + cbSpanStart);        // chop null from sprintf
 
-        std::string const szSpanStartPattern = R"X(<SPAN STYLE="color:#%02x%02x%02x;background-color:#%02x%02x%02x">)X";
+        _foreground = foreground;
+        _background = background;
+        _spanOpen = true;
+    }
 
-        size_t const cbSpanStart = 53;          // when format is expanded, there will be 53 bytes per color pattern.
-        std::string szSpanStart;
-        szSpanStart.resize(cbSpanStart + 1);    // +1 for null terminator
+    // convert the run straight onto the end of the document
+    int const cchText = gsl::narrow<int>(text.size());
+    int const cbConverted = WideCharToMultiByte(CP_UTF8, 0, text.data(), cchText, nullptr, 0, nullptr, nullptr);
+    THROW_LAST_ERROR_IF(cbConverted == 0);
+    const size_t offset = _html.size();
+    _html.resize(offset + cbConverted);
+    THROW_LAST_ERROR_IF(0 == WideCharToMultiByte(CP_UTF8, 0, text.data(), cchText, _html.data() + offset, cbConverted, nullptr, nullptr));
+}
 
-        std::string const szSpanStartFontPattern = R"X(<SPAN STYLE="font-family: '%s', monospace">)X";
-        size_t const cbSpanStartFontPattern = 41;
+// Routine Description:
+// - Lays down the CF_HTML boilerplate that comes before the selected text:
+//   space for the clip header, the document header, and the spans for the
+//   background and font.
+// Arguments:
+// - background - the background color of the first run, used for the whole fragment
+void Clipboard::HtmlBuilder::_Start(const COLORREF background)
+{
+    std::string const szDivOuterBackgroundPattern = R"X(<DIV STYLE="background-color:#%02x%02x%02x;white-space:pre;">)X";
 
-        std::string const szSpanStartFontConstant = R"X(<SPAN STYLE="font-family: monospace">)X";
-        size_t const cbSpanStartFontConstant = 37;
+    size_t const cbDivOuter = 55;
+    std::string szDivOuter;
+    szDivOuter.reserve(cbDivOuter);
 
-        std::string szSpanStartFont;
-        size_t cbSpanStartFont;
-        bool fDeleteSpanStartFont = false;
+    std::string const szSpanFontSizePattern = R"X(<SPAN STYLE="font-size: %dpt">)X";
 
-        std::wstring const wszFontFaceName = fontData.GetFaceName();
-        size_t const cchFontFaceName = wszFontFaceName.size();
-        if (cchFontFaceName > 0)
-        {
-            // measure and create buffer to convert face name to UTF8
-            int const cbNeeded = WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), nullptr, 0, nullptr, nullptr);
-            std::string szBuffer;
-            szBuffer.resize(cbNeeded);
+    const auto& fontData = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetCurrentFont();
+    int const iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
+    size_t const cbSpanFontSize = 28 + (iFontHeightPoints / 10) + 1;
 
-            // do conversion
-            WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), szBuffer.data(), cbNeeded, nullptr, nullptr);
+    std::string szSpanFontSize;
+    szSpanFontSize.resize(cbSpanFontSize + 1);    // reserve space for null after string for sprintf
+    sprintf_s(szSpanFontSize.data(), cbSpanFontSize + 1, szSpanFontSizePattern.data(), iFontHeightPoints);
+    szSpanFontSize.resize(cbSpanFontSize);      //chop off null at end
 
-            // format converted font name into pattern
-            std::string const szFinalFontPattern = R"X(<SPAN STYLE="font-family: ')X" + szBuffer + R"X(', monospace\">)X";
-            size_t const cbBytesNeeded = szFinalFontPattern.length();
+    std::string const szSpanStartFontConstant = R"X(<SPAN STYLE="font-family: monospace">)X";
 
-            fDeleteSpanStartFont = true;
-            szSpanStartFont = szFinalFontPattern;
-            cbSpanStartFont = cbBytesNeeded;
-        }
-        else
-        {
-            szSpanStartFont = szSpanStartFontConstant;
-            cbSpanStartFont = cbSpanStartFontConstant;
-        }
+    std::string szSpanStartFont;
 
-        std::string const szSpanEnd = "</SPAN>";
-        std::string const szDivEnd = "</DIV>";
+    std::wstring const wszFontFaceName = fontData.GetFaceName();
+    size_t const cchFontFaceName = wszFontFaceName.size();
+    if (cchFontFaceName > 0)
+    {
+        // measure and create buffer to convert face name to UTF8
+        int const cbNeeded = WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), nullptr, 0, nullptr, nullptr);
+        std::string szBuffer;
+        szBuffer.resize(cbNeeded);
 
-        // Start building the HTML formated string to return
-        // First we have to add the required header and then
-        // some standard HTML boiler plate required for CF_HTML
-        // as part of the HTML Clipboard format
-        szClipboard.append(cbHeader, 'H');         // reserve space for a header we fill in later
-        szClipboard.append(szHtmlHeader);
-        szClipboard.append(szHtmlFragStart);
+        // do conversion
+        WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), szBuffer.data(), cbNeeded, nullptr, nullptr);
 
-        COLORREF iBgColor = rows.BkAttr.at(0).at(0);
+        // format converted font name into pattern
+        szSpanStartFont = R"X(<SPAN STYLE="font-family: ')X" + szBuffer + R"X(', monospace\">)X";
+    }
+    else
+    {
+        szSpanStartFont = szSpanStartFontConstant;
+    }
 
-        szDivOuter.resize(cbDivOuter + 1);
-        sprintf_s(szDivOuter.data(), cbDivOuter + 1, szDivOuterBackgroundPattern.data(), GetRValue(iBgColor), GetGValue(iBgColor), GetBValue(iBgColor));
-        szDivOuter.resize(cbDivOuter);
-        szClipboard.append(szDivOuter);
+    // Start building the HTML formated string to return
+    // First we have to add the required header and then
+    // some standard HTML boiler plate required for CF_HTML
+    // as part of the HTML Clipboard format
+    _html.append(s_cbHtmlClipHeader, 'H');         // reserve space for a header we fill in later
+    _html.append(s_htmlHeader);
+    _html.append(s_htmlFragStart);
 
-        // copy font face start
-        szClipboard.append(szSpanStartFont);
+    szDivOuter.resize(cbDivOuter + 1);
+    sprintf_s(szDivOuter.data(), cbDivOuter + 1, szDivOuterBackgroundPattern.data(), GetRValue(background), GetGValue(background), GetBValue(background));
+    szDivOuter.resize(cbDivOuter);
+    _html.append(szDivOuter);
 
-        // copy font size start
-        szClipboard.append(szSpanFontSize);
+    // copy font face start
+    _html.append(szSpanStartFont);
 
-        bool bColorFound = false;
+    // copy font size start
+    _html.append(szSpanFontSize);
 
-        // copy all text into the final clipboard data handle. There should be no nulls between rows of
-        // characters, but there should be a \0 at the end.
-        for (UINT iRow = 0; iRow < rows.text.size(); iRow++)
-        {
-            size_t cbStartOffset = 0;
-            size_t cchCharsToPrint = 0;
-
-            COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
-            COLORREF fgColor = Blackness;
-            COLORREF bkColor = Blackness;
-
-            for (UINT iCol = 0; iCol < rows.text.at(iRow).length(); iCol++)
-            {
-                bool fColorDelta = false;
-
-                if (!bColorFound)
-                {
-                    fgColor = rows.FgAttr.at(iRow).at(iCol);
-                    bkColor = rows.BkAttr.at(iRow).at(iCol);
-                    bColorFound = true;
-                    fColorDelta = true;
-                }
-                else if ((rows.FgAttr.at(iRow).at(iCol) != fgColor) || (rows.BkAttr.at(iRow).at(iCol) != bkColor))
-                {
-                    fgColor = rows.FgAttr.at(iRow).at(iCol);
-                    bkColor = rows.BkAttr.at(iRow).at(iCol);
-                    fColorDelta = true;
-                }
-
-                if (fColorDelta)
-                {
-                    if (cchCharsToPrint > 0)
-                    {
-                        // write accumulated characters to stream ....
-                        std::string TempBuff;
-                        int const cbTempCharsNeeded = WideCharToMultiByte(CP_UTF8, 0, rows.text[iRow].data() + cbStartOffset, static_cast<int>(cchCharsToPrint), nullptr, 0, nullptr, nullptr);
-                        TempBuff.resize(cbTempCharsNeeded);
-                        WideCharToMultiByte(CP_UTF8, 0, rows.text[iRow].data() + cbStartOffset, static_cast<int>(cchCharsToPrint), TempBuff.data(), cbTempCharsNeeded, nullptr, nullptr);
-                        szClipboard.append(TempBuff);
-                        cbStartOffset += cchCharsToPrint;
-                        cchCharsToPrint = 0;
-
-                        // close previous span
-                        szClipboard += szSpanEnd;
-                    }
-
-                    // start new span
-
-                    // format with color then copy formatted string
-                    szSpanStart.resize(cbSpanStart + 1);       // add room for null
-                    sprintf_s(szSpanStart.data(), cbSpanStart + 1, szSpanStartPattern.data(),
-                        GetRValue(fgColor), GetGValue(fgColor), GetBValue(fgColor),
-                        GetRValue(bkColor), GetGValue(bkColor), GetBValue(bkColor));
-                    szSpanStart.resize(cbSpanStart);        // chop null from sprintf
-                    szClipboard.append(szSpanStart);
-
-                }
-
-                // accumulate 1 character
-                cchCharsToPrint++;
-            }
-
-            PCWCHAR pwchAccumulateStart = rows.text.at(iRow).data() + cbStartOffset;
-
-            // write accumulated characters to stream
-            std::string CharsConverted;
-            int cbCharsConverted = WideCharToMultiByte(CP_UTF8, 0, pwchAccumulateStart, static_cast<int>(cchCharsToPrint), nullptr, 0, nullptr, nullptr);
-            CharsConverted.resize(cbCharsConverted);
-            WideCharToMultiByte(CP_UTF8, 0, pwchAccumulateStart, static_cast<int>(cchCharsToPrint), CharsConverted.data(), cbCharsConverted, nullptr, nullptr);
-            szClipboard.append(CharsConverted);
-        }
+    _started = true;
+}
 
-        if (bColorFound)
-        {
-            // copy end span
-            szClipboard.append(szSpanEnd);
-        }
+// Routine Description:
+// - Wraps up the CF_HTML document after the last run and fills in its header.
+// Return Value:
+// - string containing the generated HTML, or an empty string if no text was added
+std::string Clipboard::HtmlBuilder::Finish()
+{
+    if (!_started)
+    {
+        return {};
+    }
 
-        // after we have copied all text we must wrap up
-        // with a standard set of HTML boilerplate required
-        // by CF_HTML
+    if (_spanOpen)
+    {
+        // copy end span
+        _html.append(s_htmlSpanEnd);
+        _spanOpen = false;
+    }
 
-        // copy end font size span
-        szClipboard.append(szSpanEnd);
+    // after we have copied all text we must wrap up
+    // with a standard set of HTML boilerplate required
+    // by CF_HTML
 
-        // copy end font face span
-        szClipboard.append(szSpanEnd);
+    // copy end font size span
+    _html.append(s_htmlSpanEnd);
 
-        // copy end background color span
-        szClipboard.append(szDivEnd);
+    // copy end font face span
+    _html.append(s_htmlSpanEnd);
 
-        // copy HTML end fragment
-        szClipboard.append(szHtmlFragEnd);
+    // copy end background color span
+    _html.append(s_htmlDivEnd);
 
-        // copy HTML footer
-        szClipboard.append(szHtmlFooter);
+    // copy HTML end fragment
+    _html.append(s_htmlFragEnd);
 
-        // null terminate the clipboard data
-        szClipboard += '\0';
+    // copy HTML footer
+    _html.append(s_htmlFooter);
 
-        // we are done generating formating & building HTML for the selection
-        // prepare the header text with the byte counts now that we know them
-        size_t const cbHtmlStart = cbHeader;                    // bytecount to start of HTML context
-        size_t const cbHtmlEnd = szClipboard.size() - 1;        // don't count the null at the end
-        size_t const cbFragStart = cbHeader + cbHtmlHeader;     // bytecount to start of selection fragment
-        size_t const cbFragEnd = cbHtmlEnd - cbHtmlFooter;
+    // null terminate the clipboard data
+    _html += '\0';
 
-        // push the values into the required HTML 0.9 header format
-        std::string szHtmlClipHeaderFinal;
-        szHtmlClipHeaderFinal.resize(cbHeader + 1);   // add room for a null
-        sprintf_s(szHtmlClipHeaderFinal.data(), cbHeader + 1, szHtmlClipFormat.data(), cbHtmlStart, cbHtmlEnd, cbFragStart, cbFragEnd, cbFragStart, cbFragEnd);
-        szHtmlClipHeaderFinal.resize(cbHeader);    // chop off the null
+    std::string const szHtmlClipFormat =
+        "Version:0.9\r\n"
+        "StartHTML:%010d\r\n"
+        "EndHTML:%010d\r\n"
+        "StartFragment:%010d\r\n"
+        "EndFragment:%010d\r\n"
+        "StartSelection:%010d\r\n"
+        "EndSelection:%010d\r\n";
 
-        // overwrite the reserved space with the actual header & offsets we calculated
-        szClipboard.replace(0, cbHeader, szHtmlClipHeaderFinal.data());
-    }
-    catch(...)
-    {
-        LOG_HR(wil::ResultFromCaughtException());
-        szClipboard.clear();            // dont return a partial html fragment...
-    }
+    // we are done generating formating & building HTML for the selection
+    // prepare the header text with the byte counts now that we know them
+    size_t const cbHtmlStart = s_cbHtmlClipHeader;                      // bytecount to start of HTML context
+    size_t const cbHtmlEnd = _html.size() - 1;                          // don't count the null at the end
+    size_t const cbFragStart = s_cbHtmlClipHeader + s_htmlHeader.size(); // bytecount to start of selection fragment
+    size_t const cbFragEnd = cbHtmlEnd - s_htmlFooter.size();
 
-    return szClipboard;
-}
+    // push the values into the required HTML 0.9 header format
+    std::string szHtmlClipHeaderFinal;
+    szHtmlClipHeaderFinal.resize(s_cbHtmlClipHeader + 1);   // add room for a null
+    sprintf_s(szHtmlClipHeaderFinal.data(), s_cbHtmlClipHeader + 1, szHtmlClipFormat.data(), cbHtmlStart, cbHtmlEnd, cbFragStart, cbFragEnd, cbFragStart, cbFragEnd);
+    szHtmlClipHeaderFinal.resize(s_cbHtmlClipHeader);    // chop off the null
 
+    // overwrite the reserved space with the actual header & offsets we calculated
+    _html.replace(0, s_cbHtmlClipHeader, szHtmlClipHeaderFinal.data());
+
+    _started = false;
+    return std::move(_html);
+}
 
 // Routine Description:
 // - Copies the text given onto the global system clipboard.
 // Arguments:
-// - rows - Rows of text data to copy
-void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyHtml)
+// - text - The plain text to copy
+// - html - The CF_HTML form of the text to copy along with it, if not empty
+void Clipboard::CopyTextToSystemClipboard(const std::wstring& text, const std::string& html)
 {
-    std::wstring finalString;
-
-    // Concatenate strings into one giant string to put onto the clipboard.
-    for (const auto& str : rows.text)
-    {
-        finalString += str;
-    }
-
     // allocate the final clipboard data
-    const size_t cchNeeded = finalString.size() + 1;
+    const size_t cchNeeded = text.size() + 1;
     const size_t cbNeeded = sizeof(wchar_t) * cchNeeded;
     wil::unique_hglobal globalHandle(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeeded));
     THROW_LAST_ERROR_IF_NULL(globalHandle.get());
@@ -508,7 +523,7 @@ void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows,
 
     // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
     // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
-    const HRESULT hr = StringCchCopyW(pwszClipboard, cchNeeded, finalString.data());
+    const HRESULT hr = StringCchCopyW(pwszClipboard, cchNeeded, text.data());
     GlobalUnlock(globalHandle.get());
     THROW_IF_FAILED(hr);
 
@@ -517,34 +532,30 @@ void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows,
     THROW_LAST_ERROR_IF(!EmptyClipboard());
     THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_UNICODETEXT, globalHandle.get()));
 
-    if (fAlsoCopyHtml)
+    const size_t cbNeededHTML = html.size();
+    if (cbNeededHTML)
     {
-        std::string HTMLToPlaceOnClip = GenHTML(rows);
-        const size_t cbNeededHTML = HTMLToPlaceOnClip.size();
-        if (cbNeededHTML)
-        {
-            wil::unique_hglobal globalHandleHTML(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeededHTML));
-            THROW_LAST_ERROR_IF_NULL(globalHandleHTML.get());
+        wil::unique_hglobal globalHandleHTML(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeededHTML));
+        THROW_LAST_ERROR_IF_NULL(globalHandleHTML.get());
 
-            PSTR pszClipboardHTML = (PSTR)GlobalLock(globalHandleHTML.get());
-            THROW_LAST_ERROR_IF_NULL(pszClipboardHTML);
+        PSTR pszClipboardHTML = (PSTR)GlobalLock(globalHandleHTML.get());
+        THROW_LAST_ERROR_IF_NULL(pszClipboardHTML);
 
-            // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
-            // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
-            const HRESULT hr2 = StringCchCopyA(pszClipboardHTML, cbNeededHTML, HTMLToPlaceOnClip.data());
-            GlobalUnlock(globalHandleHTML.get());
-            THROW_IF_FAILED(hr2);
+        // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
+        // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
+        const HRESULT hr2 = StringCchCopyA(pszClipboardHTML, cbNeededHTML, html.data());
+        GlobalUnlock(globalHandleHTML.get());
+        THROW_IF_FAILED(hr2);
 
-            UINT const CF_HTML = RegisterClipboardFormatW(L"HTML Format");
-            THROW_LAST_ERROR_IF(0 == CF_HTML);
+        UINT const CF_HTML = RegisterClipboardFormatW(L"HTML Format");
+        THROW_LAST_ERROR_IF(0 == CF_HTML);
 
-            THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_HTML, globalHandleHTML.get()));
+        THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_HTML, globalHandleHTML.get()));
 
-            // only free if we failed.
-            // the memory has to remain allocated if we successfully placed it on the clipboard.
-            // Releasing the smart pointer will leave it allocated as we exit scope.
-            globalHandleHTML.release();
-        }
+        // only free if we failed.
+        // the memory has to remain allocated if we successfully placed it on the clipboard.
+        // Releasing the smart pointer will leave it allocated as we exit scope.
+        globalHandleHTML.release();
     }
 
     THROW_LAST_ERROR_IF(!CloseClipboard());
@@ -1359,7 +1359,7 @@ const unsigned int UiaTextRange::_rowCountInRange() const
 // - the equivalent ScreenInfoRow.
 const ScreenInfoRow UiaTextRange::_textBufferRowToScreenInfoRow(const TextBufferRow row)
 {
-    const int firstRowIndex = _getTextBuffer().GetFirstRowIndex();
+    const int firstRowIndex = gsl::narrow<int>(_getTextBuffer().GetFirstRowIndex());
     return _normalizeRow(row - firstRowIndex);
 }
 
@@ -1467,7 +1467,7 @@ const bool UiaTextRange::_isScreenInfoRowInViewport(const ScreenInfoRow row,
 // - the equivalent TextBufferRow.
 const TextBufferRow UiaTextRange::_screenInfoRowToTextBufferRow(const ScreenInfoRow row)
 {
-    const TextBufferRow firstRowIndex = _getTextBuffer().GetFirstRowIndex();
+    const TextBufferRow firstRowIndex = gsl::narrow<TextBufferRow>(_getTextBuffer().GetFirstRowIndex());
     return _normalizeRow(row + firstRowIndex);
 }
 
@@ -44,9 +44,30 @@ namespace Microsoft::Console::Interactivity::Win32
                                                          const bool lineSelection,
                                                          const std::vector<SMALL_RECT>& selectionRects);
 
-        void CopyHTMLToClipboard(const TextBuffer::TextAndColor& rows);
-        std::string GenHTML(const TextBuffer::TextAndColor & rows);
-        void CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, _In_ bool const fAlsoCopyHtml);
+        void RetrieveRunsFromBuffer(const SCREEN_INFORMATION& screenInfo,
+                                    const bool lineSelection,
+                                    const std::vector<SMALL_RECT>& selectionRects,
+                                    const TextBuffer::SelectionRunCallback& writeRun);
+
+        // Builds the CF_HTML form of a selection from its runs of text as they
+        // come out of the buffer, one colored span per change of color.
+        class HtmlBuilder
+        {
+        public:
+            void AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background);
+            std::string Finish();
+
+        private:
+            void _Start(const COLORREF background);
+
+            std::string _html;
+            bool _started = false;
+            bool _spanOpen = false;
+            COLORREF _foreground = 0;
+            COLORREF _background = 0;
+        };
+
+        void CopyTextToSystemClipboard(const std::wstring& text, const std::string& html);
 
         bool FilterCharacterOnPaste(_Inout_ WCHAR * const pwch);
 
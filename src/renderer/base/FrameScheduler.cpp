@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "FrameScheduler.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+FrameScheduler::FrameScheduler(const FramePacing pacing, const DWORD budgetMilliseconds) noexcept :
+    _pacing{ pacing },
+    _budget{ std::chrono::milliseconds(budgetMilliseconds) },
+    _pendingCells{ 0 },
+    _pendingSince{ 0 },
+    _frameStart{},
+    _framePendingSince{ 0 },
+    _lastFrameStart{},
+    _lastFrameEnd{},
+    _lastFrameDuration{},
+    _frames{ 0 },
+    _framesWithLatency{ 0 },
+    _firstFrameStart{},
+    _latestFrameEnd{},
+    _totalFrameTime{},
+    _maxFrameTime{},
+    _totalLatency{},
+    _maxLatency{}
+{
+}
+
+FramePacing FrameScheduler::GetPacing() const noexcept
+{
+    return _pacing;
+}
+
+// Routine Description:
+// - Records that part of the screen needs to be painted. Can be called from any thread.
+// Arguments:
+// - cellsInvalidated - about how many cells changed. Changes of unknown size
+//      should pass the size of the whole viewport.
+// Return Value:
+// - <none>
+void FrameScheduler::NotifyInvalidated(const size_t cellsInvalidated) noexcept
+{
+    _pendingCells.fetch_add(cellsInvalidated);
+
+    // Only the first invalidation since the last frame marks when someone
+    //      started waiting for it.
+    clock::rep none = 0;
+    _pendingSince.compare_exchange_strong(none, clock::now().time_since_epoch().count());
+}
+
+// Routine Description:
+// - Decides how long the render thread should wait before it paints what's
+//      been invalidated so far. Anything invalidated while it waits joins the
+//      same frame. Only called by the render thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of milliseconds to wait. 0 to paint right away.
+DWORD FrameScheduler::GetPaintDelay() const noexcept
+{
+    const auto now = clock::now();
+    const bool isSmall = _pendingCells.load() <= s_SmallInvalidationCells;
+    const auto nextFrame = _lastFrameStart + std::chrono::milliseconds(s_FrameIntervalMilliseconds);
+    // A small change after a quiet spell, like a keystroke, is painted right
+    //      away. One that comes right on the heels of the last frame waits for
+    //      a frame interval after it, so small changes in a loop can't paint
+    //      back to back.
+    const auto nextSmallFrame = _lastFrameEnd + std::chrono::milliseconds(s_FrameIntervalMilliseconds);
+
+    switch (_pacing)
+    {
+    case FramePacing::Latency:
+        return s_MillisecondsUntil(isSmall ? nextSmallFrame : nextFrame, now);
+
+    case FramePacing::Throughput:
+    {
+        if (isSmall)
+        {
+            return s_MillisecondsUntil(nextFrame, now);
+        }
+
+        const auto pendingSince = _pendingSince.load();
+        const auto firstInvalidated = pendingSince == 0 ? now : clock::time_point{ clock::duration{ pendingSince } };
+        return s_MillisecondsUntil(std::max(nextFrame, firstInvalidated + _budget), now);
+    }
+
+    case FramePacing::Headless:
+    {
+        // Painting a VT frame blocks until the other end of the pipe reads it,
+        //      so a slow frame means the other end is falling behind. Give it
+        //      as long again to catch up before sending more. While it's
+        //      keeping up, small changes go out as they do for latency pacing.
+        if (isSmall && _lastFrameDuration < std::chrono::milliseconds(s_FrameIntervalMilliseconds))
+        {
+            return s_MillisecondsUntil(nextSmallFrame, now);
+        }
+
+        const auto backoff = std::min<clock::duration>(_lastFrameDuration, std::chrono::milliseconds(s_MaxHeadlessDelayMilliseconds));
+        return s_MillisecondsUntil(std::max(nextFrame, _lastFrameEnd + backoff), now);
+    }
+
+    default:
+        return s_FrameIntervalMilliseconds;
+    }
+}
+
+// Routine Description:
+// - Called by the render thread just before it paints. Takes everything
+//      invalidated so far as the contents of this frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void FrameScheduler::BeginFrame() noexcept
+{
+    _frameStart = clock::now();
+    _pendingCells.store(0);
+    _framePendingSince = _pendingSince.exchange(0);
+}
+
+// Routine Description:
+// - Called by the render thread when it's done painting. Records how long the
+//      frame took, and how long the oldest change in it waited to be seen.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void FrameScheduler::EndFrame() noexcept
+{
+    const auto frameEnd = clock::now();
+    const auto frameTime = frameEnd - _frameStart;
+
+    _lastFrameStart = _frameStart;
+    _lastFrameEnd = frameEnd;
+    _lastFrameDuration = frameTime;
+
+    // std::mutex::lock can only throw if something is very wrong with the lock.
+    // Losing one frame's statistics isn't worth crashing the render thread over.
+    try
+    {
+        std::lock_guard<std::mutex> lock{ _statisticsLock };
+        if (_frames == 0)
+        {
+            _firstFrameStart = _frameStart;
+        }
+
+        ++_frames;
+        _latestFrameEnd = frameEnd;
+        _totalFrameTime += frameTime;
+        _maxFrameTime = std::max(_maxFrameTime, frameTime);
+
+        if (_framePendingSince != 0)
+        {
+            const auto latency = frameEnd - clock::time_point{ clock::duration{ _framePendingSince } };
+            ++_framesWithLatency;
+            _totalLatency += latency;
+            _maxLatency = std::max(_maxLatency, latency);
+        }
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Summarizes the frames painted since the statistics were last reset.
+//      Latency is measured from the first invalidation that went into a frame
+//      until the frame was done painting.
+// Arguments:
+// - <none>
+// Return Value:
+// - The statistics. All zero if nothing has been painted.
+FrameStatistics FrameScheduler::GetStatistics() const
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+
+    std::lock_guard<std::mutex> lock{ _statisticsLock };
+
+    FrameStatistics statistics{};
+    statistics.frames = _frames;
+    if (_frames > 0)
+    {
+        statistics.averageFrameMilliseconds = milliseconds(_totalFrameTime).count() / _frames;
+        statistics.maxFrameMilliseconds = milliseconds(_maxFrameTime).count();
+
+        const auto elapsed = milliseconds(_latestFrameEnd - _firstFrameStart).count();
+        statistics.paintsPerSecond = elapsed > 0 ? _frames * 1000.0 / elapsed : 0;
+    }
+
+    if (_framesWithLatency > 0)
+    {
+        statistics.averageLatencyMilliseconds = milliseconds(_totalLatency).count() / _framesWithLatency;
+        statistics.maxLatencyMilliseconds = milliseconds(_maxLatency).count();
+    }
+
+    return statistics;
+}
+
+// Routine Description:
+// - Forgets the frames painted so far, so the statistics only cover what
+//      happens from now on.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void FrameScheduler::ResetStatistics()
+{
+    std::lock_guard<std::mutex> lock{ _statisticsLock };
+    _frames = 0;
+    _framesWithLatency = 0;
+    _totalFrameTime = {};
+    _maxFrameTime = {};
+    _totalLatency = {};
+    _maxLatency = {};
+}
+
+// Routine Description:
+// - Rounds the time until the given point up to whole milliseconds.
+// Arguments:
+// - target - when something should happen
+// - now - the current time
+// Return Value:
+// - The milliseconds until then, or 0 if it's already past.
+DWORD FrameScheduler::s_MillisecondsUntil(const clock::time_point target, const clock::time_point now) noexcept
+{
+    if (target <= now)
+    {
+        return 0;
+    }
+
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(target - now).count();
+    return static_cast<DWORD>(std::min<decltype(remaining)>(remaining, MAXDWORD));
+}
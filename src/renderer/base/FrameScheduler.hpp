@@ -0,0 +1,102 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- FrameScheduler.hpp
+
+Abstract:
+- Decides when the render thread should paint the next frame, and keeps
+  statistics about the frames it painted.
+- Small changes like an echoed keystroke or a cursor move are cheap to paint and
+  someone is waiting to see them, so they can be painted right away, unless the
+  last frame only just ended. That keeps a program rewriting a few cells in a
+  loop, like a spinner, from painting back to back and holding the lock. Large
+  changes like a flood of output are expensive, and painting fewer of them
+  costs nothing anyone can see. How the two are balanced depends on the pacing.
+--*/
+
+#pragma once
+
+#include <chrono>
+
+namespace Microsoft::Console::Render
+{
+    enum class FramePacing
+    {
+        // Paint small changes immediately if the last frame ended at least a
+        //      frame interval ago, and large ones at most once a frame interval.
+        Latency,
+        // Hold large changes back until they've collected for up to the budget.
+        Throughput,
+        // Space frames out by how long the last one took to paint, which for a
+        //      VT engine is mostly the time spent writing it to the pipe.
+        Headless
+    };
+
+    struct FrameStatistics
+    {
+        size_t frames;
+        double averageFrameMilliseconds;
+        double maxFrameMilliseconds;
+        double paintsPerSecond;
+        double averageLatencyMilliseconds;
+        double maxLatencyMilliseconds;
+    };
+
+    class FrameScheduler final
+    {
+    public:
+        FrameScheduler(const FramePacing pacing, const DWORD budgetMilliseconds) noexcept;
+
+        FramePacing GetPacing() const noexcept;
+
+        void NotifyInvalidated(const size_t cellsInvalidated) noexcept;
+
+        DWORD GetPaintDelay() const noexcept;
+
+        void BeginFrame() noexcept;
+        void EndFrame() noexcept;
+
+        FrameStatistics GetStatistics() const;
+        void ResetStatistics();
+
+        static constexpr DWORD s_FrameIntervalMilliseconds = 8;
+        static constexpr DWORD s_DefaultBudgetMilliseconds = 33;
+        static constexpr DWORD s_MaxHeadlessDelayMilliseconds = 100;
+
+        // About two lines of text. Anything up to this is painted as soon as possible.
+        static constexpr size_t s_SmallInvalidationCells = 160;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        static DWORD s_MillisecondsUntil(const clock::time_point target, const clock::time_point now) noexcept;
+
+        const FramePacing _pacing;
+        const clock::duration _budget;
+
+        // Written by whichever thread invalidates, and taken by the render
+        //      thread when it starts a frame. The time is the tick count of
+        //      the first invalidation since the last frame, or 0 if none.
+        std::atomic<size_t> _pendingCells;
+        std::atomic<clock::rep> _pendingSince;
+
+        // Only touched by the render thread.
+        clock::time_point _frameStart;
+        clock::rep _framePendingSince;
+        clock::time_point _lastFrameStart;
+        clock::time_point _lastFrameEnd;
+        clock::duration _lastFrameDuration;
+
+        mutable std::mutex _statisticsLock;
+        size_t _frames;
+        size_t _framesWithLatency;
+        clock::time_point _firstFrameStart;
+        clock::time_point _latestFrameEnd;
+        clock::duration _totalFrameTime;
+        clock::duration _maxFrameTime;
+        clock::duration _totalLatency;
+        clock::duration _maxLatency;
+    };
+}
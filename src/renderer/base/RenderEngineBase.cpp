@@ -37,3 +37,16 @@ HRESULT RenderEngineBase::UpdateTitle(const std::wstring& newTitle) noexcept
     }
     return hr;
 }
+
+// Routine Description:
+// - Gets the dirty portions of the frame as a list of rectangles in characters.
+// - Engines that only track a single dirty rectangle report just that one.
+// Arguments:
+// - <none>
+// Return Value:
+// - The dirty rectangles of the frame. These are Inclusive rects.
+const std::vector<SMALL_RECT>& RenderEngineBase::GetDirtyArea()
+{
+    _dirtyArea.assign(1, GetDirtyRectInChars());
+    return _dirtyArea;
+}
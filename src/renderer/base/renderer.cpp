@@ -140,10 +140,30 @@ HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine)
     return S_OK;
 }
 
-void Renderer::_NotifyPaintFrame()
+// Routine Description:
+// - Tells the thread there's something to paint.
+// Arguments:
+// - cellsInvalidated - about how many cells changed. The thread paints small
+//      changes sooner than large ones.
+// Return Value:
+// - <none>
+void Renderer::_NotifyPaintFrame(const size_t cellsInvalidated)
 {
     // The thread will provide throttling for us.
-    _pThread->NotifyPaint();
+    _pThread->NotifyPaint(cellsInvalidated);
+}
+
+// Routine Description:
+// - Gets the number of cells in the viewport, for changes that could touch
+//      any of it.
+// Arguments:
+// - <none>
+// Return Value:
+// - The width times the height of the viewport.
+size_t Renderer::_GetViewportCellCount()
+{
+    const COORD dimensions = _pData->GetViewport().Dimensions();
+    return static_cast<size_t>(dimensions.X) * static_cast<size_t>(dimensions.Y);
 }
 
 // Routine Description:
@@ -158,7 +178,7 @@ void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
         LOG_IF_FAILED(pEngine->InvalidateSystem(prcDirtyClient));
     });
 
-    _NotifyPaintFrame();
+    _NotifyPaintFrame(_GetViewportCellCount());
 }
 
 // Routine Description:
@@ -179,7 +199,10 @@ void Renderer::TriggerRedraw(const Viewport& region)
             LOG_IF_FAILED(pEngine->Invalidate(&srUpdateRegion));
         });
 
-        _NotifyPaintFrame();
+        // The region is exclusive.
+        const size_t cells = static_cast<size_t>(srUpdateRegion.Right - srUpdateRegion.Left) *
+                             static_cast<size_t>(srUpdateRegion.Bottom - srUpdateRegion.Top);
+        _NotifyPaintFrame(cells);
     }
 }
 
@@ -223,7 +246,7 @@ void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
             }
         }
 
-        _NotifyPaintFrame();
+        _NotifyPaintFrame(_pData->IsCursorDoubleWidth() ? 2 : 1);
     }
 }
 
@@ -240,7 +263,7 @@ void Renderer::TriggerRedrawAll()
         LOG_IF_FAILED(pEngine->InvalidateAll());
     });
 
-    _NotifyPaintFrame();
+    _NotifyPaintFrame(_GetViewportCellCount());
 }
 
 // Method Description:
@@ -287,9 +310,20 @@ void Renderer::TriggerSelection()
             LOG_IF_FAILED(pEngine->InvalidateSelection(rects));
         });
 
+        // Both the old and new selection get painted. The rectangles are inclusive.
+        const auto countCells = [](const std::vector<SMALL_RECT>& rectangles) {
+            size_t cells = 0;
+            for (const auto& rect : rectangles)
+            {
+                cells += static_cast<size_t>(rect.Right - rect.Left + 1) * static_cast<size_t>(rect.Bottom - rect.Top + 1);
+            }
+            return cells;
+        };
+        const size_t cells = countCells(_previousSelection) + countCells(rects);
+
         _previousSelection = rects;
 
-        _NotifyPaintFrame();
+        _NotifyPaintFrame(cells);
     }
     CATCH_LOG();
 }
@@ -329,7 +363,7 @@ void Renderer::TriggerScroll()
 {
     if (_CheckViewportAndScroll())
     {
-        _NotifyPaintFrame();
+        _NotifyPaintFrame(_GetViewportCellCount());
     }
 }
 
@@ -348,7 +382,7 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
         LOG_IF_FAILED(pEngine->InvalidateScroll(pcoordDelta));
     });
 
-    _NotifyPaintFrame();
+    _NotifyPaintFrame(_GetViewportCellCount());
 }
 
 // Routine Description:
@@ -387,7 +421,7 @@ void Renderer::TriggerTitleChange()
     {
         LOG_IF_FAILED(pEngine->InvalidateTitle(newTitle));
     }
-    _NotifyPaintFrame();
+    _NotifyPaintFrame(0);
 }
 
 // Routine Description:
@@ -417,7 +451,7 @@ void Renderer::TriggerFontChange(const int iDpi, const FontInfoDesired& FontInfo
         LOG_IF_FAILED(pEngine->UpdateFont(FontInfoDesired, FontInfo));
     });
 
-    _NotifyPaintFrame();
+    _NotifyPaintFrame(_GetViewportCellCount());
 }
 
 // Routine Description:
@@ -542,24 +576,36 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
     // relative to the entire buffer.
     const auto view = _pData->GetViewport();
 
-    // This is effectively the number of cells on the visible screen that need to be redrawn.
-    // The origin is always 0, 0 because it represents the screen itself, not the underlying buffer.
-    auto dirty = Viewport::FromInclusive(pEngine->GetDirtyRectInChars());
-
-    // Shift the origin of the dirty region to match the underlying buffer so we can
-    // compare the two regions directly for intersection.
-    dirty = Viewport::Offset(dirty, view.Origin());
+    // The brushes have been through the default colors since we last painted text.
+    _lastRunAttr.reset();
 
-    // The intersection between what is dirty on the screen (in need of repaint)
-    // and what is supposed to be visible on the screen (the viewport) is what
-    // we need to walk through line-by-line and repaint onto the screen.
-    const auto redraw = Viewport::Intersect(dirty, view);
+    // Retrieve the text buffer so we can read information out of it.
+    // Its rows are counted from the row base, which lets the viewport reach rows the buffer has archived.
+    const auto& buffer = _pData->GetTextBuffer();
+    const auto rowBase = _pData->GetBufferRowBase();
 
-    // Shortcut: don't bother redrawing if the width is 0.
-    if (redraw.Width() > 0)
+    // The engine may know that only a few separate parts of the screen are dirty,
+    // so ask for each of them instead of the one rectangle that surrounds them all.
+    for (const auto& dirtyRect : pEngine->GetDirtyArea())
     {
-        // Retrieve the text buffer so we can read information out of it.
-        const auto& buffer = _pData->GetTextBuffer();
+        // This is effectively the number of cells on the visible screen that need to be redrawn.
+        // The origin is always 0, 0 because it represents the screen itself, not the underlying buffer.
+        auto dirty = Viewport::FromInclusive(dirtyRect);
+
+        // Shift the origin of the dirty region to match the underlying buffer so we can
+        // compare the two regions directly for intersection.
+        dirty = Viewport::Offset(dirty, view.Origin());
+
+        // The intersection between what is dirty on the screen (in need of repaint)
+        // and what is supposed to be visible on the screen (the viewport) is what
+        // we need to walk through line-by-line and repaint onto the screen.
+        const auto redraw = Viewport::Intersect(dirty, view);
+
+        // Shortcut: don't bother redrawing if the width is 0.
+        if (redraw.Width() <= 0)
+        {
+            continue;
+        }
 
         // Now walk through each row of text that we need to redraw.
         for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
@@ -576,7 +622,7 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             const auto screenLine = Viewport::Offset(bufferLine, -view.Origin());
 
             // Retrieve the cell information iterator limited to just this line we want to redraw.
-            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine, rowBase);
 
             // Ask the helper to paint through this specific line.
             _PaintBufferOutputHelper(pEngine, it, screenLine.Origin());
@@ -591,61 +637,60 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
     // If we have valid data, let's figure out how to draw it.
     if (it)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
-        std::vector<Cluster> clusters;
-        size_t cols = 0;
-
-        // Retrieve the first color.
-        auto color = it->TextAttr();
-
-        // And hold the point where we should start drawing.
+        // Hold the point where we should start drawing.
         auto screenPoint = target;
 
         // This outer loop will continue until we reach the end of the text we are trying to draw.
         while (it)
         {
-            // Hold onto the current run color right here for the length of the outer loop.
-            // We'll be changing the persistent one as we run through the inner loops to detect
-            // when a run changes, but we will still need to know this color at the bottom
+            // Hold onto the color of this run. We need it at the bottom
             // when we go to draw gridlines for the length of the run.
-            const auto currentRunColor = color;
+            const auto currentRunColor = it->TextAttr();
 
             // Update the drawing brushes with our color.
-            THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, false));
+            THROW_IF_FAILED(_UpdateDrawingBrushesForRun(pEngine, currentRunColor));
 
-            // Advance the point by however many columns we've just outputted and reset the accumulator.
-            screenPoint.X += gsl::narrow<SHORT>(cols);
-            cols = 0;
+            // The clusters point straight into the buffer's storage, and the vector
+            // holding them keeps its capacity from the last run, so building a run
+            // doesn't allocate once the first few frames have been painted.
+            _clusterBuffer.clear();
+            size_t cols = 0;
 
-            // Ensure that our cluster vector is clear.
-            clusters.clear();
+            // The row knows where its attribute runs end, so there's no need to compare
+            // every cell's attributes to find out where this run stops.
+            size_t runRemaining = it.GetAttrRunLength();
 
             // This inner loop will accumulate clusters until the color changes.
-            // When the color changes, it will save the new color off and break.
             do
             {
-                if (color != it->TextAttr())
-                {
-                    color = it->TextAttr();
-                    break;
-                }
-
                 // Walk through the text data and turn it into rendering clusters.
-                clusters.emplace_back(it->Chars(), it->Columns());
+                _clusterBuffer.emplace_back(it->Chars(), it->Columns());
 
                 // Advance the cluster and column counts.
-                const auto columnCount = clusters.back().GetColumns();
-                it += columnCount > 0 ? columnCount : 1; // prevent infinite loop for no visible columns
+                const auto columnCount = _clusterBuffer.back().GetColumns();
+                const size_t advance = columnCount > 0 ? columnCount : 1; // prevent infinite loop for no visible columns
+                it += advance;
                 cols += columnCount;
 
+                if (advance < runRemaining)
+                {
+                    runRemaining -= advance;
+                }
+                else
+                {
+                    // We've reached the end of the run. The next one only starts
+                    // a new batch if it actually looks different.
+                    if (!it || it->TextAttr() != currentRunColor)
+                    {
+                        break;
+                    }
+                    runRemaining = it.GetAttrRunLength();
+                }
             } while (it);
 
             // Do the painting.
             // TODO: Calculate when trim left should be TRUE
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ clusters.data(), clusters.size() }, screenPoint, false));
+            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, false));
 
             // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
             if (_pData->IsGridLineDrawingAllowed())
@@ -653,6 +698,9 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 // We're only allowed to draw the grid lines under certain circumstances.
                 _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
             }
+
+            // Advance the point by however many columns we've just outputted.
+            screenPoint.X += gsl::narrow<SHORT>(cols);
         }
     }
 }
@@ -788,6 +836,9 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
         {
             Viewport viewDirty = Viewport::FromInclusive(srDirty);
 
+            // Don't assume anything about the brushes the buffer output left behind.
+            _lastRunAttr.reset();
+
             for (SHORT iRow = viewDirty.Top(); iRow < viewDirty.BottomInclusive(); iRow++)
             {
                 const COORD target{ viewDirty.Left(), iRow };
@@ -876,6 +927,30 @@ HRESULT Renderer::_UpdateDrawingBrushes(_In_ IRenderEngine* const pEngine, const
     return S_OK;
 }
 
+// Routine Description:
+// - Updates the drawing brushes for the next run of text, unless the previous
+//   run of text already left them in this state.
+// Arguments:
+// - pEngine - Which engine is being updated
+// - attr - The attributes of the run of text that's about to be painted
+// Return Value:
+// - S_OK or the engine's failure to update the brushes
+[[nodiscard]]
+HRESULT Renderer::_UpdateDrawingBrushesForRun(_In_ IRenderEngine* const pEngine, const TextAttribute attr)
+{
+    if (_lastRunAttr.has_value() && _lastRunAttr.value() == attr)
+    {
+        return S_OK;
+    }
+
+    // Forget the old attribute first, so a failure leaves us updating again next time.
+    _lastRunAttr.reset();
+    RETURN_IF_FAILED(_UpdateDrawingBrushes(pEngine, attr, false));
+    _lastRunAttr = attr;
+
+    return S_OK;
+}
+
 // Routine Description:
 // - Helper called before a majority of paint operations to scroll most of the previous frame into the appropriate
 //   position before we paint the remaining invalid area.
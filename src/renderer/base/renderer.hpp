@@ -88,7 +88,8 @@ namespace Microsoft::Console::Render
         std::unique_ptr<IRenderThread> _pThread;
         bool _destructing = false;
 
-        void _NotifyPaintFrame();
+        void _NotifyPaintFrame(const size_t cellsInvalidated);
+        size_t _GetViewportCellCount();
 
         [[nodiscard]]
         HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine);
@@ -120,6 +121,17 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT _UpdateDrawingBrushes(_In_ IRenderEngine* const pEngine, const TextAttribute attr, const bool isSettingDefaultBrushes);
 
+        [[nodiscard]]
+        HRESULT _UpdateDrawingBrushesForRun(_In_ IRenderEngine* const pEngine, const TextAttribute attr);
+
+        // Scratch space for the clusters of one run of text. It's kept between
+        // runs, rows, and frames so painting doesn't have to allocate.
+        std::vector<Cluster> _clusterBuffer;
+
+        // The attribute the engine's brushes were last set to while painting
+        // runs of text, so rows that continue in the same colors don't set them again.
+        std::optional<TextAttribute> _lastRunAttr;
+
         [[nodiscard]]
         HRESULT _PerformScrolling(_In_ IRenderEngine* const pEngine);
 
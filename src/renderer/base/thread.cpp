@@ -10,7 +10,8 @@
 
 using namespace Microsoft::Console::Render;
 
-RenderThread::RenderThread() :
+RenderThread::RenderThread(const FramePacing pacing, const DWORD budgetMilliseconds) :
+    _scheduler(pacing, budgetMilliseconds),
     _pRenderer(nullptr),
     _hThread(INVALID_HANDLE_VALUE),
     _hEvent(INVALID_HANDLE_VALUE),
@@ -163,24 +164,46 @@ DWORD WINAPI RenderThread::_ThreadProc()
         WaitForSingleObject(_hPaintEnabledEvent, INFINITE);
         WaitForSingleObject(_hEvent, INFINITE);
 
+        // The scheduler may want to hold this frame back, either so more
+        //      changes can collect in it or because the last frame was too
+        //      recent. Anything invalidated meanwhile is painted with it.
+        // extra check before we sleep since it's a "long" activity, relatively speaking.
+        const DWORD dwDelay = _scheduler.GetPaintDelay();
+        if (dwDelay > 0 && _fKeepRunning)
+        {
+            Sleep(dwDelay);
+
+            // If painting was disabled while we waited, keep the frame for
+            //      when it's enabled again.
+            if (WaitForSingleObject(_hPaintEnabledEvent, 0) != WAIT_OBJECT_0)
+            {
+                SetEvent(_hEvent);
+                continue;
+            }
+        }
+
         ResetEvent(_hPaintCompletedEvent);
 
+        _scheduler.BeginFrame();
         LOG_IF_FAILED(_pRenderer->PaintFrame());
+        _scheduler.EndFrame();
 
         SetEvent(_hPaintCompletedEvent);
-
-        // extra check before we sleep since it's a "long" activity, relatively speaking.
-        if (_fKeepRunning)
-        {
-            Sleep(s_FrameLimitMilliseconds);
-        }
     }
 
     return S_OK;
 }
 
-void RenderThread::NotifyPaint()
+// Method Description:
+// - Wakes the thread to paint a frame. When the frame is actually painted is
+//      up to the scheduler.
+// Arguments:
+// - cellsInvalidated: about how many cells need to be painted.
+// Return Value:
+// - <none>
+void RenderThread::NotifyPaint(const size_t cellsInvalidated)
 {
+    _scheduler.NotifyInvalidated(cellsInvalidated);
     SetEvent(_hEvent);
 }
 
@@ -245,3 +268,26 @@ void RenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs)
     ResetEvent(_hPaintEnabledEvent);
     WaitForSingleObject(_hPaintCompletedEvent, dwTimeoutMs);
 }
+
+// Method Description:
+// - Gets the frame time, paint rate, and invalidation-to-paint latency for
+//      the frames painted since the statistics were last reset.
+// Arguments:
+// - <none>
+// Return Value:
+// - The statistics.
+FrameStatistics RenderThread::GetFrameStatistics() const
+{
+    return _scheduler.GetStatistics();
+}
+
+// Method Description:
+// - Starts collecting frame statistics over again.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderThread::ResetFrameStatistics()
+{
+    _scheduler.ResetStatistics();
+}
@@ -16,28 +16,33 @@ Author(s):
 
 #include "..\inc\IRenderer.hpp"
 #include "..\inc\IRenderThread.hpp"
+#include "FrameScheduler.hpp"
 
 namespace Microsoft::Console::Render
 {
     class RenderThread final : public IRenderThread
     {
     public:
-        RenderThread();
+        RenderThread(const FramePacing pacing = FramePacing::Latency,
+                     const DWORD budgetMilliseconds = FrameScheduler::s_DefaultBudgetMilliseconds);
         virtual ~RenderThread() override;
 
         [[nodiscard]]
         HRESULT Initialize(_In_ IRenderer* const pRendererParent) noexcept;
 
-        void NotifyPaint() override;
+        void NotifyPaint(const size_t cellsInvalidated) override;
 
         void EnablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
-        
+
+        FrameStatistics GetFrameStatistics() const;
+        void ResetFrameStatistics();
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
-        static DWORD const s_FrameLimitMilliseconds = 8;
+        FrameScheduler _scheduler;
 
         HANDLE _hThread;
         HANDLE _hEvent;
@@ -44,6 +44,8 @@ namespace Microsoft::Console::Render
         virtual ~IRenderData() = 0;
         virtual Microsoft::Console::Types::Viewport GetViewport() noexcept = 0;
         virtual const TextBuffer& GetTextBuffer() noexcept = 0;
+        // The retained row of the text buffer that row 0 of the viewport, cursor and selection refers to.
+        virtual size_t GetBufferRowBase() noexcept = 0;
         virtual const FontInfo& GetFontInfo() noexcept = 0;
         virtual const TextAttribute GetDefaultBrushColors() noexcept = 0;
 
@@ -133,6 +133,7 @@ namespace Microsoft::Console::Render
                                         const int iDpi) noexcept = 0;
 
         virtual SMALL_RECT GetDirtyRectInChars() = 0;
+        virtual const std::vector<SMALL_RECT>& GetDirtyArea() = 0;
         [[nodiscard]]
         virtual HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept = 0;
         [[nodiscard]]
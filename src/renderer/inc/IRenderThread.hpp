@@ -19,7 +19,7 @@ namespace Microsoft::Console::Render
     {
     public:
         virtual ~IRenderThread() = 0;
-        virtual void NotifyPaint() = 0;
+        virtual void NotifyPaint(const size_t cellsInvalidated) = 0;
         virtual void EnablePainting() = 0;
         virtual void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) = 0;
     };
@@ -33,6 +33,8 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT UpdateTitle(const std::wstring& newTitle) noexcept override;
 
+        const std::vector<SMALL_RECT>& GetDirtyArea() override;
+
     protected:
         [[nodiscard]]
         virtual HRESULT _DoUpdateTitle(const std::wstring& newTitle) noexcept = 0;
@@ -40,6 +42,9 @@ namespace Microsoft::Console::Render
         bool _titleChanged;
         std::wstring _lastFrameTitle;
 
+        // Storage for the rectangles handed out by GetDirtyArea.
+        std::vector<SMALL_RECT> _dirtyArea;
+
     };
 
     inline Microsoft::Console::Render::RenderEngineBase::~RenderEngineBase() { }
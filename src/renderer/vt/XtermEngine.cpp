@@ -21,7 +21,8 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     _fUseAsciiOnly(fUseAsciiOnly),
     _previousLineWrapped(false),
     _usingUnderLine(false),
-    _needToDisableCursor(false)
+    _needToDisableCursor(false),
+    _shadowSize{ 0, 0 }
 {
     // Set out initial cursor position to -1, -1. This will force our initial
     //      paint to manually move the cursor to 0, 0, not just ignore it.
@@ -53,6 +54,7 @@ HRESULT XtermEngine::StartPaint() noexcept
         //      the screen on the first paint, just to make sure that the
         //      terminal's state is consistent with what we'll be rendering.
         RETURN_IF_FAILED(_ClearScreen());
+        _ShadowReset();
         _clearedAllThisFrame = true;
         _firstPaint = false;
     }
@@ -60,13 +62,14 @@ HRESULT XtermEngine::StartPaint() noexcept
     {
         const auto dirtyRect = GetDirtyRectInChars();
         const auto dirtyView = Viewport::FromInclusive(dirtyRect);
-        if (!_resized && dirtyView == _lastViewport)
+        if (!_resized && dirtyView == _lastViewport && _AllIsInvalid())
         {
             // TODO: MSFT:21096414 - This is never actually hit. We set
             // _resized=true on every frame (see VtEngine::UpdateViewport).
             // Unfortunately, not always setting _resized is not a good enough
             // solution, see that work item for a description why.
             RETURN_IF_FAILED(_ClearScreen());
+            _ShadowReset();
             _clearedAllThisFrame = true;
         }
     }
@@ -325,6 +328,15 @@ HRESULT XtermEngine::ScrollFrame() noexcept
         }
     }
 
+    if (SUCCEEDED(hr))
+    {
+        _ShadowScroll(dy);
+    }
+    else
+    {
+        _ShadowReset();
+    }
+
     return hr;
 }
 
@@ -373,6 +385,21 @@ HRESULT XtermEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
     return S_OK;
 }
 
+// Routine Description:
+// - Notifies us that everything needs to be repainted. Something that changes
+//      the whole frame (like the color table) may have changed, so forget what
+//      we last sent, and repaint every cell instead of only the changed ones.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or safemath failure.
+[[nodiscard]]
+HRESULT XtermEngine::InvalidateAll() noexcept
+{
+    _ShadowReset();
+    return VtEngine::InvalidateAll();
+}
+
 // Routine Description:
 // - Draws one line of the buffer to the screen. Writes the characters to the
 //      pipe, encoded in UTF-8 or ASCII only, depending on the VtIoMode.
@@ -392,12 +419,132 @@ HRESULT XtermEngine::PaintBufferLine(std::basic_string_view<Cluster> const clust
 {
     return _fUseAsciiOnly ?
         VtEngine::_PaintAsciiBufferLine(clusters, coord) :
-        VtEngine::_PaintUtf8BufferLine(clusters, coord);
+        _PaintChangedRuns(clusters, coord);
+}
+
+// Routine Description:
+// - Draws one line of the buffer to the screen, encoded in UTF-8, but only
+//      the runs of cells that differ from what we last sent to the terminal.
+//      The cursor is moved over the unchanged cells between runs (see
+//      _MoveCursor), and trailing spaces of a run are erased when that's
+//      cheaper (see _PaintUtf8BufferLine).
+// - All the clusters are painted in the current brushes, so a cell is
+//      unchanged if it has the same text and the same brushes as last time.
+// Arguments:
+// - clusters - text and column widths to be written
+// - coord - character coordinate target to render within viewport
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT XtermEngine::_PaintChangedRuns(std::basic_string_view<Cluster> const clusters,
+                                       const COORD coord) noexcept
+{
+    if (coord.Y < _virtualTop)
+    {
+        return S_OK;
+    }
+
+    try
+    {
+        _ShadowEnsureSize();
+    }
+    CATCH_RETURN();
+
+    if (coord.X < 0 || coord.Y < 0 || coord.Y >= _shadowSize.Y)
+    {
+        return VtEngine::_PaintUtf8BufferLine(clusters, coord);
+    }
+
+    const ShadowCell brush = _ShadowBrush();
+    const ShadowCell* const pRow = _shadowFrame.data() + static_cast<size_t>(coord.Y) * _shadowSize.X;
+    const auto matches = [&](const size_t index, const short column) {
+        return _ShadowMatches(pRow, column, clusters.at(index), brush);
+    };
+    const auto columnsOf = [&](const size_t index) {
+        return static_cast<short>(clusters.at(index).GetColumns());
+    };
+
+    size_t index = 0;
+    short column = coord.X;
+    while (index < clusters.size())
+    {
+        if (matches(index, column))
+        {
+            column += columnsOf(index);
+            ++index;
+            continue;
+        }
+
+        // Grow a run of changed clusters. A short stretch of unchanged ones in
+        //      the middle is cheaper to write again than to skip over.
+        const size_t runStart = index;
+        const short runColumn = column;
+        while (index < clusters.size())
+        {
+            if (!matches(index, column))
+            {
+                column += columnsOf(index);
+                ++index;
+                continue;
+            }
+
+            size_t gapEnd = index;
+            short gapColumn = column;
+            while (gapEnd < clusters.size() &&
+                   gapColumn - column <= CURSOR_FORWARD_STRING_LENGTH &&
+                   matches(gapEnd, gapColumn))
+            {
+                gapColumn += columnsOf(gapEnd);
+                ++gapEnd;
+            }
+
+            if (gapEnd == clusters.size() || gapColumn - column > CURSOR_FORWARD_STRING_LENGTH)
+            {
+                break;
+            }
+
+            index = gapEnd;
+            column = gapColumn;
+        }
+
+        const std::basic_string_view<Cluster> run{ clusters.data() + runStart, index - runStart };
+        const COORD runCoord{ runColumn, coord.Y };
+
+        // If the screen was cleared this frame, or this is a fresh line at the
+        //      bottom, the trailing spaces aren't sent at all. We assume the
+        //      terminal has blanks there, so we don't know their colors.
+        const bool trailingSpacesAssumed = _clearedAllThisFrame || _newBottomLine;
+        const HRESULT hr = VtEngine::_PaintUtf8BufferLine(run, runCoord);
+        if (FAILED(hr))
+        {
+            _ShadowReset();
+            return hr;
+        }
+        _ShadowRecord(run, runCoord, trailingSpacesAssumed);
+    }
+
+    return S_OK;
+}
+
+// Method Description:
+// - Wrapper for ITerminalOutputConnection. Writes a utf-8 string directly to
+//      the terminal. We can't know which cells that changed, so forget what
+//      we last painted.
+// Arguments:
+// - str - utf-8 string of text to be written
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT XtermEngine::WriteTerminalUtf8(const std::string& str) noexcept
+{
+    _ShadowReset();
+    return VtEngine::WriteTerminalUtf8(str);
 }
 
 // Method Description:
 // - Wrapper for ITerminalOutputConnection. Write either an ascii-only, or a
-//      proper utf-8 string, depending on our mode.
+//      proper utf-8 string, depending on our mode. We can't know which cells
+//      that changed, so forget what we last painted.
 // Arguments:
 // - wstr - wstring of text to be written
 // Return Value:
@@ -405,11 +552,195 @@ HRESULT XtermEngine::PaintBufferLine(std::basic_string_view<Cluster> const clust
 [[nodiscard]]
 HRESULT XtermEngine::WriteTerminalW(const std::wstring& wstr) noexcept
 {
+    _ShadowReset();
     return _fUseAsciiOnly ?
         VtEngine::_WriteTerminalAscii(wstr) :
         VtEngine::_WriteTerminalUtf8(wstr);
 }
 
+// Routine Description:
+// - Forgets what we last sent to the terminal. Every cell will be painted
+//      again the next time it's invalidated.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void XtermEngine::_ShadowReset() noexcept
+{
+    std::fill(_shadowFrame.begin(), _shadowFrame.end(), ShadowCell{});
+}
+
+// Routine Description:
+// - Makes sure the shadow frame is the size of the viewport. If the viewport
+//      changed size, the terminal's contents are unknown.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void XtermEngine::_ShadowEnsureSize()
+{
+    const COORD size = _lastViewport.Dimensions();
+    if (size.X != _shadowSize.X || size.Y != _shadowSize.Y)
+    {
+        _shadowSize = { 0, 0 };
+        _shadowFrame.assign(static_cast<size_t>(size.X) * static_cast<size_t>(size.Y), ShadowCell{});
+        _shadowSize = size;
+    }
+}
+
+// Routine Description:
+// - Moves the rows of the shadow frame the same way ScrollFrame moved the
+//      terminal's contents. The rows that scrolled in are unknown.
+// Arguments:
+// - dy - The number of rows the contents moved down. Negative to move up.
+// Return Value:
+// - <none>
+void XtermEngine::_ShadowScroll(const short dy) noexcept
+{
+    const size_t width = _shadowSize.X;
+    const size_t height = _shadowSize.Y;
+    const size_t absDy = static_cast<size_t>(abs(dy));
+    if (absDy >= height)
+    {
+        _ShadowReset();
+        return;
+    }
+
+    const auto first = _shadowFrame.begin();
+    const auto last = _shadowFrame.end();
+    const auto distance = static_cast<ptrdiff_t>(absDy * width);
+    if (dy < 0)
+    {
+        std::move(first + distance, last, first);
+        std::fill(last - distance, last, ShadowCell{});
+    }
+    else
+    {
+        std::move_backward(first, last - distance, last);
+        std::fill(first, first + distance, ShadowCell{});
+    }
+}
+
+// Routine Description:
+// - Gets a cell with the brushes the next text will be painted with.
+// Arguments:
+// - <none>
+// Return Value:
+// - A cell with no text in the current brushes.
+XtermEngine::ShadowCell XtermEngine::_ShadowBrush() const noexcept
+{
+    ShadowCell brush{};
+    brush.isBold = _lastWasBold;
+    brush.isUnderlined = _usingUnderLine;
+    brush.foreground = _LastFG;
+    brush.background = _LastBG;
+    return brush;
+}
+
+// Routine Description:
+// - Checks if the terminal already has the given cluster, in the given
+//      brushes, at the given column of a row.
+// Arguments:
+// - pRow - The shadow cells of the row.
+// - column - The column the cluster would be painted at.
+// - cluster - The text and width to paint.
+// - brush - The brushes the cluster would be painted in.
+// Return Value:
+// - true if painting the cluster wouldn't change anything.
+bool XtermEngine::_ShadowMatches(const ShadowCell* const pRow,
+                                 const short column,
+                                 const Cluster& cluster,
+                                 const ShadowCell& brush) const noexcept
+{
+    const auto text = cluster.GetText();
+    const size_t columns = cluster.GetColumns();
+    if (columns == 0 ||
+        static_cast<size_t>(column) + columns > static_cast<size_t>(_shadowSize.X))
+    {
+        return false;
+    }
+
+    const auto sameBrush = [&](const ShadowCell& cell) {
+        return cell.cch != 0 &&
+               cell.isBold == brush.isBold &&
+               cell.isUnderlined == brush.isUnderlined &&
+               cell.foreground == brush.foreground &&
+               cell.background == brush.background;
+    };
+
+    const ShadowCell& lead = pRow[column];
+    if (!sameBrush(lead) ||
+        lead.columns != columns ||
+        lead.cch != text.size() ||
+        std::wstring_view(lead.text, lead.cch) != text)
+    {
+        return false;
+    }
+
+    for (size_t i = 1; i < columns; ++i)
+    {
+        const ShadowCell& trailer = pRow[column + i];
+        if (!sameBrush(trailer) || trailer.columns != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Routine Description:
+// - Remembers that the given clusters were sent to the terminal in the
+//      current brushes.
+// Arguments:
+// - clusters - The text and widths that were painted.
+// - coord - The character coordinate they were painted at.
+// - trailingSpacesAssumed - If true, the spaces at the end of the clusters
+//      weren't actually sent, so we don't know their colors.
+// Return Value:
+// - <none>
+void XtermEngine::_ShadowRecord(std::basic_string_view<Cluster> const clusters,
+                                const COORD coord,
+                                const bool trailingSpacesAssumed) noexcept
+{
+    const ShadowCell brush = _ShadowBrush();
+    ShadowCell* const pRow = _shadowFrame.data() + static_cast<size_t>(coord.Y) * _shadowSize.X;
+    const size_t width = _shadowSize.X;
+
+    size_t column = coord.X;
+    for (const auto& cluster : clusters)
+    {
+        const auto text = cluster.GetText();
+        const size_t columns = cluster.GetColumns();
+        for (size_t i = 0; i < columns && column + i < width; ++i)
+        {
+            ShadowCell& cell = pRow[column + i];
+            cell = brush;
+            cell.cch = 1;
+            if (i == 0)
+            {
+                // Clusters too long to remember are never considered unchanged.
+                cell.cch = text.size() <= ARRAYSIZE(cell.text) ? static_cast<BYTE>(text.size()) : 0;
+                std::copy_n(text.data(), cell.cch, cell.text);
+                cell.columns = static_cast<BYTE>(columns);
+            }
+        }
+        column += columns;
+    }
+
+    if (trailingSpacesAssumed)
+    {
+        for (auto it = clusters.crbegin(); it != clusters.crend() && it->GetText() == L" "; ++it)
+        {
+            column -= it->GetColumns();
+            if (column < width)
+            {
+                pRow[column].cch = 0;
+            }
+        }
+    }
+}
+
 // Method Description:
 // - Updates the window's title string. Emits the VT sequence to SetWindowTitle.
 // Arguments:
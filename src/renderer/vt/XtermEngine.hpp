@@ -56,10 +56,19 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]]
         HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]]
+        HRESULT InvalidateAll() noexcept override;
 
+        [[nodiscard]]
+        HRESULT WriteTerminalUtf8(const std::string& str) noexcept override;
         [[nodiscard]]
         HRESULT WriteTerminalW(_In_ const std::wstring& str) noexcept override;
 
+        // A CUF sequence for fewer than 10 columns is 4 chars: ESC [ %d C
+        // Unchanged cells are only skipped over if there are more of them than
+        //      that, otherwise it's cheaper to just write them again.
+        static const short CURSOR_FORWARD_STRING_LENGTH = 4;
+
     protected:
         const COLORREF* const _ColorTable;
         const WORD _cColorTable;
@@ -68,6 +77,41 @@ namespace Microsoft::Console::Render
         bool _usingUnderLine;
         bool _needToDisableCursor;
 
+        // One cell of what we last sent to the terminal. A cch of 0 means we
+        //      don't know what the terminal has in that cell. The trailing
+        //      half of a wide glyph has a columns of 0.
+        struct ShadowCell
+        {
+            wchar_t text[2];
+            BYTE cch;
+            BYTE columns;
+            bool isBold;
+            bool isUnderlined;
+            COLORREF foreground;
+            COLORREF background;
+        };
+
+        // The cells of the last frame, row by row, the size of _lastViewport.
+        //      PaintBufferLine only sends the runs of cells that differ from it.
+        std::vector<ShadowCell> _shadowFrame;
+        COORD _shadowSize;
+
+        void _ShadowReset() noexcept;
+        void _ShadowEnsureSize();
+        void _ShadowScroll(const short dy) noexcept;
+        ShadowCell _ShadowBrush() const noexcept;
+        bool _ShadowMatches(const ShadowCell* const pRow,
+                            const short column,
+                            const Cluster& cluster,
+                            const ShadowCell& brush) const noexcept;
+        void _ShadowRecord(std::basic_string_view<Cluster> const clusters,
+                           const COORD coord,
+                           const bool trailingSpacesAssumed) noexcept;
+
+        [[nodiscard]]
+        HRESULT _PaintChangedRuns(std::basic_string_view<Cluster> const clusters,
+                                  const COORD coord) noexcept;
+
         [[nodiscard]]
         HRESULT _MoveCursor(const COORD coord) noexcept override;
 
@@ -157,6 +157,10 @@ HRESULT VtEngine::_InvalidCombine(const Viewport invalid) noexcept
     // Ensure invalid areas remain within bounds of window.
     RETURN_IF_FAILED(_InvalidRestrict());
 
+    // Remember exactly which parts of each row are invalid, so that two small
+    //      changes far apart don't cause everything between them to be repainted.
+    RETURN_IF_FAILED(_InvalidRowsCombine(invalid));
+
     return S_OK;
 }
 
@@ -182,6 +186,9 @@ HRESULT VtEngine::_InvalidOffset(const COORD* const pCoord) noexcept
 
             // Ensure invalid areas remain within bounds of window.
             RETURN_IF_FAILED(_InvalidRestrict());
+
+            // Do the same for each row's invalid span.
+            RETURN_IF_FAILED(_InvalidRowsOffset(*pCoord));
         }
         CATCH_RETURN();
     }
@@ -206,3 +213,98 @@ HRESULT VtEngine::_InvalidRestrict() noexcept
 
     return S_OK;
 }
+
+// Routine Description:
+// - Helper to add the given rectangle to the invalid spans of the rows it covers.
+// Expects EXCLUSIVE rectangles.
+// Arguments:
+// - invalid - A viewport containing the character region that should be
+//      repainted on the next frame
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate.
+[[nodiscard]]
+HRESULT VtEngine::_InvalidRowsCombine(const Viewport invalid) noexcept
+{
+    try
+    {
+        const auto bounds = _lastViewport.ToOrigin();
+
+        // Only grows or shrinks when the viewport is resized.
+        _invalidRows.resize(bounds.Height());
+
+        SMALL_RECT rect = invalid.ToExclusive();
+        if (bounds.TrimToViewport(&rect))
+        {
+            for (auto row = rect.Top; row < rect.Bottom; row++)
+            {
+                auto& span = _invalidRows.at(row);
+                if (span.left < span.right)
+                {
+                    span.left = std::min(span.left, rect.Left);
+                    span.right = std::max(span.right, rect.Right);
+                }
+                else
+                {
+                    span = { rect.Left, rect.Right };
+                }
+            }
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Helper to move the invalid spans of each row by the given offset, such as
+//      when a scroll operation occurs. Like the invalid rectangle, the new
+//      invalid spans are both where the old ones were and where they moved to.
+// Arguments:
+// - delta - Distances by which we should move the invalid spans in response to a scroll
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate.
+[[nodiscard]]
+HRESULT VtEngine::_InvalidRowsOffset(const COORD delta) noexcept
+{
+    try
+    {
+        const ptrdiff_t height = gsl::narrow<ptrdiff_t>(_invalidRows.size());
+        const SHORT width = _lastViewport.Width();
+
+        _invalidRowsScratch.assign(_invalidRows.size(), {});
+        for (ptrdiff_t row = 0; row < height; row++)
+        {
+            const auto& span = _invalidRows.at(row);
+            const ptrdiff_t target = row + delta.Y;
+            if (span.left < span.right && target >= 0 && target < height)
+            {
+                const SHORT left = static_cast<SHORT>(std::clamp(span.left + delta.X, 0, static_cast<int>(width)));
+                const SHORT right = static_cast<SHORT>(std::clamp(span.right + delta.X, 0, static_cast<int>(width)));
+                _invalidRowsScratch.at(target) = { left, right };
+            }
+        }
+
+        for (ptrdiff_t row = 0; row < height; row++)
+        {
+            const auto& moved = _invalidRowsScratch.at(row);
+            if (moved.left < moved.right)
+            {
+                RETURN_IF_FAILED(_InvalidRowsCombine(Viewport::FromExclusive({ moved.left, static_cast<SHORT>(row), moved.right, static_cast<SHORT>(row + 1) })));
+            }
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Helper to mark every row as entirely valid again, at the end of a frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::_InvalidRowsClear() noexcept
+{
+    std::fill(_invalidRows.begin(), _invalidRows.end(), InvalidSpan{});
+}
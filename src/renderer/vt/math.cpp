@@ -27,6 +27,52 @@ SMALL_RECT VtEngine::GetDirtyRectInChars()
     return dirty;
 }
 
+// Routine Description:
+// - Gets the dirty portions of the frame, as a list of rectangles in characters.
+// - Only the invalidated columns of each row are included, so a change at the
+//      top of the screen and another at the bottom don't dirty all the rows in
+//      between. Neighboring rows with the same dirty columns are reported as
+//      one rectangle.
+// Arguments:
+// - <none>
+// Return Value:
+// - The dirty rectangles of the frame. These are Inclusive rects.
+const std::vector<SMALL_RECT>& VtEngine::GetDirtyArea()
+{
+    // If we cleared the screen, everything inside the bounding box needs to
+    //      come back, not just what was invalidated.
+    if (_clearedAllThisFrame)
+    {
+        return RenderEngineBase::GetDirtyArea();
+    }
+
+    _dirtyArea.clear();
+
+    const SHORT height = gsl::narrow<SHORT>(_invalidRows.size());
+    for (SHORT row = std::max<SHORT>(_virtualTop, 0); row < height; row++)
+    {
+        const auto& span = _invalidRows.at(row);
+        if (span.left >= span.right)
+        {
+            continue;
+        }
+
+        const SMALL_RECT rowRect{ span.left, row, static_cast<SHORT>(span.right - 1), row };
+        if (!_dirtyArea.empty())
+        {
+            auto& last = _dirtyArea.back();
+            if (last.Bottom == row - 1 && last.Left == rowRect.Left && last.Right == rowRect.Right)
+            {
+                last.Bottom = row;
+                continue;
+            }
+        }
+        _dirtyArea.push_back(rowRect);
+    }
+
+    return _dirtyArea;
+}
+
 // Routine Description:
 // - Uses the currently selected font to determine how wide the given character will be when renderered.
 // - NOTE: Only supports determining half-width/full-width status for CJK-type languages (e.g. is it 1 character wide or 2. a.k.a. is it a rectangle or square.)
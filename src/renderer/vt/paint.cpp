@@ -34,6 +34,10 @@ HRESULT VtEngine::StartPaint() noexcept
 
     _quickReturn = !somethingToDo;
     _trace.TraceStartPaint(_quickReturn, _fInvalidRectUsed, _invalidRect, _lastViewport, _scrollDelta, _cursorMoved);
+    if (!_quickReturn)
+    {
+        _trace.StartFrame();
+    }
 
     return _quickReturn ? S_FALSE : S_OK;
 }
@@ -53,6 +57,7 @@ HRESULT VtEngine::EndPaint() noexcept
     _trace.TraceEndPaint();
 
     _invalidRect = Viewport::Empty();
+    _InvalidRowsClear();
     _fInvalidRectUsed = false;
     _scrollDelta = {0};
     _clearedAllThisFrame = false;
@@ -80,6 +85,7 @@ HRESULT VtEngine::EndPaint() noexcept
     }
 
     RETURN_IF_FAILED(_Flush());
+    _trace.EndFrame();
 
     return S_OK;
 }
@@ -312,7 +318,7 @@ HRESULT VtEngine::_16ColorUpdateDrawingBrushes(const COLORREF colorForeground,
 
         if (fgChanged)
         {
-            const WORD wNearestFg = ::FindNearestTableIndex(colorForeground, ColorTable, cColorTable);
+            const WORD wNearestFg = _colorQuantizer.FindNearestTableIndex(colorForeground, ColorTable, cColorTable);
             RETURN_IF_FAILED(_SetGraphicsRendition16Color(wNearestFg, true));
 
             _LastFG = colorForeground;
@@ -320,7 +326,7 @@ HRESULT VtEngine::_16ColorUpdateDrawingBrushes(const COLORREF colorForeground,
 
         if (bgChanged)
         {
-            const WORD wNearestBg = ::FindNearestTableIndex(colorBackground, ColorTable, cColorTable);
+            const WORD wNearestBg = _colorQuantizer.FindNearestTableIndex(colorBackground, ColorTable, cColorTable);
             RETURN_IF_FAILED(_SetGraphicsRendition16Color(wNearestBg, false));
 
             _LastBG = colorBackground;
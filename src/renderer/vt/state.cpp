@@ -54,7 +54,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _terminalOwner{ nullptr },
     _newBottomLine{ false },
     _deferredCursorPos{ INVALID_COORDS },
-    _trace {}
+    _trace {},
+    _colorQuantizer{}
 {
 #ifndef UNIT_TESTING
     // When unit testing, we can instantiate a VtEngine without a pipe.
@@ -107,7 +108,11 @@ HRESULT VtEngine::_Flush() noexcept
 
     if (!_pipeBroken)
     {
-        bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), static_cast<DWORD>(_buffer.size()), nullptr, nullptr);
+        bool fSuccess;
+        {
+            const auto throughput = _trace.MeasureWrite(_buffer.size());
+            fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), static_cast<DWORD>(_buffer.size()), nullptr, nullptr);
+        }
         _buffer.clear();
         if (!fSuccess)
         {
@@ -178,39 +183,69 @@ HRESULT VtEngine::_WriteTerminalAscii(const std::wstring& wstr) noexcept
 }
 
 // Method Description:
-// - Helper for calling _Write with a string for formatting a sequence. Used
-//      extensively by VtSequences.cpp
+// - Helper for calling _Write with a control sequence: the prefix, then the
+//      numeric parameters separated by semicolons, then the final character.
+//      Used extensively by VtSequences.cpp
+//   The sequence is built in a buffer on the stack, so unlike formatting it
+//      printf style, nothing is measured or allocated.
 // Arguments:
-// - pFormat: the pointer to the string to write to the pipe.
-// - ...: a va_list of args to format the string with.
+// - prefix: the start of the sequence, like "\x1b[" or "\x1b[38;2;"
+// - parameters: the numbers to write, in order
+// - finalChar: the character that ends the sequence
 // Return Value:
-// - S_OK, E_INVALIDARG for a invalid format string, or suitable HRESULT error
+// - S_OK, E_INVALIDARG if the sequence won't fit, or suitable HRESULT error
 //      from writing pipe.
 [[nodiscard]]
-HRESULT VtEngine::_WriteFormattedString(const std::string* const pFormat, ...) noexcept
+HRESULT VtEngine::_WriteSequence(const std::string_view prefix,
+                                 const std::initializer_list<int> parameters,
+                                 const char finalChar) noexcept
 {
+    // Each parameter is at most a sign, 10 digits, and a separator.
+    const size_t cchMaxParameter = 12;
+    char sequence[64];
+    RETURN_HR_IF(E_INVALIDARG, prefix.size() + (parameters.size() * cchMaxParameter) + 1 > ARRAYSIZE(sequence));
 
-    HRESULT hr = E_FAIL;
-    va_list argList;
-    va_start(argList, pFormat);
-
-    int cchNeeded = _scprintf(pFormat->c_str(), argList);
-    // -1 is the _scprintf error case https://msdn.microsoft.com/en-us/library/t32cf9tb.aspx
-    if (cchNeeded > -1)
+    char* pch = std::copy(prefix.cbegin(), prefix.cend(), sequence);
+    for (auto it = parameters.begin(); it != parameters.end(); ++it)
     {
-        wistd::unique_ptr<char[]> psz = wil::make_unique_nothrow<char[]>(cchNeeded + 1);
-        RETURN_IF_NULL_ALLOC(psz);
-
-        int cchWritten = _vsnprintf_s(psz.get(), cchNeeded + 1, cchNeeded, pFormat->c_str(), argList);
-        hr = _Write({ psz.get(), gsl::narrow<size_t>(cchWritten) });
+        if (it != parameters.begin())
+        {
+            *pch++ = ';';
+        }
+        pch = s_FormatDecimal(pch, *it);
     }
-    else
+    *pch++ = finalChar;
+
+    return _Write({ sequence, gsl::narrow_cast<size_t>(pch - sequence) });
+}
+
+// Method Description:
+// - Writes a number in decimal, the way printf's %d would.
+// Arguments:
+// - pch: where to write the number. There must be room for 11 characters.
+// - value: the number to write
+// Return Value:
+// - A pointer just past the last character written.
+char* VtEngine::s_FormatDecimal(_Out_writes_(11) char* const pch, const int value) noexcept
+{
+    char* out = pch;
+    unsigned int magnitude = static_cast<unsigned int>(value);
+    if (value < 0)
     {
-        hr = E_INVALIDARG;
+        *out++ = '-';
+        magnitude = 0u - magnitude;
     }
 
-    va_end(argList);
-    return hr;
+    // Write the digits backwards, then turn them around.
+    char* const firstDigit = out;
+    do
+    {
+        *out++ = static_cast<char>('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    std::reverse(firstDigit, out);
+
+    return out;
 }
 
 // Method Description:
@@ -371,13 +406,23 @@ void VtEngine::SetTestCallback(_In_ std::function<bool(const char* const, size_t
 // Method Description:
 // - Returns true if the entire viewport has been invalidated. That signals we
 //      should use a VT Clear Screen sequence as an optimization.
+// - The bounding box of the invalid area covering the viewport isn't enough,
+//      every row needs to be invalid from edge to edge too.
 // Arguments:
 // - <none>
 // Return Value:
 // - true if the entire viewport has been invalidated
 bool VtEngine::_AllIsInvalid() const
 {
-    return _lastViewport == _invalidRect;
+    if (_lastViewport != _invalidRect)
+    {
+        return false;
+    }
+
+    const SHORT width = _lastViewport.Width();
+    return std::all_of(_invalidRows.cbegin(), _invalidRows.cend(), [=](const InvalidSpan& span) {
+        return span.left == 0 && span.right >= width;
+    });
 }
 
 // Method Description:
@@ -420,6 +465,32 @@ void VtEngine::SetTerminalOwner(Microsoft::Console::ITerminalOwner* const termin
     _terminalOwner = terminalOwner;
 }
 
+// Method Description:
+// - Gets the frame and write metrics for this engine. They only move while
+//   instrumentation is enabled.
+// Arguments:
+// - <none>
+// Return Value:
+// - The metrics collected so far.
+const Microsoft::Console::VirtualTerminal::RenderMetrics& VtEngine::GetMetrics() const noexcept
+{
+    return _trace.GetMetrics();
+}
+
+// Method Description:
+// - Chooses how RGB colors are matched to the color table when this engine can
+//   only emit the 16 color table entries.
+// Arguments:
+// - metric: ColorQuantizer::Metric::Hsl to match the console's own color
+//   mapping exactly, or ColorQuantizer::Metric::Perceptual to trade some
+//   accuracy for speed.
+// Return Value:
+// - <none>
+void VtEngine::SetColorMetric(const ColorQuantizer::Metric metric) noexcept
+{
+    _colorQuantizer.SetMetric(metric);
+}
+
 // Method Description:
 // - sends a sequence to request the end terminal to tell us the
 //      cursor position. The terminal will reply back on the vt input handle.
@@ -14,7 +14,24 @@ TRACELOGGING_DEFINE_PROVIDER(g_hConsoleVtRendererTraceProvider,
 using namespace Microsoft::Console::VirtualTerminal;
 using namespace Microsoft::Console::Types;
 
-RenderTracing::RenderTracing()
+// Routine Description:
+// - Clears all the counters and histograms.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderMetrics::Reset() noexcept
+{
+    frames.Reset();
+    bytesWritten.Reset();
+    bytesPerSecond.Reset();
+    frameLatency.Reset();
+}
+
+RenderTracing::RenderTracing() :
+    _metrics{},
+    _frameStart{},
+    _inFrame{ false }
 {
     #ifndef UNIT_TESTING
     TraceLoggingRegister(g_hConsoleVtRendererTraceProvider);
@@ -24,10 +41,26 @@ RenderTracing::RenderTracing()
 RenderTracing::~RenderTracing()
 {
     #ifndef UNIT_TESTING
+    if (Instrumentation::IsEnabled())
+    {
+        TraceMetrics();
+    }
     TraceLoggingUnregister(g_hConsoleVtRendererTraceProvider);
     #endif UNIT_TESTING
 }
 
+// Routine Description:
+// - Checks whether anybody is listening for the verbose traces, so we can skip
+//   building the strings that go in them when nobody is.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the verbose traces should be written.
+bool RenderTracing::_IsTracing() noexcept
+{
+    return TraceLoggingProviderEnabled(g_hConsoleVtRendererTraceProvider, WINEVENT_LEVEL_VERBOSE, 0);
+}
+
 // Function Description:
 // - Convert the string to only have printable characters in it. Control
 //      characters are converted to hat notation, spaces are converted to "SPC"
@@ -67,6 +100,10 @@ std::string toPrintableString(const std::string_view& inString)
 void RenderTracing::TraceString(const std::string_view& instr) const
 {
     #ifndef UNIT_TESTING
+    if (!_IsTracing())
+    {
+        return;
+    }
     const std::string _seq = toPrintableString(instr);
     const char* const seq = _seq.c_str();
     TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
@@ -117,6 +154,10 @@ std::string _CoordToString(const COORD& c)
 void RenderTracing::TraceInvalidate(const Viewport invalidRect) const
 {
     #ifndef UNIT_TESTING
+    if (!_IsTracing())
+    {
+        return;
+    }
     const auto invalidatedStr = _ViewportToString(invalidRect);
     const auto invalidated = invalidatedStr.c_str();
     TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
@@ -131,6 +172,10 @@ void RenderTracing::TraceInvalidate(const Viewport invalidRect) const
 void RenderTracing::TraceInvalidateAll(const Viewport viewport) const
 {
     #ifndef UNIT_TESTING
+    if (!_IsTracing())
+    {
+        return;
+    }
     const auto invalidatedStr = _ViewportToString(viewport);
     const auto invalidatedAll = invalidatedStr.c_str();
     TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
@@ -162,6 +207,10 @@ void RenderTracing::TraceStartPaint(const bool quickReturn,
                                     const bool cursorMoved) const
 {
     #ifndef UNIT_TESTING
+    if (!_IsTracing())
+    {
+        return;
+    }
     const auto invalidatedStr = _ViewportToString(invalidRect);
     const auto invalidated = invalidatedStr.c_str();
     const auto lastViewStr = _ViewportToString(lastViewport);
@@ -201,6 +250,10 @@ void RenderTracing::TraceEndPaint() const
 void RenderTracing::TraceLastText(const COORD lastTextPos) const
 {
     #ifndef UNIT_TESTING
+    if (!_IsTracing())
+    {
+        return;
+    }
     const auto lastTextStr = _CoordToString(lastTextPos);
     const auto lastText = lastTextStr.c_str();
     TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
@@ -211,3 +264,70 @@ void RenderTracing::TraceLastText(const COORD lastTextPos) const
     UNREFERENCED_PARAMETER(lastTextPos);
     #endif UNIT_TESTING
 }
+
+// Routine Description:
+// - Notes that the engine started painting a frame that has something in it.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderTracing::StartFrame() noexcept
+{
+    _inFrame = Instrumentation::IsEnabled();
+    if (_inFrame)
+    {
+        _frameStart = Instrumentation::Clock::now();
+    }
+}
+
+// Routine Description:
+// - Notes that the frame started with StartFrame has been painted and flushed.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderTracing::EndFrame() noexcept
+{
+    if (_inFrame)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Instrumentation::Clock::now() - _frameStart);
+        _metrics.frameLatency.Record(static_cast<uint64_t>(elapsed.count()));
+        _metrics.frames.Increment();
+        _inFrame = false;
+    }
+}
+
+const RenderMetrics& RenderTracing::GetMetrics() const noexcept
+{
+    return _metrics;
+}
+
+void RenderTracing::ResetMetrics() noexcept
+{
+    _metrics.Reset();
+}
+
+// Routine Description:
+// - Writes a summary of the metrics collected so far to the VT renderer's ETW provider.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderTracing::TraceMetrics() const
+{
+    #ifndef UNIT_TESTING
+    const auto& throughput = _metrics.bytesPerSecond;
+    const auto& latency = _metrics.frameLatency;
+    TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
+                      "VtEngine_Metrics",
+                      TraceLoggingUInt64(_metrics.frames.Get(), "Frames"),
+                      TraceLoggingUInt64(_metrics.bytesWritten.Get(), "BytesWritten"),
+                      TraceLoggingUInt64(throughput.GetPercentile(50), "BytesPerSecondP50"),
+                      TraceLoggingUInt64(throughput.GetPercentile(99), "BytesPerSecondP99"),
+                      TraceLoggingUInt64(latency.GetMean(), "FrameNsMean"),
+                      TraceLoggingUInt64(latency.GetPercentile(50), "FrameNsP50"),
+                      TraceLoggingUInt64(latency.GetPercentile(99), "FrameNsP99"),
+                      TraceLoggingUInt64(latency.GetMax(), "FrameNsMax"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_INFO));
+    #endif UNIT_TESTING
+}
@@ -7,6 +7,8 @@ Module Name:
 
 Abstract:
 - This module is used for recording tracing/debugging information to the telemetry ETW channel
+- Also holds the VT renderer's metrics, which are only recorded while
+  instrumentation is enabled (see types/inc/Instrumentation.hpp).
 --*/
 
 #pragma once
@@ -16,11 +18,26 @@ Abstract:
 #include <TraceLoggingProvider.h>
 #include <telemetry\ProjectTelemetry.h>
 #include "../../types/inc/Viewport.hpp"
+#include "../../types/inc/Instrumentation.hpp"
 
 TRACELOGGING_DECLARE_PROVIDER(g_hConsoleVtRendererTraceProvider);
 
 namespace Microsoft::Console::VirtualTerminal
 {
+    struct RenderMetrics
+    {
+        Instrumentation::Counter frames;
+        Instrumentation::Counter bytesWritten;
+
+        // How fast each flush of a frame got written to the pipe.
+        Instrumentation::Histogram bytesPerSecond;
+
+        // Nanoseconds from the start of painting a frame to the end of flushing it.
+        Instrumentation::Histogram frameLatency;
+
+        void Reset() noexcept;
+    };
+
     class RenderTracing final
     {
     public:
@@ -39,5 +56,29 @@ namespace Microsoft::Console::VirtualTerminal
                              const COORD scrollDelta,
                              const bool cursorMoved) const;
         void TraceEndPaint() const;
+
+        void StartFrame() noexcept;
+        void EndFrame() noexcept;
+
+        [[nodiscard]]
+        Instrumentation::ScopedThroughput MeasureWrite(const size_t cb) noexcept
+        {
+            if (Instrumentation::IsEnabled())
+            {
+                _metrics.bytesWritten.Increment(cb);
+            }
+            return Instrumentation::ScopedThroughput(_metrics.bytesPerSecond, cb);
+        }
+
+        const RenderMetrics& GetMetrics() const noexcept;
+        void ResetMetrics() noexcept;
+        void TraceMetrics() const;
+
+    private:
+        static bool _IsTracing() noexcept;
+
+        RenderMetrics _metrics;
+        Instrumentation::Clock::time_point _frameStart;
+        bool _inFrame;
     };
 }
@@ -103,6 +103,7 @@ namespace Microsoft::Console::Render
                                 const int iDpi) noexcept override;
 
         SMALL_RECT GetDirtyRectInChars() override;
+        const std::vector<SMALL_RECT>& GetDirtyArea() override;
         [[nodiscard]]
         HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
         [[nodiscard]]
@@ -124,6 +125,10 @@ namespace Microsoft::Console::Render
 
         void SetTerminalOwner(Microsoft::Console::ITerminalOwner* const terminalOwner);
 
+        const Microsoft::Console::VirtualTerminal::RenderMetrics& GetMetrics() const noexcept;
+
+        void SetColorMetric(const ColorQuantizer::Metric metric) noexcept;
+
     protected:
         wil::unique_hfile _hFile;
         std::string _buffer;
@@ -137,6 +142,18 @@ namespace Microsoft::Console::Render
         Microsoft::Console::Types::Viewport _lastViewport;
         Microsoft::Console::Types::Viewport _invalidRect;
 
+        // The columns [left, right) that are invalid on one row of the viewport.
+        struct InvalidSpan
+        {
+            SHORT left;
+            SHORT right;
+        };
+
+        // The invalid span of each row of the viewport. _invalidRect is the
+        //      bounding box of all of them, but only these need repainting.
+        std::vector<InvalidSpan> _invalidRows;
+        std::vector<InvalidSpan> _invalidRowsScratch;
+
         bool _fInvalidRectUsed;
         COORD _lastRealCursor;
         COORD _lastText;
@@ -162,10 +179,20 @@ namespace Microsoft::Console::Render
 
         Microsoft::Console::VirtualTerminal::RenderTracing _trace;
 
+        // Scratch space for sequences that carry a string, like the title.
+        // It's kept so changing the title again doesn't allocate.
+        std::string _stringSequence;
+
+        // Maps RGB colors onto the color table for engines limited to 16 colors.
+        ColorQuantizer _colorQuantizer;
+
         [[nodiscard]]
         HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]]
-        HRESULT _WriteFormattedString(const std::string* const pFormat, ...) noexcept;
+        HRESULT _WriteSequence(const std::string_view prefix,
+                               const std::initializer_list<int> parameters,
+                               const char finalChar) noexcept;
+        static char* s_FormatDecimal(_Out_writes_(11) char* const pch, const int value) noexcept;
         [[nodiscard]]
         HRESULT _Flush() noexcept;
 
@@ -176,6 +203,11 @@ namespace Microsoft::Console::Render
         HRESULT _InvalidOffset(const COORD* const ppt) noexcept;
         [[nodiscard]]
         HRESULT _InvalidRestrict() noexcept;
+        [[nodiscard]]
+        HRESULT _InvalidRowsCombine(const Microsoft::Console::Types::Viewport invalid) noexcept;
+        [[nodiscard]]
+        HRESULT _InvalidRowsOffset(const COORD delta) noexcept;
+        void _InvalidRowsClear() noexcept;
         bool _AllIsInvalid() const;
 
         [[nodiscard]]
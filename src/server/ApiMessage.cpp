@@ -6,7 +6,8 @@
 #include <intsafe.h>
 
 #include "ApiMessage.h"
-#include "DeviceComm.h"
+#include "ApiMessageBufferPool.h"
+#include "IDeviceComm.h"
 
 _CONSOLE_API_MSG::_CONSOLE_API_MSG() : 
     _pDeviceComm(nullptr),
@@ -48,7 +49,8 @@ HRESULT _CONSOLE_API_MSG::ReadMessageInput(const ULONG cbOffset,
 }
 
 // Routine Description:
-// - This routine retrieves the input buffer associated with this message. It will allocate one if needed.
+// - This routine retrieves the input buffer associated with this message. It will take one from the
+//   message buffer pool if needed.
 // - Before completing the message, ReleaseMessageBuffers must be called to free any allocation performed by this routine.
 // Arguments:
 // - Message - Supplies the message whose input buffer will be retrieved.
@@ -67,12 +69,15 @@ HRESULT _CONSOLE_API_MSG::GetInputBuffer(_Outptr_result_bytebuffer_(*pcbSize) vo
 
         ULONG const cbReadSize = Descriptor.InputSize - State.ReadOffset;
 
-        wistd::unique_ptr<BYTE[]> pPayload = wil::make_unique_nothrow<BYTE[]>(cbReadSize);
+        auto& pool = ApiMessageBufferPool::Instance();
+        BYTE* const pPayload = pool.Acquire(cbReadSize);
         RETURN_IF_NULL_ALLOC(pPayload);
+        auto releasePayload = wil::scope_exit([&] { pool.Release(pPayload, cbReadSize); });
 
-        RETURN_IF_FAILED(ReadMessageInput(0, pPayload.get(), cbReadSize));
+        RETURN_IF_FAILED(ReadMessageInput(0, pPayload, cbReadSize));
 
-        State.InputBuffer = pPayload.release(); // TODO: MSFT: 9565140 - don't release, maintain as smart pointer.
+        releasePayload.release();
+        State.InputBuffer = pPayload; // TODO: MSFT: 9565140 - maintain as smart pointer.
         State.InputBufferSize = cbReadSize;
     }
 
@@ -84,8 +89,8 @@ HRESULT _CONSOLE_API_MSG::GetInputBuffer(_Outptr_result_bytebuffer_(*pcbSize) vo
 }
 
 // Routine Description:
-// - This routine retrieves the output buffer associated with this message. It will allocate one if needed.
-//   The allocated will be bigger than the actual output size by the requested factor.
+// - This routine retrieves the output buffer associated with this message. It will take one from the
+//   message buffer pool if needed. The buffer will be bigger than the actual output size by the requested factor.
 // - Before completing the message, ReleaseMessageBuffers must be called to free any allocation performed by this routine.
 // Arguments:
 // - Factor - Supplies the factor to multiply the allocated buffer by.
@@ -106,7 +111,7 @@ HRESULT _CONSOLE_API_MSG::GetAugmentedOutputBuffer(const ULONG cbFactor,
         ULONG cbWriteSize = Descriptor.OutputSize - State.WriteOffset;
         RETURN_IF_FAILED(ULongMult(cbWriteSize, cbFactor, &cbWriteSize));
 
-        BYTE* pPayload = new(std::nothrow) BYTE[cbWriteSize];
+        BYTE* const pPayload = ApiMessageBufferPool::Instance().Acquire(cbWriteSize);
         RETURN_IF_NULL_ALLOC(pPayload);
         ZeroMemory(pPayload, sizeof(BYTE) * cbWriteSize);
 
@@ -138,8 +143,8 @@ HRESULT _CONSOLE_API_MSG::GetOutputBuffer(_Outptr_result_bytebuffer_(*pcbSize) v
 }
 
 // Routine Description:
-// - This routine releases output or input buffers that might have been allocated
-//   during the processing of the given message. If the current completion status
+// - This routine returns output or input buffers that might have been taken from
+//   the message buffer pool during the processing of the given message. If the current completion status
 //   of the message indicates success, this routine also writes the output buffer
 //   (if any) to the message.
 // Arguments:
@@ -153,7 +158,7 @@ HRESULT _CONSOLE_API_MSG::ReleaseMessageBuffers()
 
     if (State.InputBuffer != nullptr)
     {
-        delete[] State.InputBuffer;
+        ApiMessageBufferPool::Instance().Release(State.InputBuffer, State.InputBufferSize);
         State.InputBuffer = nullptr;
     }
 
@@ -170,7 +175,7 @@ HRESULT _CONSOLE_API_MSG::ReleaseMessageBuffers()
             LOG_IF_FAILED(_pDeviceComm->WriteOutput(&IoOperation));
         }
 
-        delete[] State.OutputBuffer;
+        ApiMessageBufferPool::Instance().Release(State.OutputBuffer, State.OutputBufferSize);
         State.OutputBuffer = nullptr;
     }
 
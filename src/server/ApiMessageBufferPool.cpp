@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ApiMessageBufferPool.h"
+
+ApiMessageBufferPool& ApiMessageBufferPool::Instance()
+{
+    static ApiMessageBufferPool pool;
+    return pool;
+}
+
+ApiMessageBufferPool::ApiMessageBufferPool() noexcept :
+    _classes{}
+{
+}
+
+ApiMessageBufferPool::~ApiMessageBufferPool()
+{
+    for (auto& sizeClass : _classes)
+    {
+        for (size_t i = 0; i < sizeClass.cFree; i++)
+        {
+            delete[] sizeClass.rgpFree[i];
+        }
+        sizeClass.cFree = 0;
+    }
+}
+
+// Routine Description:
+// - Hands out a buffer able to hold at least the requested number of bytes.
+//   The contents of the buffer are undefined.
+// - The buffer must be given back with Release using the same requested size.
+// Arguments:
+// - cbSize - The number of bytes the caller needs.
+// Return Value:
+// - The buffer, or nullptr if it couldn't be allocated.
+[[nodiscard]]
+BYTE* ApiMessageBufferPool::Acquire(const ULONG cbSize) noexcept
+{
+    const size_t iClass = s_GetClass(cbSize);
+    if (iClass >= s_cClasses)
+    {
+        return new(std::nothrow) BYTE[cbSize];
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto& sizeClass = _classes[iClass];
+        if (sizeClass.cFree > 0)
+        {
+            sizeClass.cFree--;
+            return sizeClass.rgpFree[sizeClass.cFree];
+        }
+    }
+
+    return new(std::nothrow) BYTE[s_GetClassSize(iClass)];
+}
+
+// Routine Description:
+// - Gives back a buffer obtained from Acquire. It's kept for reuse if there's
+//   room in its size class and freed otherwise.
+// Arguments:
+// - pvBuffer - The buffer to give back. Can be nullptr.
+// - cbSize - The size that was passed to Acquire for this buffer.
+// Return Value:
+// - <none>
+void ApiMessageBufferPool::Release(_In_opt_ void* const pvBuffer, const ULONG cbSize) noexcept
+{
+    BYTE* const pBuffer = static_cast<BYTE*>(pvBuffer);
+    if (pBuffer == nullptr)
+    {
+        return;
+    }
+
+    const size_t iClass = s_GetClass(cbSize);
+    if (iClass < s_cClasses)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto& sizeClass = _classes[iClass];
+        if (sizeClass.cFree < s_cMaxFreePerClass)
+        {
+            sizeClass.rgpFree[sizeClass.cFree] = pBuffer;
+            sizeClass.cFree++;
+            return;
+        }
+    }
+
+    delete[] pBuffer;
+}
+
+// Routine Description:
+// - Finds the smallest size class that fits the given number of bytes.
+// Arguments:
+// - cbSize - The number of bytes needed.
+// Return Value:
+// - The index of the size class, or s_cClasses if it's too big for all of them.
+size_t ApiMessageBufferPool::s_GetClass(const ULONG cbSize) noexcept
+{
+    size_t iClass = 0;
+    ULONG cbClass = s_cbSmallestClass;
+    while (iClass < s_cClasses && cbClass < cbSize)
+    {
+        cbClass <<= 1;
+        iClass++;
+    }
+    return iClass;
+}
+
+// Routine Description:
+// - Gets the number of bytes allocated for buffers in the given size class.
+// Arguments:
+// - iClass - The index of the size class.
+// Return Value:
+// - The size in bytes.
+ULONG ApiMessageBufferPool::s_GetClassSize(const size_t iClass) noexcept
+{
+    return s_cbSmallestClass << iClass;
+}
@@ -0,0 +1,55 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ApiMessageBufferPool.h
+
+Abstract:
+- A small cache of payload buffers for API messages, so a client calling the
+  same API in a loop doesn't cost a heap allocation and free per call.
+- Buffers are grouped into power-of-two size classes. A handful of freed
+  buffers per class are kept around for the next message; anything past that,
+  or too large to fit a class, goes back to the heap.
+- Messages that wait for a reply are released from whichever thread services
+  the wait, so the cache is shared and guarded by a lock rather than being
+  owned by the IO thread.
+--*/
+
+#pragma once
+
+#include <array>
+
+class ApiMessageBufferPool final
+{
+public:
+    static ApiMessageBufferPool& Instance();
+
+    ~ApiMessageBufferPool();
+
+    ApiMessageBufferPool(const ApiMessageBufferPool&) = delete;
+    ApiMessageBufferPool& operator=(const ApiMessageBufferPool&) = delete;
+
+    [[nodiscard]]
+    BYTE* Acquire(const ULONG cbSize) noexcept;
+    void Release(_In_opt_ void* const pvBuffer, const ULONG cbSize) noexcept;
+
+    static constexpr ULONG s_cbSmallestClass = 256;
+    static constexpr size_t s_cClasses = 9; // 256 bytes through 64 kilobytes
+    static constexpr size_t s_cMaxFreePerClass = 4;
+
+private:
+    ApiMessageBufferPool() noexcept;
+
+    static size_t s_GetClass(const ULONG cbSize) noexcept;
+    static ULONG s_GetClassSize(const size_t iClass) noexcept;
+
+    struct SizeClass
+    {
+        std::array<BYTE*, s_cMaxFreePerClass> rgpFree;
+        size_t cFree;
+    };
+
+    std::array<SizeClass, s_cClasses> _classes;
+    std::mutex _lock;
+};
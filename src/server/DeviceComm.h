@@ -16,31 +16,31 @@ Revision History:
 
 #pragma once
 
-#include "..\host\conapi.h"
+#include "IDeviceComm.h"
 
 #include <wil\resource.h>
 
-class DeviceComm
+class DeviceComm : public IDeviceComm
 {
 public:
     DeviceComm(_In_ HANDLE Server);
-    ~DeviceComm();
+    ~DeviceComm() override;
 
     [[nodiscard]]
-    HRESULT SetServerInformation(_In_ CD_IO_SERVER_INFORMATION* const pServerInfo) const;
+    HRESULT SetServerInformation(_In_ CD_IO_SERVER_INFORMATION* const pServerInfo) const override;
     [[nodiscard]]
     HRESULT ReadIo(_In_opt_ CD_IO_COMPLETE* const pCompletion,
-                   _Out_ CONSOLE_API_MSG* const pMessage) const;
+                   _Out_ CONSOLE_API_MSG* const pMessage) const override;
     [[nodiscard]]
-    HRESULT CompleteIo(_In_ CD_IO_COMPLETE* const pCompletion) const;
+    HRESULT CompleteIo(_In_ CD_IO_COMPLETE* const pCompletion) const override;
 
     [[nodiscard]]
-    HRESULT ReadInput(_In_ CD_IO_OPERATION* const pIoOperation) const;
+    HRESULT ReadInput(_In_ CD_IO_OPERATION* const pIoOperation) const override;
     [[nodiscard]]
-    HRESULT WriteOutput(_In_ CD_IO_OPERATION* const pIoOperation) const;
+    HRESULT WriteOutput(_In_ CD_IO_OPERATION* const pIoOperation) const override;
 
     [[nodiscard]]
-    HRESULT AllowUIAccess() const;
+    HRESULT AllowUIAccess() const override;
 
 private:
 
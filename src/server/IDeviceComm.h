@@ -0,0 +1,42 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- IDeviceComm.h
+
+Abstract:
+- An abstraction for the communication a console server does with its device
+  (the console driver): receiving messages, reading and writing their
+  payloads, and completing them.
+- Lets the API layer be driven by something other than the driver, like an
+  in-memory stand-in for testing.
+--*/
+
+#pragma once
+
+#include "..\host\conapi.h"
+
+class IDeviceComm
+{
+public:
+    virtual ~IDeviceComm() = 0;
+
+    [[nodiscard]]
+    virtual HRESULT SetServerInformation(_In_ CD_IO_SERVER_INFORMATION* const pServerInfo) const = 0;
+    [[nodiscard]]
+    virtual HRESULT ReadIo(_In_opt_ CD_IO_COMPLETE* const pCompletion,
+                           _Out_ CONSOLE_API_MSG* const pMessage) const = 0;
+    [[nodiscard]]
+    virtual HRESULT CompleteIo(_In_ CD_IO_COMPLETE* const pCompletion) const = 0;
+
+    [[nodiscard]]
+    virtual HRESULT ReadInput(_In_ CD_IO_OPERATION* const pIoOperation) const = 0;
+    [[nodiscard]]
+    virtual HRESULT WriteOutput(_In_ CD_IO_OPERATION* const pIoOperation) const = 0;
+
+    [[nodiscard]]
+    virtual HRESULT AllowUIAccess() const = 0;
+};
+
+inline IDeviceComm::~IDeviceComm() {}
@@ -7,6 +7,10 @@
 
 #include "ascii.hpp"
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#endif
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -25,7 +29,8 @@ StateMachine::StateMachine(IStateMachineEngine* const pEngine) :
     // rgusParams Initialized below
     _sOscNextChar(0),
     _sOscParam(0),
-    _currRunLength(0)
+    _currRunLength(0),
+    _fProcessingIndividually(false)
 {
     ZeroMemory(_pwchOscStringBuffer, sizeof(_pwchOscStringBuffer));
     ZeroMemory(_rgusParams, sizeof(_rgusParams));
@@ -43,30 +48,32 @@ IStateMachineEngine& StateMachine::Engine() noexcept
 }
 
 // Routine Description:
-// - Determines if a character indicates an action that should be taken in the ground state -
-//     These are C0 characters and the C1 [single-character] CSI.
+// - Gets the counters and histograms for this state machine. They only move
+//   while instrumentation is enabled.
 // Arguments:
-// - wch - Character to check.
+// - <none>
 // Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsActionableFromGround(const wchar_t wch)
+// - The metrics collected so far.
+const ParserMetrics& StateMachine::GetMetrics() const noexcept
 {
-    return (wch <= AsciiChars::US) || s_IsC1Csi(wch) || s_IsDelete(wch);
+    return _trace.GetMetrics();
+}
+
+void StateMachine::ResetMetrics() noexcept
+{
+    _trace.ResetMetrics();
 }
 
 // Routine Description:
-// - Determines if a character belongs to the C0 escape range.
-//   This is character sequences less than a space character (null, backspace, new line, etc.)
-//   See also https://en.wikipedia.org/wiki/C0_and_C1_control_codes
+// - Determines if a character indicates an action that should be taken in the ground state -
+//     These are C0 characters and the C1 [single-character] CSI.
 // Arguments:
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsC0Code(const wchar_t wch)
+bool StateMachine::s_IsActionableFromGround(const wchar_t wch)
 {
-    return (wch >= AsciiChars::NUL && wch <= AsciiChars::ETB) ||
-           wch == AsciiChars::EM ||
-           (wch >= AsciiChars::FS && wch <= AsciiChars::US);
+    return (wch <= AsciiChars::US) || s_IsC1Csi(wch) || s_IsDelete(wch);
 }
 
 // Routine Description:
@@ -93,20 +100,6 @@ bool StateMachine::s_IsC1Csi(const wchar_t wch)
     return wch == L'\x9b';
 }
 
-// Routine Description:
-// - Determines if a character is a valid intermediate in an VT escape sequence.
-//   Intermediates are punctuation type characters that are generally vendor specific and
-//   modify the operational mode of a command.
-//   See also http://vt100.net/emu/dec_ansi_parser
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsIntermediate(const wchar_t wch)
-{
-    return wch >= L' ' && wch <= L'/'; // 0x20 - 0x2F
-}
-
 // Routine Description:
 // - Determines if a character is the delete character.
 // Arguments:
@@ -131,162 +124,179 @@ bool StateMachine::s_IsEscape(const wchar_t wch)
 }
 
 // Routine Description:
-// - Determines if a character is "control sequence" beginning indicator.
-//   This immediately follows an escape and signifies a varying length control sequence.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiIndicator(const wchar_t wch)
-{
-    return wch == L'['; // 0x5B
-}
-
-// Routine Description:
-// - Determines if a character is a delimiter between two parameters in a "control sequence"
-//   This occurs in the middle of a control sequence after escape and CsiIndicator have been recognized
-//   between a series of parameters.
+// - Sorts a character into the class that the state tables key on. Every
+//   character within a class is treated identically by every state, so the
+//   transition table only needs one column per class rather than one per character.
+//   See also http://vt100.net/emu/dec_ansi_parser
 // Arguments:
-// - wch - Character to check.
+// - wch - Character to classify.
 // Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiDelimiter(const wchar_t wch)
+// - The CharClasses value for the character.
+constexpr StateMachine::CharClasses StateMachine::s_ComputeCharClass(const wchar_t wch) noexcept
 {
-    return wch == L';'; // 0x3B
+    if (wch == AsciiChars::BEL)
+    {
+        // BEL is a C0 code, but it also terminates OSC sequences.
+        return CharClasses::Bell;
+    }
+    else if (wch == AsciiChars::ESC)
+    {
+        // ESC is a "from anywhere" event, except in the OscString state where
+        //      it initiates the two-character OSC terminator.
+        return CharClasses::Escape;
+    }
+    else if (wch <= AsciiChars::US)
+    {
+        // The C0 range, the character sequences less than a space character (null, backspace, new line, etc.)
+        //      See also https://en.wikipedia.org/wiki/C0_and_C1_control_codes
+        // CAN and SUB are also in this range, but they are "from anywhere" events
+        //      and never get as far as the state tables.
+        return CharClasses::C0;
+    }
+    else if (wch >= L' ' && wch <= L'/') // 0x20 - 0x2F
+    {
+        // Intermediates are punctuation type characters that are generally vendor specific and
+        //      modify the operational mode of a command.
+        return CharClasses::Intermediate;
+    }
+    else if (wch >= L'0' && wch <= L'9') // 0x30 - 0x39
+    {
+        // Parameters must be numerical digits.
+        return CharClasses::Number;
+    }
+    else if (wch == L':') // 0x3A
+    {
+        // This is invalid in a control sequence.
+        return CharClasses::CsiInvalid;
+    }
+    else if (wch == L';') // 0x3B
+    {
+        // The delimiter between two parameters of a CSI, SS3 or OSC sequence.
+        return CharClasses::Delimiter;
+    }
+    else if (wch >= L'<' && wch <= L'?') // 0x3C - 0x3F
+    {
+        // Private range markers indicate vendor-specific behavior.
+        return CharClasses::PrivateMarker;
+    }
+    else if (wch == L'O') // 0x4F
+    {
+        // The "Single Shift Select" indicator, which immediately follows an escape.
+        return CharClasses::Ss3Indicator;
+    }
+    else if (wch == L'[') // 0x5B
+    {
+        // The "control sequence" beginning indicator, which immediately follows an escape.
+        return CharClasses::CsiIndicator;
+    }
+    else if (wch == L']') // 0x5D
+    {
+        // The "operating system control string" beginning indicator, which immediately follows an escape.
+        return CharClasses::OscIndicator;
+    }
+    else if (wch == AsciiChars::DEL)
+    {
+        return CharClasses::Delete;
+    }
+    else if (wch == L'\x9b')
+    {
+        return CharClasses::C1Csi;
+    }
+    else if (wch == L'\x9c')
+    {
+        // The C1 String Terminator, which ends an OSC sequence.
+        return CharClasses::C1Terminator;
+    }
+    else
+    {
+        return CharClasses::Other;
+    }
 }
 
 // Routine Description:
-// - Determines if a character is a valid parameter value
-//   Parameters must be numerical digits.
+// - Builds the lookup table of classes for every character below s_cCharClassTableSize.
+//   This is evaluated at compile time.
 // Arguments:
-// - wch - Character to check.
+// - <none>
 // Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiParamValue(const wchar_t wch)
+// - The populated CharClassTable.
+constexpr StateMachine::CharClassTable StateMachine::s_BuildCharClassTable() noexcept
 {
-    return wch >= L'0' && wch <= L'9'; // 0x30 - 0x39
+    CharClassTable table{};
+    for (size_t i = 0; i < s_cCharClassTableSize; i++)
+    {
+        table.rgClasses[i] = s_ComputeCharClass(static_cast<wchar_t>(i));
+    }
+    return table;
 }
 
-// Routine Description:
-// - Determines if a character is a private range marker for a control sequence.
-//   Private range markers indicate vendor-specific behavior.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiPrivateMarker(const wchar_t wch)
-{
-    return wch == L'<' || wch == L'=' || wch == L'>' || wch == L'?'; // 0x3C - 0x3F
-}
+const StateMachine::CharClassTable StateMachine::s_charClassTable = StateMachine::s_BuildCharClassTable();
 
 // Routine Description:
-// - Determines if a character is invalid in a control sequence
+// - Determines which class of character wch belongs to, using the precomputed
+//   table for everything but the rare characters above the C1 range.
 // Arguments:
-// - wch - Character to check.
+// - wch - Character to classify.
 // Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiInvalid(const wchar_t wch)
+// - The CharClasses value for the character.
+StateMachine::CharClasses StateMachine::s_ClassifyChar(const wchar_t wch) noexcept
 {
-    return wch == L':'; // 0x3A
+    if (wch < s_cCharClassTableSize)
+    {
+        return s_charClassTable.rgClasses[wch];
+    }
+    return CharClasses::Other;
 }
 
 // Routine Description:
-// - Determines if a character is "operating system control string" beginning
-//      indicator.
-//   This immediately follows an escape and signifies a  signifies a varying
-//      length control sequence, quite similar to CSI.
+// - Finds the next character in [pwchStart, pwchEnd) that needs to be handled
+//      by the state machine when we're in the ground state. Everything before
+//      that character can be printed as a single run.
+//   On x86/x64 this compares 8 characters at a time with SSE2, and then falls
+//      back to checking the remaining tail one character at a time.
 // Arguments:
-// - wch - Character to check.
+// - pwchStart - The first character to check.
+// - pwchEnd - One past the last character to check.
 // Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsSs3Indicator(const wchar_t wch)
+// - A pointer to the first actionable character, or pwchEnd if there isn't one.
+const wchar_t* StateMachine::s_FindActionableFromGround(const wchar_t* const pwchStart, const wchar_t* const pwchEnd) noexcept
 {
-    return wch == L'O'; // 0x4F
-}
+    const wchar_t* pwch = pwchStart;
 
-// Routine Description:
-// - Determines if a character is a "Single Shift Select" indicator.
-//   This immediately follows an escape and signifies a varying length control string.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscIndicator(const wchar_t wch)
-{
-    return wch == L']'; // 0x5D
-}
+#if defined(_M_IX86) || defined(_M_X64)
+    static_assert(sizeof(wchar_t) == sizeof(uint16_t), "The SSE2 scan assumes UTF-16 code units.");
 
-// Routine Description:
-// - Determines if a character is a delimiter between two parameters in a "operating system control sequence"
-//   This occurs in the middle of a control sequence after escape and OscIndicator have been recognized,
-//   after the paramater indicating which OSC action to take.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscDelimiter(const wchar_t wch)
-{
-    return wch == L';'; // 0x3B
-}
+    const __m128i c0Max = _mm_set1_epi16(AsciiChars::US);
+    const __m128i del = _mm_set1_epi16(AsciiChars::DEL);
+    const __m128i c1Csi = _mm_set1_epi16(L'\x9b');
+    const __m128i zero = _mm_setzero_si128();
 
-// Routine Description:
-// - Determines if a character is a valid parameter value for an OSC String,
-//     that is, the indicator of which OSC action to take.
-//   Parameters must be numerical digits.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscParamValue(const wchar_t wch)
-{
-    return s_IsNumber(wch); // 0x30 - 0x39
-}
-
-// Routine Description:
-// - Determines if a character should be initiate the end of an OSC sequence.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscTerminationInitiator(const wchar_t wch)
-{
-    return wch == AsciiChars::ESC;
-}
+    while (pwchEnd - pwch >= 8)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pwch));
 
-// Routine Description:
-// - Determines if a character should be ignored in a operating system control sequence
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscInvalid(const wchar_t wch)
-{
-    return wch <= L'\x17' ||
-           wch == L'\x19' ||
-           (wch >= L'\x1c' && wch <= L'\x1f') ;
-}
+        // An unsigned saturating subtract leaves zero behind for every char <= US.
+        const __m128i isC0 = _mm_cmpeq_epi16(_mm_subs_epu16(chars, c0Max), zero);
+        const __m128i isDel = _mm_cmpeq_epi16(chars, del);
+        const __m128i isC1Csi = _mm_cmpeq_epi16(chars, c1Csi);
 
-// Routine Description:
-// - Determines if a character is "operating system control string" termination indicator.
-//   This signals the end of an OSC string collection.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscTerminator(const wchar_t wch)
-{
-    return wch == L'\x7' || wch == L'\x9C'; // Bell character or C1 terminator
-}
+        const int mask = _mm_movemask_epi8(_mm_or_si128(isC0, _mm_or_si128(isDel, isC1Csi)));
+        if (mask != 0)
+        {
+            unsigned long index;
+            _BitScanForward(&index, static_cast<unsigned long>(mask));
+            // Each wchar_t contributes two bits to the byte mask.
+            return pwch + (index / 2);
+        }
+        pwch += 8;
+    }
+#endif
 
-// Routine Description:
-// - Determines if a character is a valid number character, 0-9.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsNumber(const wchar_t wch)
-{
-    return wch >= L'0' && wch <= L'9'; // 0x30 - 0x39
+    while (pwch < pwchEnd && !s_IsActionableFromGround(*pwch))
+    {
+        pwch++;
+    }
+    return pwch;
 }
 
 // Routine Description:
@@ -298,6 +308,7 @@ bool StateMachine::s_IsNumber(const wchar_t wch)
 void StateMachine::_ActionExecute(const wchar_t wch)
 {
     _trace.TraceOnExecute(wch);
+    _trace.CountSequence(ParserMetrics::Sequence::Execute);
     _pEngine->ActionExecute(wch);
 
 }
@@ -313,6 +324,7 @@ void StateMachine::_ActionExecute(const wchar_t wch)
 void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 {
     _trace.TraceOnExecuteFromEscape(wch);
+    _trace.CountSequence(ParserMetrics::Sequence::Execute);
     _pEngine->ActionExecuteFromEscape(wch);
 
 }
@@ -326,6 +338,7 @@ void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 void StateMachine::_ActionPrint(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Print");
+    _trace.CountSequence(ParserMetrics::Sequence::PrintRun);
     _pEngine->ActionPrint(wch);
 }
 
@@ -341,7 +354,12 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"EscDispatch");
 
-    bool fSuccess = _pEngine->ActionEscDispatch(wch, _cIntermediate, _wchIntermediate);
+    bool fSuccess;
+    {
+        const auto latency = _trace.MeasureDispatch();
+        fSuccess = _pEngine->ActionEscDispatch(wch, _cIntermediate, _wchIntermediate);
+    }
+    _trace.CountSequence(ParserMetrics::Sequence::EscDispatch);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(fSuccess);
@@ -349,6 +367,7 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
     if (!fSuccess)
     {
         // Suppress it and log telemetry on failed cases
+        _trace.CountSequence(ParserMetrics::Sequence::Failed);
         TermTelemetry::Instance().LogFailed(wch);
     }
 }
@@ -364,7 +383,12 @@ void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"CsiDispatch");
 
-    bool fSuccess = _pEngine->ActionCsiDispatch(wch, _cIntermediate, _wchIntermediate, _rgusParams, _cParams);
+    bool fSuccess;
+    {
+        const auto latency = _trace.MeasureDispatch();
+        fSuccess = _pEngine->ActionCsiDispatch(wch, _cIntermediate, _wchIntermediate, _rgusParams, _cParams);
+    }
+    _trace.CountSequence(ParserMetrics::Sequence::CsiDispatch);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(fSuccess);
@@ -372,6 +396,7 @@ void StateMachine::_ActionCsiDispatch(const wchar_t wch)
     if (!fSuccess)
     {
         // Suppress it and log telemetry on failed cases
+        _trace.CountSequence(ParserMetrics::Sequence::Failed);
         TermTelemetry::Instance().LogFailed(wch);
     }
 }
@@ -578,7 +603,12 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
-    bool fSuccess = _pEngine->ActionOscDispatch(wch, _sOscParam, _pwchOscStringBuffer, _sOscNextChar);
+    bool fSuccess;
+    {
+        const auto latency = _trace.MeasureDispatch();
+        fSuccess = _pEngine->ActionOscDispatch(wch, _sOscParam, _pwchOscStringBuffer, _sOscNextChar);
+    }
+    _trace.CountSequence(ParserMetrics::Sequence::OscDispatch);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(fSuccess);
@@ -586,6 +616,7 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
     if (!fSuccess)
     {
         // Suppress it and log telemetry on failed cases
+        _trace.CountSequence(ParserMetrics::Sequence::Failed);
         TermTelemetry::Instance().LogFailed(wch);
     }
 }
@@ -601,7 +632,12 @@ void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Ss3Dispatch");
 
-    bool fSuccess = _pEngine->ActionSs3Dispatch(wch, _rgusParams, _cParams);
+    bool fSuccess;
+    {
+        const auto latency = _trace.MeasureDispatch();
+        fSuccess = _pEngine->ActionSs3Dispatch(wch, _rgusParams, _cParams);
+    }
+    _trace.CountSequence(ParserMetrics::Sequence::Ss3Dispatch);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(fSuccess);
@@ -609,6 +645,7 @@ void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
     if (!fSuccess)
     {
         // Suppress it and log telemetry on failed cases
+        _trace.CountSequence(ParserMetrics::Sequence::Failed);
         TermTelemetry::Instance().LogFailed(wch);
     }
 }
@@ -790,451 +827,411 @@ void StateMachine::_EnterSs3Param()
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Ground state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Handle a C1 Control Sequence Introducer
-//   3. Print all other characters
+// - Moves the state machine into the given state, running any entry actions
+//   that state has.
 // Arguments:
-// - wch - Character that triggered the event
+// - state - The state to enter.
 // Return Value:
 // - <none>
-void StateMachine::_EventGround(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ground");
-    if (s_IsC0Code(wch) || s_IsDelete(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsC1Csi(wch))
-    {
-        _EnterCsiEntry();
-    }
-    else
-    {
-        _ActionPrint(wch);
+void StateMachine::_EnterState(const VTStates state)
+{
+    switch (state)
+    {
+    case VTStates::Ground:
+        return _EnterGround();
+    case VTStates::Escape:
+        return _EnterEscape();
+    case VTStates::EscapeIntermediate:
+        return _EnterEscapeIntermediate();
+    case VTStates::CsiEntry:
+        return _EnterCsiEntry();
+    case VTStates::CsiIntermediate:
+        return _EnterCsiIntermediate();
+    case VTStates::CsiIgnore:
+        return _EnterCsiIgnore();
+    case VTStates::CsiParam:
+        return _EnterCsiParam();
+    case VTStates::OscParam:
+        return _EnterOscParam();
+    case VTStates::OscString:
+        return _EnterOscString();
+    case VTStates::OscTermination:
+        return _EnterOscTermination();
+    case VTStates::Ss3Entry:
+        return _EnterSs3Entry();
+    case VTStates::Ss3Param:
+        return _EnterSs3Param();
+    default:
+        return;
     }
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Escape state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Enter Control Sequence state
-//   5. Dispatch an Escape action.
+// - Computes what happens when a character of the given class arrives in the
+//      given state. This is evaluated at compile time to build s_transitionTable,
+//      so ProcessCharacter never has to walk these conditions for real input.
+//   If the returned nextState is the same as state, we stay where we are
+//      without re-running the state's entry actions.
 // Arguments:
-// - wch - Character that triggered the event
+// - state - The state the event occurs in.
+// - charClass - The class of the character that triggered the event.
 // Return Value:
-// - <none>
-void StateMachine::_EventEscape(const wchar_t wch)
+// - The action to take and the state to move to afterwards.
+constexpr StateMachine::Transition StateMachine::s_ComputeTransition(const VTStates state, const CharClasses charClass) noexcept
 {
-    _trace.TraceOnEvent(L"Escape");
-    if (s_IsC0Code(wch))
+    switch (state)
     {
-        if (_pEngine->DispatchControlCharsFromEscape())
+    case VTStates::Ground:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Handle a C1 Control Sequence Introducer
+        //   3. Print all other characters
+        switch (charClass)
         {
-            _ActionExecuteFromEscape(wch);
-            _EnterGround();
+        case CharClasses::C0:
+        case CharClasses::Bell:
+        case CharClasses::Delete:
+            return { Actions::Execute, state };
+        case CharClasses::C1Csi:
+            return { Actions::None, VTStates::CsiEntry };
+        default:
+            return { Actions::Print, state };
         }
-        else
+
+    case VTStates::Escape:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Collect Intermediate characters
+        //   4. Enter Control Sequence state
+        //   5. Dispatch an Escape action.
+        switch (charClass)
         {
-            _ActionExecute(wch);
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::EscapeExecute, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::Intermediate:
+            return { Actions::Collect, VTStates::EscapeIntermediate };
+        case CharClasses::CsiIndicator:
+            return { Actions::None, VTStates::CsiEntry };
+        case CharClasses::OscIndicator:
+            return { Actions::None, VTStates::OscParam };
+        case CharClasses::Ss3Indicator:
+            return { Actions::None, VTStates::Ss3Entry };
+        default:
+            return { Actions::EscDispatch, VTStates::Ground };
         }
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterEscapeIntermediate();
-    }
-    else if (s_IsCsiIndicator(wch))
-    {
-        _EnterCsiEntry();
-    }
-    else if (s_IsOscIndicator(wch))
-    {
-        _EnterOscParam();
-    }
-    else if (s_IsSs3Indicator(wch))
-    {
-        _EnterSs3Entry();
-    }
-    else
-    {
-        _ActionEscDispatch(wch);
-        _EnterGround();
-    }
-}
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the EscapeIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Dispatch an Escape action.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventEscapeIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"EscapeIntermediate");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        _ActionEscDispatch(wch);
-        _EnterGround();
-    }
-}
+    case VTStates::EscapeIntermediate:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Collect Intermediate characters
+        //   4. Dispatch an Escape action.
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Intermediate:
+            return { Actions::Collect, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        default:
+            return { Actions::EscDispatch, VTStates::Ground };
+        }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiEntry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Collect Control Sequence Private markers
-//   7. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiEntry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiEntry");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
-    }
-    else if (s_IsCsiInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterCsiParam();
-    }
-    else if (s_IsCsiPrivateMarker(wch))
-    {
-        _ActionCollect(wch);
-        _EnterCsiParam();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+    case VTStates::CsiEntry:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Collect Intermediate characters
+        //   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        //   5. Store parameter data
+        //   6. Collect Control Sequence Private markers
+        //   7. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::Intermediate:
+            return { Actions::Collect, VTStates::CsiIntermediate };
+        case CharClasses::CsiInvalid:
+            return { Actions::None, VTStates::CsiIgnore };
+        case CharClasses::Number:
+        case CharClasses::Delimiter:
+            return { Actions::Param, VTStates::CsiParam };
+        case CharClasses::PrivateMarker:
+            return { Actions::Collect, VTStates::CsiParam };
+        default:
+            return { Actions::CsiDispatch, VTStates::Ground };
+        }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIntermediate");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiInvalid(wch) || s_IsCsiDelimiter(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+    case VTStates::CsiIntermediate:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Collect Intermediate characters
+        //   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        //   5. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Intermediate:
+            return { Actions::Collect, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::Number:
+        case CharClasses::CsiInvalid:
+        case CharClasses::Delimiter:
+        case CharClasses::PrivateMarker:
+            return { Actions::None, VTStates::CsiIgnore };
+        default:
+            return { Actions::CsiDispatch, VTStates::Ground };
+        }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIgnore state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Return to Ground
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIgnore(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIgnore");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiInvalid(wch) || s_IsCsiDelimiter(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        _EnterGround();
-    }
-}
+    case VTStates::CsiIgnore:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Ignore Intermediate, parameter, delimiter and private marker characters
+        //   4. Return to Ground
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Delete:
+        case CharClasses::Intermediate:
+        case CharClasses::Number:
+        case CharClasses::CsiInvalid:
+        case CharClasses::Delimiter:
+        case CharClasses::PrivateMarker:
+            return { Actions::Ignore, state };
+        default:
+            return { Actions::None, VTStates::Ground };
+        }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiParam");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
-    }
-    else if (s_IsCsiInvalid(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+    case VTStates::CsiParam:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Collect Intermediate characters
+        //   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        //   5. Store parameter data
+        //   6. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::Number:
+        case CharClasses::Delimiter:
+            return { Actions::Param, state };
+        case CharClasses::Intermediate:
+            return { Actions::Collect, VTStates::CsiIntermediate };
+        case CharClasses::CsiInvalid:
+        case CharClasses::PrivateMarker:
+            return { Actions::None, VTStates::CsiIgnore };
+        default:
+            return { Actions::CsiDispatch, VTStates::Ground };
+        }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Collect numeric values into an Osc Param
-//   2. Move to the OscString state on a delimiter
-//   3. Ignore everything else.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscParam");
-    if (s_IsOscTerminator(wch))
-    {
-        _EnterGround();
-    }
-    else if (s_IsOscParamValue(wch))
-    {
-        _ActionOscParam(wch);
-    }
-    else if (s_IsOscDelimiter(wch))
-    {
-        _EnterOscString();
-    }
-    else
-    {
-        _ActionIgnore();
-    }
-}
+    case VTStates::OscParam:
+        // Events in this state will:
+        //   1. Collect numeric values into an Osc Param
+        //   2. Move to the OscString state on a delimiter
+        //   3. Ignore everything else.
+        switch (charClass)
+        {
+        case CharClasses::Bell:
+        case CharClasses::C1Terminator:
+            return { Actions::None, VTStates::Ground };
+        case CharClasses::Number:
+            return { Actions::OscParam, state };
+        case CharClasses::Delimiter:
+            return { Actions::None, VTStates::OscString };
+        default:
+            return { Actions::Ignore, state };
+        }
 
-// Routine Description:
-// - Processes a character event into a Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
-//   2. If we see a ESC, enter the OscTermination state. We'll wait for one
-//      more character before we dispatch the string.
-//   3. Ignore OscInvalid characters.
-//   4. Collect everything else into the OscString
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscString(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscString");
-    if (s_IsOscTerminator(wch))
-    {
-        _ActionOscDispatch(wch);
-        _EnterGround();
-    }
-    else if (s_IsOscTerminationInitiator(wch))
-    {
-        _EnterOscTermination();
-    }
-    else if (s_IsOscInvalid(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        // add this character to our OSC string
-        _ActionOscPut(wch);
-    }
-}
+    case VTStates::OscString:
+        // Events in this state will:
+        //   1. Trigger the OSC action associated with the param on an OscTerminator
+        //   2. If we see a ESC, enter the OscTermination state. We'll wait for one
+        //      more character before we dispatch the string.
+        //   3. Ignore OscInvalid characters.
+        //   4. Collect everything else into the OscString
+        switch (charClass)
+        {
+        case CharClasses::Bell:
+        case CharClasses::C1Terminator:
+            return { Actions::OscDispatch, VTStates::Ground };
+        case CharClasses::Escape:
+            return { Actions::None, VTStates::OscTermination };
+        case CharClasses::C0:
+            return { Actions::Ignore, state };
+        default:
+            return { Actions::OscPut, state };
+        }
 
-// Routine Description:
-// - Handle the two-character termination of a OSC sequence.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscTermination(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscTermination");
+    case VTStates::OscTermination:
+        // Events in this state will:
+        //   1. Trigger the OSC action associated with the param on an OscTerminator
+        return { Actions::OscDispatch, VTStates::Ground };
+
+    case VTStates::Ss3Entry:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        //   4. Store parameter data
+        //   5. Dispatch a control sequence with parameters for action
+        //  SS3 sequences are structurally the same as CSI sequences, just with a
+        //      different initiation. It's safe to reuse CSI's classes for
+        //      determining if a character is a parameter, delimiter, or invalid,
+        //      and to go into the CSI ignore state, because both SS3 and CSI
+        //      sequences ignore characters the same way.
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::CsiInvalid:
+            return { Actions::None, VTStates::CsiIgnore };
+        case CharClasses::Number:
+        case CharClasses::Delimiter:
+            return { Actions::Param, VTStates::Ss3Param };
+        default:
+            return { Actions::Ss3Dispatch, VTStates::Ground };
+        }
 
-    _ActionOscDispatch(wch);
-    _EnterGround();
+    case VTStates::Ss3Param:
+        // Events in this state will:
+        //   1. Execute C0 control characters
+        //   2. Ignore Delete characters
+        //   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        //   4. Store parameter data
+        //   5. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return { Actions::Execute, state };
+        case CharClasses::Delete:
+            return { Actions::Ignore, state };
+        case CharClasses::Number:
+        case CharClasses::Delimiter:
+            return { Actions::Param, state };
+        case CharClasses::CsiInvalid:
+        case CharClasses::PrivateMarker:
+            return { Actions::None, VTStates::CsiIgnore };
+        default:
+            return { Actions::Ss3Dispatch, VTStates::Ground };
+        }
+
+    default:
+        return { Actions::None, state };
+    }
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Ss3Entry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
-//  SS3 sequences are structurally the same as CSI sequences, just with a
-//      different initiation. It's safe to reuse CSI's functions for
-//      determining if a character is a parameter, delimiter, or invalid.
+// - Builds the state x character class transition table. This is evaluated at compile time.
 // Arguments:
-// - wch - Character that triggered the event
-// Return Value:
 // - <none>
-void StateMachine::_EventSs3Entry(const wchar_t wch)
+// Return Value:
+// - The populated TransitionTable.
+constexpr StateMachine::TransitionTable StateMachine::s_BuildTransitionTable() noexcept
 {
-    _trace.TraceOnEvent(L"Ss3Entry");
-    if (s_IsC0Code(wch))
+    TransitionTable table{};
+    for (size_t state = 0; state < s_cStates; state++)
     {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiInvalid(wch))
-    {
-        // It's safe for us to go into the CSI ignore here, because both SS3 and
-        //      CSI sequences ignore characters the same way.
-        _EnterCsiIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterSs3Param();
-    }
-    else
-    {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
+        for (size_t charClass = 0; charClass < s_cCharClasses; charClass++)
+        {
+            table.rgTransitions[state][charClass] = s_ComputeTransition(static_cast<VTStates>(state),
+                                                                        static_cast<CharClasses>(charClass));
+        }
     }
+    return table;
 }
 
+const StateMachine::TransitionTable StateMachine::s_transitionTable = StateMachine::s_BuildTransitionTable();
+
+// The names of each state, for tracing. These must be in the same order as VTStates.
+const PCWSTR StateMachine::s_rgwszStateNames[StateMachine::s_cStates] = {
+    L"Ground",
+    L"Escape",
+    L"EscapeIntermediate",
+    L"CsiEntry",
+    L"CsiIntermediate",
+    L"CsiIgnore",
+    L"CsiParam",
+    L"OscParam",
+    L"OscString",
+    L"OscTermination",
+    L"Ss3Entry",
+    L"Ss3Param"
+};
+
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
+// - Runs a single action from the transition table.
 // Arguments:
+// - action - The action to run.
 // - wch - Character that triggered the event
 // Return Value:
 // - <none>
-void StateMachine::_EventSs3Param(const wchar_t wch)
+void StateMachine::_ActionFromTable(const Actions action, const wchar_t wch)
 {
-    _trace.TraceOnEvent(L"Ss3Param");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
+    switch (action)
     {
-        _ActionParam(wch);
-    }
-    else if (s_IsCsiInvalid(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
+    case Actions::None:
+        return;
+    case Actions::Ignore:
+        return _ActionIgnore();
+    case Actions::Execute:
+        return _ActionExecute(wch);
+    case Actions::EscapeExecute:
+        if (_pEngine->DispatchControlCharsFromEscape())
+        {
+            _ActionExecuteFromEscape(wch);
+            _EnterGround();
+        }
+        else
+        {
+            _ActionExecute(wch);
+        }
+        return;
+    case Actions::Print:
+        return _ActionPrint(wch);
+    case Actions::Collect:
+        return _ActionCollect(wch);
+    case Actions::Param:
+        return _ActionParam(wch);
+    case Actions::EscDispatch:
+        return _ActionEscDispatch(wch);
+    case Actions::CsiDispatch:
+        return _ActionCsiDispatch(wch);
+    case Actions::OscParam:
+        return _ActionOscParam(wch);
+    case Actions::OscPut:
+        return _ActionOscPut(wch);
+    case Actions::OscDispatch:
+        return _ActionOscDispatch(wch);
+    case Actions::Ss3Dispatch:
+        return _ActionSs3Dispatch(wch);
+    default:
+        return;
     }
 }
 
@@ -1264,37 +1261,22 @@ void StateMachine::ProcessCharacter(const wchar_t wch)
     else
     {
         // Then pass to the current state as an event
-        switch (_state)
+        const VTStates state = _state;
+        const size_t iState = static_cast<size_t>(state);
+        _trace.TraceOnEvent(s_rgwszStateNames[iState]);
+
+        const Transition transition = s_transitionTable.rgTransitions[iState][static_cast<size_t>(s_ClassifyChar(wch))];
+        _ActionFromTable(transition.action, wch);
+
+        // Compare against the state we started in, not _state - some actions
+        //      (like executing a C0 from the Escape state) move us themselves.
+        if (transition.nextState != state)
         {
-        case VTStates::Ground:
-            return _EventGround(wch);
-        case VTStates::Escape:
-            return _EventEscape(wch);
-        case VTStates::EscapeIntermediate:
-            return _EventEscapeIntermediate(wch);
-        case VTStates::CsiEntry:
-            return _EventCsiEntry(wch);
-        case VTStates::CsiIntermediate:
-            return _EventCsiIntermediate(wch);
-        case VTStates::CsiIgnore:
-            return _EventCsiIgnore(wch);
-        case VTStates::CsiParam:
-            return _EventCsiParam(wch);
-        case VTStates::OscParam:
-            return _EventOscParam(wch);
-        case VTStates::OscString:
-            return _EventOscString(wch);
-        case VTStates::OscTermination:
-            return _EventOscTermination(wch);
-        case VTStates::Ss3Entry:
-            return _EventSs3Entry(wch);
-        case VTStates::Ss3Param:
-            return _EventSs3Param(wch);
-        default:
-            return;
+            _EnterState(transition.nextState);
         }
     }
 }
+
 // Method Description:
 // - Pass the current string we're processing through to the engine. It may eat
 //      the string, it may write it straight to the input unmodified, it might
@@ -1330,63 +1312,66 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
 {
+    const auto throughput = _trace.MeasureString(cch);
+
     _pwchCurr = rgwch;
     _pwchSequenceStart = rgwch;
     _currRunLength = 0;
 
-    // This should be static, because if one string starts a sequence, and the next finishes it,
-    //   we want the partial sequence state to persist.
-    static bool s_fProcessIndividually = false;
+    const wchar_t* const pwchEnd = rgwch + cch;
 
-    for(size_t cchCharsRemaining = cch; cchCharsRemaining > 0; cchCharsRemaining--)
+    while (_pwchCurr < pwchEnd)
     {
-        if (s_fProcessIndividually)
+        if (_fProcessingIndividually)
         {
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(*_pwchCurr);
             _pwchCurr++;
             if (_state == VTStates::Ground)  // Then check if we're back at ground. If we are, the next character (pwchCurr)
             {                                //   is the start of the next run of characters that might be printable.
-                s_fProcessIndividually = false;
+                _fProcessingIndividually = false;
                 _pwchSequenceStart = _pwchCurr;
                 _currRunLength = 0;
             }
         }
         else
         {
-            if (s_IsActionableFromGround(*_pwchCurr))  // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Add every char up to the next one that's actionable to the current run to be printed, all at once.
+            const wchar_t* const pwchActionable = s_FindActionableFromGround(_pwchCurr, pwchEnd);
+            _currRunLength += pwchActionable - _pwchCurr;
+            _pwchCurr = pwchActionable;
+
+            if (_pwchCurr < pwchEnd)  // If the current char is the start of an escape sequence, or should be executed in ground state...
             {
-                FAIL_FAST_IF(!(_pwchSequenceStart + _currRunLength <= rgwch + cch));
+                FAIL_FAST_IF(!(_pwchSequenceStart + _currRunLength <= pwchEnd));
                 _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength); // ... print all the chars leading up to it as part of the run...
+                _trace.CountSequence(ParserMetrics::Sequence::PrintRun);
                 _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
-                s_fProcessIndividually = true; // begin processing future characters individually...
+                _fProcessingIndividually = true; // begin processing future characters individually...
                 _currRunLength = 0;
                 _pwchSequenceStart = _pwchCurr;
                 ProcessCharacter(*_pwchCurr); // ... Then process the character individually.
                 if (_state == VTStates::Ground)  // If the character took us right back to ground, start another run after it.
                 {
-                    s_fProcessIndividually = false;
+                    _fProcessingIndividually = false;
                     _pwchSequenceStart = _pwchCurr + 1;
                     _currRunLength = 0;
                 }
+                _pwchCurr++;
             }
-            else
-            {
-                _currRunLength++; // Otherwise, add this char to the current run to be printed.
-            }
-            _pwchCurr++;
         }
     }
 
     // If we're at the end of the string and have remaining un-printed characters,
-    if (!s_fProcessIndividually && _currRunLength > 0)
+    if (!_fProcessingIndividually && _currRunLength > 0)
     {
         // print the rest of the characters in the string
         _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength);
+        _trace.CountSequence(ParserMetrics::Sequence::PrintRun);
         _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
 
     }
-    else if (s_fProcessIndividually)
+    else if (_fProcessingIndividually)
     {
         if (_pEngine->FlushAtEndOfString())
         {
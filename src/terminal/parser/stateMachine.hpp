@@ -42,32 +42,104 @@ namespace Microsoft::Console::VirtualTerminal
         const IStateMachineEngine& Engine() const noexcept;
         IStateMachineEngine& Engine() noexcept;
 
+        const ParserMetrics& GetMetrics() const noexcept;
+        void ResetMetrics() noexcept;
+
         static const short s_cIntermediateMax = 1;
         static const short s_cParamsMax = 16;
         static const short s_cOscStringMaxLength = 256;
 
     private:
+        enum class VTStates
+        {
+            Ground,
+            Escape,
+            EscapeIntermediate,
+            CsiEntry,
+            CsiIntermediate,
+            CsiIgnore,
+            CsiParam,
+            OscParam,
+            OscString,
+            OscTermination,
+            Ss3Entry,
+            Ss3Param
+        };
+        static constexpr size_t s_cStates = static_cast<size_t>(VTStates::Ss3Param) + 1;
+
+        // Every character in a class is treated identically by every state.
+        enum class CharClasses : BYTE
+        {
+            C0,
+            Bell,
+            Escape,
+            Intermediate,
+            Number,
+            CsiInvalid,
+            Delimiter,
+            PrivateMarker,
+            Ss3Indicator,
+            CsiIndicator,
+            OscIndicator,
+            Delete,
+            C1Csi,
+            C1Terminator,
+            Other
+        };
+        static constexpr size_t s_cCharClasses = static_cast<size_t>(CharClasses::Other) + 1;
+
+        // The action to take for a single cell of the transition table.
+        enum class Actions : BYTE
+        {
+            None,
+            Ignore,
+            Execute,
+            EscapeExecute,
+            Print,
+            Collect,
+            Param,
+            EscDispatch,
+            CsiDispatch,
+            OscParam,
+            OscPut,
+            OscDispatch,
+            Ss3Dispatch
+        };
+
+        struct Transition
+        {
+            Actions action;
+            VTStates nextState;
+        };
+
+        struct TransitionTable
+        {
+            Transition rgTransitions[s_cStates][s_cCharClasses];
+        };
+
+        // Everything from U+00A0 up is in CharClasses::Other.
+        static constexpr size_t s_cCharClassTableSize = 0xA0;
+        struct CharClassTable
+        {
+            CharClasses rgClasses[s_cCharClassTableSize];
+        };
+
+        static const TransitionTable s_transitionTable;
+        static const CharClassTable s_charClassTable;
+        static const PCWSTR s_rgwszStateNames[s_cStates];
+
+        static constexpr CharClasses s_ComputeCharClass(const wchar_t wch) noexcept;
+        static constexpr CharClassTable s_BuildCharClassTable() noexcept;
+        static constexpr Transition s_ComputeTransition(const VTStates state, const CharClasses charClass) noexcept;
+        static constexpr TransitionTable s_BuildTransitionTable() noexcept;
+        static CharClasses s_ClassifyChar(const wchar_t wch) noexcept;
+
+        static const wchar_t* s_FindActionableFromGround(const wchar_t* const pwchStart, const wchar_t* const pwchEnd) noexcept;
+
         static bool s_IsActionableFromGround(const wchar_t wch);
-        static bool s_IsC0Code(const wchar_t wch);
         static bool s_IsC1Csi(const wchar_t wch);
-        static bool s_IsIntermediate(const wchar_t wch);
         static bool s_IsDelete(const wchar_t wch);
         static bool s_IsEscape(const wchar_t wch);
-        static bool s_IsCsiIndicator(const wchar_t wch);
-        static bool s_IsCsiDelimiter(const wchar_t wch);
-        static bool s_IsCsiParamValue(const wchar_t wch);
-        static bool s_IsCsiPrivateMarker(const wchar_t wch);
-        static bool s_IsCsiInvalid(const wchar_t wch);
-        static bool s_IsOscIndicator(const wchar_t wch);
-        static bool s_IsOscDelimiter(const wchar_t wch);
-        static bool s_IsOscParamValue(const wchar_t wch);
-        static bool s_IsOscInvalid(const wchar_t wch);
-        static bool s_IsOscTerminator(const wchar_t wch);
-        static bool s_IsOscTerminationInitiator(const wchar_t wch);
-        static bool s_IsDesignateCharsetIndicator(const wchar_t wch);
-        static bool s_IsCharsetCode(const wchar_t wch);
-        static bool s_IsNumber(const wchar_t wch);
-        static bool s_IsSs3Indicator(const wchar_t wch);
 
         void _ActionExecute(const wchar_t wch);
         void _ActionExecuteFromEscape(const wchar_t wch);
@@ -97,34 +169,8 @@ namespace Microsoft::Console::VirtualTerminal
         void _EnterSs3Entry();
         void _EnterSs3Param();
 
-        void _EventGround(const wchar_t wch);
-        void _EventEscape(const wchar_t wch);
-        void _EventEscapeIntermediate(const wchar_t wch);
-        void _EventCsiEntry(const wchar_t wch);
-        void _EventCsiIntermediate(const wchar_t wch);
-        void _EventCsiIgnore(const wchar_t wch);
-        void _EventCsiParam(const wchar_t wch);
-        void _EventOscParam(const wchar_t wch);
-        void _EventOscString(const wchar_t wch);
-        void _EventOscTermination(const wchar_t wch);
-        void _EventSs3Entry(const wchar_t wch);
-        void _EventSs3Param(const wchar_t wch);
-
-        enum class VTStates
-        {
-            Ground,
-            Escape,
-            EscapeIntermediate,
-            CsiEntry,
-            CsiIntermediate,
-            CsiIgnore,
-            CsiParam,
-            OscParam,
-            OscString,
-            OscTermination,
-            Ss3Entry,
-            Ss3Param
-        };
+        void _EnterState(const VTStates state);
+        void _ActionFromTable(const Actions action, const wchar_t wch);
 
         Microsoft::Console::VirtualTerminal::ParserTracing _trace;
 
@@ -151,5 +197,11 @@ namespace Microsoft::Console::VirtualTerminal
         const wchar_t* _pwchSequenceStart;
         size_t _currRunLength;
 
+        // This is a member rather than a local, because if one string starts a
+        //   sequence, and the next finishes it, we want the partial sequence
+        //   state to persist. It is per-instance so that several machines (input
+        //   and output, or one per tab) can each be mid-sequence independently.
+        bool _fProcessingIndividually;
+
     };
 }
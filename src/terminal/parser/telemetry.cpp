@@ -52,8 +52,10 @@ void TermTelemetry::Log(const Codes code)
     // to use an array which has very quick access times.
     // The downside is we have to create an enum type, and then convert them to strings when we finally
     // send out the telemetry, but the upside is we should have very good performance.
-    _uiTimesUsed[code]++;
-    _uiTimesUsedCurrent++;
+    // Every StateMachine in the process shares this instance, and they may be running on different
+    // threads (one per tab in the Terminal), so the counts are updated with interlocked operations.
+    InterlockedIncrement(&_uiTimesUsed[code]);
+    InterlockedIncrement(&_uiTimesUsedCurrent);
 }
 
 // Routine Description:
@@ -67,14 +69,14 @@ void TermTelemetry::LogFailed(const wchar_t wch)
 {
     if (wch > CHAR_MAX)
     {
-        _uiTimesFailedOutsideRange++;
-        _uiTimesFailedOutsideRangeCurrent++;
+        InterlockedIncrement(&_uiTimesFailedOutsideRange);
+        InterlockedIncrement(&_uiTimesFailedOutsideRangeCurrent);
     }
     else
     {
         // Even though we pass over a wide character, we only care about the ASCII single byte character.
-        _uiTimesFailed[wch]++;
-        _uiTimesFailedCurrent++;
+        InterlockedIncrement(&_uiTimesFailed[wch]);
+        InterlockedIncrement(&_uiTimesFailedCurrent);
     }
 }
 
@@ -87,9 +89,19 @@ void TermTelemetry::LogFailed(const wchar_t wch)
 // - total number.
 unsigned int TermTelemetry::GetAndResetTimesUsedCurrent()
 {
-    unsigned int uiTemp = _uiTimesUsedCurrent;
-    _uiTimesUsedCurrent = 0;
-    return uiTemp;
+    return InterlockedExchange(&_uiTimesUsedCurrent, 0);
+}
+
+// Routine Description:
+// - Gets how many times a particular VT100 code has been dispatched since the process started.
+//
+// Arguments:
+// - code - VT100 code.
+// Return Value:
+// - total number.
+unsigned int TermTelemetry::GetTimesUsed(const Codes code) const noexcept
+{
+    return code < NUMBER_OF_CODES ? _uiTimesUsed[code] : 0;
 }
 
 // Routine Description:
@@ -101,9 +113,7 @@ unsigned int TermTelemetry::GetAndResetTimesUsedCurrent()
 // - total number.
 unsigned int TermTelemetry::GetAndResetTimesFailedCurrent()
 {
-    unsigned int uiTemp = _uiTimesFailedCurrent;
-    _uiTimesFailedCurrent = 0;
-    return uiTemp;
+    return InterlockedExchange(&_uiTimesFailedCurrent, 0);
 }
 
 // Routine Description:
@@ -115,9 +125,7 @@ unsigned int TermTelemetry::GetAndResetTimesFailedCurrent()
 // - total number.
 unsigned int TermTelemetry::GetAndResetTimesFailedOutsideRangeCurrent()
 {
-    unsigned int uiTemp = _uiTimesFailedOutsideRangeCurrent;
-    _uiTimesFailedOutsideRangeCurrent = 0;
-    return uiTemp;
+    return InterlockedExchange(&_uiTimesFailedOutsideRangeCurrent, 0);
 }
 
 // Routine Description:
@@ -91,6 +91,7 @@ namespace Microsoft::Console::VirtualTerminal
         void SetShouldWriteFinalLog(const bool writeLog);
         void SetActivityId(const GUID *activityId);
         unsigned int GetAndResetTimesUsedCurrent();
+        unsigned int GetTimesUsed(const Codes code) const noexcept;
         unsigned int GetAndResetTimesFailedCurrent();
         unsigned int GetAndResetTimesFailedOutsideRangeCurrent();
 
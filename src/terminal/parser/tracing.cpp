@@ -6,17 +6,78 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-ParserTracing::ParserTracing()
+// Routine Description:
+// - Clears all the counters and histograms.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ParserMetrics::Reset() noexcept
+{
+    for (auto& counter : sequences)
+    {
+        counter.Reset();
+    }
+    charactersPerSecond.Reset();
+    dispatchLatency.Reset();
+}
+
+ParserTracing::ParserTracing() :
+    _rgwchSequenceTrace{},
+    _cchSequenceTrace(0),
+    _metrics{}
 {
-    ClearSequenceTrace();
 }
 
 ParserTracing::~ParserTracing()
 {
+    if (Instrumentation::IsEnabled())
+    {
+        TraceMetrics();
+    }
+}
 
+const ParserMetrics& ParserTracing::GetMetrics() const noexcept
+{
+    return _metrics;
 }
 
-void ParserTracing::TraceStateChange(_In_ PCWSTR const pwszName) const
+void ParserTracing::ResetMetrics() noexcept
+{
+    _metrics.Reset();
+}
+
+// Routine Description:
+// - Writes a summary of the metrics collected so far to the parser's ETW provider.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ParserTracing::TraceMetrics() const
+{
+    using Sequence = ParserMetrics::Sequence;
+    const auto& throughput = _metrics.charactersPerSecond;
+    const auto& latency = _metrics.dispatchLatency;
+    TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_Metrics",
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::Execute), "Execute"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::PrintRun), "PrintRun"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::EscDispatch), "EscDispatch"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::CsiDispatch), "CsiDispatch"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::OscDispatch), "OscDispatch"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::Ss3Dispatch), "Ss3Dispatch"),
+        TraceLoggingUInt64(_metrics.GetCount(Sequence::Failed), "Failed"),
+        TraceLoggingUInt64(throughput.GetCount(), "Strings"),
+        TraceLoggingUInt64(throughput.GetPercentile(50), "CharactersPerSecondP50"),
+        TraceLoggingUInt64(throughput.GetPercentile(99), "CharactersPerSecondP99"),
+        TraceLoggingUInt64(latency.GetMean(), "DispatchNsMean"),
+        TraceLoggingUInt64(latency.GetPercentile(50), "DispatchNsP50"),
+        TraceLoggingUInt64(latency.GetPercentile(99), "DispatchNsP99"),
+        TraceLoggingUInt64(latency.GetMax(), "DispatchNsMax"),
+        TraceLoggingLevel(WINEVENT_LEVEL_INFO)
+        );
+}
+
+void ParserTracing::_TraceStateChange(_In_ PCWSTR const pwszName) const
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_EnterState",
         TraceLoggingWideString(pwszName),
@@ -24,7 +85,7 @@ void ParserTracing::TraceStateChange(_In_ PCWSTR const pwszName) const
         );
 }
 
-void ParserTracing::TraceOnAction(_In_ PCWSTR const pwszName) const
+void ParserTracing::_TraceOnAction(_In_ PCWSTR const pwszName) const
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_Action",
         TraceLoggingWideString(pwszName),
@@ -32,7 +93,7 @@ void ParserTracing::TraceOnAction(_In_ PCWSTR const pwszName) const
         );
 }
 
-void ParserTracing::TraceOnExecute(const wchar_t wch) const
+void ParserTracing::_TraceOnExecute(const wchar_t wch) const
 {
     INT16 sch = (INT16)wch;
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_Execute",
@@ -42,7 +103,7 @@ void ParserTracing::TraceOnExecute(const wchar_t wch) const
         );
 }
 
-void ParserTracing::TraceOnExecuteFromEscape(const wchar_t wch) const
+void ParserTracing::_TraceOnExecuteFromEscape(const wchar_t wch) const
 {
     INT16 sch = (INT16)wch;
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_ExecuteFromEscape",
@@ -52,7 +113,7 @@ void ParserTracing::TraceOnExecuteFromEscape(const wchar_t wch) const
         );
 }
 
-void ParserTracing::TraceOnEvent(_In_ PCWSTR const pwszName) const
+void ParserTracing::_TraceOnEvent(_In_ PCWSTR const pwszName) const
 {
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_Event",
         TraceLoggingWideString(pwszName),
@@ -60,9 +121,9 @@ void ParserTracing::TraceOnEvent(_In_ PCWSTR const pwszName) const
         );
 }
 
-void ParserTracing::TraceCharInput(const wchar_t wch)
+void ParserTracing::_TraceCharInput(const wchar_t wch)
 {
-    AddSequenceTrace(wch);
+    _AddSequenceTrace(wch);
     INT16 sch = (INT16)wch;
 
     TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_NewChar",
@@ -72,7 +133,7 @@ void ParserTracing::TraceCharInput(const wchar_t wch)
         );
 }
 
-void ParserTracing::AddSequenceTrace(const wchar_t wch)
+void ParserTracing::_AddSequenceTrace(const wchar_t wch) noexcept
 {
     // -1 to always leave the last character as null/0.
     if (_cchSequenceTrace < s_cMaxSequenceTrace - 1)
@@ -82,8 +143,11 @@ void ParserTracing::AddSequenceTrace(const wchar_t wch)
     }
 }
 
-void ParserTracing::DispatchSequenceTrace(const bool fSuccess)
+void ParserTracing::_DispatchSequenceTrace(const bool fSuccess)
 {
+    // The trace is only terminated here rather than cleared every time a sequence starts.
+    _rgwchSequenceTrace[_cchSequenceTrace] = L'\0';
+
     if (fSuccess)
     {
         TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_Sequence_OK",
@@ -98,19 +162,12 @@ void ParserTracing::DispatchSequenceTrace(const bool fSuccess)
                           TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE)
                           );
     }
-
-    ClearSequenceTrace();
-}
-
-void ParserTracing::ClearSequenceTrace()
-{
-    ZeroMemory(_rgwchSequenceTrace, sizeof(_rgwchSequenceTrace));
-    _cchSequenceTrace = 0;
 }
 
 // NOTE: I'm expecting this to not be null terminated
-void ParserTracing::DispatchPrintRunTrace(const wchar_t* const pwsString, const size_t cchString) const
+void ParserTracing::_DispatchPrintRunTrace(const wchar_t* const pwsString, const size_t cchString) const
 {
+    const wchar_t* pwsRemaining = pwsString;
     size_t charsRemaining = cchString;
     wchar_t str[BYTE_MAX + 4 + sizeof(wchar_t) + sizeof('\0')];
 
@@ -139,8 +196,9 @@ void ParserTracing::DispatchPrintRunTrace(const wchar_t* const pwsString, const
             }
             charsRemaining -= strLen;
 
-            memcpy(str, pwsString, sizeof(wchar_t) * strLen);
+            memcpy(str, pwsRemaining, sizeof(wchar_t) * strLen);
             str[strLen] = '\0';
+            pwsRemaining += strLen;
 
             TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider, "StateMachine_PrintRun",
                               TraceLoggingWideString(str),
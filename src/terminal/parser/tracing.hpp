@@ -8,6 +8,10 @@ Module Name:
 Abstract:
 - This module is used for recording tracing/debugging information to the telemetry ETW channel
 - The data is not automatically broadcast to telemetry backends.
+- Every trace is skipped unless a listener has enabled the provider at verbose level, so the
+  per-character calls the state machine makes cost a single check when nobody is listening.
+- Also holds the parser's metrics, which are only recorded while instrumentation is enabled
+  (see types/inc/Instrumentation.hpp).
 - NOTE: Many functions in this file appear to be copy/pastes. This is because the TraceLog documentation warns
         to not be "cute" in trying to reduce its macro usages with variables as it can cause unexpected behavior.
 */
@@ -15,9 +19,42 @@ Abstract:
 #pragma once
 
 #include "telemetry.hpp"
+#include "../../types/inc/Instrumentation.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
 {
+    struct ParserMetrics
+    {
+        enum class Sequence : size_t
+        {
+            Execute = 0,
+            PrintRun,
+            EscDispatch,
+            CsiDispatch,
+            OscDispatch,
+            Ss3Dispatch,
+            Failed,
+            // Only use this last enum as a count of the number of sequence types.
+            NUMBER_OF_SEQUENCES
+        };
+
+        std::array<Instrumentation::Counter, static_cast<size_t>(Sequence::NUMBER_OF_SEQUENCES)> sequences;
+
+        // How many characters per second ProcessString got through, one sample per call.
+        Instrumentation::Histogram charactersPerSecond;
+
+        // Nanoseconds the engine (and the dispatcher behind it) took to handle each
+        // dispatched escape, CSI, OSC or SS3 sequence. C0 controls aren't timed.
+        Instrumentation::Histogram dispatchLatency;
+
+        uint64_t GetCount(const Sequence sequence) const noexcept
+        {
+            return sequences[static_cast<size_t>(sequence)].Get();
+        }
+
+        void Reset() noexcept;
+    };
+
     class ParserTracing sealed
     {
     public:
@@ -25,24 +62,121 @@ namespace Microsoft::Console::VirtualTerminal
         ParserTracing();
         ~ParserTracing();
 
-        void TraceStateChange(_In_ PCWSTR const pwszName) const;
-        void TraceOnAction(_In_ PCWSTR const pwszName) const;
-        void TraceOnExecute(const wchar_t wch) const;
-        void TraceOnExecuteFromEscape(const wchar_t wch) const;
-        void TraceOnEvent(_In_ PCWSTR const pwszName) const;
-        void TraceCharInput(const wchar_t wch);
+        void TraceStateChange(_In_ PCWSTR const pwszName) const
+        {
+            if (_IsTracing())
+            {
+                _TraceStateChange(pwszName);
+            }
+        }
+
+        void TraceOnAction(_In_ PCWSTR const pwszName) const
+        {
+            if (_IsTracing())
+            {
+                _TraceOnAction(pwszName);
+            }
+        }
+
+        void TraceOnExecute(const wchar_t wch) const
+        {
+            if (_IsTracing())
+            {
+                _TraceOnExecute(wch);
+            }
+        }
+
+        void TraceOnExecuteFromEscape(const wchar_t wch) const
+        {
+            if (_IsTracing())
+            {
+                _TraceOnExecuteFromEscape(wch);
+            }
+        }
 
-        void AddSequenceTrace(const wchar_t wch);
-        void DispatchSequenceTrace(const bool fSuccess);
-        void ClearSequenceTrace();
-        void DispatchPrintRunTrace(const wchar_t* const pwsString, const size_t cchString) const;
+        void TraceOnEvent(_In_ PCWSTR const pwszName) const
+        {
+            if (_IsTracing())
+            {
+                _TraceOnEvent(pwszName);
+            }
+        }
+
+        void TraceCharInput(const wchar_t wch)
+        {
+            if (_IsTracing())
+            {
+                _TraceCharInput(wch);
+            }
+        }
+
+        void DispatchSequenceTrace(const bool fSuccess)
+        {
+            if (_IsTracing())
+            {
+                _DispatchSequenceTrace(fSuccess);
+            }
+            ClearSequenceTrace();
+        }
+
+        void ClearSequenceTrace() noexcept
+        {
+            _cchSequenceTrace = 0;
+        }
+
+        void DispatchPrintRunTrace(const wchar_t* const pwsString, const size_t cchString) const
+        {
+            if (_IsTracing())
+            {
+                _DispatchPrintRunTrace(pwsString, cchString);
+            }
+        }
+
+        void CountSequence(const ParserMetrics::Sequence sequence) noexcept
+        {
+            if (Instrumentation::IsEnabled())
+            {
+                _metrics.sequences[static_cast<size_t>(sequence)].Increment();
+            }
+        }
+
+        [[nodiscard]]
+        Instrumentation::ScopedLatency MeasureDispatch() noexcept
+        {
+            return Instrumentation::ScopedLatency(_metrics.dispatchLatency);
+        }
+
+        [[nodiscard]]
+        Instrumentation::ScopedThroughput MeasureString(const size_t cch) noexcept
+        {
+            return Instrumentation::ScopedThroughput(_metrics.charactersPerSecond, cch);
+        }
+
+        const ParserMetrics& GetMetrics() const noexcept;
+        void ResetMetrics() noexcept;
+        void TraceMetrics() const;
 
     private:
+        static bool _IsTracing() noexcept
+        {
+            return TraceLoggingProviderEnabled(g_hConsoleVirtTermParserEventTraceProvider, WINEVENT_LEVEL_VERBOSE, 0);
+        }
+
+        void _TraceStateChange(_In_ PCWSTR const pwszName) const;
+        void _TraceOnAction(_In_ PCWSTR const pwszName) const;
+        void _TraceOnExecute(const wchar_t wch) const;
+        void _TraceOnExecuteFromEscape(const wchar_t wch) const;
+        void _TraceOnEvent(_In_ PCWSTR const pwszName) const;
+        void _TraceCharInput(const wchar_t wch);
+        void _AddSequenceTrace(const wchar_t wch) noexcept;
+        void _DispatchSequenceTrace(const bool fSuccess);
+        void _DispatchPrintRunTrace(const wchar_t* const pwsString, const size_t cchString) const;
+
         static const size_t s_cMaxSequenceTrace = 32;
 
         wchar_t _rgwchSequenceTrace[s_cMaxSequenceTrace];
         size_t _cchSequenceTrace;
 
-
+        ParserMetrics _metrics;
     };
 }
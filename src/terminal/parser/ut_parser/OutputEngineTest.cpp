@@ -10,6 +10,8 @@
 
 #include "ascii.hpp"
 
+#include <chrono>
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 using namespace WEX::Common;
@@ -544,6 +546,114 @@ class Microsoft::Console::VirtualTerminal::OutputEngineTest final
         mach.ProcessCharacter(L'J');
         VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
     }
+
+    void _MeasureProcessStringThroughput(_In_ PCWSTR const pwszName, const std::wstring& line)
+    {
+        // Build up a few MB of output, then hand it to the state machine in
+        //      pipe-read sized chunks, the way conhost and the Terminal do.
+        const size_t cchPayload = 4 * 1024 * 1024;
+        const size_t cchChunk = 4096;
+
+        std::wstring payload;
+        payload.reserve(cchPayload + line.size());
+        while (payload.size() < cchPayload)
+        {
+            payload.append(line);
+        }
+
+        StateMachine mach(new OutputStateMachineEngine(new DummyDispatch));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < payload.size(); i += cchChunk)
+        {
+            mach.ProcessString(payload.data() + i, std::min(cchChunk, payload.size() - i));
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double megabytes = static_cast<double>(payload.size() * sizeof(wchar_t)) / (1024.0 * 1024.0);
+        Log::Comment(String().Format(L"%s: %.2f MB in %.3f s, %.2f MB/s",
+                                     pwszName,
+                                     megabytes,
+                                     elapsed,
+                                     elapsed > 0 ? megabytes / elapsed : 0.0));
+    }
+
+    TEST_METHOD(TestProcessStringThroughput)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        _MeasureProcessStringThroughput(L"Plain text",
+                                        L"cl.exe /c /Zi /nologo /W4 /WX /O2 src\\terminal\\parser\\stateMachine.cpp\r\n");
+        _MeasureProcessStringThroughput(L"SGR heavy",
+                                        L"\x1b[1;32mok\x1b[0m \x1b[38;5;208mwarn\x1b[0m \x1b[38;2;255;0;0merror\x1b[m: \x1b[4msomething\x1b[24m\r\n");
+        _MeasureProcessStringThroughput(L"Cursor movement heavy",
+                                        L"\x1b[1;1H\x1b[K12:00:01\x1b[5;10Hcpu\x1b[2C42%\x1b[3A\x1b[10D\x1b[?25l\x1b[?25h\x1b[24;80H");
+    }
+
+    TEST_METHOD(TestMetrics)
+    {
+        using Sequence = ParserMetrics::Sequence;
+
+        StateMachine mach(new OutputStateMachineEngine(new DummyDispatch));
+        const ParserMetrics& metrics = mach.GetMetrics();
+
+        // Two print runs, one CSI, two C0s, one escape, one OSC and one SS3.
+        const std::wstring text(L"abc\x1b[1mdef\r\n\x1b" L"7\x1b]0;title\x07\x1bOP");
+
+        Log::Comment(L"Nothing should be recorded while instrumentation is off.");
+        Instrumentation::SetEnabled(false);
+        mach.ProcessString(text);
+        for (size_t i = 0; i < static_cast<size_t>(Sequence::NUMBER_OF_SEQUENCES); ++i)
+        {
+            VERIFY_ARE_EQUAL(0u, metrics.sequences[i].Get());
+        }
+        VERIFY_ARE_EQUAL(0u, metrics.charactersPerSecond.GetCount());
+        VERIFY_ARE_EQUAL(0u, metrics.dispatchLatency.GetCount());
+
+        Log::Comment(L"Every kind of sequence should be counted once it's on.");
+        Instrumentation::SetEnabled(true);
+        auto disable = wil::scope_exit([] { Instrumentation::SetEnabled(false); });
+        mach.ProcessString(text);
+        VERIFY_ARE_EQUAL(2u, metrics.GetCount(Sequence::PrintRun));
+        VERIFY_ARE_EQUAL(1u, metrics.GetCount(Sequence::CsiDispatch));
+        VERIFY_ARE_EQUAL(2u, metrics.GetCount(Sequence::Execute));
+        VERIFY_ARE_EQUAL(1u, metrics.GetCount(Sequence::EscDispatch));
+        VERIFY_ARE_EQUAL(1u, metrics.GetCount(Sequence::OscDispatch));
+        VERIFY_ARE_EQUAL(1u, metrics.GetCount(Sequence::Ss3Dispatch));
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(metrics.GetCount(Sequence::Failed), 1u, L"The output engine never handles SS3.");
+        VERIFY_ARE_EQUAL(1u, metrics.charactersPerSecond.GetCount(), L"One sample per call to ProcessString.");
+        VERIFY_ARE_EQUAL(4u, metrics.dispatchLatency.GetCount(), L"One sample per dispatched sequence.");
+
+        mach.ResetMetrics();
+        VERIFY_ARE_EQUAL(0u, metrics.GetCount(Sequence::PrintRun));
+        VERIFY_ARE_EQUAL(0u, metrics.dispatchLatency.GetCount());
+    }
+
+    TEST_METHOD(TestHistogramBuckets)
+    {
+        using Instrumentation::Histogram;
+
+        VERIFY_ARE_EQUAL(0u, Histogram::s_GetBucket(0));
+        VERIFY_ARE_EQUAL(1u, Histogram::s_GetBucket(1));
+        VERIFY_ARE_EQUAL(2u, Histogram::s_GetBucket(3));
+        VERIFY_ARE_EQUAL(3u, Histogram::s_GetBucket(4));
+        VERIFY_ARE_EQUAL(Histogram::s_cBuckets - 1, Histogram::s_GetBucket(UINT64_MAX));
+
+        Histogram histogram;
+        VERIFY_ARE_EQUAL(0u, histogram.GetPercentile(50), L"An empty histogram has no percentiles.");
+
+        for (const uint64_t value : { 0, 1, 2, 3, 4, 1000 })
+        {
+            histogram.Record(value);
+        }
+        VERIFY_ARE_EQUAL(6u, histogram.GetCount());
+        VERIFY_ARE_EQUAL(1010u, histogram.GetSum());
+        VERIFY_ARE_EQUAL(1000u, histogram.GetMax());
+        VERIFY_ARE_EQUAL(3u, histogram.GetPercentile(50), L"Half the values are at most 3.");
+        VERIFY_ARE_EQUAL(1000u, histogram.GetPercentile(100), L"Percentiles never go past the largest value.");
+    }
 };
 
 class StatefulDispatch final : public TermDispatch
@@ -554,12 +664,14 @@ public:
     {
     }
 
-    virtual void Print(const wchar_t /*wchPrintable*/) override
+    virtual void Print(const wchar_t wchPrintable) override
     {
+        _printString.push_back(wchPrintable);
     }
 
-    virtual void PrintString(const wchar_t* const /*rgwch*/, const size_t /*cch*/) override
+    virtual void PrintString(const wchar_t* const rgwch, const size_t cch) override
     {
+        _printString.append(rgwch, cch);
     }
 
     StatefulDispatch() :
@@ -852,6 +964,7 @@ public:
     static const unsigned int s_uiGraphicsCleared = UINT_MAX;
     DispatchTypes::GraphicsOptions _rgOptions[s_cMaxOptions];
     size_t _cOptions;
+    std::wstring _printString;
 };
 
 class StateMachineExternalTest final
@@ -1647,4 +1760,112 @@ class StateMachineExternalTest final
         pDispatch->ClearState();
 
     }
+
+    TEST_METHOD(TestPrintRunBoundaries)
+    {
+        StatefulDispatch* pDispatch = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatch);
+        StateMachine mach(new OutputStateMachineEngine(pDispatch));
+
+        // The ground state scans ahead for the next control character several
+        //      characters at a time. Move a sequence across every offset of a
+        //      few scan blocks to make sure none of them are missed.
+        const std::wstring sequences[] = { L"\x1b[1m", L"\x9b" L"1m" };
+        for (const auto& sequence : sequences)
+        {
+            for (size_t offset = 0; offset <= 33; offset++)
+            {
+                const std::wstring before(offset, L'a');
+                const std::wstring after(40 - offset, L'b');
+                const std::wstring input = before + sequence + after;
+
+                mach.ProcessString(input);
+
+                VERIFY_IS_TRUE(pDispatch->_fSetGraphics);
+                VERIFY_ARE_EQUAL(String((before + after).c_str()), String(pDispatch->_printString.c_str()));
+
+                pDispatch->ClearState();
+            }
+        }
+    }
+
+    TEST_METHOD(TestMultipleInstancesPartialSequences)
+    {
+        StatefulDispatch* pDispatchA = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatchA);
+        StateMachine machA(new OutputStateMachineEngine(pDispatchA));
+
+        StatefulDispatch* pDispatchB = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatchB);
+        StateMachine machB(new OutputStateMachineEngine(pDispatchB));
+
+        Log::Comment(L"Leave the first machine in the middle of a sequence.");
+        machA.ProcessString(L"abc\x1b[3", 6);
+        VERIFY_IS_FALSE(pDispatchA->_fSetGraphics);
+
+        Log::Comment(L"The second machine shouldn't be affected by the partial sequence in the first.");
+        machB.ProcessString(L"Hello World", 11);
+        VERIFY_ARE_EQUAL(String(L"Hello World"), String(pDispatchB->_printString.c_str()));
+        VERIFY_IS_FALSE(pDispatchB->_fSetGraphics);
+
+        Log::Comment(L"Now leave the second machine mid-sequence, then finish the first.");
+        machB.ProcessString(L"\x1b]0;tit", 7);
+        machA.ProcessString(L"1mdef", 5);
+        VERIFY_IS_TRUE(pDispatchA->_fSetGraphics);
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), pDispatchA->_cOptions);
+        VERIFY_ARE_EQUAL(DispatchTypes::GraphicsOptions::ForegroundRed, pDispatchA->_rgOptions[0]);
+        VERIFY_ARE_EQUAL(String(L"abcdef"), String(pDispatchA->_printString.c_str()));
+
+        Log::Comment(L"The second machine should still be collecting its OSC string.");
+        machB.ProcessString(L"le\x7" L"xyz", 6);
+        VERIFY_ARE_EQUAL(String(L"Hello Worldxyz"), String(pDispatchB->_printString.c_str()));
+    }
+
+    TEST_METHOD(TestMultipleInstancesAcrossThreads)
+    {
+        // Parse a stream of partial sequences in many machines at once, one
+        //      per thread, the way the Terminal parses the output of each tab.
+        //      Every sequence is split across two calls to ProcessString, so
+        //      any state shared between the machines would break the results.
+        const size_t cThreads = 8;
+        const size_t cIterations = 5000;
+
+        std::atomic<size_t> cFailures{ 0 };
+        std::vector<std::thread> threads;
+        for (size_t iThread = 0; iThread < cThreads; iThread++)
+        {
+            threads.emplace_back([&cFailures, cIterations]() {
+                StatefulDispatch* pDispatch = new StatefulDispatch;
+                StateMachine mach(new OutputStateMachineEngine(pDispatch));
+
+                for (size_t i = 0; i < cIterations; i++)
+                {
+                    mach.ProcessString(L"abc\x1b[3", 6);
+                    std::this_thread::yield();
+                    mach.ProcessString(L"1mdef\x1b", 6);
+                    std::this_thread::yield();
+                    mach.ProcessString(L"[2J", 3);
+
+                    if (!pDispatch->_fSetGraphics ||
+                        pDispatch->_cOptions != 1 ||
+                        pDispatch->_rgOptions[0] != DispatchTypes::GraphicsOptions::ForegroundRed ||
+                        !pDispatch->_fEraseDisplay ||
+                        pDispatch->_eraseType != DispatchTypes::EraseType::All ||
+                        pDispatch->_printString != L"abcdef")
+                    {
+                        cFailures++;
+                    }
+
+                    pDispatch->ClearState();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        VERIFY_ARE_EQUAL(static_cast<size_t>(0), cFailures.load());
+    }
 };
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "inc/Utf8StreamDecoder.hpp"
+
+Utf8StreamDecoder::Utf8StreamDecoder() noexcept
+{
+    _ResetSequence();
+}
+
+// Routine Description:
+// - Decodes the next piece of the stream and appends the text to out.
+// - If the piece ends partway through a sequence, those bytes are remembered
+//   and nothing is appended for them until the rest of the sequence arrives.
+// Arguments:
+// - bytes - The next bytes of the UTF-8 stream.
+// - out - Receives the decoded UTF-16 text. Its existing contents are kept.
+// Return Value:
+// - <none>, throws if out can't grow.
+void Utf8StreamDecoder::Decode(const std::string_view bytes, std::wstring& out)
+{
+    const auto end = bytes.cend();
+    auto it = bytes.cbegin();
+    while (it != end)
+    {
+        const auto byte = static_cast<unsigned char>(*it);
+
+        if (_bytesNeeded == 0)
+        {
+            if (byte < 0x80)
+            {
+                // Copy the whole run of ASCII at once. It's by far the most common input.
+                const auto runEnd = std::find_if(it, end, [](const char ch) { return static_cast<unsigned char>(ch) >= 0x80; });
+                const auto runStart = out.size();
+                out.resize(runStart + (runEnd - it));
+                std::transform(it, runEnd, out.begin() + runStart, [](const char ch) { return static_cast<wchar_t>(ch); });
+                it = runEnd;
+                continue;
+            }
+            else if (byte >= 0xC2 && byte <= 0xDF)
+            {
+                _bytesNeeded = 1;
+                _codepoint = byte & 0x1F;
+            }
+            else if (byte >= 0xE0 && byte <= 0xEF)
+            {
+                // E0 would be overlong below A0. ED would be a surrogate above 9F.
+                _lowerBoundary = byte == 0xE0 ? 0xA0 : 0x80;
+                _upperBoundary = byte == 0xED ? 0x9F : 0xBF;
+                _bytesNeeded = 2;
+                _codepoint = byte & 0xF;
+            }
+            else if (byte >= 0xF0 && byte <= 0xF4)
+            {
+                // F0 would be overlong below 90. F4 would be past U+10FFFF above 8F.
+                _lowerBoundary = byte == 0xF0 ? 0x90 : 0x80;
+                _upperBoundary = byte == 0xF4 ? 0x8F : 0xBF;
+                _bytesNeeded = 3;
+                _codepoint = byte & 0x7;
+            }
+            else
+            {
+                // A stray continuation byte or a lead byte that can never start a valid sequence.
+                out.push_back(ReplacementChar);
+            }
+
+            ++it;
+            continue;
+        }
+
+        if (byte < _lowerBoundary || byte > _upperBoundary)
+        {
+            // The sequence in progress is broken. Replace what we had of it and
+            // look at this byte again as the start of something new.
+            _ResetSequence();
+            out.push_back(ReplacementChar);
+            continue;
+        }
+
+        _lowerBoundary = 0x80;
+        _upperBoundary = 0xBF;
+        _codepoint = (_codepoint << 6) | (byte & 0x3F);
+        ++it;
+
+        if (--_bytesNeeded == 0)
+        {
+            _Append(_codepoint, out);
+            _codepoint = 0;
+        }
+    }
+}
+
+// Routine Description:
+// - Ends the stream. A sequence that was still waiting for more bytes is
+//   replaced with U+FFFD and the decoder is ready for a new stream.
+// Arguments:
+// - out - Receives the replacement, if there was anything left over.
+// Return Value:
+// - <none>, throws if out can't grow.
+void Utf8StreamDecoder::Flush(std::wstring& out)
+{
+    if (HasPartialSequence())
+    {
+        _ResetSequence();
+        out.push_back(ReplacementChar);
+    }
+}
+
+// Routine Description:
+// - Forgets any partially decoded sequence.
+void Utf8StreamDecoder::Reset() noexcept
+{
+    _ResetSequence();
+}
+
+// Routine Description:
+// - Reports whether the last bytes given to Decode were the start of a sequence that isn't finished yet.
+// Return Value:
+// - true if some bytes are being held for the next piece of the stream.
+bool Utf8StreamDecoder::HasPartialSequence() const noexcept
+{
+    return _bytesNeeded != 0;
+}
+
+void Utf8StreamDecoder::_Append(const unsigned int codepoint, std::wstring& out)
+{
+    if (codepoint < 0x10000)
+    {
+        out.push_back(static_cast<wchar_t>(codepoint));
+    }
+    else
+    {
+        const auto supplementary = codepoint - 0x10000;
+        out.push_back(static_cast<wchar_t>(0xD800 + (supplementary >> 10)));
+        out.push_back(static_cast<wchar_t>(0xDC00 + (supplementary & 0x3FF)));
+    }
+}
+
+void Utf8StreamDecoder::_ResetSequence() noexcept
+{
+    _codepoint = 0;
+    _bytesNeeded = 0;
+    _lowerBoundary = 0x80;
+    _upperBoundary = 0xBF;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "inc/Utf8StreamReader.hpp"
+
+// Routine Description:
+// - Creates a reader over a stream.
+// Arguments:
+// - read - Called to read from the stream. See ReadCallback.
+// - available - Called to find out whether more can be read without blocking.
+//               May be empty, in which case each delivery is a single read.
+// - bufferSize - How many bytes to read into memory at most before decoding them.
+Utf8StreamReader::Utf8StreamReader(ReadCallback read,
+                                   AvailableCallback available,
+                                   const size_t bufferSize) :
+    _read{ std::move(read) },
+    _available{ std::move(available) },
+    _buffer(bufferSize),
+    _open{ true }
+{
+    THROW_HR_IF(E_INVALIDARG, !_read);
+    THROW_HR_IF(E_INVALIDARG, bufferSize == 0);
+
+    // The text never has more units than the bytes it was decoded from, plus
+    // the replacement for a sequence that was cut off when the stream ended.
+    _text.reserve(bufferSize + 1);
+}
+
+// Routine Description:
+// - Blocks until there's text to deliver and returns it.
+// - Everything that can be read without blocking again is read and decoded
+//   first, up to the size of the read buffer.
+// - When the stream ends, the text read before the end is still delivered,
+//   and the call after that returns false.
+// Arguments:
+// - text - On success, a view of the text. It stays valid until the next call.
+// Return Value:
+// - true if there's text. false if the stream has ended and everything in it has been delivered.
+bool Utf8StreamReader::Read(std::wstring_view& text)
+{
+    text = {};
+    _text.clear();
+
+    while (_open && _text.empty())
+    {
+        size_t filled = 0;
+        const bool stillOpen = _Fill(filled);
+
+        _decoder.Decode({ _buffer.data(), filled }, _text);
+
+        if (!stillOpen)
+        {
+            _decoder.Flush(_text);
+            _open = false;
+        }
+    }
+
+    text = _text;
+    return !_text.empty();
+}
+
+// Routine Description:
+// - Reports whether the stream might still have more to deliver.
+// Return Value:
+// - false once the stream has ended.
+bool Utf8StreamReader::IsOpen() const noexcept
+{
+    return _open;
+}
+
+// Routine Description:
+// - Reads into the buffer: once, blocking, and then again for as long as more
+//   is ready right now and there's room for it.
+// Arguments:
+// - filled - Receives how much of the buffer was filled.
+// Return Value:
+// - false if the stream ended or broke. What was read before that is still in the buffer.
+bool Utf8StreamReader::_Fill(size_t& filled)
+{
+    filled = 0;
+    do
+    {
+        size_t read = 0;
+        if (!_read(_buffer.data() + filled, _buffer.size() - filled, read))
+        {
+            return false;
+        }
+        filled += read;
+    } while (filled < _buffer.size() && _available && _available() > 0);
+
+    return true;
+}
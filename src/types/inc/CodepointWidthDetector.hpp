@@ -15,87 +15,16 @@ Author:
 
 #include "convert.hpp"
 
+#include <array>
+#include <climits>
+
 static_assert(sizeof(unsigned int) == sizeof(wchar_t) * 2,
-              "UnicodeRange expects to be able to store a unicode codepoint in an unsigned int");
+              "CodepointWidthDetector expects to be able to store a unicode codepoint in an unsigned int");
 
 
 // use to measure the width of a codepoint
 class CodepointWidthDetector final
 {
-protected:
-
-    // used to store range data in CodepointWidthDetector's internal map
-    class UnicodeRange final
-    {
-    public:
-        UnicodeRange(const unsigned int lowerBound,
-                     const unsigned int upperBound) :
-                     _lowerBound{ lowerBound },
-                     _upperBound{ upperBound },
-                     _isBounds{ true }
-        {
-        }
-
-        UnicodeRange(const unsigned int searchTerm) :
-                     _lowerBound{ searchTerm },
-                     _upperBound{ searchTerm },
-                     _isBounds{ false }
-        {
-        }
-
-        bool IsBounds() const noexcept
-        {
-            return _isBounds;
-        }
-
-        unsigned int LowerBound() const
-        {
-            FAIL_FAST_IF(!_isBounds);
-            return _lowerBound;
-        }
-
-        unsigned int UpperBound() const
-        {
-            FAIL_FAST_IF(!_isBounds);
-            return _upperBound;
-        }
-
-        unsigned int SearchTerm() const
-        {
-            FAIL_FAST_IF(_isBounds);
-            return _lowerBound;
-        }
-
-    private:
-        unsigned int _lowerBound;
-        unsigned int _upperBound;
-        bool _isBounds;
-    };
-
-    // used for comparing if we've found the range that a searching UnicodeRange falls into
-    struct UnicodeRangeCompare final
-    {
-        bool operator()(const UnicodeRange& a, const UnicodeRange& b) const
-        {
-            if (!a.IsBounds() && b.IsBounds())
-            {
-                return a.SearchTerm() < b.LowerBound();
-            }
-            else if (a.IsBounds() && !b.IsBounds())
-            {
-                return a.UpperBound() < b.SearchTerm();
-            }
-            else if (a.IsBounds() && b.IsBounds())
-            {
-                return a.LowerBound() < b.LowerBound();
-            }
-            else
-            {
-                return a.SearchTerm() < b.SearchTerm();
-            }
-        }
-    };
-
 public:
     CodepointWidthDetector() = default;
     CodepointWidthDetector(const CodepointWidthDetector&) = delete;
@@ -114,13 +43,44 @@ public:
 #endif
 
 private:
-    bool _lookupIsWide(const std::wstring_view glyph) const noexcept;
-    bool _checkFallbackViaCache(const std::wstring_view glyph) const;
+    // Remembers what the fallback method said about ambiguous codepoints, as
+    // asking the font is expensive. This is a fixed-size open addressing table
+    // keyed on the codepoint, so neither lookups nor inserts allocate. When it
+    // gets too full, it's emptied and starts over.
+    class FallbackCache final
+    {
+    public:
+        FallbackCache() noexcept;
+
+        bool TryGet(const unsigned int codepoint, bool& isWide) const noexcept;
+        void Set(const unsigned int codepoint, const bool isWide) noexcept;
+        void Clear() noexcept;
+        size_t Size() const noexcept;
+
+    private:
+        static constexpr size_t s_cSlots = 1024; // must be a power of two
+        static constexpr size_t s_cMaxEntries = s_cSlots / 4 * 3;
+        static constexpr unsigned int s_emptySlot = UINT_MAX;
+
+        struct Slot
+        {
+            unsigned int codepoint;
+            bool isWide;
+        };
+
+        static size_t _Hash(const unsigned int codepoint) noexcept;
+
+        std::array<Slot, s_cSlots> _slots;
+        size_t _cEntries;
+    };
+
+    static CodepointWidth _lookupWidth(const unsigned int codepoint) noexcept;
+    bool _isWide(const unsigned int codepoint, const std::wstring_view glyph) const;
+    bool _lookupIsWide(const unsigned int codepoint, const std::wstring_view glyph) const;
+    bool _checkFallbackViaCache(const unsigned int codepoint, const std::wstring_view glyph) const;
     unsigned int _extractCodepoint(const std::wstring_view glyph) const noexcept;
-    void _populateUnicodeSearchMap();
 
-    mutable std::map<std::wstring, bool> _fallbackCache;
-    std::map<UnicodeRange, CodepointWidth, UnicodeRangeCompare> _map;
+    mutable FallbackCache _fallbackCache;
     std::function<bool(std::wstring_view)> _pfnFallbackMethod;
     bool _hasFallback = false;
 };
@@ -0,0 +1,257 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Instrumentation.hpp
+
+Abstract:
+- Counters and histograms for measuring the hot paths of the console, like the
+  VT parser and the VT renderer, while they run in a real session.
+- Nothing is recorded unless instrumentation has been turned on with
+  SetEnabled. While it's off, a measurement costs one relaxed load and a
+  branch, and no clock is read.
+- Defining CON_INSTRUMENTATION_DISABLED turns IsEnabled into a constant false,
+  so the compiler removes the measurements entirely.
+- Header only and doesn't depend on any platform APIs, so any library can use
+  it without taking on a new link dependency.
+--*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Microsoft::Console::Instrumentation
+{
+#ifdef CON_INSTRUMENTATION_DISABLED
+    constexpr bool IsEnabled() noexcept
+    {
+        return false;
+    }
+
+    inline void SetEnabled(const bool /*enabled*/) noexcept
+    {
+    }
+#else
+    inline std::atomic<bool> s_enabled{ false };
+
+    inline bool IsEnabled() noexcept
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    inline void SetEnabled(const bool enabled) noexcept
+    {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+#endif
+
+    using Clock = std::chrono::steady_clock;
+
+    // A count that can be bumped from any thread.
+    class Counter final
+    {
+    public:
+        void Increment(const uint64_t amount = 1) noexcept
+        {
+            _value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t Get() const noexcept
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        void Reset() noexcept
+        {
+            _value.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> _value{ 0 };
+    };
+
+    // Distribution of values in power-of-two buckets that can be recorded into
+    // from any thread. Bucket 0 holds 0, and bucket N holds [2^(N-1), 2^N).
+    // The last bucket also holds everything too big for the others.
+    class Histogram final
+    {
+    public:
+        static constexpr size_t s_cBuckets = 48;
+
+        void Record(const uint64_t value) noexcept
+        {
+            _buckets[s_GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _sum.fetch_add(value, std::memory_order_relaxed);
+
+            uint64_t max = _max.load(std::memory_order_relaxed);
+            while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        uint64_t GetCount() const noexcept
+        {
+            return _count.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetSum() const noexcept
+        {
+            return _sum.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetMax() const noexcept
+        {
+            return _max.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetMean() const noexcept
+        {
+            const uint64_t count = GetCount();
+            return count == 0 ? 0 : GetSum() / count;
+        }
+
+        uint64_t GetBucketCount(const size_t bucket) const noexcept
+        {
+            return bucket < s_cBuckets ? _buckets[bucket].load(std::memory_order_relaxed) : 0;
+        }
+
+        // Routine Description:
+        // - Estimates the value below which the given share of the recorded
+        //   values fall, as the top of the bucket that share ends in.
+        // Arguments:
+        // - percent - The share of values to include, from 0 to 100.
+        // Return Value:
+        // - The estimate, never more than the largest value recorded. 0 if nothing was recorded.
+        uint64_t GetPercentile(const unsigned int percent) const noexcept
+        {
+            const uint64_t count = GetCount();
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            // Round up so that asking for 100 percent always reaches the last value.
+            const uint64_t target = (count * percent + 99) / 100;
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < s_cBuckets; ++bucket)
+            {
+                seen += GetBucketCount(bucket);
+                if (seen >= target && seen > 0)
+                {
+                    const uint64_t max = GetMax();
+                    const uint64_t top = s_GetBucketUpperBound(bucket);
+                    return top < max ? top : max;
+                }
+            }
+            return GetMax();
+        }
+
+        void Reset() noexcept
+        {
+            for (auto& bucket : _buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            _count.store(0, std::memory_order_relaxed);
+            _sum.store(0, std::memory_order_relaxed);
+            _max.store(0, std::memory_order_relaxed);
+        }
+
+        static size_t s_GetBucket(uint64_t value) noexcept
+        {
+            size_t bucket = 0;
+            while (value != 0 && bucket < s_cBuckets - 1)
+            {
+                value >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        // Gets the largest value that lands in the given bucket.
+        static uint64_t s_GetBucketUpperBound(const size_t bucket) noexcept
+        {
+            return bucket >= s_cBuckets - 1 ? UINT64_MAX : (uint64_t{ 1 } << bucket) - 1;
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, s_cBuckets> _buckets{};
+        std::atomic<uint64_t> _count{ 0 };
+        std::atomic<uint64_t> _sum{ 0 };
+        std::atomic<uint64_t> _max{ 0 };
+    };
+
+    // Records how many nanoseconds a scope took. The clock is only read if
+    // instrumentation was on when the scope started.
+    class ScopedLatency final
+    {
+    public:
+        explicit ScopedLatency(Histogram& histogram) noexcept :
+            _pHistogram{ IsEnabled() ? &histogram : nullptr },
+            _start{}
+        {
+            if (_pHistogram)
+            {
+                _start = Clock::now();
+            }
+        }
+
+        ~ScopedLatency()
+        {
+            if (_pHistogram)
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start);
+                _pHistogram->Record(static_cast<uint64_t>(elapsed.count()));
+            }
+        }
+
+        ScopedLatency(const ScopedLatency&) = delete;
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+    private:
+        Histogram* const _pHistogram;
+        Clock::time_point _start;
+    };
+
+    // Records how many units per second were handled by a scope, like the
+    // bytes written by a flush. The clock is only read if instrumentation was
+    // on when the scope started.
+    class ScopedThroughput final
+    {
+    public:
+        ScopedThroughput(Histogram& histogram, const size_t units) noexcept :
+            _pHistogram{ IsEnabled() ? &histogram : nullptr },
+            _units{ units },
+            _start{}
+        {
+            if (_pHistogram)
+            {
+                _start = Clock::now();
+            }
+        }
+
+        ~ScopedThroughput()
+        {
+            if (_pHistogram)
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start);
+                // Anything too quick to measure counts as one nanosecond.
+                const double seconds = (elapsed.count() > 0 ? elapsed.count() : 1) / 1e9;
+                _pHistogram->Record(static_cast<uint64_t>(_units / seconds));
+            }
+        }
+
+        ScopedThroughput(const ScopedThroughput&) = delete;
+        ScopedThroughput& operator=(const ScopedThroughput&) = delete;
+
+    private:
+        Histogram* const _pHistogram;
+        const size_t _units;
+        Clock::time_point _start;
+    };
+}
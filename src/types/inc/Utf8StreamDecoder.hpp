@@ -0,0 +1,47 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Utf8StreamDecoder.hpp
+
+Abstract:
+- Incremental decoder from a stream of UTF-8 bytes to UTF-16 text.
+- The stream can be handed over in pieces of any size. A sequence that is cut
+  off at the end of one piece is held onto and finished with the next.
+- Ill-formed input is replaced with U+FFFD, one per maximal invalid subpart,
+  the same way MultiByteToWideChar and the WHATWG decoder do it.
+- Doesn't depend on any platform APIs so it can be used and tested anywhere.
+
+--*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+class Utf8StreamDecoder final
+{
+public:
+    Utf8StreamDecoder() noexcept;
+
+    void Decode(const std::string_view bytes, std::wstring& out);
+    void Flush(std::wstring& out);
+    void Reset() noexcept;
+
+    bool HasPartialSequence() const noexcept;
+
+private:
+    static constexpr wchar_t ReplacementChar = 0xFFFD;
+
+    void _Append(const unsigned int codepoint, std::wstring& out);
+    void _ResetSequence() noexcept;
+
+    // The codepoint decoded so far from the sequence in progress, how many
+    // more continuation bytes it needs, and the range the next one has to be
+    // in to keep the sequence from being overlong, a surrogate, or out of range.
+    unsigned int _codepoint;
+    unsigned int _bytesNeeded;
+    unsigned char _lowerBoundary;
+    unsigned char _upperBoundary;
+};
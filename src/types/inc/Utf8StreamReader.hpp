@@ -0,0 +1,60 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Utf8StreamReader.hpp
+
+Abstract:
+- Reads a UTF-8 byte stream (like the output pipe of a pseudoconsole) and
+  hands it back as UTF-16 text in as few, as large, pieces as possible.
+- One large read buffer and one text buffer are kept for the life of the
+  reader. Everything that's ready to read is drained before the text is
+  handed back, so a burst of small writes on the other end becomes one
+  delivery here.
+- Sequences split between reads are put back together by Utf8StreamDecoder.
+- The stream itself is reached through callbacks, so the reader doesn't
+  depend on any platform APIs and can be driven by a pipe, a file, or memory.
+
+--*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Utf8StreamDecoder.hpp"
+
+class Utf8StreamReader final
+{
+public:
+    // Reads up to size bytes into buffer, blocking until there's at least one.
+    // Returns false once the stream has ended or broken.
+    using ReadCallback = std::function<bool(char* const buffer, const size_t size, size_t& read)>;
+
+    // Reports how many bytes can be read right now without blocking.
+    using AvailableCallback = std::function<size_t()>;
+
+    static constexpr size_t DefaultBufferSize = 128 * 1024;
+
+    Utf8StreamReader(ReadCallback read,
+                     AvailableCallback available,
+                     const size_t bufferSize = DefaultBufferSize);
+
+    bool Read(std::wstring_view& text);
+
+    bool IsOpen() const noexcept;
+
+private:
+    bool _Fill(size_t& filled);
+
+    ReadCallback _read;
+    AvailableCallback _available;
+
+    std::vector<char> _buffer;
+    std::wstring _text;
+    Utf8StreamDecoder _decoder;
+    bool _open;
+};